@@ -23,6 +23,28 @@ fn main() {
         "wrapper-cpp/modules/c_rawdata_audio_helper.cpp",
         "wrapper-cpp/modules/c_rawdata_video_helper.cpp",
         "wrapper-cpp/modules/c_recording_controller.cpp",
+        "wrapper-cpp/modules/c_audio_user_table.cpp",
+        "wrapper-cpp/modules/c_media_timeline.cpp",
+        "wrapper-cpp/modules/c_audio_dsp.cpp",
+        "wrapper-cpp/modules/c_audio_resampler.cpp",
+        "wrapper-cpp/modules/c_audio_vad.cpp",
+        "wrapper-cpp/modules/c_audio_level.cpp",
+        "wrapper-cpp/modules/c_audio_batch.cpp",
+        "wrapper-cpp/modules/c_audio_language_table.cpp",
+        "wrapper-cpp/modules/c_audio_mic_pacer.cpp",
+        "wrapper-cpp/modules/c_audio_mic_converter.cpp",
+        "wrapper-cpp/modules/c_audio_track_writer.cpp",
+        "wrapper-cpp/modules/c_audio_flac_encoder.cpp",
+        "wrapper-cpp/modules/c_audio_aligner.cpp",
+        "wrapper-cpp/modules/c_audio_mixer.cpp",
+        "wrapper-cpp/modules/c_audio_chunker.cpp",
+        "wrapper-cpp/modules/c_audio_share_capture.cpp",
+        "wrapper-cpp/modules/c_audio_overload.cpp",
+        "wrapper-cpp/modules/c_audio_echo_canceller.cpp",
+        "wrapper-cpp/modules/c_video_frame_pool.cpp",
+        "wrapper-cpp/modules/c_video_convert.cpp",
+        "wrapper-cpp/modules/c_video_thumbnailer.cpp",
+        "wrapper-cpp/modules/c_video_frame_rate.cpp",
     ];
     let cpp_headers = [
         "wrapper-cpp/c_auth_service_interface.h",
@@ -40,9 +62,41 @@ fn main() {
         "zoom-meeting-sdk-linux/h/zoom_sdk.h",
     ];
 
-    cpp_files.iter().chain(cpp_headers.iter()).for_each(|file| {
-        println!("cargo:rerun-if-changed={}", *file);
-    });
+    // Wrapper internals, not exposed to bindgen.
+    let cpp_internal_headers = [
+        "wrapper-cpp/modules/c_audio_ring_buffer.h",
+        "wrapper-cpp/modules/c_audio_user_table.h",
+        "wrapper-cpp/modules/c_media_timeline.h",
+        "wrapper-cpp/modules/c_audio_dsp.h",
+        "wrapper-cpp/modules/c_audio_resampler.h",
+        "wrapper-cpp/modules/c_audio_vad.h",
+        "wrapper-cpp/modules/c_audio_level.h",
+        "wrapper-cpp/modules/c_audio_batch.h",
+        "wrapper-cpp/modules/c_audio_language_table.h",
+        "wrapper-cpp/modules/c_audio_mic_pacer.h",
+        "wrapper-cpp/modules/c_audio_mic_converter.h",
+        "wrapper-cpp/modules/c_audio_track_writer.h",
+        "wrapper-cpp/modules/c_audio_flac_encoder.h",
+        "wrapper-cpp/modules/c_audio_aligner.h",
+        "wrapper-cpp/modules/c_audio_mixer.h",
+        "wrapper-cpp/modules/c_audio_chunker.h",
+        "wrapper-cpp/modules/c_audio_share_capture.h",
+        "wrapper-cpp/modules/c_audio_overload.h",
+        "wrapper-cpp/modules/c_audio_echo_canceller.h",
+        "wrapper-cpp/modules/c_video_frame_pool.h",
+        "wrapper-cpp/modules/c_video_convert.h",
+        "wrapper-cpp/modules/c_video_thumbnailer.h",
+        "wrapper-cpp/modules/c_video_frame_rate.h",
+        "wrapper-cpp/modules/c_cpu_features.h",
+    ];
+
+    cpp_files
+        .iter()
+        .chain(cpp_headers.iter())
+        .chain(cpp_internal_headers.iter())
+        .for_each(|file| {
+            println!("cargo:rerun-if-changed={}", *file);
+        });
 
     // Build own wrapper library
     cc::Build::new()
@@ -6567,16 +6567,39 @@ const _: () = {
     ["Alignment of IYUVRawDataI420Converter"]
         [::std::mem::align_of::<IYUVRawDataI420Converter>() - 8usize];
 };
+#[doc = " Signed 16-bit PCM, as produced by the SDK."]
+pub const audio_sample_format_AUDIO_SAMPLE_S16: audio_sample_format = 0;
+#[doc = " 32-bit float PCM in [-1, 1]."]
+pub const audio_sample_format_AUDIO_SAMPLE_F32: audio_sample_format = 1;
+#[doc = " @brief Sample format of exported_audio_raw_data::data."]
+pub type audio_sample_format = ::std::os::raw::c_uint;
 #[repr(C)]
 #[derive(Debug, Copy, Clone)]
 pub struct exported_audio_raw_data {
     pub data: *mut ::std::os::raw::c_char,
+    #[doc = " Wall clock arrival time in microseconds, derived from the monotonic clock so NTP steps do not show."]
     pub time: i64,
     pub len: ::std::os::raw::c_uint,
+    #[doc = " Sample format of `data`, see audio_helper_set_output_format."]
+    pub format: audio_sample_format,
+    #[doc = " Sample rate of `data` in Hz, the SDK rate unless a resampling rate is set."]
+    pub sample_rate: ::std::os::raw::c_uint,
+    #[doc = " Interleaved channels in `data`."]
+    pub channels: ::std::os::raw::c_uint,
+    #[doc = " SDK buffer backing `data`, NULL when `data` is a copy owned by the wrapper (queued delivery).\n Pass the frame to audio_raw_data_retain to keep `data` valid after the callback returns."]
+    pub raw: *mut AudioRawData,
+    #[doc = " SDK media timestamp in milliseconds (AudioRawData::GetTimeStamp), 0 if unavailable."]
+    pub sdk_time: u64,
+    #[doc = " CLOCK_MONOTONIC arrival time in microseconds."]
+    pub mono_time: i64,
+    #[doc = " Smoothed change of (arrival - media time) since the first frame of this stream, in microseconds."]
+    pub drift: i64,
+    #[doc = " Position of the first sample on the aligned timeline, at `sample_rate`: sample 0 is the first audio\n frame of the meeting. -1 when alignment is off or for share and interpreter audio, see audio_helper_set_alignment."]
+    pub sample_index: i64,
 }
 #[allow(clippy::unnecessary_operation, clippy::identity_op)]
 const _: () = {
-    ["Size of exported_audio_raw_data"][::std::mem::size_of::<exported_audio_raw_data>() - 24usize];
+    ["Size of exported_audio_raw_data"][::std::mem::size_of::<exported_audio_raw_data>() - 72usize];
     ["Alignment of exported_audio_raw_data"]
         [::std::mem::align_of::<exported_audio_raw_data>() - 8usize];
     ["Offset of field: exported_audio_raw_data::data"]
@@ -6585,6 +6608,589 @@ const _: () = {
         [::std::mem::offset_of!(exported_audio_raw_data, time) - 8usize];
     ["Offset of field: exported_audio_raw_data::len"]
         [::std::mem::offset_of!(exported_audio_raw_data, len) - 16usize];
+    ["Offset of field: exported_audio_raw_data::format"]
+        [::std::mem::offset_of!(exported_audio_raw_data, format) - 20usize];
+    ["Offset of field: exported_audio_raw_data::sample_rate"]
+        [::std::mem::offset_of!(exported_audio_raw_data, sample_rate) - 24usize];
+    ["Offset of field: exported_audio_raw_data::channels"]
+        [::std::mem::offset_of!(exported_audio_raw_data, channels) - 28usize];
+    ["Offset of field: exported_audio_raw_data::raw"]
+        [::std::mem::offset_of!(exported_audio_raw_data, raw) - 32usize];
+    ["Offset of field: exported_audio_raw_data::sdk_time"]
+        [::std::mem::offset_of!(exported_audio_raw_data, sdk_time) - 40usize];
+    ["Offset of field: exported_audio_raw_data::mono_time"]
+        [::std::mem::offset_of!(exported_audio_raw_data, mono_time) - 48usize];
+    ["Offset of field: exported_audio_raw_data::drift"]
+        [::std::mem::offset_of!(exported_audio_raw_data, drift) - 56usize];
+    ["Offset of field: exported_audio_raw_data::sample_index"]
+        [::std::mem::offset_of!(exported_audio_raw_data, sample_index) - 64usize];
+};
+#[doc = " @brief Silent one-way frames folded by the voice activity gate (see audio_helper_set_vad),\n or a gap between aligned frames (see audio_helper_set_alignment)."]
+#[repr(C)]
+#[derive(Debug, Copy, Clone)]
+pub struct audio_silence_marker {
+    #[doc = " Arrival time of the first silent frame, same clock as exported_audio_raw_data::time."]
+    pub start_time: i64,
+    #[doc = " SDK media timestamp of the first silent frame in milliseconds, 0 if unavailable."]
+    pub sdk_time: u64,
+    #[doc = " Audio duration of the folded frames."]
+    pub duration_ms: u32,
+    #[doc = " Folded frames, 0 for a gap."]
+    pub frames: u32,
+    #[doc = " Aligned position of the first silent sample, -1 when alignment is off."]
+    pub sample_index: i64,
+    #[doc = " Silent samples per channel, at the rate of the user's frames."]
+    pub samples: u64,
+}
+#[allow(clippy::unnecessary_operation, clippy::identity_op)]
+const _: () = {
+    ["Size of audio_silence_marker"][::std::mem::size_of::<audio_silence_marker>() - 40usize];
+    ["Alignment of audio_silence_marker"][::std::mem::align_of::<audio_silence_marker>() - 8usize];
+    ["Offset of field: audio_silence_marker::start_time"]
+        [::std::mem::offset_of!(audio_silence_marker, start_time) - 0usize];
+    ["Offset of field: audio_silence_marker::sdk_time"]
+        [::std::mem::offset_of!(audio_silence_marker, sdk_time) - 8usize];
+    ["Offset of field: audio_silence_marker::duration_ms"]
+        [::std::mem::offset_of!(audio_silence_marker, duration_ms) - 16usize];
+    ["Offset of field: audio_silence_marker::frames"]
+        [::std::mem::offset_of!(audio_silence_marker, frames) - 20usize];
+    ["Offset of field: audio_silence_marker::sample_index"]
+        [::std::mem::offset_of!(audio_silence_marker, sample_index) - 24usize];
+    ["Offset of field: audio_silence_marker::samples"]
+        [::std::mem::offset_of!(audio_silence_marker, samples) - 32usize];
+};
+#[doc = " Call into Rust synchronously from the SDK callback thread."]
+pub const audio_delivery_mode_AUDIO_DELIVERY_DIRECT: audio_delivery_mode = 0;
+#[doc = " Copy frames into preallocated lock-free rings, Rust pulls them with audio_helper_drain()."]
+pub const audio_delivery_mode_AUDIO_DELIVERY_QUEUED: audio_delivery_mode = 1;
+#[doc = " @brief How the delegate hands frames over to Rust."]
+pub type audio_delivery_mode = ::std::os::raw::c_uint;
+pub const audio_stream_kind_AUDIO_STREAM_MIXED: audio_stream_kind = 0;
+pub const audio_stream_kind_AUDIO_STREAM_ONE_WAY: audio_stream_kind = 1;
+pub const audio_stream_kind_AUDIO_STREAM_SHARE: audio_stream_kind = 2;
+#[doc = " Interpretation channels, see audio_helper_subscribe_delegate."]
+pub const audio_stream_kind_AUDIO_STREAM_INTERPRETER: audio_stream_kind = 3;
+#[doc = " @brief Audio streams produced by the delegate."]
+pub type audio_stream_kind = ::std::os::raw::c_uint;
+#[doc = " A frame, the payload is its PCM."]
+pub const audio_record_kind_AUDIO_RECORD_FRAME: audio_record_kind = 0;
+#[doc = " The payload is an audio_silence_marker."]
+pub const audio_record_kind_AUDIO_RECORD_SILENCE: audio_record_kind = 1;
+#[doc = " @brief Kind of a queued or batched record."]
+pub type audio_record_kind = ::std::os::raw::c_uint;
+#[doc = " @brief One record of a batch, see audio_helper_set_batch_window."]
+#[repr(C)]
+#[derive(Debug, Copy, Clone)]
+pub struct audio_batch_entry {
+    #[doc = " Metadata of the frame. `data` points to a copy owned by the batch (`raw` is NULL),\n or to an audio_silence_marker for AUDIO_RECORD_SILENCE."]
+    pub data: exported_audio_raw_data,
+    #[doc = " Sender of one-way and share audio, 0 for mixed and interpreter audio."]
+    pub user_id: u32,
+    pub stream: audio_stream_kind,
+    pub kind: audio_record_kind,
+    #[doc = " Language of interpreter audio, see audio_helper_get_interpreter_languages. 0 for the other streams."]
+    pub language_id: u16,
+}
+#[allow(clippy::unnecessary_operation, clippy::identity_op)]
+const _: () = {
+    ["Size of audio_batch_entry"][::std::mem::size_of::<audio_batch_entry>() - 88usize];
+    ["Alignment of audio_batch_entry"][::std::mem::align_of::<audio_batch_entry>() - 8usize];
+    ["Offset of field: audio_batch_entry::data"]
+        [::std::mem::offset_of!(audio_batch_entry, data) - 0usize];
+    ["Offset of field: audio_batch_entry::user_id"]
+        [::std::mem::offset_of!(audio_batch_entry, user_id) - 72usize];
+    ["Offset of field: audio_batch_entry::stream"]
+        [::std::mem::offset_of!(audio_batch_entry, stream) - 76usize];
+    ["Offset of field: audio_batch_entry::kind"]
+        [::std::mem::offset_of!(audio_batch_entry, kind) - 80usize];
+    ["Offset of field: audio_batch_entry::language_id"]
+        [::std::mem::offset_of!(audio_batch_entry, language_id) - 84usize];
+};
+#[doc = " @brief Ring buffer counters of one stream in AUDIO_DELIVERY_QUEUED mode."]
+#[repr(C)]
+#[derive(Debug, Copy, Clone)]
+pub struct audio_queue_stats {
+    pub pushed_frames: u64,
+    pub dropped_frames: u64,
+    pub dropped_bytes: u64,
+    pub drained_frames: u64,
+    pub high_water_bytes: u64,
+    pub capacity_bytes: u64,
+}
+#[allow(clippy::unnecessary_operation, clippy::identity_op)]
+const _: () = {
+    ["Size of audio_queue_stats"][::std::mem::size_of::<audio_queue_stats>() - 48usize];
+    ["Alignment of audio_queue_stats"][::std::mem::align_of::<audio_queue_stats>() - 8usize];
+    ["Offset of field: audio_queue_stats::pushed_frames"]
+        [::std::mem::offset_of!(audio_queue_stats, pushed_frames) - 0usize];
+    ["Offset of field: audio_queue_stats::dropped_frames"]
+        [::std::mem::offset_of!(audio_queue_stats, dropped_frames) - 8usize];
+    ["Offset of field: audio_queue_stats::dropped_bytes"]
+        [::std::mem::offset_of!(audio_queue_stats, dropped_bytes) - 16usize];
+    ["Offset of field: audio_queue_stats::drained_frames"]
+        [::std::mem::offset_of!(audio_queue_stats, drained_frames) - 24usize];
+    ["Offset of field: audio_queue_stats::high_water_bytes"]
+        [::std::mem::offset_of!(audio_queue_stats, high_water_bytes) - 32usize];
+    ["Offset of field: audio_queue_stats::capacity_bytes"]
+        [::std::mem::offset_of!(audio_queue_stats, capacity_bytes) - 40usize];
+};
+#[doc = " @brief State of one per-user stream of the one-way audio demultiplexer."]
+#[repr(C)]
+#[derive(Debug, Copy, Clone)]
+pub struct audio_user_stream {
+    pub user_id: u32,
+    #[doc = " False once the user left, the stream is still listed while it has queued frames."]
+    pub active: bool,
+    pub frames: u64,
+    pub samples: u64,
+    #[doc = " Arrival time of the last frame, same clock as exported_audio_raw_data::time."]
+    pub last_seen: i64,
+    pub queued_bytes: u64,
+    pub dropped_frames: u64,
+    #[doc = " Frames folded into silence markers by the voice activity gate."]
+    pub silent_frames: u64,
+}
+#[allow(clippy::unnecessary_operation, clippy::identity_op)]
+const _: () = {
+    ["Size of audio_user_stream"][::std::mem::size_of::<audio_user_stream>() - 56usize];
+    ["Alignment of audio_user_stream"][::std::mem::align_of::<audio_user_stream>() - 8usize];
+    ["Offset of field: audio_user_stream::user_id"]
+        [::std::mem::offset_of!(audio_user_stream, user_id) - 0usize];
+    ["Offset of field: audio_user_stream::active"]
+        [::std::mem::offset_of!(audio_user_stream, active) - 4usize];
+    ["Offset of field: audio_user_stream::frames"]
+        [::std::mem::offset_of!(audio_user_stream, frames) - 8usize];
+    ["Offset of field: audio_user_stream::samples"]
+        [::std::mem::offset_of!(audio_user_stream, samples) - 16usize];
+    ["Offset of field: audio_user_stream::last_seen"]
+        [::std::mem::offset_of!(audio_user_stream, last_seen) - 24usize];
+    ["Offset of field: audio_user_stream::queued_bytes"]
+        [::std::mem::offset_of!(audio_user_stream, queued_bytes) - 32usize];
+    ["Offset of field: audio_user_stream::dropped_frames"]
+        [::std::mem::offset_of!(audio_user_stream, dropped_frames) - 40usize];
+    ["Offset of field: audio_user_stream::silent_frames"]
+        [::std::mem::offset_of!(audio_user_stream, silent_frames) - 48usize];
+};
+#[doc = " @brief Rolling audio level of one user, see audio_helper_get_levels."]
+#[repr(C)]
+#[derive(Debug, Copy, Clone)]
+pub struct user_level {
+    pub user_id: u32,
+    #[doc = " Largest sample magnitude over the window, relative to full scale."]
+    pub peak: f32,
+    #[doc = " RMS over the window, relative to full scale."]
+    pub rms: f32,
+    #[doc = " `peak` in dBFS, -120 for silence."]
+    pub peak_dbfs: f32,
+    #[doc = " `rms` in dBFS, -120 for silence."]
+    pub rms_dbfs: f32,
+}
+#[allow(clippy::unnecessary_operation, clippy::identity_op)]
+const _: () = {
+    ["Size of user_level"][::std::mem::size_of::<user_level>() - 20usize];
+    ["Alignment of user_level"][::std::mem::align_of::<user_level>() - 4usize];
+    ["Offset of field: user_level::user_id"][::std::mem::offset_of!(user_level, user_id) - 0usize];
+    ["Offset of field: user_level::peak"][::std::mem::offset_of!(user_level, peak) - 4usize];
+    ["Offset of field: user_level::rms"][::std::mem::offset_of!(user_level, rms) - 8usize];
+    ["Offset of field: user_level::peak_dbfs"]
+        [::std::mem::offset_of!(user_level, peak_dbfs) - 12usize];
+    ["Offset of field: user_level::rms_dbfs"]
+        [::std::mem::offset_of!(user_level, rms_dbfs) - 16usize];
+};
+#[doc = " @brief Interpreter language interned by the delegate."]
+#[repr(C)]
+#[derive(Debug, Copy, Clone)]
+pub struct interpreter_language {
+    #[doc = " Carried by interpreter frames instead of the name, ids start at 1."]
+    pub language_id: u16,
+    #[doc = " Name given by the SDK, NUL terminated and truncated to 61 bytes."]
+    pub name: [::std::os::raw::c_char; 62usize],
+}
+#[allow(clippy::unnecessary_operation, clippy::identity_op)]
+const _: () = {
+    ["Size of interpreter_language"][::std::mem::size_of::<interpreter_language>() - 64usize];
+    ["Alignment of interpreter_language"][::std::mem::align_of::<interpreter_language>() - 2usize];
+    ["Offset of field: interpreter_language::language_id"]
+        [::std::mem::offset_of!(interpreter_language, language_id) - 0usize];
+    ["Offset of field: interpreter_language::name"]
+        [::std::mem::offset_of!(interpreter_language, name) - 2usize];
+};
+#[doc = " @brief Counters of the virtual mic pacer, see audio_helper_set_mic_pacer."]
+#[repr(C)]
+#[derive(Debug, Copy, Clone)]
+pub struct audio_mic_pacer_stats {
+    #[doc = " Chunks carrying queued audio, padded with silence on underrun."]
+    pub sent_chunks: u64,
+    #[doc = " Chunks of pure silence, sent while the queue was empty or refilling."]
+    pub silence_chunks: u64,
+    #[doc = " Times the queue ran dry during playback."]
+    pub underruns: u64,
+    #[doc = " Periods the thread woke up too late for, sent back to back or not sent at all."]
+    pub late_chunks: u64,
+    #[doc = " Chunks rejected by the SDK."]
+    pub send_errors: u64,
+    #[doc = " Worst delay between a period and the wake up of the thread."]
+    pub max_lateness_us: i64,
+    pub queued_bytes: u32,
+    pub running: bool,
+    #[doc = " Format sent to the SDK."]
+    pub sample_rate: u32,
+    pub channels: u32,
+}
+#[allow(clippy::unnecessary_operation, clippy::identity_op)]
+const _: () = {
+    ["Size of audio_mic_pacer_stats"][::std::mem::size_of::<audio_mic_pacer_stats>() - 64usize];
+    ["Alignment of audio_mic_pacer_stats"]
+        [::std::mem::align_of::<audio_mic_pacer_stats>() - 8usize];
+    ["Offset of field: audio_mic_pacer_stats::sent_chunks"]
+        [::std::mem::offset_of!(audio_mic_pacer_stats, sent_chunks) - 0usize];
+    ["Offset of field: audio_mic_pacer_stats::silence_chunks"]
+        [::std::mem::offset_of!(audio_mic_pacer_stats, silence_chunks) - 8usize];
+    ["Offset of field: audio_mic_pacer_stats::underruns"]
+        [::std::mem::offset_of!(audio_mic_pacer_stats, underruns) - 16usize];
+    ["Offset of field: audio_mic_pacer_stats::late_chunks"]
+        [::std::mem::offset_of!(audio_mic_pacer_stats, late_chunks) - 24usize];
+    ["Offset of field: audio_mic_pacer_stats::send_errors"]
+        [::std::mem::offset_of!(audio_mic_pacer_stats, send_errors) - 32usize];
+    ["Offset of field: audio_mic_pacer_stats::max_lateness_us"]
+        [::std::mem::offset_of!(audio_mic_pacer_stats, max_lateness_us) - 40usize];
+    ["Offset of field: audio_mic_pacer_stats::queued_bytes"]
+        [::std::mem::offset_of!(audio_mic_pacer_stats, queued_bytes) - 48usize];
+    ["Offset of field: audio_mic_pacer_stats::running"]
+        [::std::mem::offset_of!(audio_mic_pacer_stats, running) - 52usize];
+    ["Offset of field: audio_mic_pacer_stats::sample_rate"]
+        [::std::mem::offset_of!(audio_mic_pacer_stats, sample_rate) - 56usize];
+    ["Offset of field: audio_mic_pacer_stats::channels"]
+        [::std::mem::offset_of!(audio_mic_pacer_stats, channels) - 60usize];
+};
+#[doc = " PCM as delivered."]
+pub const audio_track_codec_AUDIO_TRACK_WAV: audio_track_codec = 0;
+#[doc = " Lossless 16-bit FLAC, encoded by the writer threads."]
+pub const audio_track_codec_AUDIO_TRACK_FLAC: audio_track_codec = 1;
+#[doc = " @brief File format of the recorded tracks."]
+pub type audio_track_codec = ::std::os::raw::c_uint;
+#[doc = " @brief Counters of the per-user track recorder, see audio_helper_start_recording."]
+#[repr(C)]
+#[derive(Debug, Copy, Clone)]
+pub struct audio_recorder_stats {
+    #[doc = " Track files opened since the delegate was created."]
+    pub files: u64,
+    pub written_frames: u64,
+    pub written_bytes: u64,
+    #[doc = " Frames lost to a full track ring, a user without slot or a failed write."]
+    pub dropped_frames: u64,
+    pub dropped_bytes: u64,
+    pub syncs: u64,
+    #[doc = " Failed opens, writes and truncations."]
+    pub write_errors: u64,
+    #[doc = " Slowest pwritev call."]
+    pub max_write_us: i64,
+    #[doc = " PCM taken from the track rings, `written_bytes` over it is the compression ratio."]
+    pub pcm_bytes: u64,
+    #[doc = " Writer thread time spent encoding, summed over the threads."]
+    pub encode_us: i64,
+    #[doc = " Frames waiting in the track rings."]
+    pub queued_bytes: u64,
+    pub open_tracks: u32,
+    pub running: bool,
+}
+#[allow(clippy::unnecessary_operation, clippy::identity_op)]
+const _: () = {
+    ["Size of audio_recorder_stats"][::std::mem::size_of::<audio_recorder_stats>() - 96usize];
+    ["Alignment of audio_recorder_stats"][::std::mem::align_of::<audio_recorder_stats>() - 8usize];
+    ["Offset of field: audio_recorder_stats::files"]
+        [::std::mem::offset_of!(audio_recorder_stats, files) - 0usize];
+    ["Offset of field: audio_recorder_stats::written_frames"]
+        [::std::mem::offset_of!(audio_recorder_stats, written_frames) - 8usize];
+    ["Offset of field: audio_recorder_stats::written_bytes"]
+        [::std::mem::offset_of!(audio_recorder_stats, written_bytes) - 16usize];
+    ["Offset of field: audio_recorder_stats::dropped_frames"]
+        [::std::mem::offset_of!(audio_recorder_stats, dropped_frames) - 24usize];
+    ["Offset of field: audio_recorder_stats::dropped_bytes"]
+        [::std::mem::offset_of!(audio_recorder_stats, dropped_bytes) - 32usize];
+    ["Offset of field: audio_recorder_stats::syncs"]
+        [::std::mem::offset_of!(audio_recorder_stats, syncs) - 40usize];
+    ["Offset of field: audio_recorder_stats::write_errors"]
+        [::std::mem::offset_of!(audio_recorder_stats, write_errors) - 48usize];
+    ["Offset of field: audio_recorder_stats::max_write_us"]
+        [::std::mem::offset_of!(audio_recorder_stats, max_write_us) - 56usize];
+    ["Offset of field: audio_recorder_stats::pcm_bytes"]
+        [::std::mem::offset_of!(audio_recorder_stats, pcm_bytes) - 64usize];
+    ["Offset of field: audio_recorder_stats::encode_us"]
+        [::std::mem::offset_of!(audio_recorder_stats, encode_us) - 72usize];
+    ["Offset of field: audio_recorder_stats::queued_bytes"]
+        [::std::mem::offset_of!(audio_recorder_stats, queued_bytes) - 80usize];
+    ["Offset of field: audio_recorder_stats::open_tracks"]
+        [::std::mem::offset_of!(audio_recorder_stats, open_tracks) - 88usize];
+    ["Offset of field: audio_recorder_stats::running"]
+        [::std::mem::offset_of!(audio_recorder_stats, running) - 92usize];
+};
+#[doc = " The mix is not produced."]
+pub const audio_mix_mode_AUDIO_MIX_OFF: audio_mix_mode = 0;
+#[doc = " Only the listed users."]
+pub const audio_mix_mode_AUDIO_MIX_INCLUDE: audio_mix_mode = 1;
+#[doc = " Everyone but the listed users."]
+pub const audio_mix_mode_AUDIO_MIX_EXCLUDE: audio_mix_mode = 2;
+#[doc = " @brief Members of a custom mix, see audio_helper_set_mix."]
+pub type audio_mix_mode = ::std::os::raw::c_uint;
+#[doc = " @brief Counters of the custom mixer, see audio_helper_set_mixer."]
+#[repr(C)]
+#[derive(Debug, Copy, Clone)]
+pub struct audio_mixer_stats {
+    #[doc = " 10 ms periods mixed."]
+    pub ticks: u64,
+    #[doc = " Periods the thread woke up too late for, mixed back to back or not mixed at all."]
+    pub late_ticks: u64,
+    #[doc = " Mixed frames handed to Rust, one per produced mix and period."]
+    pub delivered_frames: u64,
+    #[doc = " Times the queue of a playing user ran dry."]
+    pub underruns: u64,
+    #[doc = " Audio discarded because a user queue was full or lagged too far behind the clock."]
+    pub dropped_bytes: u64,
+    #[doc = " Worst delay between a period and the wake up of the thread."]
+    pub max_lateness_us: i64,
+    #[doc = " Slowest mixing of one period, callbacks excluded."]
+    pub max_mix_us: i64,
+    #[doc = " Users who contributed to the last period."]
+    pub inputs: u32,
+    #[doc = " Mixes currently produced."]
+    pub mixes: u32,
+    pub sample_rate: u32,
+    pub running: bool,
+}
+#[allow(clippy::unnecessary_operation, clippy::identity_op)]
+const _: () = {
+    ["Size of audio_mixer_stats"][::std::mem::size_of::<audio_mixer_stats>() - 72usize];
+    ["Alignment of audio_mixer_stats"][::std::mem::align_of::<audio_mixer_stats>() - 8usize];
+    ["Offset of field: audio_mixer_stats::ticks"]
+        [::std::mem::offset_of!(audio_mixer_stats, ticks) - 0usize];
+    ["Offset of field: audio_mixer_stats::late_ticks"]
+        [::std::mem::offset_of!(audio_mixer_stats, late_ticks) - 8usize];
+    ["Offset of field: audio_mixer_stats::delivered_frames"]
+        [::std::mem::offset_of!(audio_mixer_stats, delivered_frames) - 16usize];
+    ["Offset of field: audio_mixer_stats::underruns"]
+        [::std::mem::offset_of!(audio_mixer_stats, underruns) - 24usize];
+    ["Offset of field: audio_mixer_stats::dropped_bytes"]
+        [::std::mem::offset_of!(audio_mixer_stats, dropped_bytes) - 32usize];
+    ["Offset of field: audio_mixer_stats::max_lateness_us"]
+        [::std::mem::offset_of!(audio_mixer_stats, max_lateness_us) - 40usize];
+    ["Offset of field: audio_mixer_stats::max_mix_us"]
+        [::std::mem::offset_of!(audio_mixer_stats, max_mix_us) - 48usize];
+    ["Offset of field: audio_mixer_stats::inputs"]
+        [::std::mem::offset_of!(audio_mixer_stats, inputs) - 56usize];
+    ["Offset of field: audio_mixer_stats::mixes"]
+        [::std::mem::offset_of!(audio_mixer_stats, mixes) - 60usize];
+    ["Offset of field: audio_mixer_stats::sample_rate"]
+        [::std::mem::offset_of!(audio_mixer_stats, sample_rate) - 64usize];
+    ["Offset of field: audio_mixer_stats::running"]
+        [::std::mem::offset_of!(audio_mixer_stats, running) - 68usize];
+};
+#[doc = " @brief Counters of the chunker, see audio_helper_set_chunker."]
+#[repr(C)]
+#[derive(Debug, Copy, Clone)]
+pub struct audio_chunker_stats {
+    #[doc = " Windows delivered, padded ones included."]
+    pub windows: u64,
+    #[doc = " Windows delivered in place, pointing into the frame."]
+    pub zero_copy_windows: u64,
+    #[doc = " Audio copied into the slab to assemble windows straddling two frames."]
+    pub copied_bytes: u64,
+    #[doc = " Windows completed with zeros because their stream was interrupted."]
+    pub padded_windows: u64,
+    #[doc = " Frames delivered as is: stream beyond the slab, or window larger than a slot."]
+    pub unchunked_frames: u64,
+    pub window_ms: u32,
+    pub overlap_ms: u32,
+}
+#[allow(clippy::unnecessary_operation, clippy::identity_op)]
+const _: () = {
+    ["Size of audio_chunker_stats"][::std::mem::size_of::<audio_chunker_stats>() - 48usize];
+    ["Alignment of audio_chunker_stats"][::std::mem::align_of::<audio_chunker_stats>() - 8usize];
+    ["Offset of field: audio_chunker_stats::windows"]
+        [::std::mem::offset_of!(audio_chunker_stats, windows) - 0usize];
+    ["Offset of field: audio_chunker_stats::zero_copy_windows"]
+        [::std::mem::offset_of!(audio_chunker_stats, zero_copy_windows) - 8usize];
+    ["Offset of field: audio_chunker_stats::copied_bytes"]
+        [::std::mem::offset_of!(audio_chunker_stats, copied_bytes) - 16usize];
+    ["Offset of field: audio_chunker_stats::padded_windows"]
+        [::std::mem::offset_of!(audio_chunker_stats, padded_windows) - 24usize];
+    ["Offset of field: audio_chunker_stats::unchunked_frames"]
+        [::std::mem::offset_of!(audio_chunker_stats, unchunked_frames) - 32usize];
+    ["Offset of field: audio_chunker_stats::window_ms"]
+        [::std::mem::offset_of!(audio_chunker_stats, window_ms) - 40usize];
+    ["Offset of field: audio_chunker_stats::overlap_ms"]
+        [::std::mem::offset_of!(audio_chunker_stats, overlap_ms) - 44usize];
+};
+#[doc = " @brief Share audio frame popped with audio_helper_pop_share_audio.\n The receiver owns a reference on `data.raw`, given back with audio_raw_data_release."]
+#[repr(C)]
+#[derive(Debug, Copy, Clone)]
+pub struct share_audio_packet {
+    #[doc = " `sdk_time` is the SDK timestamp of the frame."]
+    pub data: exported_audio_raw_data,
+    #[doc = " User sharing the audio."]
+    pub user_id: u32,
+}
+#[allow(clippy::unnecessary_operation, clippy::identity_op)]
+const _: () = {
+    ["Size of share_audio_packet"][::std::mem::size_of::<share_audio_packet>() - 80usize];
+    ["Alignment of share_audio_packet"][::std::mem::align_of::<share_audio_packet>() - 8usize];
+    ["Offset of field: share_audio_packet::data"]
+        [::std::mem::offset_of!(share_audio_packet, data) - 0usize];
+    ["Offset of field: share_audio_packet::user_id"]
+        [::std::mem::offset_of!(share_audio_packet, user_id) - 72usize];
+};
+#[doc = " @brief Counters of the share audio capture, see audio_helper_set_share_capture."]
+#[repr(C)]
+#[derive(Debug, Copy, Clone)]
+pub struct share_capture_stats {
+    #[doc = " Frames queued with a reference on the SDK buffer."]
+    pub zero_copy_frames: u64,
+    #[doc = " Frames queued as a pooled copy: converted by the output format, or reference refused by the SDK."]
+    pub copied_frames: u64,
+    #[doc = " Frames lost to a full queue or an exhausted pool."]
+    pub dropped_frames: u64,
+    pub popped_frames: u64,
+    pub queued: u32,
+    pub capacity: u32,
+    #[doc = " Pooled copies still referenced, queued or held by the receiver."]
+    pub pooled_in_use: u32,
+    pub pool_size: u32,
+    pub enabled: bool,
+}
+#[allow(clippy::unnecessary_operation, clippy::identity_op)]
+const _: () = {
+    ["Size of share_capture_stats"][::std::mem::size_of::<share_capture_stats>() - 56usize];
+    ["Alignment of share_capture_stats"][::std::mem::align_of::<share_capture_stats>() - 8usize];
+    ["Offset of field: share_capture_stats::zero_copy_frames"]
+        [::std::mem::offset_of!(share_capture_stats, zero_copy_frames) - 0usize];
+    ["Offset of field: share_capture_stats::copied_frames"]
+        [::std::mem::offset_of!(share_capture_stats, copied_frames) - 8usize];
+    ["Offset of field: share_capture_stats::dropped_frames"]
+        [::std::mem::offset_of!(share_capture_stats, dropped_frames) - 16usize];
+    ["Offset of field: share_capture_stats::popped_frames"]
+        [::std::mem::offset_of!(share_capture_stats, popped_frames) - 24usize];
+    ["Offset of field: share_capture_stats::queued"]
+        [::std::mem::offset_of!(share_capture_stats, queued) - 32usize];
+    ["Offset of field: share_capture_stats::capacity"]
+        [::std::mem::offset_of!(share_capture_stats, capacity) - 36usize];
+    ["Offset of field: share_capture_stats::pooled_in_use"]
+        [::std::mem::offset_of!(share_capture_stats, pooled_in_use) - 40usize];
+    ["Offset of field: share_capture_stats::pool_size"]
+        [::std::mem::offset_of!(share_capture_stats, pool_size) - 44usize];
+    ["Offset of field: share_capture_stats::enabled"]
+        [::std::mem::offset_of!(share_capture_stats, enabled) - 48usize];
+};
+#[doc = " Queue everything, frames are only lost when the ring is full."]
+pub const audio_overload_policy_AUDIO_OVERLOAD_NEVER_DROP: audio_overload_policy = 0;
+#[doc = " While the ring is over the high-water mark, the drain skips its oldest silent frames."]
+pub const audio_overload_policy_AUDIO_OVERLOAD_DROP_SILENCE: audio_overload_policy = 1;
+#[doc = " Also resample the frames queued over the high-water mark to a lower rate."]
+pub const audio_overload_policy_AUDIO_OVERLOAD_DEGRADE: audio_overload_policy = 2;
+#[doc = " Also stop queueing the users whose ring stays backed up, one-way stream only."]
+pub const audio_overload_policy_AUDIO_OVERLOAD_SHED_USERS: audio_overload_policy = 3;
+#[doc = " @brief What a queued stream gives up when its ring backs up, see audio_helper_set_overload_policy.\n Each policy applies the gentler ones before it."]
+pub type audio_overload_policy = ::std::os::raw::c_uint;
+#[doc = " @brief Actions of the overload policy of one stream, see audio_helper_set_overload_policy."]
+#[repr(C)]
+#[derive(Debug, Copy, Clone)]
+pub struct audio_overload_stats {
+    #[doc = " Silent frames skipped by the drain."]
+    pub dropped_silent_frames: u64,
+    #[doc = " Frames queued at the degraded rate."]
+    pub degraded_frames: u64,
+    #[doc = " Times a queue switched to the degraded rate."]
+    pub degrade_events: u64,
+    #[doc = " Frames of shed users."]
+    pub shed_frames: u64,
+    #[doc = " Times a user was shed."]
+    pub shed_events: u64,
+    #[doc = " Frames that would have been shed but were queued, their user having no slot to keep the state in."]
+    pub unshed_frames: u64,
+    #[doc = " Queues currently at the degraded rate."]
+    pub degraded_queues: u32,
+    #[doc = " Users currently shed."]
+    pub shed_users: u32,
+    pub policy: audio_overload_policy,
+    pub high_water_percent: u32,
+    pub degrade_rate: u32,
+}
+#[allow(clippy::unnecessary_operation, clippy::identity_op)]
+const _: () = {
+    ["Size of audio_overload_stats"][::std::mem::size_of::<audio_overload_stats>() - 72usize];
+    ["Alignment of audio_overload_stats"][::std::mem::align_of::<audio_overload_stats>() - 8usize];
+    ["Offset of field: audio_overload_stats::dropped_silent_frames"]
+        [::std::mem::offset_of!(audio_overload_stats, dropped_silent_frames) - 0usize];
+    ["Offset of field: audio_overload_stats::degraded_frames"]
+        [::std::mem::offset_of!(audio_overload_stats, degraded_frames) - 8usize];
+    ["Offset of field: audio_overload_stats::degrade_events"]
+        [::std::mem::offset_of!(audio_overload_stats, degrade_events) - 16usize];
+    ["Offset of field: audio_overload_stats::shed_frames"]
+        [::std::mem::offset_of!(audio_overload_stats, shed_frames) - 24usize];
+    ["Offset of field: audio_overload_stats::shed_events"]
+        [::std::mem::offset_of!(audio_overload_stats, shed_events) - 32usize];
+    ["Offset of field: audio_overload_stats::unshed_frames"]
+        [::std::mem::offset_of!(audio_overload_stats, unshed_frames) - 40usize];
+    ["Offset of field: audio_overload_stats::degraded_queues"]
+        [::std::mem::offset_of!(audio_overload_stats, degraded_queues) - 48usize];
+    ["Offset of field: audio_overload_stats::shed_users"]
+        [::std::mem::offset_of!(audio_overload_stats, shed_users) - 52usize];
+    ["Offset of field: audio_overload_stats::policy"]
+        [::std::mem::offset_of!(audio_overload_stats, policy) - 56usize];
+    ["Offset of field: audio_overload_stats::high_water_percent"]
+        [::std::mem::offset_of!(audio_overload_stats, high_water_percent) - 60usize];
+    ["Offset of field: audio_overload_stats::degrade_rate"]
+        [::std::mem::offset_of!(audio_overload_stats, degrade_rate) - 64usize];
+};
+#[doc = " @brief Counters of the echo canceller, see audio_helper_set_echo_canceller."]
+#[repr(C)]
+#[derive(Debug, Copy, Clone)]
+pub struct audio_echo_canceller_stats {
+    #[doc = " Mixed frames filtered."]
+    pub frames: u64,
+    #[doc = " Mixed frames left untouched: no delay estimate yet, or not mono 16-bit PCM at the canceller rate."]
+    pub bypassed_frames: u64,
+    #[doc = " Sent samples kept as reference, at the canceller rate."]
+    pub reference_samples: u64,
+    #[doc = " Sent samples not kept, sent more than 2 s ahead of real time."]
+    pub dropped_reference_samples: u64,
+    #[doc = " Trusted delay estimates."]
+    pub delay_estimates: u64,
+    #[doc = " Filtered frames where someone talked over the bot, the filter does not adapt on them."]
+    pub double_talk_frames: u64,
+    #[doc = " Longest time spent on a mixed frame."]
+    pub max_frame_us: i64,
+    #[doc = " Estimated loopback delay, -1 until the first estimate."]
+    pub delay_ms: i32,
+    #[doc = " Echo return loss enhancement over the last second of bot speech."]
+    pub erle_db: f32,
+    pub enabled: bool,
+}
+#[allow(clippy::unnecessary_operation, clippy::identity_op)]
+const _: () = {
+    ["Size of audio_echo_canceller_stats"]
+        [::std::mem::size_of::<audio_echo_canceller_stats>() - 72usize];
+    ["Alignment of audio_echo_canceller_stats"]
+        [::std::mem::align_of::<audio_echo_canceller_stats>() - 8usize];
+    ["Offset of field: audio_echo_canceller_stats::frames"]
+        [::std::mem::offset_of!(audio_echo_canceller_stats, frames) - 0usize];
+    ["Offset of field: audio_echo_canceller_stats::bypassed_frames"]
+        [::std::mem::offset_of!(audio_echo_canceller_stats, bypassed_frames) - 8usize];
+    ["Offset of field: audio_echo_canceller_stats::reference_samples"]
+        [::std::mem::offset_of!(audio_echo_canceller_stats, reference_samples) - 16usize];
+    ["Offset of field: audio_echo_canceller_stats::dropped_reference_samples"]
+        [::std::mem::offset_of!(audio_echo_canceller_stats, dropped_reference_samples) - 24usize];
+    ["Offset of field: audio_echo_canceller_stats::delay_estimates"]
+        [::std::mem::offset_of!(audio_echo_canceller_stats, delay_estimates) - 32usize];
+    ["Offset of field: audio_echo_canceller_stats::double_talk_frames"]
+        [::std::mem::offset_of!(audio_echo_canceller_stats, double_talk_frames) - 40usize];
+    ["Offset of field: audio_echo_canceller_stats::max_frame_us"]
+        [::std::mem::offset_of!(audio_echo_canceller_stats, max_frame_us) - 48usize];
+    ["Offset of field: audio_echo_canceller_stats::delay_ms"]
+        [::std::mem::offset_of!(audio_echo_canceller_stats, delay_ms) - 56usize];
+    ["Offset of field: audio_echo_canceller_stats::erle_db"]
+        [::std::mem::offset_of!(audio_echo_canceller_stats, erle_db) - 60usize];
+    ["Offset of field: audio_echo_canceller_stats::enabled"]
+        [::std::mem::offset_of!(audio_echo_canceller_stats, enabled) - 64usize];
 };
 unsafe extern "C" {
     pub fn audio_helper_create_delegate(
@@ -6592,11 +7198,285 @@ unsafe extern "C" {
         use_separate_channels: bool,
     ) -> *mut ZOOMSDK_IZoomSDKAudioRawDataDelegate;
 }
+unsafe extern "C" {
+    #[doc = " @brief Select how frames are delivered to Rust.\n @param delegate A delegate created by audio_helper_create_delegate.\n @param mode AUDIO_DELIVERY_DIRECT or AUDIO_DELIVERY_QUEUED.\n @param ring_capacity Size in bytes of each per-stream ring. Only used the first time queued mode is enabled.\n @param user_ring_capacity Size in bytes of each per-user ring of the one-way stream, same rule.\n @return false if the delegate is NULL or the rings cannot be allocated."]
+    pub fn audio_helper_set_delivery_mode(
+        delegate: *mut ZOOMSDK_IZoomSDKAudioRawDataDelegate,
+        mode: audio_delivery_mode,
+        ring_capacity: ::std::os::raw::c_uint,
+        user_ring_capacity: ::std::os::raw::c_uint,
+    ) -> bool;
+}
+unsafe extern "C" {
+    #[doc = " @brief Pop queued frames and dispatch them to the usual Rust callbacks on the calling thread.\n Must always be called from the same thread.\n @param max_frames Upper bound of frames dispatched by this call, across all streams.\n @return The number of dispatched frames."]
+    pub fn audio_helper_drain(
+        delegate: *mut ZOOMSDK_IZoomSDKAudioRawDataDelegate,
+        max_frames: ::std::os::raw::c_uint,
+    ) -> ::std::os::raw::c_uint;
+}
+unsafe extern "C" {
+    #[doc = " @brief Convert frames before they are delivered, with SIMD kernels on the SDK thread.\n Converted frames are owned by the wrapper, their `raw` field is NULL.\n @param format AUDIO_SAMPLE_F32 to receive floats instead of 16-bit PCM.\n @param downmix_mono Average the channels of stereo frames.\n @param gain Linear gain, 16-bit output saturates and float output is clipped to [-1, 1].\n @param sample_rate Resample every stream to this rate with a polyphase filter, 0 keeps the SDK rate.\n Filter state is kept per stream, and per user for one-way audio.\n @return false if the delegate is NULL."]
+    pub fn audio_helper_set_output_format(
+        delegate: *mut ZOOMSDK_IZoomSDKAudioRawDataDelegate,
+        format: audio_sample_format,
+        downmix_mono: bool,
+        gain: f32,
+        sample_rate: ::std::os::raw::c_uint,
+    ) -> bool;
+}
+unsafe extern "C" {
+    #[doc = " @brief Gate silent one-way frames before they reach Rust.\n Each user has an energy / zero-crossing detector. Frames that are not forwarded are summed\n into audio_silence_marker records, delivered in order with the frames of the user.\n @param enabled false forwards every frame.\n @param threshold_dbfs RMS level from which a frame is voice, e.g. -50.\n @param hangover_ms Keep forwarding this long after the last voiced frame.\n @param max_silence_ms Emit a marker at least this often while a user stays silent.\n @return false if the delegate is NULL."]
+    pub fn audio_helper_set_vad(
+        delegate: *mut ZOOMSDK_IZoomSDKAudioRawDataDelegate,
+        enabled: bool,
+        threshold_dbfs: f32,
+        hangover_ms: ::std::os::raw::c_uint,
+        max_silence_ms: ::std::os::raw::c_uint,
+    ) -> bool;
+}
+unsafe extern "C" {
+    #[doc = " @brief Get the ring buffer counters of a stream.\n @return false if the delegate is NULL or queued mode was never enabled."]
+    pub fn audio_helper_get_queue_stats(
+        delegate: *mut ZOOMSDK_IZoomSDKAudioRawDataDelegate,
+        stream: audio_stream_kind,
+        stats: *mut audio_queue_stats,
+    ) -> bool;
+}
+unsafe extern "C" {
+    #[doc = " @brief Create the per-user stream slots of users who joined the meeting.\n Called automatically for a delegate attached with audio_helper_attach_participants."]
+    pub fn audio_helper_user_join(
+        delegate: *mut ZOOMSDK_IZoomSDKAudioRawDataDelegate,
+        user_ids: *const ::std::os::raw::c_uint,
+        count: ::std::os::raw::c_uint,
+    );
+}
+unsafe extern "C" {
+    #[doc = " @brief Keep the per-user stream slots of the delegate in sync with the participants of the meeting.\n Creates the slots of the users already in the meeting, then routes the joins and leaves to the delegate.\n Without it a slot is created by the first frame of its user and reclaimed once idle and needed.\n @return SDKERR_INVALID_PARAMETER if the delegate or the controller is NULL."]
+    pub fn audio_helper_attach_participants(
+        delegate: *mut ZOOMSDK_IZoomSDKAudioRawDataDelegate,
+        controller: *mut ZOOMSDK_IMeetingParticipantsController,
+    ) -> ZOOMSDK_SDKError;
+}
+unsafe extern "C" {
+    #[doc = " @brief Stop routing the participant events to the delegate, see audio_helper_attach_participants."]
+    pub fn audio_helper_detach_participants(delegate: *mut ZOOMSDK_IZoomSDKAudioRawDataDelegate);
+}
+unsafe extern "C" {
+    #[doc = " @brief Retire the per-user stream slots of users who left the meeting."]
+    pub fn audio_helper_user_left(
+        delegate: *mut ZOOMSDK_IZoomSDKAudioRawDataDelegate,
+        user_ids: *const ::std::os::raw::c_uint,
+        count: ::std::os::raw::c_uint,
+    );
+}
+unsafe extern "C" {
+    #[doc = " @brief Copy the state of the per-user streams into `streams`.\n @return The number of written entries, at most `cap`."]
+    pub fn audio_helper_get_user_streams(
+        delegate: *mut ZOOMSDK_IZoomSDKAudioRawDataDelegate,
+        streams: *mut audio_user_stream,
+        cap: ::std::os::raw::c_uint,
+    ) -> ::std::os::raw::c_uint;
+}
+unsafe extern "C" {
+    #[doc = " @brief Take a reference on the SDK buffer of a frame, so `data` stays valid after the callback returns.\n @return The buffer to give back with audio_raw_data_release, NULL if the frame has no SDK buffer\n or the SDK does not allow more references."]
+    pub fn audio_raw_data_retain(data: *const exported_audio_raw_data) -> *mut AudioRawData;
+}
+unsafe extern "C" {
+    #[doc = " @brief Drop a reference taken by audio_raw_data_retain. The SDK frees the buffer with its last reference."]
+    pub fn audio_raw_data_release(raw: *mut AudioRawData);
+}
+unsafe extern "C" {
+    #[doc = " @brief Meter the one-way audio of every user over a rolling window.\n @param window_ms Length of the window, 0 disables metering.\n @return false if the delegate is NULL."]
+    pub fn audio_helper_set_level_window(
+        delegate: *mut ZOOMSDK_IZoomSDKAudioRawDataDelegate,
+        window_ms: ::std::os::raw::c_uint,
+    ) -> bool;
+}
+unsafe extern "C" {
+    #[doc = " @brief Copy the levels of the users in the meeting into `levels`, in one call.\n Users who sent no audio during the window read as silence.\n @return The number of written entries, at most `cap`. 0 if metering is disabled."]
+    pub fn audio_helper_get_levels(
+        delegate: *mut ZOOMSDK_IZoomSDKAudioRawDataDelegate,
+        levels: *mut user_level,
+        cap: ::std::os::raw::c_uint,
+    ) -> ::std::os::raw::c_uint;
+}
+unsafe extern "C" {
+    #[doc = " @brief Accumulate directly delivered frames and hand them to Rust in one call per window.\n Each stream is batched on its own SDK thread, the records keep their order within a stream.\n A batch is delivered with the first frame arriving once the window elapsed. The batch of a stream\n that went quiet is delivered by the next frame of another stream, or by audio_helper_flush_stale_batches,\n 20 ms past the window. Queued delivery is not batched.\n @param window_ms Age of the oldest record of a batch before it is delivered, 0 delivers every frame on its own.\n @return false if the delegate is NULL."]
+    pub fn audio_helper_set_batch_window(
+        delegate: *mut ZOOMSDK_IZoomSDKAudioRawDataDelegate,
+        window_ms: ::std::os::raw::c_uint,
+    ) -> bool;
+}
+unsafe extern "C" {
+    #[doc = " @brief Deliver the pending batches. Call it once the delegate is unsubscribed, the SDK threads own them before."]
+    pub fn audio_helper_flush_batches(delegate: *mut ZOOMSDK_IZoomSDKAudioRawDataDelegate);
+}
+unsafe extern "C" {
+    #[doc = " @brief Deliver the batches held 20 ms past the window by streams that went quiet. Safe from any thread,\n e.g. a timer for meetings where every stream can stop."]
+    pub fn audio_helper_flush_stale_batches(delegate: *mut ZOOMSDK_IZoomSDKAudioRawDataDelegate);
+}
+unsafe extern "C" {
+    #[doc = " @brief Record the one-way audio of every user to `<directory>/<user_id>-<time>.wav` (or `.flac`), `time` being the\n arrival time of the first frame. Frames are recorded as delivered, after conversion and voice gating.\n The SDK thread only copies frames into per-user rings, writer threads do the encoding and the I/O.\n @param threads Writer threads, each one owns a share of the users.\n @param ring_capacity Size in bytes of each per-user ring, 0 for the default. Only used the first time recording starts.\n @param flush_ms Period of the batched writes.\n @param sync_ms Period of the fdatasync calls of each file, the file header is updated before each one.\n @param preallocate_kb Grow the files by extents of this size with fallocate, 0 to disable.\n @param codec AUDIO_TRACK_FLAC stores 16-bit FLAC instead of the delivered PCM, float frames are rounded to 16 bits.\n FLAC frames carry the number of their first sample, and gaps of aligned tracks are encoded as silence.\n @return false if the delegate is NULL, recording is already started or the directory is not writable."]
+    pub fn audio_helper_start_recording(
+        delegate: *mut ZOOMSDK_IZoomSDKAudioRawDataDelegate,
+        directory: *const ::std::os::raw::c_char,
+        threads: ::std::os::raw::c_uint,
+        ring_capacity: ::std::os::raw::c_uint,
+        flush_ms: ::std::os::raw::c_uint,
+        sync_ms: ::std::os::raw::c_uint,
+        preallocate_kb: ::std::os::raw::c_uint,
+        codec: audio_track_codec,
+    ) -> bool;
+}
+unsafe extern "C" {
+    #[doc = " @brief Write the queued frames, close the files and stop the writer threads. Blocks until done."]
+    pub fn audio_helper_stop_recording(delegate: *mut ZOOMSDK_IZoomSDKAudioRawDataDelegate);
+}
+unsafe extern "C" {
+    #[doc = " @return false if the delegate is NULL."]
+    pub fn audio_helper_get_recorder_stats(
+        delegate: *mut ZOOMSDK_IZoomSDKAudioRawDataDelegate,
+        stats: *mut audio_recorder_stats,
+    ) -> bool;
+}
+unsafe extern "C" {
+    #[doc = " @brief Number of interpreter languages seen so far, also the highest language id.\n The table only grows, so it only needs to be read again when this number changes."]
+    pub fn audio_helper_get_interpreter_language_count(
+        delegate: *mut ZOOMSDK_IZoomSDKAudioRawDataDelegate,
+    ) -> ::std::os::raw::c_uint;
+}
+unsafe extern "C" {
+    #[doc = " @brief Copy the interpreter language table into `languages`, ordered by id.\n @return The number of written entries, at most `cap`."]
+    pub fn audio_helper_get_interpreter_languages(
+        delegate: *mut ZOOMSDK_IZoomSDKAudioRawDataDelegate,
+        languages: *mut interpreter_language,
+        cap: ::std::os::raw::c_uint,
+    ) -> ::std::os::raw::c_uint;
+}
+unsafe extern "C" {
+    #[doc = " @brief Place mixed and one-way frames on a timeline shared by all users, see exported_audio_raw_data::sample_index.\n Sample 0 is the first frame received after alignment is enabled, positions follow the SDK timestamps.\n Every user's track is made continuous from sample 0: the time between frames of a user, including the lead-in\n before the first one, is delivered as silence markers, and the recorder leaves it as silence in the files.\n @param enabled false stops aligning, enabling again starts a new timeline.\n @param tolerance_ms Timestamp jitter absorbed before a frame is moved, larger differences open a gap\n or trim the frame head.\n @return false if the delegate is NULL."]
+    pub fn audio_helper_set_alignment(
+        delegate: *mut ZOOMSDK_IZoomSDKAudioRawDataDelegate,
+        enabled: bool,
+        tolerance_ms: ::std::os::raw::c_uint,
+    ) -> bool;
+}
+unsafe extern "C" {
+    #[doc = " @brief Wall clock time of sample 0, in microseconds.\n @return false if the delegate is NULL, alignment is off or no frame arrived yet."]
+    pub fn audio_helper_get_alignment_origin(
+        delegate: *mut ZOOMSDK_IZoomSDKAudioRawDataDelegate,
+        time: *mut i64,
+    ) -> bool;
+}
+unsafe extern "C" {
+    #[doc = " @brief Mix the one-way audio of chosen users into custom mono streams on a fixed 10 ms clock.\n The SDK thread only converts each user's frames to the mix rate and queues them, a dedicated thread\n sums one period of every playing user per mix with saturating SIMD adds and hands the mixes to Rust.\n Requires a delegate created with separate channels.\n @param sample_rate Rate of the mixes, from 8000 to 48000 and a multiple of 100. 0 stops the mixer.\n @param jitter_ms Audio queued per user before it joins the mixes, absorbs the delivery jitter of the SDK.\n The thread is restarted and the queues emptied. Do not call it from a mix callback, it joins the thread.\n @return false if the delegate is NULL or the settings are invalid."]
+    pub fn audio_helper_set_mixer(
+        delegate: *mut ZOOMSDK_IZoomSDKAudioRawDataDelegate,
+        sample_rate: ::std::os::raw::c_uint,
+        jitter_ms: ::std::os::raw::c_uint,
+    ) -> bool;
+}
+unsafe extern "C" {
+    #[doc = " @brief Define, replace or remove (AUDIO_MIX_OFF) a custom mix, from the next period.\n Mixes are kept when the mixer is stopped.\n @param mix_id From 0 to 15, passed back with each mixed frame.\n @param user_ids Users included or excluded according to `mode`.\n @return false if the delegate is NULL or `mix_id` is out of range."]
+    pub fn audio_helper_set_mix(
+        delegate: *mut ZOOMSDK_IZoomSDKAudioRawDataDelegate,
+        mix_id: ::std::os::raw::c_uint,
+        mode: audio_mix_mode,
+        user_ids: *const u32,
+        count: ::std::os::raw::c_uint,
+    ) -> bool;
+}
+unsafe extern "C" {
+    #[doc = " @return false if the delegate is NULL."]
+    pub fn audio_helper_get_mixer_stats(
+        delegate: *mut ZOOMSDK_IZoomSDKAudioRawDataDelegate,
+        stats: *mut audio_mixer_stats,
+    ) -> bool;
+}
+unsafe extern "C" {
+    #[doc = " @brief Re-frame the mixed and one-way streams into fixed windows of `window_ms`, each one starting\n `window_ms - overlap_ms` after the previous one, delivered through the usual callbacks, batches and queues.\n Windows are cut after the output format is applied, so they hold `window_ms * rate / 1000` samples per channel.\n A window lying inside one frame points into that frame, without copy. Windows straddling two frames\n are assembled in `slab`: the mixed stream uses slot 0, the user of slot `i` slot `i + 1`, streams\n beyond `slots` are delivered unchunked. A window interrupted by a silence marker, a gap on the\n timeline or a format change is completed with zeros. `time` and `sample_index` are those of the first\n sample of a window, the other fields come from the frame holding it. Recording and mixing see the frames.\n @param window_ms 0 disables the chunker.\n @param slab `slot_bytes * slots` bytes owned by the caller, kept alive until the delegate is unsubscribed\n even after another call replaced it: a frame being chunked may still write to it.\n @return false if the delegate is NULL or `overlap_ms` is not shorter than `window_ms`."]
+    pub fn audio_helper_set_chunker(
+        delegate: *mut ZOOMSDK_IZoomSDKAudioRawDataDelegate,
+        window_ms: ::std::os::raw::c_uint,
+        overlap_ms: ::std::os::raw::c_uint,
+        slab: *mut ::std::os::raw::c_char,
+        slot_bytes: usize,
+        slots: ::std::os::raw::c_uint,
+    ) -> bool;
+}
+unsafe extern "C" {
+    #[doc = " @return false if the delegate is NULL."]
+    pub fn audio_helper_get_chunker_stats(
+        delegate: *mut ZOOMSDK_IZoomSDKAudioRawDataDelegate,
+        stats: *mut audio_chunker_stats,
+    ) -> bool;
+}
+unsafe extern "C" {
+    #[doc = " @brief Capture share audio into a bounded lock-free queue of refcounted frames, tagged with the sharing user,\n instead of delivering it to on_share_audio_raw_data. A frame is queued by reference on its SDK buffer when\n the SDK allows it, as a copy in a pooled buffer otherwise; with the queue full or the pool exhausted it is\n dropped and counted. The share thread never blocks and never writes to stdio.\n @param capacity Packets the queue holds, 0 for the default. Only used the first time capture starts.\n @param pool_size Pooled copies, bounding the copies queued or held by the receiver at once. Only used the first time.\n Packets still queued when capture stops can be popped afterwards.\n @return false if the delegate is NULL."]
+    pub fn audio_helper_set_share_capture(
+        delegate: *mut ZOOMSDK_IZoomSDKAudioRawDataDelegate,
+        enabled: bool,
+        capacity: ::std::os::raw::c_uint,
+        pool_size: ::std::os::raw::c_uint,
+    ) -> bool;
+}
+unsafe extern "C" {
+    #[doc = " @brief Pop at most `cap` captured share frames, oldest first. A single thread pops.\n @return The number of packets written to `packets`, each one to release with audio_raw_data_release."]
+    pub fn audio_helper_pop_share_audio(
+        delegate: *mut ZOOMSDK_IZoomSDKAudioRawDataDelegate,
+        packets: *mut share_audio_packet,
+        cap: ::std::os::raw::c_uint,
+    ) -> ::std::os::raw::c_uint;
+}
+unsafe extern "C" {
+    #[doc = " @return false if the delegate is NULL."]
+    pub fn audio_helper_get_share_capture_stats(
+        delegate: *mut ZOOMSDK_IZoomSDKAudioRawDataDelegate,
+        stats: *mut share_capture_stats,
+    ) -> bool;
+}
+unsafe extern "C" {
+    #[doc = " @brief Select what a stream gives up when the Rust side falls behind in AUDIO_DELIVERY_QUEUED mode,\n instead of losing whatever arrives once its ring is full. A queue is over the high-water mark when\n that share of its ring is waiting to be drained; it goes back to normal under half the mark. Users\n are shed halfway between the mark and a full ring. Silence is judged with the threshold of\n audio_helper_set_vad, dropped one-way silence is handed over as silence markers. Aligned frames\n are never resampled, their sample_index counts samples of the output rate.\n @param stream One of audio_stream_kind. Every stream starts with AUDIO_OVERLOAD_NEVER_DROP.\n @param high_water_percent From 1 to 99, 0 for 50.\n @param degrade_rate Rate of degraded frames, a multiple of 100 from 8000 to 48000, 0 for 16000.\n @return false if the delegate is NULL or the settings are invalid."]
+    pub fn audio_helper_set_overload_policy(
+        delegate: *mut ZOOMSDK_IZoomSDKAudioRawDataDelegate,
+        stream: audio_stream_kind,
+        policy: audio_overload_policy,
+        high_water_percent: ::std::os::raw::c_uint,
+        degrade_rate: ::std::os::raw::c_uint,
+    ) -> bool;
+}
+unsafe extern "C" {
+    #[doc = " @return false if the delegate is NULL or the stream unknown."]
+    pub fn audio_helper_get_overload_stats(
+        delegate: *mut ZOOMSDK_IZoomSDKAudioRawDataDelegate,
+        stream: audio_stream_kind,
+        stats: *mut audio_overload_stats,
+    ) -> bool;
+}
+unsafe extern "C" {
+    #[doc = " @brief Remove the audio sent through the virtual mic from the mixed stream, so downstream speech recognition does\n not transcribe the bot. Everything the mic sends, directly or through the pacer, is kept as a reference; the\n loopback delay is estimated by FFT cross-correlation every half second and an adaptive filter centered on it\n subtracts the echo before any other processing of the mixed frames. The estimate is spread over several\n frames, each mixed frame costs at most one 16k-point FFT on top of the filter.\n @param mic Mic event whose sent audio is the reference, see audio_helper_create_mic_event.\n @param sample_rate Rate of the mixed frames processed, others pass through. 0 for 32000, the SDK rate.\n @param max_delay_ms Longest loopback delay searched, up to 2000, 0 for 1000.\n @param taps Length of the adaptive filter in samples, from 32 to 1024, 0 for 256.\n The sizes are only used the first time the canceller is enabled.\n @return false if the delegate or the mic is NULL, or the settings are invalid."]
+    pub fn audio_helper_set_echo_canceller(
+        delegate: *mut ZOOMSDK_IZoomSDKAudioRawDataDelegate,
+        mic: *mut ZOOMSDK_IZoomSDKVirtualAudioMicEvent,
+        enabled: bool,
+        sample_rate: ::std::os::raw::c_uint,
+        max_delay_ms: ::std::os::raw::c_uint,
+        taps: ::std::os::raw::c_uint,
+    ) -> bool;
+}
+unsafe extern "C" {
+    #[doc = " @return false if the delegate is NULL."]
+    pub fn audio_helper_get_echo_canceller_stats(
+        delegate: *mut ZOOMSDK_IZoomSDKAudioRawDataDelegate,
+        stats: *mut audio_echo_canceller_stats,
+    ) -> bool;
+}
 unsafe extern "C" {
     #[doc = " \\brief Subscribe raw audio data.\n \\param pDelegate, the callback handler of raw audio data.\n \\param bWithInterpreters, if bWithInterpreters is true, it means that you want to get the raw audio data of interpreters, otherwise not.\n        NOTE: if bWithInterpreters is true, it will cause your local interpreter related functions to be unavailable.\n \\return If the function succeeds, the return value is SDKERR_SUCCESS.\nOtherwise fails. To get extended error information, see \\link SDKError \\endlink enum."]
     pub fn audio_helper_subscribe_delegate(
         ctx: *mut ZOOMSDK_IZoomSDKAudioRawDataHelper,
         pDelegate: *mut ZOOMSDK_IZoomSDKAudioRawDataDelegate,
+        bWithInterpreters: bool,
     ) -> ZOOMSDK_SDKError;
 }
 unsafe extern "C" {
@@ -6605,34 +7485,123 @@ unsafe extern "C" {
     ) -> ZOOMSDK_SDKError;
 }
 unsafe extern "C" {
-    #[doc = " \\brief Subscribe audio mic raw data with a callback.\n \\param pSource, Callback sink object.\n \\return If the function succeeds, the return value is SDKERR_SUCCESS.\nOtherwise failed. To get extended error information, see \\link SDKError \\endlink enum."]
+    pub fn audio_helper_create_mic_event(
+        arc_ptr: *mut ::std::os::raw::c_void,
+    ) -> *mut ZOOMSDK_IZoomSDKVirtualAudioMicEvent;
+}
+unsafe extern "C" {
+    #[doc = " \\brief Subscribe audio mic raw data with a callback.\n \\param mic, Callback sink object created by audio_helper_create_mic_event.\n \\return If the function succeeds, the return value is SDKERR_SUCCESS.\nOtherwise failed. To get extended error information, see \\link SDKError \\endlink enum."]
     pub fn audio_helper_set_external_audio_source(
         ctx: *mut ZOOMSDK_IZoomSDKAudioRawDataHelper,
-        arc_ptr: *mut ::std::os::raw::c_void,
+        mic: *mut ZOOMSDK_IZoomSDKVirtualAudioMicEvent,
     ) -> ZOOMSDK_SDKError;
 }
 unsafe extern "C" {
-    #[doc = " \\brief Send audio raw data. Audio sample must be 16-bit audio.\n \\param data the audio datas address.\n \\param data_length the audio datas length. Must be an even number.\n \\param sample_rate the audio datas sampling rate.\n When the channel is mono, supported sample rates: 8000/11025/16000/32000/44100/48000/50000/50400/96000/192000/2822400\n \\return If the function succeeds, the return value is SDKERR_SUCCESS."]
+    #[doc = " @brief Let the wrapper send the virtual mic audio in real time.\n While the SDK allows sending, a dedicated thread sends one `chunk_ms` chunk per period from the\n queue filled by audio_helper_mic_push, and silence when there is nothing to play.\n @param sample_rate Rate sent to the SDK, rounded up to the nearest supported rate (48000 at most). 0 disables the pacer.\n @param channels Sent layout, 1 (mono) or 2 (stereo).\n @param chunk_ms 10 or 20.\n @param prefill_ms Audio queued before playback starts or resumes after an underrun.\n @param queue_ms Size of the queue. Only used the first time the pacer is enabled.\n @return false if the mic is NULL or the settings are invalid."]
+    pub fn audio_helper_set_mic_pacer(
+        mic: *mut ZOOMSDK_IZoomSDKVirtualAudioMicEvent,
+        sample_rate: ::std::os::raw::c_uint,
+        channels: ::std::os::raw::c_uint,
+        chunk_ms: ::std::os::raw::c_uint,
+        prefill_ms: ::std::os::raw::c_uint,
+        queue_ms: ::std::os::raw::c_uint,
+    ) -> bool;
+}
+unsafe extern "C" {
+    #[doc = " @brief Queue 16-bit PCM in the sent format for the pacer, without blocking.\n Must always be called from the same thread, shared with audio_helper_mic_push_pcm.\n @return The number of bytes queued, less than `len` when the queue is full."]
+    pub fn audio_helper_mic_push(
+        mic: *mut ZOOMSDK_IZoomSDKVirtualAudioMicEvent,
+        data: *const ::std::os::raw::c_char,
+        len: ::std::os::raw::c_uint,
+    ) -> ::std::os::raw::c_uint;
+}
+unsafe extern "C" {
+    #[doc = " @brief Queue interleaved PCM of any rate, channel count and format for the pacer, without blocking.\n The audio is converted to the sent format with the SIMD kernels and a polyphase resampler kept across calls.\n @return The number of input frames consumed, less than `frames` when the queue is full."]
+    pub fn audio_helper_mic_push_pcm(
+        mic: *mut ZOOMSDK_IZoomSDKVirtualAudioMicEvent,
+        data: *const ::std::os::raw::c_char,
+        frames: ::std::os::raw::c_uint,
+        format: audio_sample_format,
+        sample_rate: ::std::os::raw::c_uint,
+        channels: ::std::os::raw::c_uint,
+    ) -> ::std::os::raw::c_uint;
+}
+unsafe extern "C" {
+    #[doc = " @return false if the mic is NULL."]
+    pub fn audio_helper_get_mic_pacer_stats(
+        mic: *mut ZOOMSDK_IZoomSDKVirtualAudioMicEvent,
+        stats: *mut audio_mic_pacer_stats,
+    ) -> bool;
+}
+unsafe extern "C" {
+    #[doc = " \\brief Send audio raw data. Audio sample must be 16-bit audio.\n \\param data the audio datas address.\n \\param data_length the audio datas length. Must be an even number.\n \\param sample_rate the audio datas sampling rate.\n When the channel is mono, supported sample rates: 8000/11025/16000/32000/44100/48000/50000/50400/96000/192000/2822400\n When the channel is stereo, supported sample rates: 8000/16000/32000/44100/48000/50000/50400/96000/192000\n \\param channel the layout of interleaved `data`.\n \\return If the function succeeds, the return value is SDKERR_SUCCESS."]
     pub fn send_audio_raw_data(
         p_sender: *mut ZOOMSDK_IZoomSDKAudioRawDataSender,
         data: *mut ::std::os::raw::c_char,
         data_length: ::std::os::raw::c_uint,
         sample_rate: ::std::os::raw::c_int,
+        channel: ZOOMSDK_ZoomSDKAudioChannel,
     ) -> ZOOMSDK_SDKError;
 }
+#[doc = " Y plane, then the U and V planes of (width + 1) / 2 x (height + 1) / 2 samples."]
+pub const video_pixel_format_VIDEO_PIXEL_I420: video_pixel_format = 0;
+#[doc = " Y plane, then one plane of interleaved U/V pairs."]
+pub const video_pixel_format_VIDEO_PIXEL_NV12: video_pixel_format = 1;
+#[doc = " 4 bytes per pixel, alpha from the alpha plane of the frame or opaque."]
+pub const video_pixel_format_VIDEO_PIXEL_RGBA: video_pixel_format = 2;
+#[doc = " 4 bytes per pixel, alpha from the alpha plane of the frame or opaque."]
+pub const video_pixel_format_VIDEO_PIXEL_BGRA: video_pixel_format = 3;
+#[doc = " 3 bytes per pixel."]
+pub const video_pixel_format_VIDEO_PIXEL_RGB24: video_pixel_format = 4;
+#[doc = " @brief Pixel layouts produced by video_raw_data_convert, rows packed without padding."]
+pub type video_pixel_format = ::std::os::raw::c_uint;
+#[doc = " Average of every source pixel under the thumbnail pixel."]
+pub const video_scale_filter_VIDEO_SCALE_BOX: video_scale_filter = 0;
+#[doc = " Interpolation between the 4 nearest source pixels, cheaper but aliased past a 2x reduction."]
+pub const video_scale_filter_VIDEO_SCALE_BILINEAR: video_scale_filter = 1;
+#[doc = " @brief Filters of the thumbnail downscaler, see video_helper_set_thumbnail."]
+pub type video_scale_filter = ::std::os::raw::c_uint;
+#[repr(C)]
+#[derive(Debug, Copy, Clone)]
+pub struct VideoFramePool {
+    _unused: [u8; 0],
+}
 #[repr(C)]
 #[derive(Debug, Copy, Clone)]
 pub struct exported_video_raw_data {
     pub data: *mut ::std::os::raw::c_char,
+    #[doc = " Wall clock arrival time in microseconds, derived from the monotonic clock so NTP steps do not show."]
     pub time: i64,
     pub len: u32,
     pub user_id: u32,
     pub width: u32,
     pub height: u32,
+    #[doc = " SDK media timestamp in milliseconds (YUVRawDataI420::GetTimeStamp), 0 if unavailable."]
+    pub sdk_time: u64,
+    #[doc = " CLOCK_MONOTONIC arrival time in microseconds."]
+    pub mono_time: i64,
+    #[doc = " Smoothed change of (arrival - media time) since the first frame of this renderer, in microseconds."]
+    pub drift: i64,
+    #[doc = " Planes of the I420 frame, each row `width` (luma) or `(width + 1) / 2` (chroma) bytes long.\n They usually follow each other in `data` but need not."]
+    pub y: *mut ::std::os::raw::c_char,
+    pub u: *mut ::std::os::raw::c_char,
+    pub v: *mut ::std::os::raw::c_char,
+    #[doc = " Alpha plane, one byte per pixel, NULL when the source sends none."]
+    pub alpha: *mut ::std::os::raw::c_char,
+    pub alpha_len: u32,
+    #[doc = " Clockwise rotation to apply for display, in degrees: 0, 90, 180 or 270."]
+    pub rotation: u32,
+    #[doc = " Whether the samples use the limited (16-235) range rather than the full one."]
+    pub limited: bool,
+    #[doc = " SDK frame backing the buffers. Pass the frame to video_raw_data_retain to keep them valid after the callback returns."]
+    pub raw: *mut YUVRawDataI420,
+    #[doc = " References kept on the frames of the renderer, see video_raw_data_retain."]
+    pub pool: *mut VideoFramePool,
 }
 #[allow(clippy::unnecessary_operation, clippy::identity_op)]
 const _: () = {
-    ["Size of exported_video_raw_data"][::std::mem::size_of::<exported_video_raw_data>() - 32usize];
+    ["Size of exported_video_raw_data"]
+        [::std::mem::size_of::<exported_video_raw_data>() - 120usize];
     ["Alignment of exported_video_raw_data"]
         [::std::mem::align_of::<exported_video_raw_data>() - 8usize];
     ["Offset of field: exported_video_raw_data::data"]
@@ -6647,12 +7616,193 @@ const _: () = {
         [::std::mem::offset_of!(exported_video_raw_data, width) - 24usize];
     ["Offset of field: exported_video_raw_data::height"]
         [::std::mem::offset_of!(exported_video_raw_data, height) - 28usize];
+    ["Offset of field: exported_video_raw_data::sdk_time"]
+        [::std::mem::offset_of!(exported_video_raw_data, sdk_time) - 32usize];
+    ["Offset of field: exported_video_raw_data::mono_time"]
+        [::std::mem::offset_of!(exported_video_raw_data, mono_time) - 40usize];
+    ["Offset of field: exported_video_raw_data::drift"]
+        [::std::mem::offset_of!(exported_video_raw_data, drift) - 48usize];
+    ["Offset of field: exported_video_raw_data::y"]
+        [::std::mem::offset_of!(exported_video_raw_data, y) - 56usize];
+    ["Offset of field: exported_video_raw_data::u"]
+        [::std::mem::offset_of!(exported_video_raw_data, u) - 64usize];
+    ["Offset of field: exported_video_raw_data::v"]
+        [::std::mem::offset_of!(exported_video_raw_data, v) - 72usize];
+    ["Offset of field: exported_video_raw_data::alpha"]
+        [::std::mem::offset_of!(exported_video_raw_data, alpha) - 80usize];
+    ["Offset of field: exported_video_raw_data::alpha_len"]
+        [::std::mem::offset_of!(exported_video_raw_data, alpha_len) - 88usize];
+    ["Offset of field: exported_video_raw_data::rotation"]
+        [::std::mem::offset_of!(exported_video_raw_data, rotation) - 92usize];
+    ["Offset of field: exported_video_raw_data::limited"]
+        [::std::mem::offset_of!(exported_video_raw_data, limited) - 96usize];
+    ["Offset of field: exported_video_raw_data::raw"]
+        [::std::mem::offset_of!(exported_video_raw_data, raw) - 104usize];
+    ["Offset of field: exported_video_raw_data::pool"]
+        [::std::mem::offset_of!(exported_video_raw_data, pool) - 112usize];
+};
+#[doc = " @brief References kept on the frames of a renderer, see video_raw_data_retain."]
+#[repr(C)]
+#[derive(Debug, Copy, Clone)]
+pub struct video_frame_ref_stats {
+    #[doc = " References taken on the SDK frame."]
+    pub zero_copy_refs: u64,
+    #[doc = " Frames copied into a pooled buffer, the SDK refused the reference."]
+    pub copied_refs: u64,
+    #[doc = " Frames not retained, `max_refs` references were out."]
+    pub refused_refs: u64,
+    #[doc = " References not released yet."]
+    pub outstanding: u32,
+    pub max_refs: u32,
+}
+#[allow(clippy::unnecessary_operation, clippy::identity_op)]
+const _: () = {
+    ["Size of video_frame_ref_stats"][::std::mem::size_of::<video_frame_ref_stats>() - 32usize];
+    ["Alignment of video_frame_ref_stats"]
+        [::std::mem::align_of::<video_frame_ref_stats>() - 8usize];
+    ["Offset of field: video_frame_ref_stats::zero_copy_refs"]
+        [::std::mem::offset_of!(video_frame_ref_stats, zero_copy_refs) - 0usize];
+    ["Offset of field: video_frame_ref_stats::copied_refs"]
+        [::std::mem::offset_of!(video_frame_ref_stats, copied_refs) - 8usize];
+    ["Offset of field: video_frame_ref_stats::refused_refs"]
+        [::std::mem::offset_of!(video_frame_ref_stats, refused_refs) - 16usize];
+    ["Offset of field: video_frame_ref_stats::outstanding"]
+        [::std::mem::offset_of!(video_frame_ref_stats, outstanding) - 24usize];
+    ["Offset of field: video_frame_ref_stats::max_refs"]
+        [::std::mem::offset_of!(video_frame_ref_stats, max_refs) - 28usize];
+};
+#[doc = " @brief Counters of the thumbnails of a renderer, see video_helper_set_thumbnail."]
+#[repr(C)]
+#[derive(Debug, Copy, Clone)]
+pub struct video_thumbnail_stats {
+    #[doc = " Thumbnails delivered."]
+    pub thumbnails: u64,
+    #[doc = " Thumbnails due but not made, every pooled buffer was retained."]
+    pub dropped_thumbnails: u64,
+    #[doc = " Full frames not delivered, thumbnails only being asked for."]
+    pub unforwarded_frames: u64,
+    #[doc = " Longest time spent scaling a frame."]
+    pub max_scale_us: i64,
+}
+#[allow(clippy::unnecessary_operation, clippy::identity_op)]
+const _: () = {
+    ["Size of video_thumbnail_stats"][::std::mem::size_of::<video_thumbnail_stats>() - 32usize];
+    ["Alignment of video_thumbnail_stats"]
+        [::std::mem::align_of::<video_thumbnail_stats>() - 8usize];
+    ["Offset of field: video_thumbnail_stats::thumbnails"]
+        [::std::mem::offset_of!(video_thumbnail_stats, thumbnails) - 0usize];
+    ["Offset of field: video_thumbnail_stats::dropped_thumbnails"]
+        [::std::mem::offset_of!(video_thumbnail_stats, dropped_thumbnails) - 8usize];
+    ["Offset of field: video_thumbnail_stats::unforwarded_frames"]
+        [::std::mem::offset_of!(video_thumbnail_stats, unforwarded_frames) - 16usize];
+    ["Offset of field: video_thumbnail_stats::max_scale_us"]
+        [::std::mem::offset_of!(video_thumbnail_stats, max_scale_us) - 24usize];
+};
+#[doc = " @brief Counters of the frame rate decimation of a renderer, see video_helper_set_target_fps."]
+#[repr(C)]
+#[derive(Debug, Copy, Clone)]
+pub struct video_frame_rate_stats {
+    #[doc = " Frames delivered to on_raw_data_frame_received."]
+    pub forwarded_frames: u64,
+    #[doc = " Frames dropped before reaching Rust, over the target frame rate."]
+    pub dropped_frames: u64,
+    pub target_fps: u32,
+}
+#[allow(clippy::unnecessary_operation, clippy::identity_op)]
+const _: () = {
+    ["Size of video_frame_rate_stats"][::std::mem::size_of::<video_frame_rate_stats>() - 24usize];
+    ["Alignment of video_frame_rate_stats"]
+        [::std::mem::align_of::<video_frame_rate_stats>() - 8usize];
+    ["Offset of field: video_frame_rate_stats::forwarded_frames"]
+        [::std::mem::offset_of!(video_frame_rate_stats, forwarded_frames) - 0usize];
+    ["Offset of field: video_frame_rate_stats::dropped_frames"]
+        [::std::mem::offset_of!(video_frame_rate_stats, dropped_frames) - 8usize];
+    ["Offset of field: video_frame_rate_stats::target_fps"]
+        [::std::mem::offset_of!(video_frame_rate_stats, target_fps) - 16usize];
 };
 unsafe extern "C" {
+    #[doc = " @param target_fps Frame rate delivered to on_raw_data_frame_received, see video_helper_set_target_fps.\n @return NULL if `target_fps` is over 60."]
     pub fn video_helper_create_delegate(
         arc_ptr: *mut ::std::os::raw::c_void,
+        target_fps: ::std::os::raw::c_uint,
     ) -> *mut ZOOMSDK_IZoomSDKRendererDelegate;
 }
+unsafe extern "C" {
+    #[doc = " @brief Keep a frame after the callback returns, e.g. in an encoder queue. Call it from the frame callback only.\n The SDK frame itself is kept when it can be, without a copy; otherwise it is copied into a buffer of the\n renderer's pool, planes, alpha and properties included.\n @param retained Filled with `data`, `data` and `raw` pointing at the kept frame.\n @return false once the renderer has `max_refs` frames out (see video_helper_set_max_frame_refs)\n or if `data` has no frame. Otherwise give the frame back with video_raw_data_release."]
+    pub fn video_raw_data_retain(
+        data: *const exported_video_raw_data,
+        retained: *mut exported_video_raw_data,
+    ) -> bool;
+}
+unsafe extern "C" {
+    #[doc = " @brief Drop a reference taken by video_raw_data_retain, from any thread.\n @param pool The `pool` of the retained frame."]
+    pub fn video_raw_data_release(pool: *mut VideoFramePool, raw: *mut YUVRawDataI420);
+}
+unsafe extern "C" {
+    #[doc = " @return Bytes written by video_raw_data_convert for `format`, 0 if the format is unknown."]
+    pub fn video_raw_data_converted_len(
+        data: *const exported_video_raw_data,
+        format: video_pixel_format,
+    ) -> usize;
+}
+unsafe extern "C" {
+    #[doc = " @brief Convert a frame into a caller-owned buffer with SIMD kernels, from any thread while the frame is valid.\n Colors use the BT.601 matrix.\n @param rotation Clockwise rotation applied on the way: 0, 90, 180 or 270, `data->rotation` to get the frame\n upright. Width and height swap at 90 and 270.\n @param full_range Expand limited range samples to the full range in I420 and NV12 output. RGB output is\n always full range.\n @return false if `data` has no planes, the format or rotation is unknown or `out_len` is below\n video_raw_data_converted_len."]
+    pub fn video_raw_data_convert(
+        data: *const exported_video_raw_data,
+        format: video_pixel_format,
+        rotation: ::std::os::raw::c_uint,
+        full_range: bool,
+        out: *mut u8,
+        out_len: usize,
+    ) -> bool;
+}
+unsafe extern "C" {
+    #[doc = " @brief Deliver downscaled copies of the frames through on_video_thumbnail, e.g. for a gallery or a face detector.\n A thumbnail fits in `width` x `height` with the aspect ratio of the frame, in even sizes, and is never larger than\n the frame. It is a packed I420 frame from the renderer's pool: it can be retained and converted like full frames.\n @param enabled false stops thumbnails and delivers full frames again.\n @param width From 16 to 1920.\n @param height From 16 to 1080.\n @param interval_ms Time between two thumbnails, 0 for one per frame.\n @param forward_frames false stops on_raw_data_frame_received while thumbnails are on.\n @return false if the delegate is NULL or the settings are invalid."]
+    pub fn video_helper_set_thumbnail(
+        delegate: *mut ZOOMSDK_IZoomSDKRendererDelegate,
+        enabled: bool,
+        width: ::std::os::raw::c_uint,
+        height: ::std::os::raw::c_uint,
+        interval_ms: ::std::os::raw::c_uint,
+        filter: video_scale_filter,
+        forward_frames: bool,
+    ) -> bool;
+}
+unsafe extern "C" {
+    #[doc = " @return false if the delegate is NULL."]
+    pub fn video_helper_get_thumbnail_stats(
+        delegate: *mut ZOOMSDK_IZoomSDKRendererDelegate,
+        stats: *mut video_thumbnail_stats,
+    ) -> bool;
+}
+unsafe extern "C" {
+    #[doc = " @brief Deliver at most `target_fps` frames per second to on_raw_data_frame_received, e.g. for snapshots or a\n detector. Frames over the rate are dropped in the delegate, before crossing into Rust. The kept frames are the\n closest to a fixed 1 / target_fps grid of the frame timestamps (SDK media time, arrival time without it), so\n the cadence stays even when the frames jitter. Thumbnails keep their own interval.\n @param target_fps From 1 to 60, 0 for every frame.\n @return false if the delegate is NULL or `target_fps` is over 60."]
+    pub fn video_helper_set_target_fps(
+        delegate: *mut ZOOMSDK_IZoomSDKRendererDelegate,
+        target_fps: ::std::os::raw::c_uint,
+    ) -> bool;
+}
+unsafe extern "C" {
+    #[doc = " @return false if the delegate is NULL."]
+    pub fn video_helper_get_frame_rate_stats(
+        delegate: *mut ZOOMSDK_IZoomSDKRendererDelegate,
+        stats: *mut video_frame_rate_stats,
+    ) -> bool;
+}
+unsafe extern "C" {
+    #[doc = " @brief Cap the frames of the renderer retained at once, so a slow consumer cannot pin the SDK buffers.\n @param max_refs From 1 to 64, 0 for 8.\n @return false if the delegate is NULL or `max_refs` is over 64."]
+    pub fn video_helper_set_max_frame_refs(
+        delegate: *mut ZOOMSDK_IZoomSDKRendererDelegate,
+        max_refs: ::std::os::raw::c_uint,
+    ) -> bool;
+}
+unsafe extern "C" {
+    #[doc = " @return false if the delegate is NULL."]
+    pub fn video_helper_get_frame_ref_stats(
+        delegate: *mut ZOOMSDK_IZoomSDKRendererDelegate,
+        stats: *mut video_frame_ref_stats,
+    ) -> bool;
+}
 unsafe extern "C" {
     pub fn video_helper_subscribe_delegate(
         ctx: *mut ZOOMSDK_IZoomSDKRenderer,
@@ -6746,6 +7896,17 @@ unsafe extern "C" {
         arc_ptr: *mut ::std::os::raw::c_void,
     ) -> ZOOMSDK_SDKError;
 }
+unsafe extern "C" {
+    #[doc = " @brief Route the participant joins and leaves to an audio delegate, see audio_helper_attach_participants.\n Shares the event handler of participants_set_event, either can be set first.\n @param controller A Pointer to ZOOMSDK::IMeetingParticipantsController\n @param delegate The audio delegate, replaces the previous one\n @return SDKError indicating success or failure"]
+    pub fn participants_set_audio_delegate(
+        controller: *mut ZOOMSDK_IMeetingParticipantsController,
+        delegate: *mut ZOOMSDK_IZoomSDKAudioRawDataDelegate,
+    ) -> ZOOMSDK_SDKError;
+}
+unsafe extern "C" {
+    #[doc = " @brief Stop routing the participant events to `delegate`, if it is still the routed one."]
+    pub fn participants_clear_audio_delegate(delegate: *mut ZOOMSDK_IZoomSDKAudioRawDataDelegate);
+}
 unsafe extern "C" {
     #[doc = " \\brief Determine if the host supports receiving local recording privilege requests.\n \\return If the host supports it, the return value is SDKErr_Success.\n Otherwise failed (e.g., host is using Zoom Rooms which cannot display the permission dialog)."]
     pub fn recording_is_support_request_local_recording_privilege(
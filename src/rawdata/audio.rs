@@ -1,11 +1,449 @@
 use std::fmt::Debug;
+use std::sync::atomic::{AtomicBool, Ordering};
 use std::sync::{Arc, Mutex};
 
+use crate::meeting_service::ParticipantsInterface;
 use crate::{bindings::*, SdkResult, ZoomRsError, ZoomSdkResult};
 
 /// Rust type definition.
 pub type ExportedAudioRawData = exported_audio_raw_data;
 
+/// Ring buffer counters of a queued audio stream.
+pub type AudioQueueStats = audio_queue_stats;
+
+/// State of one per-user stream of the one-way audio demultiplexer.
+pub type AudioUserStream = audio_user_stream;
+
+impl ExportedAudioRawData {
+    /// PCM bytes of the frame, valid for the duration of the callback.
+    pub fn as_bytes(&self) -> &[u8] {
+        if self.data.is_null() {
+            return &[];
+        }
+        unsafe { std::slice::from_raw_parts(self.data as *const u8, self.len as usize) }
+    }
+    /// Samples of a 16-bit frame, None if the frame was converted to float.
+    pub fn as_s16(&self) -> Option<&[i16]> {
+        (self.format == audio_sample_format_AUDIO_SAMPLE_S16).then(|| {
+            let bytes = self.as_bytes();
+            unsafe { std::slice::from_raw_parts(bytes.as_ptr() as *const i16, bytes.len() / 2) }
+        })
+    }
+    /// Samples of a float frame, see [AudioOutputFormat].
+    pub fn as_f32(&self) -> Option<&[f32]> {
+        (self.format == audio_sample_format_AUDIO_SAMPLE_F32).then(|| {
+            let bytes = self.as_bytes();
+            unsafe { std::slice::from_raw_parts(bytes.as_ptr() as *const f32, bytes.len() / 4) }
+        })
+    }
+    /// Position of the frame on the timeline shared by all users, see [AudioRawDataHelper::set_alignment].
+    /// - Returns None when alignment is off, or for share and interpreter audio.
+    pub fn sample_index(&self) -> Option<u64> {
+        (self.sample_index >= 0).then_some(self.sample_index as u64)
+    }
+    /// Keep the SDK buffer of the frame alive after the callback returns, without copying it.
+    /// - Returns None for frames copied by the wrapper ([AudioDelivery::Queued]) or when the SDK refuses the reference.
+    pub fn retain(&self) -> Option<AudioRawDataHandle> {
+        let raw = unsafe { audio_raw_data_retain(self) };
+        if raw.is_null() {
+            return None;
+        }
+        Some(AudioRawDataHandle { raw, data: *self })
+    }
+}
+
+/// Reference on an SDK audio buffer obtained with [ExportedAudioRawData::retain], released on drop.
+#[derive(Debug)]
+pub struct AudioRawDataHandle {
+    raw: *mut AudioRawData,
+    data: ExportedAudioRawData,
+}
+
+unsafe impl Send for AudioRawDataHandle {}
+
+impl AudioRawDataHandle {
+    /// PCM bytes of the frame.
+    pub fn as_bytes(&self) -> &[u8] {
+        self.data.as_bytes()
+    }
+    /// Metadata of the frame, as received in the callback.
+    pub fn data(&self) -> &ExportedAudioRawData {
+        &self.data
+    }
+}
+
+impl Drop for AudioRawDataHandle {
+    fn drop(&mut self) {
+        unsafe { audio_raw_data_release(self.raw) };
+    }
+}
+
+/// Silent one-way frames folded by the voice activity gate (see [AudioVad]),
+/// or the silence between two aligned frames of a user (see [AudioAlignment]).
+pub type AudioSilenceMarker = audio_silence_marker;
+
+/// One record of a batch, see [RawAudioEvent::on_audio_batch].
+pub type AudioBatchEntry = audio_batch_entry;
+
+#[allow(non_upper_case_globals)]
+impl AudioBatchEntry {
+    /// Stream the record belongs to.
+    pub fn stream(&self) -> AudioStream {
+        match self.stream {
+            audio_stream_kind_AUDIO_STREAM_MIXED => AudioStream::Mixed,
+            audio_stream_kind_AUDIO_STREAM_ONE_WAY => AudioStream::OneWay,
+            audio_stream_kind_AUDIO_STREAM_SHARE => AudioStream::Share,
+            _ => AudioStream::Interpreter,
+        }
+    }
+    /// The frame, None for a silence marker.
+    pub fn frame(&self) -> Option<&ExportedAudioRawData> {
+        (self.kind == audio_record_kind_AUDIO_RECORD_FRAME).then_some(&self.data)
+    }
+    /// The silence marker, None for a frame.
+    pub fn silence(&self) -> Option<&AudioSilenceMarker> {
+        (self.kind == audio_record_kind_AUDIO_RECORD_SILENCE)
+            .then(|| unsafe { &*(self.data.data as *const AudioSilenceMarker) })
+    }
+}
+
+/// Interpreter language interned by the delegate, see [AudioRawDataHelper::interpreter_languages].
+pub type InterpreterLanguage = interpreter_language;
+
+impl InterpreterLanguage {
+    /// Language name given by the SDK.
+    pub fn name(&self) -> String {
+        let bytes: Vec<u8> = self
+            .name
+            .iter()
+            .take_while(|c| **c != 0)
+            .map(|c| *c as u8)
+            .collect();
+        String::from_utf8_lossy(&bytes).into_owned()
+    }
+}
+
+/// Rolling peak and RMS level of one user, see [AudioRawDataHelper::levels].
+pub type UserLevel = user_level;
+
+/// Upper bound of per-user streams tracked by the delegate.
+const AUDIO_MAX_USERS: usize = 1024;
+
+/// How the audio delegate hands frames over to [RawAudioEvent].
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub enum AudioDelivery {
+    /// Callbacks run synchronously on the SDK audio thread.
+    Direct,
+    /// Frames are copied into preallocated lock-free rings (`ring_capacity` bytes per stream)
+    /// and callbacks run on the thread calling [AudioQueueDrain::drain].
+    Queued {
+        /// Size in bytes of each per-stream ring, 0 selects the default (1 MiB).
+        ring_capacity: u32,
+        /// Size in bytes of each per-user ring of the one-way stream, 0 selects the default (128 KiB).
+        user_ring_capacity: u32,
+    },
+}
+
+/// Audio streams produced by the delegate.
+#[derive(Debug, PartialEq, Eq, Clone, Copy)]
+#[repr(u32)]
+pub enum AudioStream {
+    /// Mixed audio of the whole meeting.
+    Mixed = audio_stream_kind_AUDIO_STREAM_MIXED,
+    /// Per-user audio.
+    OneWay = audio_stream_kind_AUDIO_STREAM_ONE_WAY,
+    /// Audio of the shared content.
+    Share = audio_stream_kind_AUDIO_STREAM_SHARE,
+    /// Interpretation channels, see [AudioSubscribeOptions::with_interpreters].
+    Interpreter = audio_stream_kind_AUDIO_STREAM_INTERPRETER,
+}
+
+/// Sample format of the delivered frames.
+#[derive(Debug, PartialEq, Eq, Clone, Copy)]
+#[repr(u32)]
+pub enum AudioSampleFormat {
+    /// Signed 16-bit PCM, as produced by the SDK.
+    S16 = audio_sample_format_AUDIO_SAMPLE_S16,
+    /// 32-bit float PCM in [-1, 1].
+    F32 = audio_sample_format_AUDIO_SAMPLE_F32,
+}
+
+/// Conversion applied by the delegate before frames are delivered, with SIMD kernels.
+#[derive(Debug, Clone, Copy, PartialEq)]
+pub struct AudioOutputFormat {
+    /// Sample format of [ExportedAudioRawData::data].
+    pub sample_format: AudioSampleFormat,
+    /// Average the channels of stereo frames.
+    pub downmix_mono: bool,
+    /// Linear gain, 16-bit output saturates and float output is clipped to [-1, 1].
+    pub gain: f32,
+    /// Resample to this rate in Hz with a polyphase filter kept per stream and per user, 0 keeps the SDK rate.
+    pub sample_rate: u32,
+}
+
+impl Default for AudioOutputFormat {
+    fn default() -> Self {
+        Self {
+            sample_format: AudioSampleFormat::S16,
+            downmix_mono: false,
+            gain: 1.0,
+            sample_rate: 0,
+        }
+    }
+}
+
+/// Voice activity gate of the one-way streams, evaluated per user in the delegate.
+/// Silent frames are not delivered, [RawAudioEvent::on_one_way_audio_silence] receives their duration instead.
+#[derive(Debug, Clone, Copy, PartialEq)]
+pub struct AudioVad {
+    /// RMS level in dBFS from which a frame is voice.
+    pub threshold_dbfs: f32,
+    /// Keep forwarding frames this long after the last voiced one.
+    pub hangover_ms: u32,
+    /// Emit a silence marker at least this often while a user stays silent.
+    pub max_silence_ms: u32,
+}
+
+impl Default for AudioVad {
+    fn default() -> Self {
+        Self {
+            threshold_dbfs: -50.0,
+            hangover_ms: 300,
+            max_silence_ms: 1000,
+        }
+    }
+}
+
+/// Alignment of the mixed and one-way frames on a timeline shared by all users, sample 0 being the
+/// first frame of the meeting. The silence between the frames of a user, lead-in included, is delivered
+/// through [RawAudioEvent::on_one_way_audio_silence], so every user's track is continuous from sample 0.
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub struct AudioAlignment {
+    /// Timestamp jitter absorbed before a frame is moved.
+    pub tolerance_ms: u32,
+}
+
+impl Default for AudioAlignment {
+    fn default() -> Self {
+        Self { tolerance_ms: 20 }
+    }
+}
+
+/// File format of the recorded tracks.
+#[derive(Debug, PartialEq, Eq, Clone, Copy)]
+#[repr(u32)]
+pub enum AudioTrackCodec {
+    /// PCM as delivered.
+    Wav = audio_track_codec_AUDIO_TRACK_WAV,
+    /// Lossless 16-bit FLAC, about half the size of 16-bit speech. Each frame carries the number of its
+    /// first sample, gaps of aligned tracks are encoded as silence.
+    Flac = audio_track_codec_AUDIO_TRACK_FLAC,
+}
+
+/// Per-user track recorder of the one-way streams, see [AudioRawDataHelper::start_recording].
+/// Each user is written to `<directory>/<user_id>-<time>.wav` (or `.flac`) by writer threads, which also
+/// encode, never by the SDK audio thread.
+#[derive(Debug, Clone, PartialEq, Eq)]
+pub struct AudioTrackRecorder {
+    /// Existing, writable directory receiving the tracks.
+    pub directory: std::path::PathBuf,
+    /// Writer threads, each one owns a share of the users.
+    pub threads: u32,
+    /// Size in bytes of each per-user ring, 0 selects the default (256 KiB). Only used the first time.
+    pub ring_capacity: u32,
+    /// Period of the batched writes.
+    pub flush_ms: u32,
+    /// Period of the fdatasync calls of each track.
+    pub sync_ms: u32,
+    /// Files grow by preallocated extents of this size, 0 disables preallocation.
+    pub preallocate_kb: u32,
+    /// Format of the files, WAV by default.
+    pub codec: AudioTrackCodec,
+}
+
+impl Default for AudioTrackRecorder {
+    fn default() -> Self {
+        Self {
+            directory: std::path::PathBuf::from("."),
+            threads: 2,
+            ring_capacity: 0,
+            flush_ms: 100,
+            sync_ms: 5000,
+            preallocate_kb: 4096,
+            codec: AudioTrackCodec::Wav,
+        }
+    }
+}
+
+/// Counters of the track recorder.
+pub type AudioRecorderStats = audio_recorder_stats;
+
+/// Custom mixer of the one-way streams, see [AudioRawDataHelper::set_mixer].
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub struct AudioMixer {
+    /// Rate of the mixes, from 8000 to 48000 and a multiple of 100. Mixing at the SDK rate skips resampling.
+    pub sample_rate: u32,
+    /// Audio queued per user before it joins the mixes, absorbs the delivery jitter of the SDK.
+    pub jitter_ms: u32,
+}
+
+impl Default for AudioMixer {
+    fn default() -> Self {
+        Self {
+            sample_rate: 32000,
+            jitter_ms: 40,
+        }
+    }
+}
+
+/// Members of a custom mix, see [AudioRawDataHelper::set_mix].
+#[derive(Debug, Clone, PartialEq, Eq)]
+pub enum AudioMix {
+    /// Only these users, e.g. the host, or a group.
+    Include(Vec<u32>),
+    /// Everyone but these users, e.g. the bot itself.
+    Exclude(Vec<u32>),
+}
+
+/// Counters of the custom mixer.
+pub type AudioMixerStats = audio_mixer_stats;
+
+/// Fixed windows of the mixed and one-way streams, see [AudioRawDataHelper::set_chunker].
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub struct AudioChunker {
+    /// Duration of a window, e.g. 20 or 100 ms for a streaming recognizer.
+    pub window_ms: u32,
+    /// Audio shared by two consecutive windows, shorter than the window.
+    pub overlap_ms: u32,
+    /// User slots chunked, users in later slots are delivered as received.
+    pub max_users: u32,
+    /// Size of each stream's slot in the slab, 0 fits the largest window the delegate can deliver
+    /// (48 kHz stereo float). A 32 kHz mono 16-bit stream only needs `window_ms * 64`.
+    pub slot_bytes: u32,
+}
+
+impl Default for AudioChunker {
+    fn default() -> Self {
+        Self {
+            window_ms: 20,
+            overlap_ms: 0,
+            max_users: 256,
+            slot_bytes: 0,
+        }
+    }
+}
+
+/// Counters of the chunker.
+pub type AudioChunkerStats = audio_chunker_stats;
+
+/// Capture of the share audio into a bounded queue, see [AudioRawDataHelper::set_share_capture].
+/// Sizes are only used the first time capture starts.
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub struct ShareAudioCapture {
+    /// Frames the queue holds, older frames are kept and newer ones dropped when it is full.
+    pub capacity: u32,
+    /// Wrapper-owned copies for frames the SDK does not let us reference, queued or held at once.
+    pub pool_size: u32,
+}
+
+impl Default for ShareAudioCapture {
+    fn default() -> Self {
+        Self {
+            capacity: 256,
+            pool_size: 64,
+        }
+    }
+}
+
+/// Counters of the share audio capture.
+pub type ShareCaptureStats = share_capture_stats;
+
+/// Captured share audio frame, see [ShareAudioQueue::pop].
+#[derive(Debug)]
+pub struct ShareAudioFrame {
+    /// User sharing the audio.
+    pub user_id: u32,
+    /// Reference on the frame, released on drop. [ExportedAudioRawData::sdk_time] is the SDK timestamp.
+    pub frame: AudioRawDataHandle,
+}
+
+/// What a queued stream gives up when the drain falls behind, each action includes the gentler ones before it.
+#[derive(Debug, PartialEq, Eq, Clone, Copy)]
+#[repr(u32)]
+pub enum AudioOverloadAction {
+    /// Queue everything, frames are only lost when the ring is full. The right choice for the mixed stream.
+    NeverDrop = audio_overload_policy_AUDIO_OVERLOAD_NEVER_DROP,
+    /// Skip the oldest silent frames while the ring is over the high-water mark. Skipped one-way frames
+    /// reach [RawAudioEvent::on_one_way_audio_silence] as markers.
+    DropSilence = audio_overload_policy_AUDIO_OVERLOAD_DROP_SILENCE,
+    /// Also resample the frames queued over the mark to [AudioOverloadPolicy::degrade_rate]. Aligned frames keep their rate.
+    Degrade = audio_overload_policy_AUDIO_OVERLOAD_DEGRADE,
+    /// Also stop queueing the users whose ring stays backed up, until the drain catches up. One-way stream only.
+    ShedUsers = audio_overload_policy_AUDIO_OVERLOAD_SHED_USERS,
+}
+
+/// Overload policy of a queued stream, see [AudioRawDataHelper::set_overload_policy].
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub struct AudioOverloadPolicy {
+    /// What to give up past the mark.
+    pub action: AudioOverloadAction,
+    /// Share of the ring waiting to be drained from which the action starts, from 1 to 99. The stream
+    /// recovers under half the mark, users are shed halfway between the mark and a full ring.
+    pub high_water_percent: u32,
+    /// Rate of degraded frames, a multiple of 100 from 8000 to 48000.
+    pub degrade_rate: u32,
+}
+
+impl Default for AudioOverloadPolicy {
+    fn default() -> Self {
+        Self {
+            action: AudioOverloadAction::DropSilence,
+            high_water_percent: 50,
+            degrade_rate: 16000,
+        }
+    }
+}
+
+/// Actions taken by the overload policy of a stream.
+pub type AudioOverloadStats = audio_overload_stats;
+
+/// Options of [AudioRawDataHelper::subscribe_delegate_with_options].
+#[derive(Debug, Clone)]
+pub struct AudioSubscribeOptions {
+    /// Receive per-user audio through [RawAudioEvent::on_one_way_audio_raw_data].
+    pub use_separate_channels: bool,
+    /// Receive interpretation channels through [RawAudioEvent::on_interpreter_audio_raw_data].
+    /// The local interpreter features of the SDK are unavailable while subscribed this way.
+    pub with_interpreters: bool,
+    /// How frames are delivered.
+    pub delivery: AudioDelivery,
+    /// Conversion of the delivered frames, see [AudioRawDataHelper::set_output_format].
+    pub output: AudioOutputFormat,
+    /// Gate silent one-way frames, see [AudioRawDataHelper::set_vad].
+    pub vad: Option<AudioVad>,
+    /// Deliver direct frames in batches of this many milliseconds, 0 delivers every frame on its own, see [RawAudioEvent::on_audio_batch].
+    pub batch_window_ms: u32,
+    /// Window of the per-user level meters in milliseconds, 0 disables them, see [AudioRawDataHelper::levels].
+    pub level_window_ms: u32,
+    /// Place frames on a timeline shared by all users, see [AudioRawDataHelper::set_alignment].
+    pub alignment: Option<AudioAlignment>,
+}
+
+impl Default for AudioSubscribeOptions {
+    fn default() -> Self {
+        Self {
+            use_separate_channels: false,
+            with_interpreters: false,
+            delivery: AudioDelivery::Direct,
+            output: AudioOutputFormat::default(),
+            vad: None,
+            batch_window_ms: 0,
+            level_window_ms: 0,
+            alignment: None,
+        }
+    }
+}
+
 #[derive(Debug, Clone)]
 /// This structure represents the ZOOM SDK audio sender.
 pub struct AudioRawDataSenderInterface(*mut ZOOMSDK_IZoomSDKAudioRawDataSender);
@@ -19,6 +457,20 @@ impl AudioRawDataSenderInterface {
     /// Supported sample rates: 8000/11025/16000/32000/44100/48000/50000/50400/96000/192000/2822400
     /// - If the function succeeds, the return value is Ok(), otherwise failed, see [crate::SdkError] for details.
     pub fn send(&mut self, data: &[u8], sample_rate: usize) -> SdkResult<()> {
+        self.send_with_channel(data, sample_rate, false)
+    }
+    /// Send interleaved stereo 16-bit audio.
+    /// Supported sample rates: 8000/16000/32000/44100/48000/50000/50400/96000/192000
+    /// - If the function succeeds, the return value is Ok(), otherwise failed, see [crate::SdkError] for details.
+    pub fn send_stereo(&mut self, data: &[u8], sample_rate: usize) -> SdkResult<()> {
+        self.send_with_channel(data, sample_rate, true)
+    }
+    fn send_with_channel(
+        &mut self,
+        data: &[u8],
+        sample_rate: usize,
+        stereo: bool,
+    ) -> SdkResult<()> {
         ZoomSdkResult(
             unsafe {
                 send_audio_raw_data(
@@ -26,6 +478,11 @@ impl AudioRawDataSenderInterface {
                     data.as_ptr() as *mut i8,
                     data.len() as _,
                     sample_rate as i32,
+                    if stereo {
+                        ZOOMSDK_ZoomSDKAudioChannel_ZoomSDKAudioChannel_Stereo
+                    } else {
+                        ZOOMSDK_ZoomSDKAudioChannel_ZoomSDKAudioChannel_Mono
+                    },
                 )
             },
             (),
@@ -35,13 +492,46 @@ impl AudioRawDataSenderInterface {
 }
 
 /// RawData audio events from delegate.
+/// Frames are only valid during the callback, use [ExportedAudioRawData::retain] to keep one without copying it.
+/// Return values are ignored.
 pub trait RawAudioEvent: Debug {
     /// Mixed audio represents all audio channels mixed.
     fn on_mixed_audio_raw_data(&mut self, _data: &ExportedAudioRawData) -> i32;
     /// Separate channels by users.
     fn on_one_way_audio_raw_data(&mut self, _data: &ExportedAudioRawData, _user_id: u32) -> i32;
-    /// Sharing audio song from Zoom.
-    fn on_share_audio_raw_data(&mut self, _data: &ExportedAudioRawData) -> i32;
+    /// Sharing audio song from Zoom, with the user sharing it. Not called while [AudioRawDataHelper::set_share_capture] is on.
+    fn on_share_audio_raw_data(&mut self, _data: &ExportedAudioRawData, _user_id: u32) -> i32;
+    /// Interpretation channel, see [AudioRawDataHelper::interpreter_languages] for `language_id`.
+    fn on_interpreter_audio_raw_data(
+        &mut self,
+        _data: &ExportedAudioRawData,
+        _language_id: u16,
+    ) -> i32 {
+        0
+    }
+    /// Silent frames of a user, folded by the voice activity gate (see [AudioVad]).
+    fn on_one_way_audio_silence(&mut self, _marker: &AudioSilenceMarker, _user_id: u32) {}
+    /// 10 ms of a custom mix (see [AudioRawDataHelper::set_mix]), mono 16-bit, called on the mixer thread.
+    /// [ExportedAudioRawData::sample_index] counts the samples since the mixer started.
+    fn on_custom_mix(&mut self, _data: &ExportedAudioRawData, _mix_id: u32) {}
+    /// Records of one stream accumulated over the batch window (see [AudioRawDataHelper::set_batch_window]),
+    /// in arrival order. The default dispatches each record to the callbacks above.
+    fn on_audio_batch(&mut self, batch: &[AudioBatchEntry]) {
+        for entry in batch {
+            if let Some(marker) = entry.silence() {
+                self.on_one_way_audio_silence(marker, entry.user_id);
+                continue;
+            }
+            match entry.stream() {
+                AudioStream::Mixed => self.on_mixed_audio_raw_data(&entry.data),
+                AudioStream::OneWay => self.on_one_way_audio_raw_data(&entry.data, entry.user_id),
+                AudioStream::Share => self.on_share_audio_raw_data(&entry.data, entry.user_id),
+                AudioStream::Interpreter => {
+                    self.on_interpreter_audio_raw_data(&entry.data, entry.language_id)
+                }
+            };
+        }
+    }
     /// Use it when you want to do last operation after unsubscribing.
     fn flush(&mut self);
 }
@@ -64,6 +554,9 @@ pub struct AudioRawDataHelper<'a> {
     ref_rawdata_helper: &'a mut ZOOMSDK_IZoomSDKAudioRawDataHelper,
     delegate: Option<RawAudioDelegate<'a>>,
     evt_mic_event_mutex: Option<Arc<Mutex<Box<dyn VirtualAudioMicEvent>>>>,
+    ref_mic_event: Option<&'a mut ZOOMSDK_IZoomSDKVirtualAudioMicEvent>,
+    /// The pusher of `ref_mic_event`, whose queue is single producer.
+    mic_pusher_handle: HandleSlot,
 }
 
 impl<'a> AudioRawDataHelper<'a> {
@@ -78,6 +571,8 @@ impl<'a> AudioRawDataHelper<'a> {
             ref_rawdata_helper: unsafe { ptr.as_mut() }.unwrap(),
             delegate: None,
             evt_mic_event_mutex: None,
+            ref_mic_event: None,
+            mic_pusher_handle: HandleSlot::default(),
         })
     }
     /// Subscribe raw audio data.
@@ -88,31 +583,554 @@ impl<'a> AudioRawDataHelper<'a> {
         event: Box<dyn RawAudioEvent>,
         use_separate_channels: bool,
     ) -> SdkResult<()> {
-        self.delegate = Some(RawAudioDelegate::new(event, use_separate_channels)?);
+        self.subscribe_delegate_with_options(
+            event,
+            AudioSubscribeOptions {
+                use_separate_channels,
+                ..Default::default()
+            },
+        )
+    }
+    /// Subscribe raw audio data with extra delivery options.
+    /// - [RawAudioEvent], the callback handler of raw audio data.
+    /// - [AudioSubscribeOptions], see [AudioDelivery] for the queued mode.
+    /// - If the function succeeds, the return value is Ok(), otherwise failed, see [crate::SdkError] for details.
+    pub fn subscribe_delegate_with_options(
+        &mut self,
+        event: Box<dyn RawAudioEvent>,
+        options: AudioSubscribeOptions,
+    ) -> SdkResult<()> {
+        if self.delegate.is_some() {
+            // The mixer and recorder threads of the previous delegate must stop before it is dropped. Its teardown
+            // runs even if the SDK refuses the unsubscribe, e.g. when its own subscription had failed.
+            if let Err(e) = self.unsubscribe_delegate() {
+                tracing::warn!("Error when unsubscribing the previous delegate: {:?}", e);
+            }
+        }
+        let delegate = RawAudioDelegate::new(event, options.use_separate_channels)?;
+        if let AudioDelivery::Queued {
+            ring_capacity,
+            user_ring_capacity,
+        } = options.delivery
+        {
+            let ok = unsafe {
+                audio_helper_set_delivery_mode(
+                    delegate.ref_delegate as *const _ as *mut _,
+                    audio_delivery_mode_AUDIO_DELIVERY_QUEUED,
+                    ring_capacity,
+                    user_ring_capacity,
+                )
+            };
+            if !ok {
+                return Err(ZoomRsError::NullPtr);
+            }
+        }
+        self.delegate = Some(delegate);
+        if let Err(e) = self.apply_options(&options) {
+            // Not subscribed yet, no thread uses the new delegate.
+            self.delegate = None;
+            return Err(e);
+        }
         ZoomSdkResult(
             unsafe {
                 audio_helper_subscribe_delegate(
                     self.ref_rawdata_helper,
                     self.delegate.as_mut().unwrap().ref_delegate,
+                    options.with_interpreters,
                 )
             },
             (),
         )
         .into()
     }
+    fn apply_options(&self, options: &AudioSubscribeOptions) -> SdkResult<()> {
+        if options.output != AudioOutputFormat::default() {
+            self.set_output_format(options.output)?;
+        }
+        if options.vad.is_some() {
+            self.set_vad(options.vad)?;
+        }
+        if options.batch_window_ms != 0 {
+            self.set_batch_window(options.batch_window_ms)?;
+        }
+        if options.level_window_ms != 0 {
+            self.set_level_window(options.level_window_ms)?;
+        }
+        if options.alignment.is_some() {
+            self.set_alignment(options.alignment)?;
+        }
+        Ok(())
+    }
     /// Unsubscribe raw audio data.
     /// - If the function succeeds, the return value is Ok(), otherwise failed, see [crate::SdkError] for details.
     pub fn unsubscribe_delegate(&mut self) -> SdkResult<()> {
-        let result = ZoomSdkResult(
+        let result: SdkResult<()> = ZoomSdkResult(
             unsafe { audio_helper_unsubscribe_delegate(self.ref_rawdata_helper) },
             (),
         )
         .into();
         if let Some(mut _trashes) = self.delegate.take() {
+            unsafe { audio_helper_detach_participants(_trashes.ref_delegate) };
+            // The mixer thread calls into the event handler, stop it whatever the SDK says.
+            unsafe { audio_helper_set_mixer(_trashes.ref_delegate, 0, 0) };
+            // Only stops new frames from being chunked.
+            unsafe {
+                audio_helper_set_chunker(_trashes.ref_delegate, 0, 0, std::ptr::null_mut(), 0, 0)
+            };
+            if result.is_ok() {
+                // The SDK threads are done with the delegate, hand over the last partial batches.
+                unsafe { audio_helper_flush_batches(_trashes.ref_delegate) };
+                unsafe { audio_helper_stop_recording(_trashes.ref_delegate) };
+            } else {
+                // An SDK thread may still be chunking into the slabs, they must outlive it.
+                std::mem::forget(std::mem::take(&mut _trashes.chunk_slabs));
+            }
             _trashes.flush();
         }
         result
     }
+    /// Change the conversion of the delivered frames, takes effect with the next frame.
+    /// - If the function succeeds, the return value is Ok(), otherwise failed, see [crate::SdkError] for details.
+    pub fn set_output_format(&self, output: AudioOutputFormat) -> SdkResult<()> {
+        let Some(delegate) = self.delegate.as_ref() else {
+            return Err(ZoomRsError::NullPtr);
+        };
+        let ok = unsafe {
+            audio_helper_set_output_format(
+                delegate.ref_delegate as *const _ as *mut _,
+                output.sample_format as u32,
+                output.downmix_mono,
+                output.gain,
+                output.sample_rate,
+            )
+        };
+        if !ok {
+            return Err(ZoomRsError::NullPtr);
+        }
+        Ok(())
+    }
+    /// Enable, tune or disable (None) the voice activity gate of the one-way streams.
+    /// - If the function succeeds, the return value is Ok(), otherwise failed, see [crate::SdkError] for details.
+    pub fn set_vad(&self, vad: Option<AudioVad>) -> SdkResult<()> {
+        let Some(delegate) = self.delegate.as_ref() else {
+            return Err(ZoomRsError::NullPtr);
+        };
+        let settings = vad.unwrap_or_default();
+        let ok = unsafe {
+            audio_helper_set_vad(
+                delegate.ref_delegate as *const _ as *mut _,
+                vad.is_some(),
+                settings.threshold_dbfs,
+                settings.hangover_ms,
+                settings.max_silence_ms,
+            )
+        };
+        if !ok {
+            return Err(ZoomRsError::NullPtr);
+        }
+        Ok(())
+    }
+    /// Deliver direct frames through [RawAudioEvent::on_audio_batch], one call per stream every `window_ms`.
+    /// Takes effect with the next frame, 0 goes back to one call per frame. The batch of a stream that went
+    /// quiet goes out 20 ms past the window, with a frame of another stream or [Self::flush_stale_batches].
+    /// - If the function succeeds, the return value is Ok(), otherwise failed, see [crate::SdkError] for details.
+    pub fn set_batch_window(&self, window_ms: u32) -> SdkResult<()> {
+        let Some(delegate) = self.delegate.as_ref() else {
+            return Err(ZoomRsError::NullPtr);
+        };
+        let ok = unsafe {
+            audio_helper_set_batch_window(delegate.ref_delegate as *const _ as *mut _, window_ms)
+        };
+        if !ok {
+            return Err(ZoomRsError::NullPtr);
+        }
+        Ok(())
+    }
+    /// Deliver the batches kept past the window by streams that went quiet, from any thread.
+    /// Only needed on a timer when every stream can stop, e.g. without mixed audio.
+    pub fn flush_stale_batches(&self) {
+        if let Some(delegate) = self.delegate.as_ref() {
+            unsafe {
+                audio_helper_flush_stale_batches(delegate.ref_delegate as *const _ as *mut _)
+            };
+        }
+    }
+    /// Meter the one-way audio of every user over a rolling window of `window_ms`, 0 disables the meters.
+    /// - If the function succeeds, the return value is Ok(), otherwise failed, see [crate::SdkError] for details.
+    pub fn set_level_window(&self, window_ms: u32) -> SdkResult<()> {
+        let Some(delegate) = self.delegate.as_ref() else {
+            return Err(ZoomRsError::NullPtr);
+        };
+        let ok = unsafe {
+            audio_helper_set_level_window(delegate.ref_delegate as *const _ as *mut _, window_ms)
+        };
+        if !ok {
+            return Err(ZoomRsError::NullPtr);
+        }
+        Ok(())
+    }
+    /// Current level of every user in the meeting, read without locking the audio thread.
+    /// - Returns an empty list if no delegate is subscribed or the meters are disabled.
+    pub fn levels(&self) -> Vec<UserLevel> {
+        let Some(delegate) = self.delegate.as_ref() else {
+            return Vec::new();
+        };
+        let mut levels = Vec::with_capacity(AUDIO_MAX_USERS);
+        unsafe {
+            let len = audio_helper_get_levels(
+                delegate.ref_delegate as *const _ as *mut _,
+                levels.as_mut_ptr(),
+                AUDIO_MAX_USERS as u32,
+            );
+            levels.set_len(len as usize);
+        }
+        levels
+    }
+    /// Enable, tune or disable (None) the alignment of mixed and one-way frames.
+    /// Enabling it again starts a new timeline.
+    /// - If the function succeeds, the return value is Ok(), otherwise failed, see [crate::SdkError] for details.
+    pub fn set_alignment(&self, alignment: Option<AudioAlignment>) -> SdkResult<()> {
+        let Some(delegate) = self.delegate.as_ref() else {
+            return Err(ZoomRsError::NullPtr);
+        };
+        let settings = alignment.unwrap_or_default();
+        let ok = unsafe {
+            audio_helper_set_alignment(
+                delegate.ref_delegate as *const _ as *mut _,
+                alignment.is_some(),
+                settings.tolerance_ms,
+            )
+        };
+        if !ok {
+            return Err(ZoomRsError::NullPtr);
+        }
+        Ok(())
+    }
+    /// Wall clock time of sample 0 in microseconds, same clock as [ExportedAudioRawData::time].
+    /// - Returns None if alignment is off or no frame arrived yet.
+    pub fn alignment_origin(&self) -> Option<i64> {
+        let delegate = self.delegate.as_ref()?;
+        let mut time = 0;
+        unsafe {
+            audio_helper_get_alignment_origin(
+                delegate.ref_delegate as *const _ as *mut _,
+                &mut time,
+            )
+        }
+        .then_some(time)
+    }
+    /// Record the one-way audio of every user to its own WAV or FLAC file, frames are recorded as delivered.
+    /// - If the function succeeds, the return value is Ok(), otherwise failed, see [crate::SdkError] for details.
+    pub fn start_recording(&self, recorder: &AudioTrackRecorder) -> SdkResult<()> {
+        let Some(delegate) = self.delegate.as_ref() else {
+            return Err(ZoomRsError::NullPtr);
+        };
+        let Ok(directory) =
+            std::ffi::CString::new(recorder.directory.as_os_str().as_encoded_bytes())
+        else {
+            return Err(ZoomRsError::NullPtr);
+        };
+        let ok = unsafe {
+            audio_helper_start_recording(
+                delegate.ref_delegate as *const _ as *mut _,
+                directory.as_ptr(),
+                recorder.threads,
+                recorder.ring_capacity,
+                recorder.flush_ms,
+                recorder.sync_ms,
+                recorder.preallocate_kb,
+                recorder.codec as u32,
+            )
+        };
+        if !ok {
+            return Err(ZoomRsError::NullPtr);
+        }
+        Ok(())
+    }
+    /// Write what is queued and close the tracks, blocks until the files are synced.
+    /// Also done when unsubscribing.
+    pub fn stop_recording(&self) {
+        if let Some(delegate) = self.delegate.as_ref() {
+            unsafe { audio_helper_stop_recording(delegate.ref_delegate as *const _ as *mut _) };
+        }
+    }
+    /// Track recorder counters, None if no delegate is subscribed.
+    pub fn recorder_stats(&self) -> Option<AudioRecorderStats> {
+        let delegate = self.delegate.as_ref()?;
+        let mut stats = std::mem::MaybeUninit::<AudioRecorderStats>::uninit();
+        unsafe {
+            if !audio_helper_get_recorder_stats(
+                delegate.ref_delegate as *const _ as *mut _,
+                stats.as_mut_ptr(),
+            ) {
+                return None;
+            }
+            Some(stats.assume_init())
+        }
+    }
+    /// Start, restart with new settings or stop (None) the custom mixer, which needs separate channels.
+    /// The mixes set with [Self::set_mix] are delivered to [RawAudioEvent::on_custom_mix] every 10 ms.
+    /// Must not be called from a [RawAudioEvent] callback, it waits for the mixer thread.
+    /// Also stopped when unsubscribing.
+    /// - If the function succeeds, the return value is Ok(), otherwise failed, see [crate::SdkError] for details.
+    pub fn set_mixer(&self, mixer: Option<AudioMixer>) -> SdkResult<()> {
+        let Some(delegate) = self.delegate.as_ref() else {
+            return Err(ZoomRsError::NullPtr);
+        };
+        let settings = mixer.unwrap_or_default();
+        let ok = unsafe {
+            audio_helper_set_mixer(
+                delegate.ref_delegate as *const _ as *mut _,
+                if mixer.is_some() {
+                    settings.sample_rate
+                } else {
+                    0
+                },
+                settings.jitter_ms,
+            )
+        };
+        if !ok {
+            return Err(ZoomRsError::NullPtr);
+        }
+        Ok(())
+    }
+    /// Define, replace or remove (None) the custom mix `mix_id`, from 0 to 15. Takes effect with the next period.
+    /// - If the function succeeds, the return value is Ok(), otherwise failed, see [crate::SdkError] for details.
+    pub fn set_mix(&self, mix_id: u32, mix: Option<&AudioMix>) -> SdkResult<()> {
+        let Some(delegate) = self.delegate.as_ref() else {
+            return Err(ZoomRsError::NullPtr);
+        };
+        let (mode, users): (audio_mix_mode, &[u32]) = match mix {
+            None => (audio_mix_mode_AUDIO_MIX_OFF, &[]),
+            Some(AudioMix::Include(users)) => (audio_mix_mode_AUDIO_MIX_INCLUDE, users),
+            Some(AudioMix::Exclude(users)) => (audio_mix_mode_AUDIO_MIX_EXCLUDE, users),
+        };
+        let ok = unsafe {
+            audio_helper_set_mix(
+                delegate.ref_delegate as *const _ as *mut _,
+                mix_id,
+                mode,
+                users.as_ptr(),
+                users.len() as u32,
+            )
+        };
+        if !ok {
+            return Err(ZoomRsError::NullPtr);
+        }
+        Ok(())
+    }
+    /// Custom mixer counters, None if no delegate is subscribed.
+    pub fn mixer_stats(&self) -> Option<AudioMixerStats> {
+        let delegate = self.delegate.as_ref()?;
+        let mut stats = std::mem::MaybeUninit::<AudioMixerStats>::uninit();
+        unsafe {
+            if !audio_helper_get_mixer_stats(
+                delegate.ref_delegate as *const _ as *mut _,
+                stats.as_mut_ptr(),
+            ) {
+                return None;
+            }
+            Some(stats.assume_init())
+        }
+    }
+    /// Deliver the mixed and one-way streams in fixed windows instead of the frames of the SDK, or as received (None).
+    /// Windows reach [RawAudioEvent::on_mixed_audio_raw_data] and [RawAudioEvent::on_one_way_audio_raw_data] like
+    /// frames, after conversion and voice gating. A window lying inside one frame points into it and can be retained,
+    /// the others are assembled in a slab owned by the helper. A window cut short by silence is completed with zeros.
+    /// - If the function succeeds, the return value is Ok(), otherwise failed, see [crate::SdkError] for details.
+    pub fn set_chunker(&mut self, chunker: Option<AudioChunker>) -> SdkResult<()> {
+        let Some(delegate) = self.delegate.as_mut() else {
+            return Err(ZoomRsError::NullPtr);
+        };
+        let settings = chunker.unwrap_or_default();
+        let slot_bytes = match settings.slot_bytes {
+            0 => settings.window_ms as usize * 48 * 2 * std::mem::size_of::<f32>(),
+            bytes => bytes as usize,
+        };
+        let slots = settings.max_users + 1;
+        let slab_bytes = if chunker.is_some() {
+            slot_bytes * slots as usize
+        } else {
+            0
+        };
+        let mut slab = vec![0u8; slab_bytes];
+        let ok = unsafe {
+            audio_helper_set_chunker(
+                delegate.ref_delegate as *const _ as *mut _,
+                if chunker.is_some() {
+                    settings.window_ms
+                } else {
+                    0
+                },
+                settings.overlap_ms,
+                slab.as_mut_ptr() as *mut _,
+                slot_bytes,
+                slots,
+            )
+        };
+        if !ok {
+            return Err(ZoomRsError::NullPtr);
+        }
+        if chunker.is_some() {
+            // The SDK threads may still be chunking into the previous slabs, they are all kept until unsubscribing.
+            delegate.chunk_slabs.push(ChunkSlab(slab));
+        }
+        Ok(())
+    }
+    /// Counters of the chunker, None when not subscribed.
+    pub fn chunker_stats(&self) -> Option<AudioChunkerStats> {
+        let delegate = self.delegate.as_ref()?;
+        let mut stats = std::mem::MaybeUninit::<AudioChunkerStats>::uninit();
+        unsafe {
+            if !audio_helper_get_chunker_stats(
+                delegate.ref_delegate as *const _ as *mut _,
+                stats.as_mut_ptr(),
+            ) {
+                return None;
+            }
+            Some(stats.assume_init())
+        }
+    }
+    /// Number of interpreter languages seen so far. The table only grows, so
+    /// [Self::interpreter_languages] only needs to be read again when this changes.
+    pub fn interpreter_language_count(&self) -> u32 {
+        let Some(delegate) = self.delegate.as_ref() else {
+            return 0;
+        };
+        unsafe {
+            audio_helper_get_interpreter_language_count(delegate.ref_delegate as *const _ as *mut _)
+        }
+    }
+    /// Languages of the interpreter frames, ordered by id.
+    /// - Returns an empty list if no delegate is subscribed.
+    pub fn interpreter_languages(&self) -> Vec<InterpreterLanguage> {
+        let Some(delegate) = self.delegate.as_ref() else {
+            return Vec::new();
+        };
+        let cap = self.interpreter_language_count();
+        let mut languages = Vec::with_capacity(cap as usize);
+        unsafe {
+            let len = audio_helper_get_interpreter_languages(
+                delegate.ref_delegate as *const _ as *mut _,
+                languages.as_mut_ptr(),
+                cap,
+            );
+            languages.set_len(len as usize);
+        }
+        languages
+    }
+    /// Get the handle pulling queued frames, see [AudioDelivery::Queued]. The rings are single consumer:
+    /// there is one handle per subscription, available again once dropped.
+    /// - Returns None if no delegate is subscribed or the handle is already out.
+    pub fn queue_drain(&self) -> Option<AudioQueueDrain> {
+        let delegate = self.delegate.as_ref()?;
+        Some(AudioQueueDrain {
+            ptr_delegate: delegate.ref_delegate as *const _ as *mut _,
+            _evt_mutex: delegate.evt_mutex.clone().unwrap(),
+            _lease: delegate.drain_handle.lease()?,
+        })
+    }
+    /// Capture the share audio into a bounded lock-free queue of refcounted frames, popped with
+    /// [Self::share_audio_queue], instead of calling [RawAudioEvent::on_share_audio_raw_data] (None).
+    /// Frames keep the SDK buffer alive without copying it when the SDK allows it, and are copied into a
+    /// pooled buffer otherwise. Sharing can start and stop any number of times while capturing.
+    /// - If the function succeeds, the return value is Ok(), otherwise failed, see [crate::SdkError] for details.
+    pub fn set_share_capture(&self, capture: Option<ShareAudioCapture>) -> SdkResult<()> {
+        let Some(delegate) = self.delegate.as_ref() else {
+            return Err(ZoomRsError::NullPtr);
+        };
+        let settings = capture.unwrap_or_default();
+        let ok = unsafe {
+            audio_helper_set_share_capture(
+                delegate.ref_delegate as *const _ as *mut _,
+                capture.is_some(),
+                settings.capacity,
+                settings.pool_size,
+            )
+        };
+        if !ok {
+            return Err(ZoomRsError::NullPtr);
+        }
+        Ok(())
+    }
+    /// Get the handle popping the share audio captured with [Self::set_share_capture]. The queue is single
+    /// consumer: there is one handle per subscription, available again once dropped.
+    /// - Returns None if no delegate is subscribed or the handle is already out.
+    pub fn share_audio_queue(&self) -> Option<ShareAudioQueue> {
+        let delegate = self.delegate.as_ref()?;
+        Some(ShareAudioQueue {
+            ptr_delegate: delegate.ref_delegate as *const _ as *mut _,
+            _lease: delegate.share_queue_handle.lease()?,
+        })
+    }
+    /// Select what `stream` gives up when the [AudioQueueDrain] falls behind, instead of losing whatever
+    /// arrives once its ring is full, or go back to [AudioOverloadAction::NeverDrop] (None).
+    /// Silence is judged with the threshold of [Self::set_vad], whether the gate is enabled or not.
+    /// Actions are counted in [AudioQueueDrain::overload_stats].
+    /// - If the function succeeds, the return value is Ok(), otherwise failed, see [crate::SdkError] for details.
+    pub fn set_overload_policy(
+        &self,
+        stream: AudioStream,
+        policy: Option<AudioOverloadPolicy>,
+    ) -> SdkResult<()> {
+        let Some(delegate) = self.delegate.as_ref() else {
+            return Err(ZoomRsError::NullPtr);
+        };
+        let settings = policy.unwrap_or(AudioOverloadPolicy {
+            action: AudioOverloadAction::NeverDrop,
+            ..Default::default()
+        });
+        let ok = unsafe {
+            audio_helper_set_overload_policy(
+                delegate.ref_delegate as *const _ as *mut _,
+                stream as u32,
+                settings.action as u32,
+                settings.high_water_percent,
+                settings.degrade_rate,
+            )
+        };
+        if !ok {
+            return Err(ZoomRsError::NullPtr);
+        }
+        Ok(())
+    }
+    /// State of the per-user streams (one per user who sent audio or joined the meeting).
+    /// - Returns an empty list if no delegate is subscribed.
+    pub fn user_streams(&self) -> Vec<AudioUserStream> {
+        let Some(delegate) = self.delegate.as_ref() else {
+            return Vec::new();
+        };
+        let mut streams = Vec::with_capacity(AUDIO_MAX_USERS);
+        unsafe {
+            let len = audio_helper_get_user_streams(
+                delegate.ref_delegate as *const _ as *mut _,
+                streams.as_mut_ptr(),
+                AUDIO_MAX_USERS as u32,
+            );
+            streams.set_len(len as usize);
+        }
+        streams
+    }
+    /// Keep the per-user streams in sync with the participants of the meeting: the users already in it
+    /// get their stream now, then joins and leaves are followed. Without it a stream is created by the
+    /// first frame of its user and reclaimed once idle.
+    /// - Shares the participants event handler with [ParticipantsInterface::set_event], in any order.
+    /// - If the function succeeds, the return value is Ok(), otherwise failed, see [crate::SdkError] for details.
+    pub fn attach_participants(&self, participants: &ParticipantsInterface) -> SdkResult<()> {
+        let Some(delegate) = self.delegate.as_ref() else {
+            return Err(ZoomRsError::NullPtr);
+        };
+        ZoomSdkResult(
+            unsafe {
+                audio_helper_attach_participants(
+                    delegate.ref_delegate as *const _ as *mut _,
+                    participants.controller(),
+                )
+            },
+            (),
+        )
+        .into()
+    }
     /// Flush the audio delegate (sends remaining per-user audio tracks for processing)
     /// without making any SDK calls. Safe to call during SDK teardown.
     pub fn flush(&mut self) {
@@ -128,13 +1146,250 @@ impl<'a> AudioRawDataHelper<'a> {
         arc_event: Arc<Mutex<Box<dyn VirtualAudioMicEvent>>>,
     ) -> SdkResult<()> {
         let ptr = Arc::as_ptr(&arc_event) as *mut _;
+        let mic = unsafe { audio_helper_create_mic_event(ptr) };
+        if mic.is_null() {
+            return Err(ZoomRsError::NullPtr);
+        }
         self.evt_mic_event_mutex = Some(arc_event);
+        self.ref_mic_event = unsafe { mic.as_mut() };
+        self.mic_pusher_handle = HandleSlot::default();
         ZoomSdkResult(
-            unsafe { audio_helper_set_external_audio_source(self.ref_rawdata_helper, ptr) },
+            unsafe { audio_helper_set_external_audio_source(self.ref_rawdata_helper, mic) },
             (),
         )
         .into()
     }
+    /// Let the wrapper send the virtual mic audio in real time, None goes back to [AudioRawDataSenderInterface::send].
+    /// Audio is then queued with [AudioMicPusher::push] and sent on a dedicated thread while the SDK allows it.
+    /// - If the function succeeds, the return value is Ok(), otherwise failed, see [crate::SdkError] for details.
+    pub fn set_mic_pacer(&self, pacer: Option<AudioMicPacer>) -> SdkResult<()> {
+        let Some(mic) = self.ref_mic_event.as_ref() else {
+            return Err(ZoomRsError::NullPtr);
+        };
+        let settings = pacer.unwrap_or_default();
+        let ok = unsafe {
+            audio_helper_set_mic_pacer(
+                *mic as *const _ as *mut _,
+                if pacer.is_some() {
+                    settings.sample_rate
+                } else {
+                    0
+                },
+                settings.channels,
+                settings.chunk_ms,
+                settings.prefill_ms,
+                settings.queue_ms,
+            )
+        };
+        if !ok {
+            return Err(ZoomRsError::NullPtr);
+        }
+        Ok(())
+    }
+    /// Get the handle queuing audio for the mic pacer, see [Self::set_mic_pacer]. The queue is single producer:
+    /// there is one handle per external audio source, available again once dropped.
+    /// - Returns None if no external audio source is set or the handle is already out.
+    pub fn mic_pusher(&self) -> Option<AudioMicPusher> {
+        let mic = self.ref_mic_event.as_ref()?;
+        Some(AudioMicPusher {
+            ptr_mic: *mic as *const _ as *mut _,
+            _evt_mutex: self.evt_mic_event_mutex.clone().unwrap(),
+            _lease: self.mic_pusher_handle.lease()?,
+        })
+    }
+    /// Remove what the bot says through the virtual mic from the mixed stream, so a transcription of it
+    /// does not pick up the bot itself, or stop (None). Everything sent, by [AudioRawDataSenderInterface::send]
+    /// or the mic pacer, is kept as a reference; the loopback delay is estimated by cross-correlation
+    /// every half second and an adaptive filter subtracts the echo before any other processing of the
+    /// mixed frames. The sizes are only used the first time the canceller is enabled.
+    /// - Needs a subscribed delegate and an external audio source.
+    /// - If the function succeeds, the return value is Ok(), otherwise failed, see [crate::SdkError] for details.
+    pub fn set_echo_canceller(&self, canceller: Option<AudioEchoCanceller>) -> SdkResult<()> {
+        let Some(delegate) = self.delegate.as_ref() else {
+            return Err(ZoomRsError::NullPtr);
+        };
+        let Some(mic) = self.ref_mic_event.as_ref() else {
+            return Err(ZoomRsError::NullPtr);
+        };
+        let settings = canceller.unwrap_or_default();
+        let ok = unsafe {
+            audio_helper_set_echo_canceller(
+                delegate.ref_delegate as *const _ as *mut _,
+                *mic as *const _ as *mut _,
+                canceller.is_some(),
+                settings.sample_rate,
+                settings.max_delay_ms,
+                settings.taps,
+            )
+        };
+        if !ok {
+            return Err(ZoomRsError::NullPtr);
+        }
+        Ok(())
+    }
+    /// Counters of the echo canceller, None when not subscribed.
+    pub fn echo_canceller_stats(&self) -> Option<AudioEchoCancellerStats> {
+        let delegate = self.delegate.as_ref()?;
+        let mut stats = std::mem::MaybeUninit::<AudioEchoCancellerStats>::uninit();
+        unsafe {
+            if !audio_helper_get_echo_canceller_stats(
+                delegate.ref_delegate as *const _ as *mut _,
+                stats.as_mut_ptr(),
+            ) {
+                return None;
+            }
+            Some(stats.assume_init())
+        }
+    }
+}
+
+/// Real-time pacing of the virtual mic, see [AudioRawDataHelper::set_mic_pacer].
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub struct AudioMicPacer {
+    /// Rate sent to the SDK, rounded up to the nearest rate supported by [AudioRawDataSenderInterface::send]
+    /// or [AudioRawDataSenderInterface::send_stereo], 48000 at most.
+    pub sample_rate: u32,
+    /// 1 to send mono, 2 to send stereo.
+    pub channels: u32,
+    /// Duration of each sent chunk, 10 or 20.
+    pub chunk_ms: u32,
+    /// Audio queued before playback starts, or resumes after an underrun.
+    pub prefill_ms: u32,
+    /// Capacity of the queue, only used the first time a pacer is set.
+    pub queue_ms: u32,
+}
+
+impl Default for AudioMicPacer {
+    fn default() -> Self {
+        Self {
+            sample_rate: 48000,
+            channels: 1,
+            chunk_ms: 10,
+            prefill_ms: 60,
+            queue_ms: 2000,
+        }
+    }
+}
+
+/// Counters of the virtual mic pacer.
+pub type AudioMicPacerStats = audio_mic_pacer_stats;
+
+/// Removal of the audio sent through the virtual mic from the mixed stream, see [AudioRawDataHelper::set_echo_canceller].
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub struct AudioEchoCanceller {
+    /// Rate of the mixed frames processed, a multiple of 8000 up to 48000. Frames at another rate,
+    /// or not mono 16-bit PCM, pass through.
+    pub sample_rate: u32,
+    /// Longest loopback delay searched, from 10 to 2000.
+    pub max_delay_ms: u32,
+    /// Length of the adaptive filter in samples, from 32 to 1024.
+    pub taps: u32,
+}
+
+impl Default for AudioEchoCanceller {
+    fn default() -> Self {
+        Self {
+            sample_rate: 32000,
+            max_delay_ms: 1000,
+            taps: 256,
+        }
+    }
+}
+
+/// Counters of the echo canceller.
+pub type AudioEchoCancellerStats = audio_echo_canceller_stats;
+
+/// Queues audio for the mic pacer, see [AudioRawDataHelper::set_mic_pacer].
+/// Move it to the thread producing the audio: the queue is single producer.
+#[derive(Debug)]
+pub struct AudioMicPusher {
+    ptr_mic: *mut ZOOMSDK_IZoomSDKVirtualAudioMicEvent,
+    /// Keeps the mic event handler alive while the pacer can still run.
+    _evt_mutex: Arc<Mutex<Box<dyn VirtualAudioMicEvent>>>,
+    _lease: HandleLease,
+}
+
+unsafe impl Send for AudioMicPusher {}
+
+impl AudioMicPusher {
+    /// Queue 16-bit PCM bytes in the sent format without blocking.
+    /// - Returns the number of queued bytes, less than `pcm.len()` when the queue is full.
+    pub fn push(&mut self, pcm: &[u8]) -> usize {
+        unsafe {
+            audio_helper_mic_push(
+                self.ptr_mic,
+                pcm.as_ptr() as *const _,
+                pcm.len().min(u32::MAX as usize) as u32,
+            ) as usize
+        }
+    }
+    /// Queue samples without blocking.
+    /// - Returns the number of queued samples.
+    pub fn push_s16(&mut self, samples: &[i16]) -> usize {
+        let bytes = unsafe {
+            std::slice::from_raw_parts(
+                samples.as_ptr() as *const u8,
+                std::mem::size_of_val(samples),
+            )
+        };
+        self.push(bytes) / 2
+    }
+    /// Convert interleaved samples of any rate and channel count to the sent format and queue them without blocking.
+    /// - Returns the number of consumed frames, less than `samples.len() / channels` when the queue is full.
+    pub fn push_converted_s16(
+        &mut self,
+        samples: &[i16],
+        sample_rate: u32,
+        channels: u32,
+    ) -> usize {
+        self.push_pcm(
+            samples.as_ptr() as *const _,
+            samples.len(),
+            audio_sample_format_AUDIO_SAMPLE_S16,
+            sample_rate,
+            channels,
+        )
+    }
+    /// Same as [Self::push_converted_s16] for float samples in [-1, 1].
+    pub fn push_converted_f32(
+        &mut self,
+        samples: &[f32],
+        sample_rate: u32,
+        channels: u32,
+    ) -> usize {
+        self.push_pcm(
+            samples.as_ptr() as *const _,
+            samples.len(),
+            audio_sample_format_AUDIO_SAMPLE_F32,
+            sample_rate,
+            channels,
+        )
+    }
+    fn push_pcm(
+        &mut self,
+        data: *const i8,
+        samples: usize,
+        format: audio_sample_format,
+        sample_rate: u32,
+        channels: u32,
+    ) -> usize {
+        if channels == 0 {
+            return 0;
+        }
+        let frames = (samples / channels as usize).min(u32::MAX as usize) as u32;
+        unsafe {
+            audio_helper_mic_push_pcm(self.ptr_mic, data, frames, format, sample_rate, channels)
+                as usize
+        }
+    }
+    /// Pacer counters.
+    pub fn stats(&self) -> AudioMicPacerStats {
+        let mut stats = std::mem::MaybeUninit::<AudioMicPacerStats>::uninit();
+        unsafe {
+            audio_helper_get_mic_pacer_stats(self.ptr_mic, stats.as_mut_ptr());
+            stats.assume_init()
+        }
+    }
 }
 
 /// Drop boilerplate for RawDataHelper.
@@ -152,10 +1407,126 @@ impl<'a> Drop for AudioRawDataHelper<'a> {
     }
 }
 
+/// Pulls frames out of the delegate rings when [AudioDelivery::Queued] is selected.
+/// Move it to the worker thread which owns the consumption: the rings are single consumer.
+#[derive(Debug)]
+pub struct AudioQueueDrain {
+    ptr_delegate: *mut ZOOMSDK_IZoomSDKAudioRawDataDelegate,
+    /// Keeps the event handler alive while frames can still be dispatched to it.
+    _evt_mutex: Arc<Mutex<Box<dyn RawAudioEvent>>>,
+    _lease: HandleLease,
+}
+
+unsafe impl Send for AudioQueueDrain {}
+
+impl AudioQueueDrain {
+    /// Dispatch at most `max_frames` queued frames to [RawAudioEvent] on the calling thread.
+    /// - Returns the number of dispatched frames.
+    pub fn drain(&mut self, max_frames: u32) -> u32 {
+        unsafe { audio_helper_drain(self.ptr_delegate, max_frames) }
+    }
+    /// Ring buffer counters of the given stream, None if queued mode is not enabled.
+    pub fn stats(&self, stream: AudioStream) -> Option<AudioQueueStats> {
+        let mut stats = std::mem::MaybeUninit::<AudioQueueStats>::uninit();
+        let ok = unsafe {
+            audio_helper_get_queue_stats(self.ptr_delegate, stream as u32, stats.as_mut_ptr())
+        };
+        ok.then(|| unsafe { stats.assume_init() })
+    }
+    /// Actions of the overload policy of the given stream, see [AudioRawDataHelper::set_overload_policy].
+    pub fn overload_stats(&self, stream: AudioStream) -> Option<AudioOverloadStats> {
+        let mut stats = std::mem::MaybeUninit::<AudioOverloadStats>::uninit();
+        let ok = unsafe {
+            audio_helper_get_overload_stats(self.ptr_delegate, stream as u32, stats.as_mut_ptr())
+        };
+        ok.then(|| unsafe { stats.assume_init() })
+    }
+}
+
+/// Pops the share audio captured with [AudioRawDataHelper::set_share_capture].
+/// Move it to the thread consuming the share audio: the queue is single consumer.
+#[derive(Debug)]
+pub struct ShareAudioQueue {
+    ptr_delegate: *mut ZOOMSDK_IZoomSDKAudioRawDataDelegate,
+    _lease: HandleLease,
+}
+
+unsafe impl Send for ShareAudioQueue {}
+
+impl ShareAudioQueue {
+    /// Append at most `max_frames` captured frames to `frames`, oldest first.
+    /// - Returns the number of appended frames.
+    pub fn pop(&mut self, frames: &mut Vec<ShareAudioFrame>, max_frames: u32) -> u32 {
+        let mut packets = [std::mem::MaybeUninit::<share_audio_packet>::uninit(); 32];
+        let mut total = 0;
+        while total < max_frames {
+            let cap = (max_frames - total).min(packets.len() as u32);
+            let count = unsafe {
+                audio_helper_pop_share_audio(self.ptr_delegate, packets.as_mut_ptr() as *mut _, cap)
+            };
+            for packet in &packets[..count as usize] {
+                let packet = unsafe { packet.assume_init() };
+                frames.push(ShareAudioFrame {
+                    user_id: packet.user_id,
+                    frame: AudioRawDataHandle {
+                        raw: packet.data.raw,
+                        data: packet.data,
+                    },
+                });
+            }
+            total += count;
+            if count < cap {
+                break;
+            }
+        }
+        total
+    }
+    /// Counters of the capture.
+    pub fn stats(&self) -> Option<ShareCaptureStats> {
+        let mut stats = std::mem::MaybeUninit::<ShareCaptureStats>::uninit();
+        let ok =
+            unsafe { audio_helper_get_share_capture_stats(self.ptr_delegate, stats.as_mut_ptr()) };
+        ok.then(|| unsafe { stats.assume_init() })
+    }
+}
+
+/// Hands out at most one handle at a time over a single producer or single consumer queue.
+#[derive(Debug, Default)]
+struct HandleSlot(Arc<AtomicBool>);
+
+impl HandleSlot {
+    /// None while another lease is alive.
+    fn lease(&self) -> Option<HandleLease> {
+        (!self.0.swap(true, Ordering::Acquire)).then(|| HandleLease(self.0.clone()))
+    }
+}
+
+/// Frees its [HandleSlot] when dropped.
+#[derive(Debug)]
+struct HandleLease(Arc<AtomicBool>);
+
+impl Drop for HandleLease {
+    fn drop(&mut self) {
+        self.0.store(false, Ordering::Release);
+    }
+}
+
+/// Slab handed to the chunker, only written by the SDK threads.
+struct ChunkSlab(Vec<u8>);
+
+impl std::fmt::Debug for ChunkSlab {
+    fn fmt(&self, f: &mut std::fmt::Formatter<'_>) -> std::fmt::Result {
+        write!(f, "ChunkSlab({} bytes)", self.0.len())
+    }
+}
+
 #[derive(Debug)]
 struct RawAudioDelegate<'a> {
     evt_mutex: Option<Arc<Mutex<Box<dyn RawAudioEvent>>>>,
     ref_delegate: &'a mut ZOOMSDK_IZoomSDKAudioRawDataDelegate,
+    chunk_slabs: Vec<ChunkSlab>,
+    drain_handle: HandleSlot,
+    share_queue_handle: HandleSlot,
 }
 
 impl<'a> RawAudioDelegate<'a> {
@@ -169,6 +1540,9 @@ impl<'a> RawAudioDelegate<'a> {
         Ok(Self {
             evt_mutex,
             ref_delegate: unsafe { delegate.as_mut() }.unwrap(),
+            chunk_slabs: Vec::new(),
+            drain_handle: HandleSlot::default(),
+            share_queue_handle: HandleSlot::default(),
         })
     }
     fn flush(&mut self) {
@@ -205,12 +1579,73 @@ extern "C" fn on_one_way_audio_raw_data(
 
 #[tracing::instrument(ret)]
 #[no_mangle]
-extern "C" fn on_share_audio_raw_data(ptr: *const u8, data: *const exported_audio_raw_data) -> i32 {
+extern "C" fn on_share_audio_raw_data(
+    ptr: *const u8,
+    data: *const exported_audio_raw_data,
+    user_id: __uint32_t,
+) -> i32 {
     if data.is_null() {
         tracing::warn!("Null pointer detected!");
         0
     } else {
-        (*convert(ptr).lock().unwrap()).on_share_audio_raw_data(unsafe { data.as_ref() }.unwrap())
+        (*convert(ptr).lock().unwrap())
+            .on_share_audio_raw_data(unsafe { data.as_ref() }.unwrap(), user_id)
+    }
+}
+
+#[no_mangle]
+extern "C" fn on_interpreter_audio_raw_data(
+    ptr: *const u8,
+    data: *const exported_audio_raw_data,
+    language_id: u16,
+) -> i32 {
+    if data.is_null() {
+        tracing::warn!("Null pointer detected!");
+        0
+    } else {
+        (*convert(ptr).lock().unwrap())
+            .on_interpreter_audio_raw_data(unsafe { data.as_ref() }.unwrap(), language_id)
+    }
+}
+
+#[no_mangle]
+extern "C" fn on_one_way_audio_silence(
+    ptr: *const u8,
+    marker: *const audio_silence_marker,
+    user_id: __uint32_t,
+) {
+    if marker.is_null() {
+        tracing::warn!("Null pointer detected!");
+    } else {
+        (*convert(ptr).lock().unwrap())
+            .on_one_way_audio_silence(unsafe { marker.as_ref() }.unwrap(), user_id)
+    }
+}
+
+#[no_mangle]
+extern "C" fn on_audio_raw_data_batch(
+    ptr: *const u8,
+    entries: *const audio_batch_entry,
+    count: __uint32_t,
+) {
+    if entries.is_null() {
+        tracing::warn!("Null pointer detected!");
+    } else {
+        let batch = unsafe { std::slice::from_raw_parts(entries, count as usize) };
+        (*convert(ptr).lock().unwrap()).on_audio_batch(batch)
+    }
+}
+
+#[no_mangle]
+extern "C" fn on_custom_audio_mix(
+    ptr: *const u8,
+    data: *const exported_audio_raw_data,
+    mix_id: __uint32_t,
+) {
+    if data.is_null() {
+        tracing::warn!("Null pointer detected!");
+    } else {
+        (*convert(ptr).lock().unwrap()).on_custom_mix(unsafe { data.as_ref() }.unwrap(), mix_id)
     }
 }
 
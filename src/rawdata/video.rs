@@ -9,7 +9,113 @@ use crate::bindings::*;
 /// Raw data of an image.
 pub type ExportedVideoRawData = exported_video_raw_data;
 
+/// References kept on the frames of a renderer, see [Renderer::frame_ref_stats].
+pub type VideoFrameRefStats = video_frame_ref_stats;
+
+impl ExportedVideoRawData {
+    /// I420 bytes of the frame.
+    pub fn as_bytes(&self) -> &[u8] {
+        if self.data.is_null() {
+            return &[];
+        }
+        unsafe { std::slice::from_raw_parts(self.data as *const u8, self.len as usize) }
+    }
+    /// Luma, then the two chroma planes of the frame, with rows of [Self::width] and `(width + 1) / 2` bytes.
+    /// - Returns None if the SDK gave no planes.
+    pub fn planes(&self) -> Option<[&[u8]; 3]> {
+        if self.y.is_null() || self.u.is_null() || self.v.is_null() {
+            return None;
+        }
+        let luma = self.width as usize * self.height as usize;
+        let chroma = self.width.div_ceil(2) as usize * self.height.div_ceil(2) as usize;
+        unsafe {
+            Some([
+                std::slice::from_raw_parts(self.y as *const u8, luma),
+                std::slice::from_raw_parts(self.u as *const u8, chroma),
+                std::slice::from_raw_parts(self.v as *const u8, chroma),
+            ])
+        }
+    }
+    /// Alpha plane of the frame, one byte per pixel, None when the source sends none.
+    pub fn alpha(&self) -> Option<&[u8]> {
+        (!self.alpha.is_null() && self.alpha_len > 0).then(|| unsafe {
+            std::slice::from_raw_parts(self.alpha as *const u8, self.alpha_len as usize)
+        })
+    }
+    /// Bytes written by [Self::convert] for `format`.
+    pub fn converted_len(&self, format: VideoPixelFormat) -> usize {
+        unsafe { video_raw_data_converted_len(self, format as u32) }
+    }
+    /// Convert the frame into `out` with SIMD kernels, using the BT.601 matrix. Works on retained frames too.
+    /// - `rotation`: clockwise rotation applied on the way, 0, 90, 180 or 270. Pass [Self::rotation] to get the frame upright;
+    ///   width and height swap at 90 and 270.
+    /// - `full_range`: expand limited range samples to the full range in I420 and NV12 output. RGB output is always full range.
+    /// - Fails if the frame has no planes, the rotation is unknown or `out` is shorter than [Self::converted_len].
+    pub fn convert(
+        &self,
+        format: VideoPixelFormat,
+        rotation: u32,
+        full_range: bool,
+        out: &mut [u8],
+    ) -> SdkResult<()> {
+        if !unsafe {
+            video_raw_data_convert(
+                self,
+                format as u32,
+                rotation,
+                full_range,
+                out.as_mut_ptr(),
+                out.len(),
+            )
+        } {
+            return Err(ZoomRsError::NullPtr);
+        }
+        Ok(())
+    }
+    /// Keep the frame after the callback returns, e.g. to hand it to an encoder thread.
+    /// The SDK buffer itself is kept when the SDK allows it, otherwise the frame is copied into a buffer pooled by the renderer.
+    /// - Call it from [RawVideoEvent::on_raw_data_frame_received] only.
+    /// - Returns None once the renderer has [Renderer::set_max_frame_refs] frames out, until some handles are dropped.
+    pub fn retain(&self) -> Option<VideoRawDataHandle> {
+        let mut data = std::mem::MaybeUninit::<ExportedVideoRawData>::uninit();
+        unsafe {
+            if !video_raw_data_retain(self, data.as_mut_ptr()) {
+                return None;
+            }
+            Some(VideoRawDataHandle {
+                data: data.assume_init(),
+            })
+        }
+    }
+}
+
+/// Reference on a video frame obtained with [ExportedVideoRawData::retain], released on drop.
+#[derive(Debug)]
+pub struct VideoRawDataHandle {
+    data: ExportedVideoRawData,
+}
+
+unsafe impl Send for VideoRawDataHandle {}
+
+impl VideoRawDataHandle {
+    /// I420 bytes of the frame.
+    pub fn as_bytes(&self) -> &[u8] {
+        self.data.as_bytes()
+    }
+    /// Metadata of the frame, as received in the callback, pointing at the kept buffer.
+    pub fn data(&self) -> &ExportedVideoRawData {
+        &self.data
+    }
+}
+
+impl Drop for VideoRawDataHandle {
+    fn drop(&mut self) {
+        unsafe { video_raw_data_release(self.data.pool, self.data.raw) };
+    }
+}
+
 /// RawData video events from delegate.
+/// Frames are only valid during the callback, use [ExportedVideoRawData::retain] to keep one.
 pub trait RawVideoEvent: Debug {
     /// Get Data frame.
     fn on_raw_data_frame_received(&mut self, _data: &ExportedVideoRawData);
@@ -18,6 +124,8 @@ pub trait RawVideoEvent: Debug {
     /// Notify the current renderer object is going to be destroyed.
     /// After you handle this callback, you should never user this renderer object any more
     fn on_renderer_be_destroyed(&mut self, time: i64);
+    /// Downscaled copy of a frame, see [Renderer::set_thumbnail]. It can be retained and converted like a full frame.
+    fn on_thumbnail(&mut self, _data: &ExportedVideoRawData) {}
     /// Use it when you want to do last operation after unsubscribing.
     fn flush(&mut self);
 }
@@ -27,7 +135,6 @@ pub trait RawVideoEvent: Debug {
 pub struct Renderer {
     renderer: Option<*mut ZOOMSDK_IZoomSDKRenderer>,
     /// Delegate created by video_helper_create_delegate (in C wrapper). Never freed here; see TODO in Drop.
-    #[allow(dead_code)]
     delegate: *mut ZOOMSDK_IZoomSDKRendererDelegate,
     evt_mutex: Arc<Mutex<Box<dyn RawVideoEvent>>>,
     /// Set when the SDK calls onRendererBeDestroyed; we then skip unSubscribe/destroy in Drop.
@@ -39,10 +146,21 @@ impl Renderer {
     pub fn new(
         evt_mutex: Arc<Mutex<Box<dyn RawVideoEvent>>>,
         resolution: VideoResolution,
+    ) -> SdkResult<Self> {
+        Self::with_target_fps(evt_mutex, resolution, 0)
+    }
+    /// Create a new renderer delivering at most `target_fps` frames per second, see [Renderer::set_target_fps].
+    pub fn with_target_fps(
+        evt_mutex: Arc<Mutex<Box<dyn RawVideoEvent>>>,
+        resolution: VideoResolution,
+        target_fps: u32,
     ) -> SdkResult<Self> {
         let mut renderer: *mut ZOOMSDK_IZoomSDKRenderer = ptr::null_mut();
         let ptr = Arc::as_ptr(&evt_mutex) as *mut _;
-        let delegate = unsafe { video_helper_create_delegate(ptr) };
+        let delegate = unsafe { video_helper_create_delegate(ptr, target_fps) };
+        if delegate.is_null() {
+            return Err(ZoomRsError::NullPtr);
+        }
         let result: Result<(), ZoomRsError> = ZoomSdkResult(
             unsafe { ZOOMSDK_createRenderer(&mut renderer, delegate) },
             (),
@@ -89,6 +207,79 @@ impl Renderer {
         }
     }
 
+    /// Deliver at most `target_fps` frames per second to [RawVideoEvent::on_raw_data_frame_received], from 1 to 60,
+    /// 0 for every frame. The other frames are dropped in the C++ delegate before reaching Rust; the kept ones are
+    /// the closest to a fixed grid of the frame timestamps, so the cadence stays even when the frames jitter.
+    /// Thumbnails keep their own interval.
+    /// - If the function succeeds, the return value is Ok(), otherwise failed, see [crate::SdkError] for details.
+    pub fn set_target_fps(&self, target_fps: u32) -> SdkResult<()> {
+        if !unsafe { video_helper_set_target_fps(self.delegate, target_fps) } {
+            return Err(ZoomRsError::NullPtr);
+        }
+        Ok(())
+    }
+    /// Frames of this renderer forwarded and dropped by the frame rate decimation.
+    pub fn frame_rate_stats(&self) -> Option<VideoFrameRateStats> {
+        let mut stats = std::mem::MaybeUninit::<VideoFrameRateStats>::uninit();
+        unsafe {
+            if !video_helper_get_frame_rate_stats(self.delegate, stats.as_mut_ptr()) {
+                return None;
+            }
+            Some(stats.assume_init())
+        }
+    }
+
+    /// Cap the frames of this renderer kept with [ExportedVideoRawData::retain] at once, from 1 to 64, 0 for the default of 8.
+    /// Past the cap frames are still delivered but cannot be retained, so a consumer falling behind never pins the SDK buffers.
+    /// - If the function succeeds, the return value is Ok(), otherwise failed, see [crate::SdkError] for details.
+    pub fn set_max_frame_refs(&self, max_refs: u32) -> SdkResult<()> {
+        if !unsafe { video_helper_set_max_frame_refs(self.delegate, max_refs) } {
+            return Err(ZoomRsError::NullPtr);
+        }
+        Ok(())
+    }
+    /// References kept on the frames of this renderer.
+    pub fn frame_ref_stats(&self) -> Option<VideoFrameRefStats> {
+        let mut stats = std::mem::MaybeUninit::<VideoFrameRefStats>::uninit();
+        unsafe {
+            if !video_helper_get_frame_ref_stats(self.delegate, stats.as_mut_ptr()) {
+                return None;
+            }
+            Some(stats.assume_init())
+        }
+    }
+
+    /// Deliver downscaled copies of the frames to [RawVideoEvent::on_thumbnail], None to stop them.
+    /// - If the function succeeds, the return value is Ok(), otherwise failed, see [crate::SdkError] for details.
+    pub fn set_thumbnail(&self, thumbnail: Option<VideoThumbnail>) -> SdkResult<()> {
+        let settings = thumbnail.unwrap_or_default();
+        let ok = unsafe {
+            video_helper_set_thumbnail(
+                self.delegate,
+                thumbnail.is_some(),
+                settings.width,
+                settings.height,
+                settings.interval_ms,
+                settings.filter as u32,
+                settings.forward_frames,
+            )
+        };
+        if !ok {
+            return Err(ZoomRsError::NullPtr);
+        }
+        Ok(())
+    }
+    /// Counters of the thumbnails of this renderer.
+    pub fn thumbnail_stats(&self) -> Option<VideoThumbnailStats> {
+        let mut stats = std::mem::MaybeUninit::<VideoThumbnailStats>::uninit();
+        unsafe {
+            if !video_helper_get_thumbnail_stats(self.delegate, stats.as_mut_ptr()) {
+                return None;
+            }
+            Some(stats.assume_init())
+        }
+    }
+
     /// The renderer is not valid anymore according to documentation.
     /// Called when the SDK fires onRendererBeDestroyed (e.g. on meeting disconnect).
     /// After this, we must not call unSubscribe or destroy; Drop will no-op (Attendee-style).
@@ -152,6 +343,15 @@ extern "C" fn on_raw_data_frame_received(ptr: *const u8, data: *const exported_v
     }
 }
 
+#[no_mangle]
+extern "C" fn on_video_thumbnail(ptr: *const u8, data: *const exported_video_raw_data) {
+    if data.is_null() {
+        tracing::warn!("Null pointer detected!");
+    } else {
+        (*convert(ptr).lock().unwrap()).on_thumbnail(unsafe { data.as_ref() }.unwrap())
+    }
+}
+
 #[tracing::instrument(ret)]
 #[no_mangle]
 extern "C" fn on_renderer_be_destroyed(ptr: *const u8, time: i64) {
@@ -171,6 +371,66 @@ fn convert(ptr: *const u8) -> Arc<Mutex<Box<dyn RawVideoEvent>>> {
     unsafe { Arc::from_raw(ptr) }
 }
 
+/// Pixel layouts of [ExportedVideoRawData::convert], rows packed without padding.
+#[derive(Debug, PartialEq, Eq, Clone, Copy)]
+#[repr(u32)]
+pub enum VideoPixelFormat {
+    /// Y plane, then the U and V planes of `(width + 1) / 2` x `(height + 1) / 2` samples.
+    I420 = video_pixel_format_VIDEO_PIXEL_I420,
+    /// Y plane, then one plane of interleaved U/V pairs.
+    Nv12 = video_pixel_format_VIDEO_PIXEL_NV12,
+    /// 4 bytes per pixel, alpha from the alpha plane of the frame or opaque.
+    Rgba = video_pixel_format_VIDEO_PIXEL_RGBA,
+    /// 4 bytes per pixel, alpha from the alpha plane of the frame or opaque.
+    Bgra = video_pixel_format_VIDEO_PIXEL_BGRA,
+    /// 3 bytes per pixel.
+    Rgb24 = video_pixel_format_VIDEO_PIXEL_RGB24,
+}
+
+/// Filter of the thumbnail downscaler.
+#[derive(Debug, PartialEq, Eq, Clone, Copy)]
+#[repr(u32)]
+pub enum VideoScaleFilter {
+    /// Average of every source pixel under the thumbnail pixel.
+    Box = video_scale_filter_VIDEO_SCALE_BOX,
+    /// Interpolation between the 4 nearest source pixels, cheaper but aliased past a 2x reduction.
+    Bilinear = video_scale_filter_VIDEO_SCALE_BILINEAR,
+}
+
+/// Downscaled copies of the frames of a renderer, see [Renderer::set_thumbnail].
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub struct VideoThumbnail {
+    /// Largest thumbnail width, from 16 to 1920. Thumbnails keep the aspect ratio of the frame, in even sizes,
+    /// and are never larger than the frame.
+    pub width: u32,
+    /// Largest thumbnail height, from 16 to 1080.
+    pub height: u32,
+    /// Time between two thumbnails, 0 for one per frame.
+    pub interval_ms: u32,
+    /// Downscaling filter.
+    pub filter: VideoScaleFilter,
+    /// Keep delivering full frames to [RawVideoEvent::on_raw_data_frame_received].
+    pub forward_frames: bool,
+}
+
+impl Default for VideoThumbnail {
+    fn default() -> Self {
+        Self {
+            width: 320,
+            height: 180,
+            interval_ms: 200,
+            filter: VideoScaleFilter::Box,
+            forward_frames: true,
+        }
+    }
+}
+
+/// Counters of the thumbnails of a renderer.
+pub type VideoThumbnailStats = video_thumbnail_stats;
+
+/// Counters of the frame rate decimation of a renderer, see [Renderer::set_target_fps].
+pub type VideoFrameRateStats = video_frame_rate_stats;
+
 /// Resolution MAX of the input images.
 #[derive(Debug, Copy, Clone)]
 #[repr(u32)]
@@ -98,6 +98,9 @@ impl<'a> ParticipantsInterface<'a> {
             })
         }
     }
+    pub(crate) fn controller(&self) -> *mut ZOOMSDK_IMeetingParticipantsController {
+        self.ref_participants_controler as *const _ as *mut _
+    }
     /// Get user id of the bot
     pub fn get_my_self_user_id(&mut self) -> i32 {
         let this = unsafe { get_my_self_user(self.ref_participants_controler) };
@@ -0,0 +1,72 @@
+#include "c_audio_aligner.h"
+
+MeetingOrigin::MeetingOrigin() {
+    epoch_.store(0, std::memory_order_relaxed);
+    ready_.store(false, std::memory_order_relaxed);
+    mono_us_.store(0, std::memory_order_relaxed);
+    sdk_us_.store(0, std::memory_order_relaxed);
+}
+
+void MeetingOrigin::reset() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ready_.store(false, std::memory_order_relaxed);
+    sdk_us_.store(0, std::memory_order_relaxed);
+    epoch_.fetch_add(1, std::memory_order_release);
+}
+
+bool MeetingOrigin::mono_us(int64_t *out) const {
+    if (!ready_.load(std::memory_order_acquire)) {
+        return false;
+    }
+    *out = mono_us_.load(std::memory_order_relaxed);
+    return true;
+}
+
+int64_t MeetingOrigin::position_us(uint64_t sdk_ms, int64_t mono_us) {
+    if (!ready_.load(std::memory_order_acquire)) {
+        // Once per meeting, streams of other SDK threads may race for it.
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!ready_.load(std::memory_order_relaxed)) {
+            mono_us_.store(mono_us, std::memory_order_relaxed);
+            sdk_us_.store(static_cast<int64_t>(sdk_ms) * 1000, std::memory_order_relaxed);
+            ready_.store(true, std::memory_order_release);
+        }
+    }
+    int64_t origin_mono = mono_us_.load(std::memory_order_relaxed);
+    if (sdk_ms == 0) {
+        return mono_us - origin_mono;
+    }
+    int64_t origin_sdk = sdk_us_.load(std::memory_order_relaxed);
+    if (origin_sdk == 0) {
+        // The origin had no timestamp: anchor the SDK clock with the arrival time of this frame.
+        int64_t anchor = static_cast<int64_t>(sdk_ms) * 1000 - (mono_us - origin_mono);
+        if (sdk_us_.compare_exchange_strong(origin_sdk, anchor, std::memory_order_relaxed)) {
+            origin_sdk = anchor;
+        }
+    }
+    return static_cast<int64_t>(sdk_ms) * 1000 - origin_sdk;
+}
+
+int64_t StreamAligner::place(int64_t position_us, uint32_t epoch, unsigned int rate, int64_t tolerance_us, int64_t *gap, int64_t *skip) {
+    *gap = 0;
+    *skip = 0;
+    int64_t target = position_us > 0 ? (position_us * rate + 500000) / 1000000 : 0;
+    bool first = epoch != epoch_;
+    if (first) {
+        // First frame of the stream, the track is silent since sample 0.
+        epoch_ = epoch;
+        rate_ = rate;
+        next_ = 0;
+    } else if (rate != rate_) {
+        next_ = next_ * rate / rate_;
+        rate_ = rate;
+    }
+    int64_t tolerance = tolerance_us * rate / 1000000;
+    if (target > next_ + tolerance || (first && target > 0)) {
+        *gap = target - next_;
+        next_ = target;
+    } else if (target < next_ - tolerance) {
+        *skip = next_ - target;
+    }
+    return next_;
+}
@@ -0,0 +1,78 @@
+#ifndef _C_AUDIO_ALIGNER_H_
+#define _C_AUDIO_ALIGNER_H_
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+/// @brief Sample 0 of the aligned tracks, shared by the streams of a delegate.
+///
+/// The first frame of any stream sets the origin. Positions follow the SDK media clock,
+/// anchored with the first timestamped frame, and the arrival time for frames without timestamp.
+class MeetingOrigin {
+public:
+    MeetingOrigin();
+
+    /// @brief Forget the origin, the next frame of any stream becomes sample 0.
+    void reset();
+
+    /// @brief Position of a frame relative to sample 0. The first call sets the origin.
+    /// @param sdk_ms SDK media timestamp in milliseconds, 0 if unavailable.
+    /// @return Microseconds since sample 0.
+    int64_t position_us(uint64_t sdk_ms, int64_t mono_us);
+
+    /// @brief Incremented by reset(), aligners start over when it changes.
+    uint32_t epoch() const {
+        return epoch_.load(std::memory_order_acquire);
+    }
+
+    /// @brief Monotonic time of sample 0.
+    /// @return false while no frame set the origin.
+    bool mono_us(int64_t *out) const;
+
+private:
+    std::mutex mutex_;
+    std::atomic<uint32_t> epoch_;
+    std::atomic<bool> ready_;
+    std::atomic<int64_t> mono_us_;
+    /// SDK clock at sample 0 in microseconds, 0 until a frame carries a timestamp.
+    std::atomic<int64_t> sdk_us_;
+};
+
+/// @brief Sample position of one stream on the MeetingOrigin timeline.
+///
+/// Consecutive frames are kept contiguous while their timestamps agree with the samples
+/// delivered so far within a tolerance. A frame arriving later opens a gap of silence,
+/// a frame overlapping the samples already delivered loses its leading samples, so the
+/// stream never moves backwards. Only the thread delivering the stream may use it.
+class StreamAligner {
+public:
+    StreamAligner() {
+        reset();
+    }
+
+    void reset() {
+        epoch_ = UINT32_MAX;
+        rate_ = 0;
+        next_ = 0;
+    }
+
+    /// @brief Place a frame, advance() must follow with the samples actually delivered.
+    /// @param rate Sample rate of the delivered frame.
+    /// @param gap Silent samples between the end of the previous frame (or sample 0) and this frame.
+    /// @param skip Leading samples of the frame already covered by the previous frames.
+    /// @return The sample index of the first sample kept.
+    int64_t place(int64_t position_us, uint32_t epoch, unsigned int rate, int64_t tolerance_us, int64_t *gap, int64_t *skip);
+
+    /// @brief Account the samples delivered from the index returned by place().
+    void advance(int64_t end) {
+        next_ = end;
+    }
+
+private:
+    uint32_t epoch_;
+    unsigned int rate_;
+    int64_t next_;
+};
+
+#endif
@@ -0,0 +1,51 @@
+#include "c_audio_batch.h"
+
+#include <cstring>
+
+/// Payloads start on this boundary so float frames and markers can be read in place.
+constexpr size_t BATCH_PAYLOAD_ALIGN = 16;
+
+AudioBatch::AudioBatch() {
+    opened_.store(0, std::memory_order_relaxed);
+    held_.store(false, std::memory_order_relaxed);
+}
+
+void AudioBatch::append(const struct exported_audio_raw_data &data, uint32_t id, enum audio_stream_kind stream,
+                        enum audio_record_kind kind, const char *payload, uint32_t len) {
+    if (entries_.empty()) {
+        opened_.store(data.mono_time, std::memory_order_relaxed);
+    }
+    size_t offset = payload_.size();
+    payload_.resize(offset + ((len + BATCH_PAYLOAD_ALIGN - 1) & ~(BATCH_PAYLOAD_ALIGN - 1)));
+    if (len != 0) {
+        memcpy(payload_.data() + offset, payload, len);
+    }
+    bool interpreter = stream == AUDIO_STREAM_INTERPRETER;
+    struct audio_batch_entry entry = {
+        data: data,
+        user_id: interpreter ? 0 : id,
+        stream: stream,
+        kind: kind,
+        language_id: static_cast<uint16_t>(interpreter ? id : 0),
+    };
+    entry.data.data = nullptr;
+    entry.data.len = len;
+    entry.data.raw = nullptr;
+    entries_.push_back(entry);
+    offsets_.push_back(offset);
+}
+
+const struct audio_batch_entry *AudioBatch::seal(uint32_t *count) {
+    for (size_t i = 0; i < entries_.size(); i += 1) {
+        entries_[i].data.data = payload_.data() + offsets_[i];
+    }
+    *count = static_cast<uint32_t>(entries_.size());
+    return entries_.data();
+}
+
+void AudioBatch::clear() {
+    opened_.store(0, std::memory_order_release);
+    entries_.clear();
+    offsets_.clear();
+    payload_.clear();
+}
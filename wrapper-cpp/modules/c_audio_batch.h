@@ -0,0 +1,75 @@
+#ifndef _C_AUDIO_BATCH_H_
+#define _C_AUDIO_BATCH_H_
+
+#include "c_rawdata_audio_helper.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+/// @brief Records of one stream accumulated for a single call into Rust, see audio_helper_set_batch_window.
+///
+/// Payloads are copied into an arena which keeps its capacity across batches, so a stream in
+/// steady state does not allocate. Entry pointers are only resolved by seal(), once the arena
+/// stopped growing. The batch is used by whoever holds it: the SDK thread of the stream, or
+/// another thread delivering it once the stream went quiet.
+class AudioBatch {
+public:
+    AudioBatch();
+
+    /// @brief Take the batch, waiting for a delivery by another thread to finish. SDK thread of the stream only.
+    void hold() {
+        while (held_.exchange(true, std::memory_order_acquire)) {
+            std::this_thread::yield();
+        }
+    }
+
+    /// @brief Take the batch unless its stream or another thread has it.
+    bool try_hold() {
+        return !held_.exchange(true, std::memory_order_acquire);
+    }
+
+    void release() {
+        held_.store(false, std::memory_order_release);
+    }
+
+    /// @brief Whether nothing is pending nor being delivered, readable without holding the batch.
+    /// Only the SDK thread of the stream appends, so an idle batch stays idle for it.
+    bool idle() const {
+        // A batch emptied by clear() stays held until its delivery is over.
+        return opened_.load(std::memory_order_acquire) == 0 && !held_.load(std::memory_order_relaxed);
+    }
+
+    bool empty() const {
+        return entries_.empty();
+    }
+
+    /// @brief true when the first record is at least `window_us` older than `now_us`. Readable without holding the batch.
+    bool due(int64_t now_us, int64_t window_us) const {
+        int64_t opened = opened_.load(std::memory_order_relaxed);
+        return opened != 0 && now_us - opened >= window_us;
+    }
+
+    /// @brief Copy a record at the end of the batch.
+    /// @param id Sender of the record, or its language id on the interpreter stream.
+    void append(const struct exported_audio_raw_data &data, uint32_t id, enum audio_stream_kind stream,
+                enum audio_record_kind kind, const char *payload, uint32_t len);
+
+    /// @brief Resolve the payload pointers, the entries stay valid until clear().
+    const struct audio_batch_entry *seal(uint32_t *count);
+
+    void clear();
+
+private:
+    std::vector<struct audio_batch_entry> entries_;
+    /// Offset of the payload of each entry in `payload_`.
+    std::vector<size_t> offsets_;
+    std::vector<char> payload_;
+    /// Monotonic time of the first record, 0 while empty.
+    std::atomic<int64_t> opened_;
+    std::atomic<bool> held_;
+};
+
+#endif
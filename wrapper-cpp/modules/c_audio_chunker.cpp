@@ -0,0 +1,208 @@
+#include "c_audio_chunker.h"
+
+#include <algorithm>
+#include <cstring>
+
+AudioChunker::AudioChunker(unsigned int max_streams) {
+    max_streams_ = max_streams;
+    streams_ = new Stream[max_streams];
+    for (unsigned int i = 0; i < max_streams; i += 1) {
+        streams_[i].config = nullptr;
+    }
+    config_.store(nullptr, std::memory_order_relaxed);
+    windows_.store(0, std::memory_order_relaxed);
+    zero_copy_windows_.store(0, std::memory_order_relaxed);
+    copied_bytes_.store(0, std::memory_order_relaxed);
+    padded_windows_.store(0, std::memory_order_relaxed);
+    unchunked_frames_.store(0, std::memory_order_relaxed);
+}
+
+AudioChunker::~AudioChunker() {
+    delete[] streams_;
+}
+
+bool AudioChunker::configure(unsigned int window_ms, unsigned int overlap_ms, char *slab, size_t slot_bytes, unsigned int slots) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (window_ms == 0) {
+        config_.store(nullptr, std::memory_order_release);
+        return true;
+    }
+    if (overlap_ms >= window_ms || !slab || slot_bytes == 0 || slots == 0) {
+        return false;
+    }
+    Config *config = new Config {
+        window_ms: window_ms,
+        overlap_ms: overlap_ms,
+        slab: slab,
+        slot_bytes: slot_bytes,
+        slots: slots,
+    };
+    configs_.emplace_back(config);
+    config_.store(config, std::memory_order_release);
+    return true;
+}
+
+bool AudioChunker::begin(unsigned int index, const struct exported_audio_raw_data &data) {
+    const Config *config = config_.load(std::memory_order_acquire);
+    if (!config) {
+        return false;
+    }
+    if (index >= config->slots || index >= max_streams_) {
+        unchunked_frames_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    Stream &stream = streams_[index];
+    if (stream.config != config) {
+        stream.config = config;
+        stream.slot = config->slab + index * config->slot_bytes;
+        stream.fill = 0;
+        stream.shift = 0;
+        stream.next_index = -1;
+        stream.pad = false;
+    }
+    size_t sample_bytes = (data.format == AUDIO_SAMPLE_F32 ? sizeof(float) : sizeof(int16_t)) * data.channels;
+    size_t window = static_cast<size_t>(config->window_ms) * data.sample_rate / 1000;
+    size_t overlap = static_cast<size_t>(config->overlap_ms) * data.sample_rate / 1000;
+    if (window == 0 || overlap >= window || window * sample_bytes > config->slot_bytes) {
+        stream.fill = 0;
+        stream.shift = 0;
+        unchunked_frames_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    // Only meaningful with a pending window, `start` describes it.
+    bool interrupted = stream.fill != 0 &&
+                       (stream.start.format != data.format || stream.start.sample_rate != data.sample_rate ||
+                        stream.start.channels != data.channels ||
+                        (data.sample_index >= 0 && stream.next_index >= 0 && data.sample_index != stream.next_index));
+    stream.frame = data;
+    stream.frame_window_bytes = window * sample_bytes;
+    stream.frame_hop_bytes = (window - overlap) * sample_bytes;
+    stream.frame_sample_bytes = sample_bytes;
+    stream.consumed = 0;
+    stream.next_index = data.sample_index >= 0 ? data.sample_index + static_cast<int64_t>(data.len / sample_bytes) : -1;
+    if (interrupted) {
+        // The pending window keeps its shape, next() completes it before starting on the frame.
+        stream.pad = true;
+    } else {
+        adopt_frame_shape(stream);
+    }
+    return true;
+}
+
+bool AudioChunker::next(unsigned int index, struct exported_audio_raw_data *window) {
+    Stream &stream = streams_[index];
+    settle(stream);
+    if (stream.pad) {
+        stream.pad = false;
+        emit_padded(stream, window);
+        adopt_frame_shape(stream);
+        return true;
+    }
+    size_t left = stream.frame.len - stream.consumed;
+    char *cursor = stream.frame.data + stream.consumed;
+    if (stream.fill == 0) {
+        if (left >= stream.window_bytes) {
+            // In place: the window is a slice of the frame, SDK buffer included.
+            place(window, stream.frame, stream.consumed / stream.frame_bytes, cursor, stream.window_bytes);
+            window->raw = stream.frame.raw;
+            stream.consumed += stream.hop_bytes;
+            windows_.fetch_add(1, std::memory_order_relaxed);
+            zero_copy_windows_.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+        if (left != 0) {
+            stream.start = stream.frame;
+            stream.start_offset = stream.consumed / stream.frame_bytes;
+            memcpy(stream.slot, cursor, left);
+            stream.fill = left;
+            stream.consumed += left;
+            copied_bytes_.fetch_add(left, std::memory_order_relaxed);
+        }
+        return false;
+    }
+    size_t take = std::min(stream.window_bytes - stream.fill, left);
+    memcpy(stream.slot + stream.fill, cursor, take);
+    stream.fill += take;
+    stream.consumed += take;
+    copied_bytes_.fetch_add(take, std::memory_order_relaxed);
+    if (stream.fill < stream.window_bytes) {
+        return false;
+    }
+    place(window, stream.start, stream.start_offset, stream.slot, stream.window_bytes);
+    window->raw = nullptr;
+    windows_.fetch_add(1, std::memory_order_relaxed);
+    size_t keep = stream.window_bytes - stream.hop_bytes;
+    if (take >= keep) {
+        // The overlap is still in the frame, the next window can be handed out in place.
+        stream.consumed -= keep;
+        stream.fill = 0;
+    } else {
+        stream.shift = stream.hop_bytes;
+    }
+    return true;
+}
+
+bool AudioChunker::flush(unsigned int index, struct exported_audio_raw_data *window) {
+    const Config *config = config_.load(std::memory_order_acquire);
+    if (!config || index >= max_streams_ || streams_[index].config != config) {
+        return false;
+    }
+    Stream &stream = streams_[index];
+    settle(stream);
+    if (stream.fill == 0) {
+        return false;
+    }
+    emit_padded(stream, window);
+    return true;
+}
+
+void AudioChunker::settle(Stream &stream) {
+    if (stream.shift == 0) {
+        return;
+    }
+    // Deferred until now, the window handed out pointed into the slot.
+    memmove(stream.slot, stream.slot + stream.shift, stream.fill - stream.shift);
+    stream.fill -= stream.shift;
+    stream.start_offset += stream.shift / stream.frame_bytes;
+    stream.shift = 0;
+}
+
+void AudioChunker::emit_padded(Stream &stream, struct exported_audio_raw_data *window) {
+    // Zero bits are silence in both sample formats.
+    memset(stream.slot + stream.fill, 0, stream.window_bytes - stream.fill);
+    place(window, stream.start, stream.start_offset, stream.slot, stream.window_bytes);
+    window->raw = nullptr;
+    stream.fill = 0;
+    windows_.fetch_add(1, std::memory_order_relaxed);
+    padded_windows_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void AudioChunker::adopt_frame_shape(Stream &stream) {
+    stream.window_bytes = stream.frame_window_bytes;
+    stream.hop_bytes = stream.frame_hop_bytes;
+    stream.frame_bytes = stream.frame_sample_bytes;
+}
+
+void AudioChunker::place(struct exported_audio_raw_data *window, const struct exported_audio_raw_data &base,
+                         int64_t offset, char *data, size_t len) {
+    *window = base;
+    window->data = data;
+    window->len = static_cast<unsigned int>(len);
+    if (base.sample_rate != 0) {
+        window->time = base.time + offset * 1000000 / base.sample_rate;
+    }
+    if (base.sample_index >= 0) {
+        window->sample_index = base.sample_index + offset;
+    }
+}
+
+void AudioChunker::stats(struct audio_chunker_stats *out) const {
+    const Config *config = config_.load(std::memory_order_acquire);
+    out->windows = windows_.load(std::memory_order_relaxed);
+    out->zero_copy_windows = zero_copy_windows_.load(std::memory_order_relaxed);
+    out->copied_bytes = copied_bytes_.load(std::memory_order_relaxed);
+    out->padded_windows = padded_windows_.load(std::memory_order_relaxed);
+    out->unchunked_frames = unchunked_frames_.load(std::memory_order_relaxed);
+    out->window_ms = config ? config->window_ms : 0;
+    out->overlap_ms = config ? config->overlap_ms : 0;
+}
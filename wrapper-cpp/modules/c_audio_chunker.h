@@ -0,0 +1,99 @@
+#ifndef _C_AUDIO_CHUNKER_H_
+#define _C_AUDIO_CHUNKER_H_
+
+#include "c_rawdata_audio_helper.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/// @brief Re-frames delivered streams into fixed, optionally overlapping windows, see audio_helper_set_chunker.
+///
+/// Each stream owns a slot of the caller's slab. A window lying entirely inside the current frame
+/// is handed out in place, pointing into the frame, and only windows straddling two frames are
+/// assembled in the slot; the overlap is kept by stepping back into the frame when it is still
+/// there, by moving it to the front of the slot otherwise. When a stream is interrupted (format
+/// change, gap on the timeline, silence marker) the pending window is completed with zeros.
+/// A stream is only ever fed by one thread, configure() can be called from any thread.
+class AudioChunker {
+public:
+    explicit AudioChunker(unsigned int max_streams);
+    ~AudioChunker();
+    AudioChunker(const AudioChunker &) = delete;
+    AudioChunker &operator=(const AudioChunker &) = delete;
+
+    /// @brief Replace the settings, pending windows are dropped. A `window_ms` of 0 disables the chunker.
+    /// The previous slabs may still be read by a frame being chunked, the caller keeps them alive.
+    /// @return false if `overlap_ms` is not shorter than `window_ms` or the slab is missing.
+    bool configure(unsigned int window_ms, unsigned int overlap_ms, char *slab, size_t slot_bytes, unsigned int slots);
+
+    /// @brief Start chunking a frame of `stream`, the frame must stay valid until next() returns false.
+    /// @return false if the frame is to be delivered as is: chunking off, stream without slot or window larger than a slot.
+    bool begin(unsigned int stream, const struct exported_audio_raw_data &data);
+
+    /// @brief Next complete window of the frame given to begin(), valid until the next call.
+    bool next(unsigned int stream, struct exported_audio_raw_data *window);
+
+    /// @brief Complete the pending window of `stream` with zeros, e.g. before a silence marker.
+    /// @return false if nothing was pending.
+    bool flush(unsigned int stream, struct exported_audio_raw_data *window);
+
+    void stats(struct audio_chunker_stats *out) const;
+
+private:
+    struct Config {
+        unsigned int window_ms;
+        unsigned int overlap_ms;
+        char *slab;
+        size_t slot_bytes;
+        unsigned int slots;
+    };
+
+    struct Stream {
+        /// Settings the state below was built with, reset when they change.
+        const Config *config;
+        char *slot;
+        /// Shape of the pending window, in bytes.
+        size_t window_bytes;
+        size_t hop_bytes;
+        size_t frame_bytes;
+        size_t fill;
+        /// Bytes to drop from the front of the slot once the window handed out from it is consumed.
+        size_t shift;
+        /// Frame holding the first pending sample, and the position of that sample in it.
+        struct exported_audio_raw_data start;
+        int64_t start_offset;
+        /// Frame being chunked, with its own shape.
+        struct exported_audio_raw_data frame;
+        size_t frame_window_bytes;
+        size_t frame_hop_bytes;
+        size_t frame_sample_bytes;
+        size_t consumed;
+        /// Expected sample index of the next frame, -1 if unknown.
+        int64_t next_index;
+        bool pad;
+    };
+
+    void settle(Stream &stream);
+    void emit_padded(Stream &stream, struct exported_audio_raw_data *window);
+    void adopt_frame_shape(Stream &stream);
+    static void place(struct exported_audio_raw_data *window, const struct exported_audio_raw_data &base,
+                      int64_t offset, char *data, size_t len);
+
+    unsigned int max_streams_;
+    Stream *streams_;
+    std::atomic<const Config*> config_;
+    /// Every Config ever published, a frame may still be chunked with an old one.
+    std::vector<std::unique_ptr<Config>> configs_;
+    std::mutex mutex_;
+    std::atomic<uint64_t> windows_;
+    std::atomic<uint64_t> zero_copy_windows_;
+    std::atomic<uint64_t> copied_bytes_;
+    std::atomic<uint64_t> padded_windows_;
+    std::atomic<uint64_t> unchunked_frames_;
+};
+
+#endif
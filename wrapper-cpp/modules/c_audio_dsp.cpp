@@ -0,0 +1,472 @@
+#include "c_audio_dsp.h"
+#include "c_cpu_features.h"
+
+#include <cmath>
+
+#if WRAPPER_HAVE_X86_SIMD
+#include <immintrin.h>
+#endif
+
+static inline int16_t saturate_s16(float value) {
+    value = fminf(fmaxf(value, -32768.0f), 32767.0f);
+    return static_cast<int16_t>(lrintf(value));
+}
+
+static void s16_to_f32_scalar(const int16_t *in, float *out, size_t samples, float scale) {
+    for (size_t i = 0; i < samples; i += 1) {
+        out[i] = in[i] * scale;
+    }
+}
+
+static void f32_to_s16_scalar(const float *in, int16_t *out, size_t samples, float scale) {
+    for (size_t i = 0; i < samples; i += 1) {
+        out[i] = saturate_s16(in[i] * scale);
+    }
+}
+
+static void downmix_s16_scalar(const int16_t *in, int16_t *out, size_t frames) {
+    for (size_t i = 0; i < frames; i += 1) {
+        out[i] = static_cast<int16_t>((in[2 * i] + in[2 * i + 1]) >> 1);
+    }
+}
+
+static void downmix_f32_scalar(const float *in, float *out, size_t frames) {
+    for (size_t i = 0; i < frames; i += 1) {
+        out[i] = (in[2 * i] + in[2 * i + 1]) * 0.5f;
+    }
+}
+
+static void upmix_s16_scalar(const int16_t *in, int16_t *out, size_t frames) {
+    for (size_t i = 0; i < frames; i += 1) {
+        out[2 * i] = in[i];
+        out[2 * i + 1] = in[i];
+    }
+}
+
+static void gain_s16_scalar(const int16_t *in, int16_t *out, size_t samples, float gain) {
+    for (size_t i = 0; i < samples; i += 1) {
+        out[i] = saturate_s16(in[i] * gain);
+    }
+}
+
+static void gain_clip_f32_scalar(const float *in, float *out, size_t samples, float gain) {
+    for (size_t i = 0; i < samples; i += 1) {
+        out[i] = fminf(fmaxf(in[i] * gain, -1.0f), 1.0f);
+    }
+}
+
+static void mix_s16_scalar(int16_t *acc, const int16_t *in, size_t samples) {
+    for (size_t i = 0; i < samples; i += 1) {
+        int32_t sum = acc[i] + in[i];
+        acc[i] = static_cast<int16_t>(sum > 32767 ? 32767 : (sum < -32768 ? -32768 : sum));
+    }
+}
+
+static void s16_activity_scalar(const int16_t *in, size_t samples, unsigned int stride, struct pcm_activity *out) {
+    for (size_t i = 0; i < samples; i += 1) {
+        int32_t value = in[i];
+        out->energy += static_cast<uint64_t>(value * value);
+        uint32_t magnitude = static_cast<uint32_t>(value < 0 ? -value : value);
+        out->peak = magnitude > out->peak ? magnitude : out->peak;
+    }
+    for (size_t i = 0; i + stride < samples; i += 1) {
+        out->crossings += (in[i] ^ in[i + stride]) < 0;
+    }
+}
+
+static float dot_f32_scalar(const float *a, const float *b, size_t n) {
+    float sum = 0.0f;
+    for (size_t i = 0; i < n; i += 1) {
+        sum += a[i] * b[i];
+    }
+    return sum;
+}
+
+#if WRAPPER_HAVE_X86_SIMD
+
+// SSE4.2 is part of the x86-64-v2 baseline the wrapper is built for.
+
+static void s16_to_f32_sse4(const int16_t *in, float *out, size_t samples, float scale) {
+    const __m128 s = _mm_set1_ps(scale);
+    size_t i = 0;
+    for (; i + 8 <= samples; i += 8) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i));
+        __m128i lo = _mm_cvtepi16_epi32(v);
+        __m128i hi = _mm_cvtepi16_epi32(_mm_srli_si128(v, 8));
+        _mm_storeu_ps(out + i, _mm_mul_ps(_mm_cvtepi32_ps(lo), s));
+        _mm_storeu_ps(out + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(hi), s));
+    }
+    s16_to_f32_scalar(in + i, out + i, samples - i, scale);
+}
+
+static void f32_to_s16_sse4(const float *in, int16_t *out, size_t samples, float scale) {
+    const __m128 s = _mm_set1_ps(scale);
+    const __m128 lo_limit = _mm_set1_ps(-32768.0f);
+    const __m128 hi_limit = _mm_set1_ps(32767.0f);
+    size_t i = 0;
+    for (; i + 8 <= samples; i += 8) {
+        __m128 lo = _mm_mul_ps(_mm_loadu_ps(in + i), s);
+        __m128 hi = _mm_mul_ps(_mm_loadu_ps(in + i + 4), s);
+        lo = _mm_min_ps(_mm_max_ps(lo, lo_limit), hi_limit);
+        hi = _mm_min_ps(_mm_max_ps(hi, lo_limit), hi_limit);
+        __m128i packed = _mm_packs_epi32(_mm_cvtps_epi32(lo), _mm_cvtps_epi32(hi));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), packed);
+    }
+    f32_to_s16_scalar(in + i, out + i, samples - i, scale);
+}
+
+static void downmix_s16_sse4(const int16_t *in, int16_t *out, size_t frames) {
+    const __m128i ones = _mm_set1_epi16(1);
+    size_t i = 0;
+    for (; i + 8 <= frames; i += 8) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + 2 * i));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + 2 * i + 8));
+        a = _mm_srai_epi32(_mm_madd_epi16(a, ones), 1);
+        b = _mm_srai_epi32(_mm_madd_epi16(b, ones), 1);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), _mm_packs_epi32(a, b));
+    }
+    downmix_s16_scalar(in + 2 * i, out + i, frames - i);
+}
+
+static void downmix_f32_sse4(const float *in, float *out, size_t frames) {
+    const __m128 half = _mm_set1_ps(0.5f);
+    size_t i = 0;
+    for (; i + 4 <= frames; i += 4) {
+        __m128 a = _mm_loadu_ps(in + 2 * i);
+        __m128 b = _mm_loadu_ps(in + 2 * i + 4);
+        _mm_storeu_ps(out + i, _mm_mul_ps(_mm_hadd_ps(a, b), half));
+    }
+    downmix_f32_scalar(in + 2 * i, out + i, frames - i);
+}
+
+static void upmix_s16_sse4(const int16_t *in, int16_t *out, size_t frames) {
+    size_t i = 0;
+    for (; i + 8 <= frames; i += 8) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 2 * i), _mm_unpacklo_epi16(a, a));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 2 * i + 8), _mm_unpackhi_epi16(a, a));
+    }
+    upmix_s16_scalar(in + i, out + 2 * i, frames - i);
+}
+
+static void gain_s16_sse4(const int16_t *in, int16_t *out, size_t samples, float gain) {
+    const __m128 g = _mm_set1_ps(gain);
+    const __m128 lo_limit = _mm_set1_ps(-32768.0f);
+    const __m128 hi_limit = _mm_set1_ps(32767.0f);
+    size_t i = 0;
+    for (; i + 8 <= samples; i += 8) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i));
+        __m128 lo = _mm_mul_ps(_mm_cvtepi32_ps(_mm_cvtepi16_epi32(v)), g);
+        __m128 hi = _mm_mul_ps(_mm_cvtepi32_ps(_mm_cvtepi16_epi32(_mm_srli_si128(v, 8))), g);
+        // Clamp before converting: out of range floats convert to INT32_MIN.
+        lo = _mm_min_ps(_mm_max_ps(lo, lo_limit), hi_limit);
+        hi = _mm_min_ps(_mm_max_ps(hi, lo_limit), hi_limit);
+        __m128i packed = _mm_packs_epi32(_mm_cvtps_epi32(lo), _mm_cvtps_epi32(hi));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), packed);
+    }
+    gain_s16_scalar(in + i, out + i, samples - i, gain);
+}
+
+static void gain_clip_f32_sse4(const float *in, float *out, size_t samples, float gain) {
+    const __m128 g = _mm_set1_ps(gain);
+    const __m128 lo_limit = _mm_set1_ps(-1.0f);
+    const __m128 hi_limit = _mm_set1_ps(1.0f);
+    size_t i = 0;
+    for (; i + 4 <= samples; i += 4) {
+        __m128 v = _mm_mul_ps(_mm_loadu_ps(in + i), g);
+        _mm_storeu_ps(out + i, _mm_min_ps(_mm_max_ps(v, lo_limit), hi_limit));
+    }
+    gain_clip_f32_scalar(in + i, out + i, samples - i, gain);
+}
+
+static void mix_s16_sse4(int16_t *acc, const int16_t *in, size_t samples) {
+    size_t i = 0;
+    for (; i + 8 <= samples; i += 8) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(acc + i));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(acc + i), _mm_adds_epi16(a, b));
+    }
+    mix_s16_scalar(acc + i, in + i, samples - i);
+}
+
+static void s16_activity_sse4(const int16_t *in, size_t samples, unsigned int stride, struct pcm_activity *out) {
+    const __m128i zero = _mm_setzero_si128();
+    __m128i acc = _mm_setzero_si128();
+    __m128i peak = _mm_setzero_si128();
+    uint32_t count = 0;
+    size_t i = 0;
+    for (; i + 8 + stride <= samples; i += 8) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i));
+        __m128i next = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i + stride));
+        // Pairs of squares fit in 32 bits when read as unsigned, widen before accumulating.
+        __m128i squares = _mm_madd_epi16(v, v);
+        acc = _mm_add_epi64(acc, _mm_cvtepu32_epi64(squares));
+        acc = _mm_add_epi64(acc, _mm_cvtepu32_epi64(_mm_srli_si128(squares, 8)));
+        // |-32768| wraps to 0x8000, which is right once compared as unsigned.
+        peak = _mm_max_epu16(peak, _mm_abs_epi16(v));
+        __m128i changed = _mm_cmpgt_epi16(zero, _mm_xor_si128(v, next));
+        count += __builtin_popcount(_mm_movemask_epi8(changed)) / 2;
+    }
+    out->energy += static_cast<uint64_t>(_mm_extract_epi64(acc, 0)) + static_cast<uint64_t>(_mm_extract_epi64(acc, 1));
+    out->crossings += count;
+    // minpos finds the smallest lane, so search the complement for the largest.
+    uint32_t largest = 0xFFFF - _mm_extract_epi16(_mm_minpos_epu16(_mm_xor_si128(peak, _mm_set1_epi16(-1))), 0);
+    out->peak = largest > out->peak ? largest : out->peak;
+    s16_activity_scalar(in + i, samples - i, stride, out);
+}
+
+static float dot_f32_sse4(const float *a, const float *b, size_t n) {
+    __m128 acc0 = _mm_setzero_ps();
+    __m128 acc1 = _mm_setzero_ps();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+        acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(a + i + 4), _mm_loadu_ps(b + i + 4)));
+    }
+    __m128 acc = _mm_add_ps(acc0, acc1);
+    acc = _mm_hadd_ps(acc, acc);
+    acc = _mm_hadd_ps(acc, acc);
+    return _mm_cvtss_f32(acc) + dot_f32_scalar(a + i, b + i, n - i);
+}
+
+#define DSP_AVX2 __attribute__((target("avx2,fma")))
+
+DSP_AVX2 static void s16_to_f32_avx2(const int16_t *in, float *out, size_t samples, float scale) {
+    const __m256 s = _mm256_set1_ps(scale);
+    size_t i = 0;
+    for (; i + 16 <= samples; i += 16) {
+        __m256i lo = _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i)));
+        __m256i hi = _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i + 8)));
+        _mm256_storeu_ps(out + i, _mm256_mul_ps(_mm256_cvtepi32_ps(lo), s));
+        _mm256_storeu_ps(out + i + 8, _mm256_mul_ps(_mm256_cvtepi32_ps(hi), s));
+    }
+    s16_to_f32_sse4(in + i, out + i, samples - i, scale);
+}
+
+DSP_AVX2 static void f32_to_s16_avx2(const float *in, int16_t *out, size_t samples, float scale) {
+    const __m256 s = _mm256_set1_ps(scale);
+    const __m256 lo_limit = _mm256_set1_ps(-32768.0f);
+    const __m256 hi_limit = _mm256_set1_ps(32767.0f);
+    size_t i = 0;
+    for (; i + 16 <= samples; i += 16) {
+        __m256 lo = _mm256_mul_ps(_mm256_loadu_ps(in + i), s);
+        __m256 hi = _mm256_mul_ps(_mm256_loadu_ps(in + i + 8), s);
+        lo = _mm256_min_ps(_mm256_max_ps(lo, lo_limit), hi_limit);
+        hi = _mm256_min_ps(_mm256_max_ps(hi, lo_limit), hi_limit);
+        __m256i packed = _mm256_packs_epi32(_mm256_cvtps_epi32(lo), _mm256_cvtps_epi32(hi));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), _mm256_permute4x64_epi64(packed, 0xD8));
+    }
+    f32_to_s16_sse4(in + i, out + i, samples - i, scale);
+}
+
+DSP_AVX2 static void downmix_s16_avx2(const int16_t *in, int16_t *out, size_t frames) {
+    const __m256i ones = _mm256_set1_epi16(1);
+    size_t i = 0;
+    for (; i + 16 <= frames; i += 16) {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + 2 * i));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + 2 * i + 16));
+        a = _mm256_srai_epi32(_mm256_madd_epi16(a, ones), 1);
+        b = _mm256_srai_epi32(_mm256_madd_epi16(b, ones), 1);
+        // packs works per 128-bit lane, restore the sample order.
+        __m256i packed = _mm256_permute4x64_epi64(_mm256_packs_epi32(a, b), 0xD8);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), packed);
+    }
+    downmix_s16_sse4(in + 2 * i, out + i, frames - i);
+}
+
+DSP_AVX2 static void downmix_f32_avx2(const float *in, float *out, size_t frames) {
+    const __m256 half = _mm256_set1_ps(0.5f);
+    size_t i = 0;
+    for (; i + 8 <= frames; i += 8) {
+        __m256 a = _mm256_loadu_ps(in + 2 * i);
+        __m256 b = _mm256_loadu_ps(in + 2 * i + 8);
+        __m256d sum = _mm256_castps_pd(_mm256_hadd_ps(a, b));
+        __m256 ordered = _mm256_castpd_ps(_mm256_permute4x64_pd(sum, 0xD8));
+        _mm256_storeu_ps(out + i, _mm256_mul_ps(ordered, half));
+    }
+    downmix_f32_sse4(in + 2 * i, out + i, frames - i);
+}
+
+DSP_AVX2 static void upmix_s16_avx2(const int16_t *in, int16_t *out, size_t frames) {
+    size_t i = 0;
+    for (; i + 16 <= frames; i += 16) {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + i));
+        // unpack works per 128-bit lane, regroup the halves in sample order.
+        __m256i lo = _mm256_unpacklo_epi16(a, a);
+        __m256i hi = _mm256_unpackhi_epi16(a, a);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + 2 * i), _mm256_permute2x128_si256(lo, hi, 0x20));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + 2 * i + 16), _mm256_permute2x128_si256(lo, hi, 0x31));
+    }
+    upmix_s16_sse4(in + i, out + 2 * i, frames - i);
+}
+
+DSP_AVX2 static void gain_s16_avx2(const int16_t *in, int16_t *out, size_t samples, float gain) {
+    const __m256 g = _mm256_set1_ps(gain);
+    const __m256 lo_limit = _mm256_set1_ps(-32768.0f);
+    const __m256 hi_limit = _mm256_set1_ps(32767.0f);
+    size_t i = 0;
+    for (; i + 16 <= samples; i += 16) {
+        __m256i lo_i = _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i)));
+        __m256i hi_i = _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i + 8)));
+        __m256 lo = _mm256_mul_ps(_mm256_cvtepi32_ps(lo_i), g);
+        __m256 hi = _mm256_mul_ps(_mm256_cvtepi32_ps(hi_i), g);
+        lo = _mm256_min_ps(_mm256_max_ps(lo, lo_limit), hi_limit);
+        hi = _mm256_min_ps(_mm256_max_ps(hi, lo_limit), hi_limit);
+        __m256i packed = _mm256_packs_epi32(_mm256_cvtps_epi32(lo), _mm256_cvtps_epi32(hi));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), _mm256_permute4x64_epi64(packed, 0xD8));
+    }
+    gain_s16_sse4(in + i, out + i, samples - i, gain);
+}
+
+DSP_AVX2 static void gain_clip_f32_avx2(const float *in, float *out, size_t samples, float gain) {
+    const __m256 g = _mm256_set1_ps(gain);
+    const __m256 lo_limit = _mm256_set1_ps(-1.0f);
+    const __m256 hi_limit = _mm256_set1_ps(1.0f);
+    size_t i = 0;
+    for (; i + 8 <= samples; i += 8) {
+        __m256 v = _mm256_mul_ps(_mm256_loadu_ps(in + i), g);
+        _mm256_storeu_ps(out + i, _mm256_min_ps(_mm256_max_ps(v, lo_limit), hi_limit));
+    }
+    gain_clip_f32_sse4(in + i, out + i, samples - i, gain);
+}
+
+DSP_AVX2 static void mix_s16_avx2(int16_t *acc, const int16_t *in, size_t samples) {
+    size_t i = 0;
+    for (; i + 32 <= samples; i += 32) {
+        __m256i a0 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(acc + i));
+        __m256i a1 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(acc + i + 16));
+        __m256i b0 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + i));
+        __m256i b1 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + i + 16));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(acc + i), _mm256_adds_epi16(a0, b0));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(acc + i + 16), _mm256_adds_epi16(a1, b1));
+    }
+    mix_s16_sse4(acc + i, in + i, samples - i);
+}
+
+DSP_AVX2 static void s16_activity_avx2(const int16_t *in, size_t samples, unsigned int stride, struct pcm_activity *out) {
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i acc = _mm256_setzero_si256();
+    __m256i peak = _mm256_setzero_si256();
+    uint32_t count = 0;
+    size_t i = 0;
+    for (; i + 16 + stride <= samples; i += 16) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + i));
+        __m256i next = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + i + stride));
+        __m256i squares = _mm256_madd_epi16(v, v);
+        acc = _mm256_add_epi64(acc, _mm256_cvtepu32_epi64(_mm256_castsi256_si128(squares)));
+        acc = _mm256_add_epi64(acc, _mm256_cvtepu32_epi64(_mm256_extracti128_si256(squares, 1)));
+        peak = _mm256_max_epu16(peak, _mm256_abs_epi16(v));
+        __m256i changed = _mm256_cmpgt_epi16(zero, _mm256_xor_si256(v, next));
+        count += __builtin_popcount(_mm256_movemask_epi8(changed)) / 2;
+    }
+    __m128i sum = _mm_add_epi64(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+    out->energy += static_cast<uint64_t>(_mm_extract_epi64(sum, 0)) + static_cast<uint64_t>(_mm_extract_epi64(sum, 1));
+    out->crossings += count;
+    __m128i peak128 = _mm_max_epu16(_mm256_castsi256_si128(peak), _mm256_extracti128_si256(peak, 1));
+    uint32_t largest = 0xFFFF - _mm_extract_epi16(_mm_minpos_epu16(_mm_xor_si128(peak128, _mm_set1_epi16(-1))), 0);
+    out->peak = largest > out->peak ? largest : out->peak;
+    s16_activity_sse4(in + i, samples - i, stride, out);
+}
+
+DSP_AVX2 static float dot_f32_avx2(const float *a, const float *b, size_t n) {
+    __m256 acc0 = _mm256_setzero_ps();
+    __m256 acc1 = _mm256_setzero_ps();
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), acc0);
+        acc1 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(b + i + 8), acc1);
+    }
+    __m256 acc = _mm256_add_ps(acc0, acc1);
+    __m128 sum = _mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1));
+    sum = _mm_hadd_ps(sum, sum);
+    sum = _mm_hadd_ps(sum, sum);
+    return _mm_cvtss_f32(sum) + dot_f32_sse4(a + i, b + i, n - i);
+}
+
+#endif
+
+struct DspKernels {
+    void (*s16_to_f32)(const int16_t *, float *, size_t, float);
+    void (*f32_to_s16)(const float *, int16_t *, size_t, float);
+    void (*downmix_s16)(const int16_t *, int16_t *, size_t);
+    void (*downmix_f32)(const float *, float *, size_t);
+    void (*upmix_s16)(const int16_t *, int16_t *, size_t);
+    void (*gain_s16)(const int16_t *, int16_t *, size_t, float);
+    void (*gain_clip_f32)(const float *, float *, size_t, float);
+    void (*mix_s16)(int16_t *, const int16_t *, size_t);
+    void (*s16_activity)(const int16_t *, size_t, unsigned int, struct pcm_activity *);
+    float (*dot_f32)(const float *, const float *, size_t);
+    const char *name;
+};
+
+static DspKernels select_kernels() {
+#if WRAPPER_HAVE_X86_SIMD
+    if (cpu_has_avx2()) {
+        return {
+            s16_to_f32_avx2, f32_to_s16_avx2, downmix_s16_avx2, downmix_f32_avx2, upmix_s16_avx2,
+            gain_s16_avx2, gain_clip_f32_avx2, mix_s16_avx2, s16_activity_avx2, dot_f32_avx2, "avx2",
+        };
+    }
+    return {
+        s16_to_f32_sse4, f32_to_s16_sse4, downmix_s16_sse4, downmix_f32_sse4, upmix_s16_sse4,
+        gain_s16_sse4, gain_clip_f32_sse4, mix_s16_sse4, s16_activity_sse4, dot_f32_sse4, "sse4.2",
+    };
+#else
+    return {
+        s16_to_f32_scalar, f32_to_s16_scalar, downmix_s16_scalar, downmix_f32_scalar, upmix_s16_scalar,
+        gain_s16_scalar, gain_clip_f32_scalar, mix_s16_scalar, s16_activity_scalar, dot_f32_scalar, "scalar",
+    };
+#endif
+}
+
+static const DspKernels &kernels() {
+    static const DspKernels selected = select_kernels();
+    return selected;
+}
+
+void dsp_s16_to_f32(const int16_t *in, float *out, size_t samples, float scale) {
+    kernels().s16_to_f32(in, out, samples, scale);
+}
+
+void dsp_f32_to_s16(const float *in, int16_t *out, size_t samples, float scale) {
+    kernels().f32_to_s16(in, out, samples, scale);
+}
+
+void dsp_downmix_s16(const int16_t *in, int16_t *out, size_t frames) {
+    kernels().downmix_s16(in, out, frames);
+}
+
+void dsp_downmix_f32(const float *in, float *out, size_t frames) {
+    kernels().downmix_f32(in, out, frames);
+}
+
+void dsp_upmix_s16(const int16_t *in, int16_t *out, size_t frames) {
+    kernels().upmix_s16(in, out, frames);
+}
+
+void dsp_gain_s16(const int16_t *in, int16_t *out, size_t samples, float gain) {
+    kernels().gain_s16(in, out, samples, gain);
+}
+
+void dsp_gain_clip_f32(const float *in, float *out, size_t samples, float gain) {
+    kernels().gain_clip_f32(in, out, samples, gain);
+}
+
+void dsp_mix_s16(int16_t *acc, const int16_t *in, size_t samples) {
+    kernels().mix_s16(acc, in, samples);
+}
+
+void dsp_s16_activity(const int16_t *in, size_t samples, unsigned int stride, struct pcm_activity *out) {
+    out->energy = 0;
+    out->crossings = 0;
+    out->peak = 0;
+    kernels().s16_activity(in, samples, stride, out);
+}
+
+float dsp_dot_f32(const float *a, const float *b, size_t n) {
+    return kernels().dot_f32(a, b, n);
+}
+
+const char *dsp_kernel_name() {
+    return kernels().name;
+}
@@ -0,0 +1,55 @@
+#ifndef _C_AUDIO_DSP_H_
+#define _C_AUDIO_DSP_H_
+
+#include <cstddef>
+#include <cstdint>
+
+/// @brief Vectorized PCM kernels, dispatched once to AVX2 or SSE4.2 at startup.
+///
+/// Kernels whose input and output share a type accept `out == in`. Stereo buffers are interleaved L/R.
+
+/// @brief out[i] = in[i] * scale. Use a scale of 1/32768 to get [-1, 1) floats.
+void dsp_s16_to_f32(const int16_t *in, float *out, size_t samples, float scale);
+
+/// @brief out[i] = in[i] * scale, rounded to nearest and saturated to the int16 range.
+void dsp_f32_to_s16(const float *in, int16_t *out, size_t samples, float scale);
+
+/// @brief Average the two channels of `frames` interleaved stereo frames.
+void dsp_downmix_s16(const int16_t *in, int16_t *out, size_t frames);
+
+/// @brief Average the two channels of `frames` interleaved stereo frames.
+void dsp_downmix_f32(const float *in, float *out, size_t frames);
+
+/// @brief Duplicate `frames` mono samples into interleaved stereo, `out` holds 2 * frames samples and differs from `in`.
+void dsp_upmix_s16(const int16_t *in, int16_t *out, size_t frames);
+
+/// @brief out[i] = in[i] * gain, rounded to nearest and saturated to the int16 range.
+void dsp_gain_s16(const int16_t *in, int16_t *out, size_t samples, float gain);
+
+/// @brief out[i] = in[i] * gain, clipped to [-1, 1].
+void dsp_gain_clip_f32(const float *in, float *out, size_t samples, float gain);
+
+/// @brief acc[i] += in[i], saturated to the int16 range.
+void dsp_mix_s16(int16_t *acc, const int16_t *in, size_t samples);
+
+/// @brief Activity measures of a 16-bit frame, for voice detection and level metering.
+struct pcm_activity {
+    /// Sum of squared samples.
+    uint64_t energy;
+    /// Sign changes between consecutive samples of a channel.
+    uint32_t crossings;
+    /// Largest sample magnitude, up to 32768.
+    uint32_t peak;
+};
+
+/// @brief Measure the activity of 16-bit PCM in one pass.
+/// @param stride Distance between consecutive samples of a channel, the channel count of interleaved PCM.
+void dsp_s16_activity(const int16_t *in, size_t samples, unsigned int stride, struct pcm_activity *out);
+
+/// @brief Dot product of two float vectors, the inner loop of FIR filters.
+float dsp_dot_f32(const float *a, const float *b, size_t n);
+
+/// @brief Name of the selected kernel set, "avx2", "sse4.2" or "scalar".
+const char *dsp_kernel_name();
+
+#endif
@@ -0,0 +1,515 @@
+#include "c_audio_echo_canceller.h"
+#include "c_audio_dsp.h"
+#include "c_media_timeline.h"
+
+#include <algorithm>
+#include <cmath>
+
+/// Rate of the delay estimate.
+constexpr unsigned int ECHO_ESTIMATE_RATE = 8000;
+/// Mixed frames between two delay estimates.
+constexpr unsigned int ECHO_ESTIMATE_FRAMES = 50;
+/// Reference accepted ahead of real time, in seconds: audio sent faster than it plays.
+constexpr unsigned int ECHO_AHEAD_S = 2;
+/// Lateness of a send still played right after the previous one, the SDK buffers that much.
+constexpr unsigned int ECHO_SEND_JITTER_MS = 20;
+/// Mean power of the reference under which the bot is considered silent.
+constexpr double ECHO_REFERENCE_FLOOR = 1e-7;
+/// Correlation peak over the mean of the searched lags from which a delay is trusted.
+constexpr float ECHO_PEAK_RATIO = 8.0f;
+/// A mixed frame is double talk when its energy exceeds the echo modeled by the converged filter this much.
+constexpr double ECHO_DOUBLE_TALK_RATIO = 2.0;
+/// Double talk frames without one the filter cancels after which it is considered lost.
+constexpr unsigned int ECHO_DOUBLE_TALK_MAX_FRAMES = 300;
+/// Input over residual energy of a frame from which the filter is considered converged.
+constexpr double ECHO_CONVERGED_RATIO = 10.0;
+constexpr float ECHO_NLMS_STEP = 0.3f;
+/// Share of the mean reference power of a frame added to the power of each filter input.
+constexpr float ECHO_NLMS_REGULARIZATION = 0.1f;
+/// Loss of the background filter over the foreground one, relative to their disagreement, from which it has diverged.
+constexpr double ECHO_DIVERGED_RATIO = 4.0;
+/// Mixed frames the ERLE is measured over.
+constexpr unsigned int ECHO_ERLE_FRAMES = 100;
+
+static size_t next_power_of_two(size_t n) {
+    size_t size = 1;
+    while (size < n) {
+        size <<= 1;
+    }
+    return size;
+}
+
+void EchoCanceller::FftPlan::init(size_t fft_size) {
+    size = fft_size;
+    unsigned int bits = 0;
+    while ((static_cast<size_t>(1) << bits) < size) {
+        bits += 1;
+    }
+    reversed.resize(size);
+    for (size_t i = 0; i < size; i += 1) {
+        uint32_t r = 0;
+        for (unsigned int b = 0; b < bits; b += 1) {
+            r |= ((i >> b) & 1) << (bits - 1 - b);
+        }
+        reversed[i] = r;
+    }
+    twiddles.resize(size / 2);
+    for (size_t i = 0; i < size / 2; i += 1) {
+        double angle = -2.0 * M_PI * static_cast<double>(i) / static_cast<double>(size);
+        twiddles[i] = std::complex<float>(static_cast<float>(cos(angle)), static_cast<float>(sin(angle)));
+    }
+}
+
+void EchoCanceller::FftPlan::forward(std::complex<float> *data) const {
+    transform(data, false);
+}
+
+/// Unscaled, only the position of the correlation peak matters.
+void EchoCanceller::FftPlan::inverse(std::complex<float> *data) const {
+    transform(data, true);
+}
+
+void EchoCanceller::FftPlan::transform(std::complex<float> *data, bool inverse) const {
+    for (size_t i = 0; i < size; i += 1) {
+        if (i < reversed[i]) {
+            std::swap(data[i], data[reversed[i]]);
+        }
+    }
+    for (size_t len = 2; len <= size; len <<= 1) {
+        size_t half = len / 2;
+        size_t step = size / len;
+        for (size_t start = 0; start < size; start += len) {
+            for (size_t j = 0; j < half; j += 1) {
+                std::complex<float> w = inverse ? std::conj(twiddles[j * step]) : twiddles[j * step];
+                std::complex<float> odd = w * data[start + j + half];
+                data[start + j + half] = data[start + j] - odd;
+                data[start + j] += odd;
+            }
+        }
+    }
+}
+
+EchoCanceller::EchoCanceller() {
+    enabled_.store(false, std::memory_order_relaxed);
+    generation_.store(0, std::memory_order_relaxed);
+    allocated_ = false;
+    rate_ = 0;
+    taps_ = 0;
+    decimation_ = 1;
+    max_lag_ = 0;
+    epoch_us_ = 0;
+    reference_mask_ = 0;
+    written_.store(0, std::memory_order_relaxed);
+    seen_generation_ = 0;
+    history_mask_ = 0;
+    fft_.size = 0;
+    reset_state();
+    frames_.store(0, std::memory_order_relaxed);
+    bypassed_frames_.store(0, std::memory_order_relaxed);
+    reference_samples_.store(0, std::memory_order_relaxed);
+    dropped_reference_samples_.store(0, std::memory_order_relaxed);
+    delay_estimates_.store(0, std::memory_order_relaxed);
+    double_talk_frames_.store(0, std::memory_order_relaxed);
+    max_frame_us_.store(0, std::memory_order_relaxed);
+    delay_us_.store(-1, std::memory_order_relaxed);
+    erle_db_.store(0.0f, std::memory_order_relaxed);
+}
+
+bool EchoCanceller::configure(bool enabled, unsigned int sample_rate, unsigned int max_delay_ms, unsigned int taps) {
+    if (sample_rate < ECHO_ESTIMATE_RATE || sample_rate > 48000 || sample_rate % ECHO_ESTIMATE_RATE != 0) {
+        return false;
+    }
+    if (max_delay_ms < 10 || max_delay_ms > 2000 || taps < 32 || taps > 1024) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(reference_mutex_);
+    if (enabled && !allocated_) {
+        // Buffers are kept once allocated: the mixed thread may still be filtering when the canceller is turned off.
+        allocate(sample_rate, max_delay_ms, taps);
+        allocated_ = true;
+    }
+    if (enabled && !enabled_.load(std::memory_order_relaxed)) {
+        // The mixed thread starts over from its next frame.
+        generation_.fetch_add(1, std::memory_order_release);
+        delay_us_.store(-1, std::memory_order_relaxed);
+    }
+    enabled_.store(enabled, std::memory_order_release);
+    return true;
+}
+
+void EchoCanceller::allocate(unsigned int sample_rate, unsigned int max_delay_ms, unsigned int taps) {
+    rate_ = sample_rate;
+    taps_ = taps;
+    decimation_ = sample_rate / ECHO_ESTIMATE_RATE;
+    max_lag_ = static_cast<size_t>(max_delay_ms) * ECHO_ESTIMATE_RATE / 1000;
+    epoch_us_ = monotonic_us();
+
+    // The mixed block fills what the FFT has left once the lags are covered, about a second.
+    size_t fft_size = next_power_of_two(2 * max_lag_ < 4096 ? 4096 : 2 * max_lag_);
+    fft_.init(fft_size);
+    spectrum_mixed_.resize(fft_size);
+    spectrum_reference_.resize(fft_size);
+    reference_block_.resize(fft_size * decimation_);
+    size_t block_samples = (fft_size - max_lag_) * decimation_;
+
+    // Frames are at most 100 ms.
+    history_.assign(next_power_of_two(block_samples + sample_rate / 10), 0.0f);
+    history_mask_ = history_.size() - 1;
+    // Reads reach back the longest delay and a block, writes go ECHO_AHEAD_S ahead of real time:
+    // with twice that, a write never lands on a sample being read.
+    size_t reach = max_lag_ * decimation_ + block_samples + static_cast<size_t>(ECHO_AHEAD_S) * sample_rate;
+    reference_.assign(next_power_of_two(2 * reach), 0.0f);
+    reference_mask_ = reference_.size() - 1;
+    written_.store(timeline_position(epoch_us_), std::memory_order_release);
+    weights_.assign(taps, 0.0f);
+    foreground_.assign(taps, 0.0f);
+}
+
+void EchoCanceller::reset_state() {
+    mixed_position_ = -1;
+    delay_ = -1;
+    candidate_ = -1;
+    converged_ = false;
+    double_talk_run_ = 0;
+    double_talk_position_ = -1;
+    std::fill(weights_.begin(), weights_.end(), 0.0f);
+    std::fill(foreground_.begin(), foreground_.end(), 0.0f);
+    stage_ = STAGE_IDLE;
+    frames_since_estimate_ = 0;
+    snapshot_end_ = 0;
+    history_start_ = -1;
+    echo_in_energy_ = 0.0;
+    echo_out_energy_ = 0.0;
+    echo_frames_ = 0;
+}
+
+int64_t EchoCanceller::timeline_position(int64_t mono_us) const {
+    return (mono_us - epoch_us_) * static_cast<int64_t>(rate_) / 1000000;
+}
+
+void EchoCanceller::reference(const char *data, size_t len, unsigned int sample_rate, unsigned int channels) {
+    if (!enabled() || sample_rate == 0 || channels == 0 || channels > 2) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(reference_mutex_);
+    size_t samples = len / sizeof(int16_t);
+    size_t frames = samples / channels;
+    size_t max_frames = sample_rate != rate_ ? AudioResampler::max_output(frames, sample_rate, rate_) : 0;
+    if (reference_work_.size() < samples + max_frames) {
+        reference_work_.resize(samples + max_frames);
+    }
+    float *pcm = reference_work_.data();
+    dsp_s16_to_f32(reinterpret_cast<const int16_t*>(data), pcm, samples, 1.0f / 32768.0f);
+    if (channels == 2) {
+        dsp_downmix_f32(pcm, pcm, frames);
+    }
+    size_t count = frames;
+    if (sample_rate != rate_) {
+        count = reference_resampler_.process(pcm, frames, 1, sample_rate, rate_, pcm + samples);
+        pcm += samples;
+    }
+
+    // Played where the previous send ends, or now if the mic ran dry in between.
+    int64_t written = written_.load(std::memory_order_relaxed);
+    int64_t now = timeline_position(monotonic_us());
+    int64_t jitter = static_cast<int64_t>(rate_) * ECHO_SEND_JITTER_MS / 1000;
+    int64_t start = written + jitter >= now ? written : now;
+    int64_t limit = now + static_cast<int64_t>(ECHO_AHEAD_S) * rate_;
+    size_t keep = start >= limit ? 0 : (start + static_cast<int64_t>(count) > limit ? static_cast<size_t>(limit - start) : count);
+    int64_t gap_start = start - written > static_cast<int64_t>(reference_.size()) ? start - static_cast<int64_t>(reference_.size()) : written;
+    for (int64_t position = gap_start; position < start; position += 1) {
+        reference_[position & reference_mask_] = 0.0f;
+    }
+    for (size_t i = 0; i < keep; i += 1) {
+        reference_[(start + i) & reference_mask_] = pcm[i];
+    }
+    written_.store(start + keep, std::memory_order_release);
+    reference_samples_.fetch_add(keep, std::memory_order_relaxed);
+    if (keep < count) {
+        dropped_reference_samples_.fetch_add(count - keep, std::memory_order_relaxed);
+    }
+}
+
+void EchoCanceller::read_reference(int64_t start, float *out, size_t count, int64_t written) const {
+    int64_t oldest = written - static_cast<int64_t>(reference_.size());
+    for (size_t i = 0; i < count; i += 1) {
+        int64_t position = start + static_cast<int64_t>(i);
+        out[i] = position >= 0 && position >= oldest && position < written ? reference_[position & reference_mask_] : 0.0f;
+    }
+}
+
+bool EchoCanceller::process(struct exported_audio_raw_data &data) {
+    int64_t began = monotonic_us();
+    unsigned int generation = generation_.load(std::memory_order_acquire);
+    if (generation != seen_generation_) {
+        seen_generation_ = generation;
+        reset_state();
+    }
+    if (data.format != AUDIO_SAMPLE_S16 || data.channels != 1 || data.sample_rate != rate_ || data.len < sizeof(int16_t)) {
+        bypassed_frames_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    size_t samples = data.len / sizeof(int16_t);
+    if (samples > history_.size() / 2) {
+        bypassed_frames_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    // Arrival times jitter, frames are laid end to end unless they drift more than 100 ms away from the clock.
+    int64_t position = timeline_position(data.mono_time) - static_cast<int64_t>(samples);
+    if (mixed_position_ < 0 || llabs(position - mixed_position_) > static_cast<int64_t>(rate_ / 10)) {
+        mixed_position_ = position;
+        if (history_start_ < 0) {
+            history_start_ = position;
+        }
+    }
+    if (input_.size() < samples) {
+        input_.resize(samples);
+        residual_.resize(samples);
+        output_.resize(samples);
+    }
+    float *in = input_.data();
+    dsp_s16_to_f32(reinterpret_cast<const int16_t*>(data.data), in, samples, 1.0f / 32768.0f);
+    for (size_t i = 0; i < samples; i += 1) {
+        history_[(mixed_position_ + i) & history_mask_] = in[i];
+    }
+
+    bool filtered = false;
+    if (delay_ >= 0) {
+        // segment[i + k] feeds tap k of output sample i, the center tap sits on the estimated delay.
+        size_t taps = taps_;
+        if (segment_.size() < samples + taps) {
+            segment_.resize(samples + taps);
+        }
+        float *segment = segment_.data();
+        int64_t written = written_.load(std::memory_order_acquire);
+        read_reference(mixed_position_ - delay_ - static_cast<int64_t>(taps / 2), segment, samples + taps, written);
+        float *residual = residual_.data();
+        float *foreground = foreground_.data();
+        double reference_energy = dsp_dot_f32(segment, segment, samples + taps);
+        bool active = reference_energy > ECHO_REFERENCE_FLOOR * static_cast<double>(samples + taps);
+        double in_energy = 0.0;
+        double echo_energy = 0.0;
+        double foreground_energy = 0.0;
+        for (size_t i = 0; i < samples; i += 1) {
+            float echo = dsp_dot_f32(foreground, segment + i, taps);
+            residual[i] = in[i] - echo;
+            in_energy += static_cast<double>(in[i]) * in[i];
+            echo_energy += static_cast<double>(echo) * echo;
+            foreground_energy += static_cast<double>(residual[i]) * residual[i];
+        }
+
+        // Once the path is known, a frame much louder than its echo is someone talking over the bot.
+        // Seconds of it without a single frame the filter cancels mean the path itself changed, it
+        // is learned again and the delay estimated regardless.
+        bool double_talk = active && converged_ && in_energy > ECHO_DOUBLE_TALK_RATIO * echo_energy;
+        bool cancelled = foreground_energy * ECHO_CONVERGED_RATIO < in_energy;
+        if (double_talk) {
+            double_talk_frames_.fetch_add(1, std::memory_order_relaxed);
+            double_talk_position_ = mixed_position_ + static_cast<int64_t>(samples);
+            double_talk_run_ += 1;
+            if (double_talk_run_ == ECHO_DOUBLE_TALK_MAX_FRAMES) {
+                converged_ = false;
+                double_talk_position_ = -1;
+                double_talk = false;
+            }
+        } else if (active && cancelled) {
+            double_talk_run_ = 0;
+        }
+        bool adapt = active && !double_talk;
+        if (adapt) {
+            // Two-path filter: the background adapts, the foreground subtracting the echo only takes
+            // its weights once they cancel better, so a background diverging on undetected double
+            // talk never reaches the output.
+            float *background = weights_.data();
+            // Regularized by a share of the frame power, speech dips to nothing between syllables.
+            float norm = dsp_dot_f32(segment, segment, taps);
+            float regularization = static_cast<float>(taps) * (1e-6f + ECHO_NLMS_REGULARIZATION *
+                static_cast<float>(reference_energy / static_cast<double>(samples + taps)));
+            double background_energy = 0.0;
+            double difference_energy = 0.0;
+            for (size_t i = 0; i < samples; i += 1) {
+                const float *x = segment + i;
+                float error = in[i] - dsp_dot_f32(background, x, taps);
+                float step = ECHO_NLMS_STEP * error / (norm + regularization);
+                for (size_t k = 0; k < taps; k += 1) {
+                    background[k] += step * x[k];
+                }
+                background_energy += static_cast<double>(error) * error;
+                difference_energy += static_cast<double>(residual[i] - error) * (residual[i] - error);
+                // Slide the input power to the vector of the next sample.
+                norm += x[taps] * x[taps] - x[0] * x[0];
+                if (norm < 0.0f) {
+                    norm = 0.0f;
+                }
+            }
+            // The gain must outweigh how far the filters disagree: a background fitting someone else's
+            // speech cancels a little more, but its output moves a lot.
+            double gain = foreground_energy - background_energy;
+            double signed_gain = gain * std::fabs(gain);
+            double disagreement = foreground_energy * difference_energy;
+            if (signed_gain > disagreement) {
+                std::copy(weights_.begin(), weights_.end(), foreground_.begin());
+            } else if (-signed_gain > ECHO_DIVERGED_RATIO * disagreement) {
+                std::copy(foreground_.begin(), foreground_.end(), weights_.begin());
+            }
+            if (cancelled) {
+                converged_ = true;
+            }
+            echo_in_energy_ += in_energy;
+            echo_out_energy_ += foreground_energy;
+            echo_frames_ += 1;
+            if (echo_frames_ == ECHO_ERLE_FRAMES) {
+                if (echo_out_energy_ > 0.0) {
+                    erle_db_.store(static_cast<float>(10.0 * log10(echo_in_energy_ / echo_out_energy_)), std::memory_order_relaxed);
+                }
+                echo_in_energy_ = 0.0;
+                echo_out_energy_ = 0.0;
+                echo_frames_ = 0;
+            }
+        }
+        // Never louder than no canceller at all, e.g. while the filter learns a new path.
+        dsp_f32_to_s16(foreground_energy > in_energy ? in : residual, output_.data(), samples, 32768.0f);
+        data.data = reinterpret_cast<char*>(output_.data());
+        data.raw = nullptr;
+        filtered = true;
+    }
+    mixed_position_ += samples;
+    run_stage();
+
+    if (filtered) {
+        frames_.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        bypassed_frames_.fetch_add(1, std::memory_order_relaxed);
+    }
+    int64_t elapsed = monotonic_us() - began;
+    if (elapsed > max_frame_us_.load(std::memory_order_relaxed)) {
+        max_frame_us_.store(elapsed, std::memory_order_relaxed);
+    }
+    return filtered;
+}
+
+void EchoCanceller::run_stage() {
+    size_t fft_size = fft_.size;
+    size_t block = fft_size - max_lag_;
+    size_t block_samples = block * decimation_;
+    float scale = 1.0f / static_cast<float>(decimation_);
+    switch (stage_) {
+    case STAGE_IDLE: {
+        frames_since_estimate_ += 1;
+        if (frames_since_estimate_ < ECHO_ESTIMATE_FRAMES || mixed_position_ - history_start_ < static_cast<int64_t>(block_samples)) {
+            return;
+        }
+        frames_since_estimate_ = 0;
+        snapshot_end_ = mixed_position_;
+        stage_ = STAGE_MIXED;
+        return;
+    }
+    case STAGE_MIXED: {
+        // Box-car decimation, the correlation only needs the speech band.
+        int64_t start = snapshot_end_ - static_cast<int64_t>(block_samples);
+        for (size_t i = 0; i < block; i += 1) {
+            float sum = 0.0f;
+            for (unsigned int j = 0; j < decimation_; j += 1) {
+                sum += history_[(start + i * decimation_ + j) & history_mask_];
+            }
+            spectrum_mixed_[i] = std::complex<float>(sum * scale, 0.0f);
+        }
+        std::fill(spectrum_mixed_.begin() + block, spectrum_mixed_.end(), std::complex<float>(0.0f, 0.0f));
+        fft_.forward(spectrum_mixed_.data());
+        stage_ = STAGE_REFERENCE;
+        return;
+    }
+    case STAGE_REFERENCE: {
+        // The reference starts the longest delay before the mixed block.
+        int64_t start = snapshot_end_ - static_cast<int64_t>(block_samples + max_lag_ * decimation_);
+        float *pcm = reference_block_.data();
+        read_reference(start, pcm, fft_size * decimation_, written_.load(std::memory_order_acquire));
+        double energy = 0.0;
+        for (size_t i = 0; i < fft_size; i += 1) {
+            float sum = 0.0f;
+            for (unsigned int j = 0; j < decimation_; j += 1) {
+                sum += pcm[i * decimation_ + j];
+            }
+            sum *= scale;
+            energy += static_cast<double>(sum) * sum;
+            spectrum_reference_[i] = std::complex<float>(sum, 0.0f);
+        }
+        if (energy < ECHO_REFERENCE_FLOOR * static_cast<double>(fft_size)) {
+            // The bot was silent, nothing to correlate.
+            stage_ = STAGE_IDLE;
+            return;
+        }
+        fft_.forward(spectrum_reference_.data());
+        stage_ = STAGE_CORRELATE;
+        return;
+    }
+    case STAGE_CORRELATE: {
+        // Phase transform: every bin weighs the same, so the peak stays sharp on speech.
+        for (size_t k = 0; k < fft_size; k += 1) {
+            std::complex<float> cross = std::conj(spectrum_mixed_[k]) * spectrum_reference_[k];
+            float magnitude = std::abs(cross);
+            spectrum_mixed_[k] = magnitude > 1e-12f ? cross / magnitude : std::complex<float>(0.0f, 0.0f);
+        }
+        fft_.inverse(spectrum_mixed_.data());
+        stage_ = STAGE_PEAK;
+        return;
+    }
+    case STAGE_PEAK: {
+        // Lag k of the correlation is a delay of max_lag_ - k.
+        size_t best = 0;
+        float peak = -1.0f;
+        double sum = 0.0;
+        for (size_t k = 0; k <= max_lag_; k += 1) {
+            float value = spectrum_mixed_[k].real();
+            sum += std::fabs(value);
+            if (value > peak) {
+                peak = value;
+                best = k;
+            }
+        }
+        stage_ = STAGE_IDLE;
+        float mean = static_cast<float>(sum / static_cast<double>(max_lag_ + 1));
+        if (mean <= 0.0f || peak < ECHO_PEAK_RATIO * mean) {
+            return;
+        }
+        if (double_talk_position_ > snapshot_end_ - static_cast<int64_t>(block_samples)) {
+            // Someone talked over the bot in the block, the peak can be pulled away from the echo.
+            return;
+        }
+        int64_t delay = static_cast<int64_t>(max_lag_ - best) * decimation_;
+        int64_t tolerance = static_cast<int64_t>(taps_ / 4);
+        if (delay_ < 0 || llabs(delay - delay_) > tolerance) {
+            // A talk spurt starting or ending inside the blocks can peak elsewhere: a new path
+            // must be found twice in a row, then it is learned from scratch. Small moves stay within the filter.
+            bool confirmed = candidate_ >= 0 && llabs(delay - candidate_) <= tolerance;
+            candidate_ = delay;
+            if (!confirmed) {
+                return;
+            }
+            delay_ = delay;
+            std::fill(weights_.begin(), weights_.end(), 0.0f);
+            std::fill(foreground_.begin(), foreground_.end(), 0.0f);
+            converged_ = false;
+        }
+        candidate_ = -1;
+        delay_estimates_.fetch_add(1, std::memory_order_relaxed);
+        delay_us_.store(delay_ * 1000000 / rate_, std::memory_order_relaxed);
+        return;
+    }
+    }
+}
+
+void EchoCanceller::stats(struct audio_echo_canceller_stats *out) const {
+    out->frames = frames_.load(std::memory_order_relaxed);
+    out->bypassed_frames = bypassed_frames_.load(std::memory_order_relaxed);
+    out->reference_samples = reference_samples_.load(std::memory_order_relaxed);
+    out->dropped_reference_samples = dropped_reference_samples_.load(std::memory_order_relaxed);
+    out->delay_estimates = delay_estimates_.load(std::memory_order_relaxed);
+    out->double_talk_frames = double_talk_frames_.load(std::memory_order_relaxed);
+    out->max_frame_us = max_frame_us_.load(std::memory_order_relaxed);
+    int64_t delay_us = delay_us_.load(std::memory_order_relaxed);
+    out->delay_ms = delay_us < 0 ? -1 : static_cast<int32_t>(delay_us / 1000);
+    out->erle_db = erle_db_.load(std::memory_order_relaxed);
+    out->enabled = enabled_.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,140 @@
+#ifndef _C_AUDIO_ECHO_CANCELLER_H_
+#define _C_AUDIO_ECHO_CANCELLER_H_
+
+#include "c_rawdata_audio_helper.h"
+#include "c_audio_resampler.h"
+
+#include <atomic>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+/// @brief Removes the audio sent through the virtual mic from the mixed stream, see audio_helper_set_echo_canceller.
+///
+/// Sent audio is recorded as a mono reference on a sample timeline of the monotonic clock: a send
+/// is placed where the previous one ends, or now when the mic went quiet, as the SDK plays it out.
+/// Mixed frames are placed on the same timeline by their arrival time. The loopback delay between
+/// the two is estimated by GCC-PHAT cross-correlation of the last second of both signals, decimated
+/// to 8 kHz; the work is split in stages run one per mixed frame, so a frame never pays more than
+/// one FFT. An NLMS filter centered on the delay then models the loopback path and subtracts it,
+/// adaptation being frozen while someone else talks over the bot and the output only taking the
+/// adapted weights once they cancel better than the current ones.
+/// reference() can be called from any thread, process() from the mixed audio thread only.
+class EchoCanceller {
+public:
+    EchoCanceller();
+    EchoCanceller(const EchoCanceller &) = delete;
+    EchoCanceller &operator=(const EchoCanceller &) = delete;
+
+    /// @brief Enable or disable the canceller, the sizes are only used the first time it is enabled.
+    /// @return false if the settings are invalid.
+    bool configure(bool enabled, unsigned int sample_rate, unsigned int max_delay_ms, unsigned int taps);
+
+    bool enabled() const {
+        return enabled_.load(std::memory_order_acquire);
+    }
+
+    /// @brief Record interleaved 16-bit PCM handed to the SDK.
+    void reference(const char *data, size_t len, unsigned int sample_rate, unsigned int channels);
+
+    /// @brief Subtract the echo from a 16-bit mixed frame, the result lives in the canceller until the next frame.
+    /// @return false if the frame was left untouched.
+    bool process(struct exported_audio_raw_data &data);
+
+    void stats(struct audio_echo_canceller_stats *out) const;
+
+private:
+    /// Radix-2 complex FFT of a fixed size.
+    struct FftPlan {
+        void init(size_t size);
+        void forward(std::complex<float> *data) const;
+        void inverse(std::complex<float> *data) const;
+        void transform(std::complex<float> *data, bool inverse) const;
+
+        size_t size;
+        std::vector<uint32_t> reversed;
+        std::vector<std::complex<float>> twiddles;
+    };
+
+    /// Steps of a delay estimate, one per mixed frame.
+    enum Stage {
+        STAGE_IDLE,
+        STAGE_MIXED,
+        STAGE_REFERENCE,
+        STAGE_CORRELATE,
+        STAGE_PEAK,
+    };
+
+    void allocate(unsigned int sample_rate, unsigned int max_delay_ms, unsigned int taps);
+    void reset_state();
+    void run_stage();
+    /// Copy the reference from `start` into `out`, samples not written yet read as zeros.
+    void read_reference(int64_t start, float *out, size_t count, int64_t written) const;
+    int64_t timeline_position(int64_t mono_us) const;
+
+    std::atomic<bool> enabled_;
+    std::atomic<unsigned int> generation_;
+    bool allocated_;
+    unsigned int rate_;
+    unsigned int taps_;
+    /// Full-rate samples per decimated sample of the estimate.
+    unsigned int decimation_;
+    /// Largest delay searched, in decimated samples.
+    size_t max_lag_;
+    int64_t epoch_us_;
+
+    /// Reference timeline, guarded by `reference_mutex_` on the producer side.
+    std::vector<float> reference_;
+    size_t reference_mask_;
+    std::atomic<int64_t> written_;
+    std::mutex reference_mutex_;
+    AudioResampler reference_resampler_;
+    std::vector<float> reference_work_;
+
+    /// Mixed audio thread state.
+    unsigned int seen_generation_;
+    int64_t mixed_position_;
+    /// Position of the first sample in `history_` since the last reset.
+    int64_t history_start_;
+    std::vector<float> history_;
+    size_t history_mask_;
+    int64_t delay_;
+    /// Delay found once, waiting for the next estimate to agree.
+    int64_t candidate_;
+    /// Adapting and subtracting filters, see process().
+    std::vector<float> weights_;
+    std::vector<float> foreground_;
+    bool converged_;
+    unsigned int double_talk_run_;
+    /// End of the last double talk frame on the timeline.
+    int64_t double_talk_position_;
+    std::vector<float> segment_;
+    std::vector<float> input_;
+    std::vector<float> residual_;
+    std::vector<int16_t> output_;
+    Stage stage_;
+    unsigned int frames_since_estimate_;
+    int64_t snapshot_end_;
+    FftPlan fft_;
+    std::vector<std::complex<float>> spectrum_mixed_;
+    std::vector<std::complex<float>> spectrum_reference_;
+    /// Full-rate reference read for an estimate.
+    std::vector<float> reference_block_;
+    double echo_in_energy_;
+    double echo_out_energy_;
+    unsigned int echo_frames_;
+
+    std::atomic<uint64_t> frames_;
+    std::atomic<uint64_t> bypassed_frames_;
+    std::atomic<uint64_t> reference_samples_;
+    std::atomic<uint64_t> dropped_reference_samples_;
+    std::atomic<uint64_t> delay_estimates_;
+    std::atomic<uint64_t> double_talk_frames_;
+    std::atomic<int64_t> max_frame_us_;
+    std::atomic<int64_t> delay_us_;
+    std::atomic<float> erle_db_;
+};
+
+#endif
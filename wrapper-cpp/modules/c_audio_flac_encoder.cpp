@@ -0,0 +1,489 @@
+#include "c_audio_flac_encoder.h"
+#include "c_audio_dsp.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+constexpr unsigned int FLAC_BPS = 16;
+constexpr unsigned int FLAC_MAX_ORDER = 4;
+constexpr unsigned int FLAC_MAX_PARTITION_ORDER = 8;
+/// Largest Rice parameter of the 5-bit coding method, 31 is the escape code.
+constexpr unsigned int FLAC_MAX_RICE = 30;
+
+enum FlacChannelAssignment {
+    FLAC_LEFT_SIDE = 8,
+    FLAC_SIDE_RIGHT = 9,
+    FLAC_MID_SIDE = 10,
+};
+
+static uint8_t crc8(const uint8_t *data, size_t len) {
+    uint8_t crc = 0;
+    for (size_t i = 0; i < len; i += 1) {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; bit += 1) {
+            crc = crc & 0x80 ? static_cast<uint8_t>((crc << 1) ^ 0x07) : static_cast<uint8_t>(crc << 1);
+        }
+    }
+    return crc;
+}
+
+static uint16_t crc16(const uint8_t *data, size_t len) {
+    static uint16_t table[256];
+    static bool ready = [] {
+        for (unsigned int i = 0; i < 256; i += 1) {
+            uint16_t crc = static_cast<uint16_t>(i << 8);
+            for (int bit = 0; bit < 8; bit += 1) {
+                crc = crc & 0x8000 ? static_cast<uint16_t>((crc << 1) ^ 0x8005) : static_cast<uint16_t>(crc << 1);
+            }
+            table[i] = crc;
+        }
+        return true;
+    }();
+    (void)ready;
+    uint16_t crc = 0;
+    for (size_t i = 0; i < len; i += 1) {
+        crc = static_cast<uint16_t>((crc << 8) ^ table[(crc >> 8) ^ data[i]]);
+    }
+    return crc;
+}
+
+/// 4-bit sample rate code of the frame header, 0 reads it from STREAMINFO.
+static unsigned int rate_code(unsigned int rate) {
+    switch (rate) {
+        case 8000: return 4;
+        case 16000: return 5;
+        case 22050: return 6;
+        case 24000: return 7;
+        case 32000: return 8;
+        case 44100: return 9;
+        case 48000: return 10;
+        case 96000: return 11;
+        default: return 0;
+    }
+}
+
+static inline uint32_t zigzag(int32_t value) {
+    return (static_cast<uint32_t>(value) << 1) ^ static_cast<uint32_t>(value >> 31);
+}
+
+/// Residual of the fixed predictor of `order`, for the samples from `order` on.
+static void fixed_residual(const int32_t *x, size_t count, unsigned int order, int32_t *out) {
+    switch (order) {
+        case 0:
+            for (size_t i = 0; i < count; i += 1) {
+                out[i] = x[i];
+            }
+            break;
+        case 1:
+            for (size_t i = 1; i < count; i += 1) {
+                out[i] = x[i] - x[i - 1];
+            }
+            break;
+        case 2:
+            for (size_t i = 2; i < count; i += 1) {
+                out[i] = x[i] - 2 * x[i - 1] + x[i - 2];
+            }
+            break;
+        case 3:
+            for (size_t i = 3; i < count; i += 1) {
+                out[i] = x[i] - 3 * x[i - 1] + 3 * x[i - 2] - x[i - 3];
+            }
+            break;
+        default:
+            for (size_t i = 4; i < count; i += 1) {
+                out[i] = x[i] - 4 * x[i - 1] + 6 * x[i - 2] - 4 * x[i - 3] + x[i - 4];
+            }
+            break;
+    }
+}
+
+/// Order whose residual has the smallest magnitude, all orders computed in one pass.
+static unsigned int best_order(const int32_t *x, size_t count) {
+    if (count <= FLAC_MAX_ORDER) {
+        return 0;
+    }
+    uint64_t sums[FLAC_MAX_ORDER + 1] = { 0, 0, 0, 0, 0 };
+    int32_t prev0 = x[3];
+    int32_t prev1 = x[3] - x[2];
+    int32_t prev2 = prev1 - (x[2] - x[1]);
+    int32_t prev3 = prev2 - (x[2] - x[1] - (x[1] - x[0]));
+    for (size_t i = FLAC_MAX_ORDER; i < count; i += 1) {
+        int32_t e0 = x[i];
+        int32_t e1 = e0 - prev0;
+        int32_t e2 = e1 - prev1;
+        int32_t e3 = e2 - prev2;
+        int32_t e4 = e3 - prev3;
+        sums[0] += std::abs(e0);
+        sums[1] += std::abs(e1);
+        sums[2] += std::abs(e2);
+        sums[3] += std::abs(e3);
+        sums[4] += std::abs(e4);
+        prev0 = e0;
+        prev1 = e1;
+        prev2 = e2;
+        prev3 = e3;
+    }
+    unsigned int order = 0;
+    for (unsigned int i = 1; i <= FLAC_MAX_ORDER; i += 1) {
+        if (sums[i] < sums[order]) {
+            order = i;
+        }
+    }
+    return order;
+}
+
+/// Rice parameter minimizing the estimated size of `count` residuals summing to `sum` once zigzagged.
+static unsigned int rice_parameter(uint64_t sum, size_t count, uint64_t *bits) {
+    unsigned int k = 0;
+    uint64_t best = count + sum;
+    while (k < FLAC_MAX_RICE) {
+        uint64_t next = count * (k + 2) + (sum >> (k + 1));
+        if (next >= best) {
+            break;
+        }
+        best = next;
+        k += 1;
+    }
+    *bits = best;
+    return k;
+}
+
+/// Partitioning of a residual: the order and parameters of the cheapest one.
+struct RicePlan {
+    unsigned int partition_order;
+    unsigned int parameters[1 << FLAC_MAX_PARTITION_ORDER];
+    uint64_t bits;
+};
+
+/// Try every partition order from sums at the finest one, merged level by level.
+static void plan_residual(const int32_t *residual, size_t count, unsigned int order, RicePlan *plan) {
+    unsigned int max_order = 0;
+    while (max_order < FLAC_MAX_PARTITION_ORDER && count % (2u << max_order) == 0 && (count >> (max_order + 1)) > order) {
+        max_order += 1;
+    }
+    uint64_t sums[1 << FLAC_MAX_PARTITION_ORDER];
+    unsigned int partitions = 1u << max_order;
+    size_t size = count >> max_order;
+    for (unsigned int p = 0; p < partitions; p += 1) {
+        uint64_t sum = 0;
+        for (size_t i = p == 0 ? order : p * size; i < (p + 1) * size; i += 1) {
+            sum += zigzag(residual[i]);
+        }
+        sums[p] = sum;
+    }
+    plan->bits = UINT64_MAX;
+    for (int level = max_order; level >= 0; level -= 1) {
+        unsigned int count_p = 1u << level;
+        size_t part = count >> level;
+        unsigned int parameters[1 << FLAC_MAX_PARTITION_ORDER];
+        uint64_t bits = 0;
+        bool wide = false;
+        for (unsigned int p = 0; p < count_p; p += 1) {
+            uint64_t part_bits;
+            parameters[p] = rice_parameter(sums[p], p == 0 ? part - order : part, &part_bits);
+            bits += part_bits;
+            wide = wide || parameters[p] > 14;
+        }
+        bits += count_p * (wide ? 5 : 4);
+        if (bits < plan->bits) {
+            plan->bits = bits;
+            plan->partition_order = level;
+            memcpy(plan->parameters, parameters, count_p * sizeof(unsigned int));
+        }
+        // Merge pairs for the next, coarser level.
+        for (unsigned int p = 0; p < count_p / 2; p += 1) {
+            sums[p] = sums[2 * p] + sums[2 * p + 1];
+        }
+    }
+}
+
+/// Estimated size of the subframe of a channel, to pick the stereo assignment.
+static uint64_t subframe_bits(const int32_t *x, size_t count, unsigned int bps, int32_t *residual) {
+    bool constant = true;
+    for (size_t i = 1; i < count && constant; i += 1) {
+        constant = x[i] == x[0];
+    }
+    if (constant) {
+        return bps;
+    }
+    unsigned int order = best_order(x, count);
+    fixed_residual(x, count, order, residual);
+    RicePlan plan;
+    plan_residual(residual, count, order, &plan);
+    return std::min<uint64_t>(order * bps + 6 + plan.bits, count * bps);
+}
+
+FlacEncoder::FlacEncoder() {
+    reset(0, 1);
+}
+
+void FlacEncoder::reset(unsigned int sample_rate, unsigned int channels) {
+    sample_rate_ = sample_rate;
+    channels_ = std::min(std::max(channels, 1u), 8u);
+    pending_.assign(static_cast<size_t>(BLOCK_FRAMES) * channels_, 0);
+    pending_frames_ = 0;
+    encoded_frames_ = 0;
+    min_block_ = 0;
+    max_block_ = 0;
+    min_frame_ = 0;
+    max_frame_ = 0;
+    side_.resize(BLOCK_FRAMES);
+    mid_.resize(BLOCK_FRAMES);
+    residual_.resize(BLOCK_FRAMES);
+    out_.clear();
+    bit_buffer_ = 0;
+    bit_count_ = 0;
+}
+
+void FlacEncoder::push_s16(const int16_t *pcm, size_t frames) {
+    while (frames != 0) {
+        size_t take = std::min(frames, static_cast<size_t>(BLOCK_FRAMES) - pending_frames_);
+        for (unsigned int c = 0; c < channels_; c += 1) {
+            int32_t *plane = pending_.data() + static_cast<size_t>(c) * BLOCK_FRAMES + pending_frames_;
+            for (size_t i = 0; i < take; i += 1) {
+                plane[i] = pcm[i * channels_ + c];
+            }
+        }
+        pcm += take * channels_;
+        frames -= take;
+        pending_frames_ += take;
+        if (pending_frames_ == BLOCK_FRAMES) {
+            encode_block();
+        }
+    }
+}
+
+void FlacEncoder::push_f32(const float *pcm, size_t frames) {
+    convert_.resize(frames * channels_);
+    dsp_f32_to_s16(pcm, convert_.data(), frames * channels_, 32768.0f);
+    push_s16(convert_.data(), frames);
+}
+
+void FlacEncoder::push_silence(uint64_t frames) {
+    while (frames != 0) {
+        size_t take = static_cast<size_t>(std::min<uint64_t>(frames, BLOCK_FRAMES - pending_frames_));
+        for (unsigned int c = 0; c < channels_; c += 1) {
+            std::fill_n(pending_.data() + static_cast<size_t>(c) * BLOCK_FRAMES + pending_frames_, take, 0);
+        }
+        frames -= take;
+        pending_frames_ += take;
+        if (pending_frames_ == BLOCK_FRAMES) {
+            encode_block();
+        }
+    }
+}
+
+void FlacEncoder::finish() {
+    if (pending_frames_ == 0) {
+        return;
+    }
+    // The last block may be shorter than the minimum block size.
+    uint32_t min_block = min_block_;
+    encode_block();
+    if (min_block != 0) {
+        min_block_ = min_block;
+    }
+}
+
+void FlacEncoder::header(uint8_t *out) const {
+    memcpy(out, "fLaC", 4);
+    // Last metadata block, type 0 (STREAMINFO), 34 bytes.
+    out[4] = 0x80;
+    out[5] = 0;
+    out[6] = 0;
+    out[7] = 34;
+    uint8_t *info = out + 8;
+    uint32_t min_block = min_block_ != 0 ? min_block_ : BLOCK_FRAMES;
+    uint32_t max_block = max_block_ != 0 ? max_block_ : BLOCK_FRAMES;
+    info[0] = static_cast<uint8_t>(min_block >> 8);
+    info[1] = static_cast<uint8_t>(min_block);
+    info[2] = static_cast<uint8_t>(max_block >> 8);
+    info[3] = static_cast<uint8_t>(max_block);
+    info[4] = static_cast<uint8_t>(min_frame_ >> 16);
+    info[5] = static_cast<uint8_t>(min_frame_ >> 8);
+    info[6] = static_cast<uint8_t>(min_frame_);
+    info[7] = static_cast<uint8_t>(max_frame_ >> 16);
+    info[8] = static_cast<uint8_t>(max_frame_ >> 8);
+    info[9] = static_cast<uint8_t>(max_frame_);
+    // 20 bits of rate, 3 of channels - 1, 5 of bits per sample - 1, 36 of total samples.
+    uint64_t packed = (static_cast<uint64_t>(sample_rate_ & 0xFFFFF) << 44)
+        | (static_cast<uint64_t>(channels_ - 1) << 41)
+        | (static_cast<uint64_t>(FLAC_BPS - 1) << 36)
+        | (encoded_frames_ & 0xFFFFFFFFFull);
+    for (int i = 0; i < 8; i += 1) {
+        info[10 + i] = static_cast<uint8_t>(packed >> (56 - 8 * i));
+    }
+    memset(info + 18, 0, 16);
+}
+
+void FlacEncoder::encode_block() {
+    size_t count = pending_frames_;
+    size_t start = out_.size();
+    const int32_t *left = pending_.data();
+    const int32_t *right = pending_.data() + BLOCK_FRAMES;
+
+    unsigned int assignment = channels_ - 1;
+    if (channels_ == 2) {
+        for (size_t i = 0; i < count; i += 1) {
+            side_[i] = left[i] - right[i];
+            mid_[i] = (left[i] + right[i]) >> 1;
+        }
+        uint64_t l = subframe_bits(left, count, FLAC_BPS, residual_.data());
+        uint64_t r = subframe_bits(right, count, FLAC_BPS, residual_.data());
+        uint64_t s = subframe_bits(side_.data(), count, FLAC_BPS + 1, residual_.data());
+        uint64_t m = subframe_bits(mid_.data(), count, FLAC_BPS, residual_.data());
+        uint64_t best = l + r;
+        if (l + s < best) {
+            best = l + s;
+            assignment = FLAC_LEFT_SIDE;
+        }
+        if (s + r < best) {
+            best = s + r;
+            assignment = FLAC_SIDE_RIGHT;
+        }
+        if (m + s < best) {
+            assignment = FLAC_MID_SIDE;
+        }
+    }
+
+    // Frame header: sync code, variable block size, 16-bit block size at the end, 16 bits per sample.
+    put_bits(0x3FFE, 14);
+    put_bits(0, 1);
+    put_bits(1, 1);
+    put_bits(7, 4);
+    put_bits(rate_code(sample_rate_), 4);
+    put_bits(assignment, 4);
+    put_bits(4, 3);
+    put_bits(0, 1);
+    put_utf8(encoded_frames_);
+    put_bits(static_cast<uint32_t>(count - 1), 16);
+    put_bits(crc8(out_.data() + start, out_.size() - start), 8);
+
+    switch (assignment) {
+        case FLAC_LEFT_SIDE:
+            write_subframe(left, count, FLAC_BPS);
+            write_subframe(side_.data(), count, FLAC_BPS + 1);
+            break;
+        case FLAC_SIDE_RIGHT:
+            write_subframe(side_.data(), count, FLAC_BPS + 1);
+            write_subframe(right, count, FLAC_BPS);
+            break;
+        case FLAC_MID_SIDE:
+            write_subframe(mid_.data(), count, FLAC_BPS);
+            write_subframe(side_.data(), count, FLAC_BPS + 1);
+            break;
+        default:
+            for (unsigned int c = 0; c < channels_; c += 1) {
+                write_subframe(pending_.data() + static_cast<size_t>(c) * BLOCK_FRAMES, count, FLAC_BPS);
+            }
+            break;
+    }
+    align_byte();
+    put_bits(crc16(out_.data() + start, out_.size() - start), 16);
+
+    uint32_t frame_bytes = static_cast<uint32_t>(out_.size() - start);
+    min_frame_ = min_frame_ == 0 ? frame_bytes : std::min(min_frame_, frame_bytes);
+    max_frame_ = std::max(max_frame_, frame_bytes);
+    min_block_ = min_block_ == 0 ? static_cast<uint32_t>(count) : std::min(min_block_, static_cast<uint32_t>(count));
+    max_block_ = std::max(max_block_, static_cast<uint32_t>(count));
+    encoded_frames_ += count;
+    pending_frames_ = 0;
+}
+
+void FlacEncoder::write_subframe(const int32_t *samples, size_t count, unsigned int bps) {
+    bool constant = true;
+    for (size_t i = 1; i < count && constant; i += 1) {
+        constant = samples[i] == samples[0];
+    }
+    if (constant) {
+        put_bits(0, 8);
+        put_signed(samples[0], bps);
+        return;
+    }
+    unsigned int order = best_order(samples, count);
+    fixed_residual(samples, count, order, residual_.data());
+    RicePlan plan;
+    plan_residual(residual_.data(), count, order, &plan);
+    if (order * bps + 6 + plan.bits >= count * bps) {
+        // Verbatim.
+        put_bits(1 << 1, 8);
+        for (size_t i = 0; i < count; i += 1) {
+            put_signed(samples[i], bps);
+        }
+        return;
+    }
+    put_bits((8 + order) << 1, 8);
+    for (unsigned int i = 0; i < order; i += 1) {
+        put_signed(samples[i], bps);
+    }
+    bool wide = false;
+    unsigned int partitions = 1u << plan.partition_order;
+    for (unsigned int p = 0; p < partitions; p += 1) {
+        wide = wide || plan.parameters[p] > 14;
+    }
+    put_bits(wide ? 1 : 0, 2);
+    put_bits(plan.partition_order, 4);
+    size_t size = count >> plan.partition_order;
+    for (unsigned int p = 0; p < partitions; p += 1) {
+        unsigned int k = plan.parameters[p];
+        put_bits(k, wide ? 5 : 4);
+        for (size_t i = p == 0 ? order : p * size; i < (p + 1) * size; i += 1) {
+            uint32_t value = zigzag(residual_[i]);
+            uint32_t quotient = value >> k;
+            uint32_t low = k ? value & ((1u << k) - 1) : 0;
+            if (quotient + 1 + k <= 32) {
+                put_bits((1u << k) | low, quotient + 1 + k);
+            } else {
+                while (quotient >= 32) {
+                    put_bits(0, 32);
+                    quotient -= 32;
+                }
+                put_bits(1, quotient + 1);
+                if (k != 0) {
+                    put_bits(low, k);
+                }
+            }
+        }
+    }
+}
+
+void FlacEncoder::put_bits(uint32_t value, unsigned int bits) {
+    if (bits == 0) {
+        return;
+    }
+    bit_buffer_ = (bit_buffer_ << bits) | (bits == 32 ? value : value & ((1u << bits) - 1));
+    bit_count_ += bits;
+    while (bit_count_ >= 8) {
+        bit_count_ -= 8;
+        out_.push_back(static_cast<uint8_t>(bit_buffer_ >> bit_count_));
+    }
+}
+
+void FlacEncoder::put_signed(int32_t value, unsigned int bits) {
+    put_bits(static_cast<uint32_t>(value), bits);
+}
+
+void FlacEncoder::put_utf8(uint64_t value) {
+    if (value < 0x80) {
+        put_bits(static_cast<uint32_t>(value), 8);
+        return;
+    }
+    // Leading byte holds 1s for the total length then the top bits, continuation bytes 6 bits each.
+    unsigned int extra = 1;
+    while (extra < 6 && value >= (1ull << (6 * extra + 6 - extra))) {
+        extra += 1;
+    }
+    unsigned int lead_bits = 6 - extra;
+    uint32_t lead = (0xFF00u >> (extra + 1)) & 0xFF;
+    put_bits(lead | (static_cast<uint32_t>(value >> (6 * extra)) & ((1u << lead_bits) - 1)), 8);
+    for (int i = extra - 1; i >= 0; i -= 1) {
+        put_bits(0x80 | static_cast<uint32_t>((value >> (6 * i)) & 0x3F), 8);
+    }
+}
+
+void FlacEncoder::align_byte() {
+    if (bit_count_ != 0) {
+        put_bits(0, 8 - bit_count_);
+    }
+}
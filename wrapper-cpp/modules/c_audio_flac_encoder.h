@@ -0,0 +1,85 @@
+#ifndef _C_AUDIO_FLAC_ENCODER_H_
+#define _C_AUDIO_FLAC_ENCODER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// @brief Streaming 16-bit FLAC encoder of one track.
+///
+/// Blocks of 4096 frames are coded with the fixed polynomial predictors of order 0 to 4 and
+/// partitioned Rice residuals, silent blocks as constant subframes, and stereo blocks with the
+/// cheapest of the independent, left/side, right/side and mid/side assignments. Frames use the
+/// variable block size strategy, so each one carries the number of its first sample: the output
+/// is a sequence of self-delimited, timestamped packets that any FLAC decoder reads. No MD5 is
+/// computed, the STREAMINFO signature is left at zero as the format allows. Not thread safe.
+class FlacEncoder {
+public:
+    /// "fLaC" followed by the STREAMINFO block, the only metadata.
+    static constexpr size_t HEADER_BYTES = 42;
+    static constexpr unsigned int BLOCK_FRAMES = 4096;
+
+    FlacEncoder();
+
+    /// @brief Start a new stream, pending audio and output are dropped.
+    /// @param channels From 1 to 8.
+    void reset(unsigned int sample_rate, unsigned int channels);
+
+    /// @brief Queue interleaved frames, full blocks are encoded into output().
+    void push_s16(const int16_t *pcm, size_t frames);
+
+    /// @brief Same as push_s16 for floats in [-1, 1], rounded to 16 bits.
+    void push_f32(const float *pcm, size_t frames);
+
+    /// @brief Queue digital silence, e.g. a gap of an aligned track.
+    void push_silence(uint64_t frames);
+
+    /// @brief Encode the pending frames as a last, shorter block.
+    void finish();
+
+    /// @brief Write the stream header describing the frames encoded so far, to be rewritten at offset 0.
+    void header(uint8_t *out) const;
+
+    /// @brief Encoded frames not taken yet.
+    const std::vector<uint8_t> &output() const {
+        return out_;
+    }
+
+    void clear_output() {
+        out_.clear();
+    }
+
+    /// @brief Frames pushed since reset(), pending ones included.
+    uint64_t frames() const {
+        return encoded_frames_ + pending_frames_;
+    }
+
+private:
+    void encode_block();
+    void write_subframe(const int32_t *samples, size_t count, unsigned int bps);
+    void put_bits(uint32_t value, unsigned int bits);
+    void put_signed(int32_t value, unsigned int bits);
+    void put_utf8(uint64_t value);
+    void align_byte();
+
+    unsigned int sample_rate_;
+    unsigned int channels_;
+    /// Planar, BLOCK_FRAMES per channel.
+    std::vector<int32_t> pending_;
+    size_t pending_frames_;
+    uint64_t encoded_frames_;
+    uint32_t min_block_;
+    uint32_t max_block_;
+    uint32_t min_frame_;
+    uint32_t max_frame_;
+    /// Side and mid channels of stereo blocks.
+    std::vector<int32_t> side_;
+    std::vector<int32_t> mid_;
+    std::vector<int32_t> residual_;
+    std::vector<int16_t> convert_;
+    std::vector<uint8_t> out_;
+    uint64_t bit_buffer_;
+    unsigned int bit_count_;
+};
+
+#endif
@@ -0,0 +1,44 @@
+#include "c_audio_language_table.h"
+
+#include <cstring>
+
+AudioLanguageTable::AudioLanguageTable() {
+    count_.store(0, std::memory_order_relaxed);
+    last_ = 0;
+}
+
+uint16_t AudioLanguageTable::intern(const zchar_t *name) {
+    if (!name) {
+        return 0;
+    }
+    unsigned int count = count_.load(std::memory_order_relaxed);
+    if (last_ < count && strncmp(entries_[last_].name, name, sizeof(entries_[last_].name) - 1) == 0) {
+        return entries_[last_].language_id;
+    }
+    for (unsigned int i = 0; i < count; i += 1) {
+        if (strncmp(entries_[i].name, name, sizeof(entries_[i].name) - 1) == 0) {
+            last_ = i;
+            return entries_[i].language_id;
+        }
+    }
+    if (count == MAX_LANGUAGES) {
+        return 0;
+    }
+    struct interpreter_language &entry = entries_[count];
+    entry.language_id = static_cast<uint16_t>(count + 1);
+    strncpy(entry.name, name, sizeof(entry.name) - 1);
+    entry.name[sizeof(entry.name) - 1] = '\0';
+    // Publish the entry only once it is complete.
+    count_.store(count + 1, std::memory_order_release);
+    last_ = count;
+    return entry.language_id;
+}
+
+unsigned int AudioLanguageTable::copy(struct interpreter_language *languages, unsigned int cap) const {
+    unsigned int count = size();
+    if (count > cap) {
+        count = cap;
+    }
+    memcpy(languages, entries_, count * sizeof(struct interpreter_language));
+    return count;
+}
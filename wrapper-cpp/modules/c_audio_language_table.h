@@ -0,0 +1,39 @@
+#ifndef _C_AUDIO_LANGUAGE_TABLE_H_
+#define _C_AUDIO_LANGUAGE_TABLE_H_
+
+#include "c_rawdata_audio_helper.h"
+
+#include <atomic>
+#include <cstdint>
+
+/// @brief Interpreter language names interned into small ids, see audio_helper_get_interpreter_languages.
+///
+/// The table only grows: ids are handed out from 1 in order of first appearance and never reused,
+/// so its length doubles as a version. The SDK audio thread interns, readers on other threads copy
+/// the published entries without locking.
+class AudioLanguageTable {
+public:
+    static constexpr unsigned int MAX_LANGUAGES = 256;
+
+    AudioLanguageTable();
+
+    /// @brief Id of `name`, added to the table on first sight. SDK audio thread only.
+    /// @return 0 if `name` is NULL or the table is full.
+    uint16_t intern(const zchar_t *name);
+
+    /// @brief Number of interned languages, the id of the last one.
+    unsigned int size() const {
+        return count_.load(std::memory_order_acquire);
+    }
+
+    /// @brief Copy at most `cap` entries, ordered by id.
+    unsigned int copy(struct interpreter_language *languages, unsigned int cap) const;
+
+private:
+    struct interpreter_language entries_[MAX_LANGUAGES];
+    std::atomic<unsigned int> count_;
+    /// Index of the last interned or matched entry, checked first: frames come in runs of one language.
+    unsigned int last_;
+};
+
+#endif
@@ -0,0 +1,70 @@
+#include "c_audio_level.h"
+
+#include <cmath>
+
+/// Level reported for digital silence.
+constexpr float LEVEL_FLOOR_DBFS = -120.0f;
+
+static float to_dbfs(float level) {
+    return level > 1e-6f ? 20.0f * log10f(level) : LEVEL_FLOOR_DBFS;
+}
+
+AudioLevelMeter::AudioLevelMeter() {
+    reset();
+}
+
+void AudioLevelMeter::reset() {
+    for (unsigned int i = 0; i < BUCKETS; i += 1) {
+        buckets_[i] = { 0, 0, 0 };
+    }
+    bucket_us_ = 0;
+    bucket_index_ = -1;
+    peak_.store(0.0f, std::memory_order_relaxed);
+    rms_.store(0.0f, std::memory_order_relaxed);
+    updated_.store(0, std::memory_order_release);
+}
+
+void AudioLevelMeter::update(const struct pcm_activity &activity, uint32_t samples, int64_t mono_time, int64_t window_us) {
+    int64_t width = window_us / BUCKETS > 0 ? window_us / BUCKETS : 1;
+    int64_t index = mono_time / width;
+    if (width != bucket_us_ || bucket_index_ < 0 || index - bucket_index_ >= BUCKETS) {
+        for (unsigned int i = 0; i < BUCKETS; i += 1) {
+            buckets_[i] = { 0, 0, 0 };
+        }
+        bucket_us_ = width;
+    } else {
+        // Clear the buckets skipped since the last frame.
+        for (int64_t i = bucket_index_ + 1; i <= index; i += 1) {
+            buckets_[i % BUCKETS] = { 0, 0, 0 };
+        }
+    }
+    if (index > bucket_index_) {
+        bucket_index_ = index;
+    }
+
+    Bucket &bucket = buckets_[bucket_index_ % BUCKETS];
+    bucket.energy += activity.energy;
+    bucket.samples += samples;
+    bucket.peak = activity.peak > bucket.peak ? activity.peak : bucket.peak;
+
+    uint64_t energy = 0;
+    uint64_t total = 0;
+    uint32_t peak = 0;
+    for (unsigned int i = 0; i < BUCKETS; i += 1) {
+        energy += buckets_[i].energy;
+        total += buckets_[i].samples;
+        peak = buckets_[i].peak > peak ? buckets_[i].peak : peak;
+    }
+    peak_.store(peak / 32768.0f, std::memory_order_relaxed);
+    rms_.store(total ? static_cast<float>(sqrt(static_cast<double>(energy) / total) / 32768.0) : 0.0f, std::memory_order_relaxed);
+    updated_.store(mono_time, std::memory_order_release);
+}
+
+void AudioLevelMeter::read(struct user_level *out, int64_t now_us, int64_t window_us) const {
+    int64_t updated = updated_.load(std::memory_order_acquire);
+    bool stale = updated == 0 || now_us - updated > window_us;
+    out->peak = stale ? 0.0f : peak_.load(std::memory_order_relaxed);
+    out->rms = stale ? 0.0f : rms_.load(std::memory_order_relaxed);
+    out->peak_dbfs = to_dbfs(out->peak);
+    out->rms_dbfs = to_dbfs(out->rms);
+}
@@ -0,0 +1,46 @@
+#ifndef _C_AUDIO_LEVEL_H_
+#define _C_AUDIO_LEVEL_H_
+
+#include "c_rawdata_audio_helper.h"
+#include "c_audio_dsp.h"
+
+#include <atomic>
+#include <cstdint>
+
+/// @brief Rolling peak / RMS window of one stream.
+///
+/// The window is split into buckets of window/8, so it slides in steps of one bucket whatever
+/// the frame size. The SDK audio thread feeds the frames and publishes the window after each
+/// one; readers on other threads only touch the published atomics.
+class AudioLevelMeter {
+public:
+    AudioLevelMeter();
+
+    /// @brief Account one frame and publish the window. SDK audio thread only.
+    /// @param samples Samples of the frame, all channels included.
+    void update(const struct pcm_activity &activity, uint32_t samples, int64_t mono_time, int64_t window_us);
+
+    /// @brief Copy the published window into `out`, silence if no frame arrived during the last `window_us`.
+    void read(struct user_level *out, int64_t now_us, int64_t window_us) const;
+
+    /// @brief Clear the window, used when the stream is handed to another user.
+    void reset();
+
+private:
+    static constexpr unsigned int BUCKETS = 8;
+
+    struct Bucket {
+        uint64_t energy;
+        uint32_t samples;
+        uint32_t peak;
+    };
+
+    Bucket buckets_[BUCKETS];
+    int64_t bucket_us_;
+    int64_t bucket_index_;
+    std::atomic<float> peak_;
+    std::atomic<float> rms_;
+    std::atomic<int64_t> updated_;
+};
+
+#endif
@@ -0,0 +1,90 @@
+#include "c_audio_mic_converter.h"
+#include "c_audio_dsp.h"
+
+/// Rates accepted by IZoomSDKAudioRawDataSender::send, ascending, up to the highest one worth converting to.
+static const unsigned int MIC_MONO_RATES[] = { 8000, 11025, 16000, 32000, 44100, 48000 };
+static const unsigned int MIC_STEREO_RATES[] = { 8000, 16000, 32000, 44100, 48000 };
+/// Higher rates accepted as they are.
+static const unsigned int MIC_HIGH_RATES[] = { 50000, 50400, 96000, 192000 };
+
+unsigned int mic_send_rate(unsigned int rate, unsigned int channels) {
+    for (unsigned int high : MIC_HIGH_RATES) {
+        if (rate == high) {
+            return rate;
+        }
+    }
+    if (channels == 1 && rate == 2822400) {
+        return rate;
+    }
+    const unsigned int *rates = channels == 1 ? MIC_MONO_RATES : MIC_STEREO_RATES;
+    size_t count = channels == 1 ? sizeof(MIC_MONO_RATES) / sizeof(unsigned int) : sizeof(MIC_STEREO_RATES) / sizeof(unsigned int);
+    for (size_t i = 0; i < count; i += 1) {
+        if (rates[i] >= rate) {
+            return rates[i];
+        }
+    }
+    return rates[count - 1];
+}
+
+size_t MicConverter::max_output(size_t frames, unsigned int in_rate, unsigned int out_rate) {
+    return in_rate == out_rate ? frames : AudioResampler::max_output(frames, in_rate, out_rate);
+}
+
+size_t MicConverter::convert(const char *in, size_t frames, enum audio_sample_format format, unsigned int in_rate,
+                             unsigned int in_channels, unsigned int out_rate, unsigned int out_channels) {
+    if (frames == 0 || in_channels == 0 || in_rate == 0 || out_rate == 0) {
+        return 0;
+    }
+    // Resample as few channels as possible: downmix first, upmix last.
+    unsigned int channels = in_channels > out_channels ? out_channels : in_channels;
+    size_t samples = frames * in_channels;
+    size_t max_frames = max_output(frames, in_rate, out_rate);
+    if (work_.size() < samples + max_frames * channels) {
+        work_.resize(samples + max_frames * channels);
+    }
+
+    const float *pcm = reinterpret_cast<const float*>(in);
+    if (format == AUDIO_SAMPLE_S16) {
+        dsp_s16_to_f32(reinterpret_cast<const int16_t*>(in), work_.data(), samples, 1.0f / 32768.0f);
+        pcm = work_.data();
+    }
+    if (channels != in_channels) {
+        // Written front to back, never ahead of what is read.
+        float *mapped = work_.data();
+        if (in_channels == 2) {
+            dsp_downmix_f32(pcm, mapped, frames);
+        } else {
+            for (size_t i = 0; i < frames; i += 1) {
+                const float *frame = pcm + i * in_channels;
+                if (channels == 1) {
+                    float sum = 0.0f;
+                    for (unsigned int c = 0; c < in_channels; c += 1) {
+                        sum += frame[c];
+                    }
+                    mapped[i] = sum / in_channels;
+                } else {
+                    float left = frame[0];
+                    float right = frame[1];
+                    mapped[2 * i] = left;
+                    mapped[2 * i + 1] = right;
+                }
+            }
+        }
+        pcm = mapped;
+    }
+    if (in_rate != out_rate) {
+        float *resampled = work_.data() + samples;
+        frames = resampler_.process(pcm, frames, channels, in_rate, out_rate, resampled);
+        pcm = resampled;
+    }
+
+    out_.resize(frames * out_channels);
+    if (channels == out_channels) {
+        dsp_f32_to_s16(pcm, out_.data(), frames * channels, 32768.0f);
+    } else {
+        mono_.resize(frames);
+        dsp_f32_to_s16(pcm, mono_.data(), frames, 32768.0f);
+        dsp_upmix_s16(mono_.data(), out_.data(), frames);
+    }
+    return frames;
+}
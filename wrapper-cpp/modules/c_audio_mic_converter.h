@@ -0,0 +1,43 @@
+#ifndef _C_AUDIO_MIC_CONVERTER_H_
+#define _C_AUDIO_MIC_CONVERTER_H_
+
+#include "c_rawdata_audio_helper.h"
+#include "c_audio_resampler.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// @brief Rate the virtual mic sends audio of `rate` Hz at: `rate` itself when the SDK accepts it
+/// for that channel count, otherwise the lowest accepted rate above it, 48000 at most.
+unsigned int mic_send_rate(unsigned int rate, unsigned int channels);
+
+/// @brief Converts PCM of any rate, channel count and sample format into what the virtual mic sends.
+///
+/// Samples go through the SIMD kernels: to float, channel mapping, polyphase resampling, back to
+/// 16-bit. Extra channels are averaged into mono or cut to the first two, mono is duplicated into
+/// stereo after resampling. The resampler keeps its history between calls, so one instance per
+/// producer, not thread safe.
+class MicConverter {
+public:
+    /// @brief Upper bound of the frames produced by convert() for `frames` input frames.
+    static size_t max_output(size_t frames, unsigned int in_rate, unsigned int out_rate);
+
+    /// @param out_channels 1 or 2.
+    /// @return The number of converted frames, read them with data() before the next call.
+    size_t convert(const char *in, size_t frames, enum audio_sample_format format, unsigned int in_rate,
+                   unsigned int in_channels, unsigned int out_rate, unsigned int out_channels);
+
+    const int16_t *data() const {
+        return out_.data();
+    }
+
+private:
+    AudioResampler resampler_;
+    /// Float input followed by the resampled frames.
+    std::vector<float> work_;
+    std::vector<int16_t> mono_;
+    std::vector<int16_t> out_;
+};
+
+#endif
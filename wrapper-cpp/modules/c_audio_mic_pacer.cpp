@@ -0,0 +1,186 @@
+#include "c_audio_mic_pacer.h"
+#include "c_media_timeline.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <sys/timerfd.h>
+#include <unistd.h>
+#include <vector>
+
+/// Chunks sent back to back when the thread wakes up late, further missed periods are not sent.
+constexpr uint64_t MIC_MAX_CATCH_UP = 4;
+
+AudioMicPacer::AudioMicPacer() {
+    running_.store(false, std::memory_order_relaxed);
+    queue_.store(nullptr, std::memory_order_relaxed);
+    sample_rate_.store(0, std::memory_order_relaxed);
+    channels_.store(1, std::memory_order_relaxed);
+    chunk_ms_.store(10, std::memory_order_relaxed);
+    prefill_ms_.store(0, std::memory_order_relaxed);
+    last_push_us_.store(0, std::memory_order_relaxed);
+    sent_chunks_.store(0, std::memory_order_relaxed);
+    silence_chunks_.store(0, std::memory_order_relaxed);
+    underruns_.store(0, std::memory_order_relaxed);
+    late_chunks_.store(0, std::memory_order_relaxed);
+    send_errors_.store(0, std::memory_order_relaxed);
+    max_lateness_us_.store(0, std::memory_order_relaxed);
+}
+
+AudioMicPacer::~AudioMicPacer() {
+    stop();
+}
+
+bool AudioMicPacer::configure(unsigned int sample_rate, unsigned int channels, unsigned int chunk_ms, unsigned int prefill_ms, unsigned int queue_ms) {
+    if (sample_rate != 0 && ((chunk_ms != 10 && chunk_ms != 20) || (channels != 1 && channels != 2))) {
+        return false;
+    }
+    if (sample_rate != 0) {
+        sample_rate = mic_send_rate(sample_rate, channels);
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (sample_rate != 0 && !queue_storage_) {
+        size_t capacity = static_cast<size_t>(sample_rate) * channels * sizeof(int16_t) * std::max(queue_ms, chunk_ms) / 1000;
+        queue_storage_.reset(new SpscByteRing(capacity));
+        queue_.store(queue_storage_.get(), std::memory_order_release);
+    }
+    chunk_ms_.store(chunk_ms, std::memory_order_relaxed);
+    channels_.store(channels, std::memory_order_relaxed);
+    prefill_ms_.store(prefill_ms, std::memory_order_relaxed);
+    sample_rate_.store(sample_rate, std::memory_order_release);
+    return true;
+}
+
+size_t AudioMicPacer::push(const char *data, size_t len) {
+    SpscByteRing *queue = queue_.load(std::memory_order_acquire);
+    if (!queue) {
+        return 0;
+    }
+    size_t written = queue->write(data, len, sizeof(int16_t) * channels_.load(std::memory_order_relaxed));
+    last_push_us_.store(monotonic_us(), std::memory_order_release);
+    return written;
+}
+
+size_t AudioMicPacer::push_pcm(const char *data, size_t frames, enum audio_sample_format format, unsigned int sample_rate, unsigned int channels) {
+    SpscByteRing *queue = queue_.load(std::memory_order_acquire);
+    unsigned int out_rate = sample_rate_.load(std::memory_order_acquire);
+    if (!queue || out_rate == 0 || sample_rate == 0) {
+        return 0;
+    }
+    unsigned int out_channels = channels_.load(std::memory_order_relaxed);
+    size_t frame_bytes = sizeof(int16_t) * out_channels;
+    // Only convert what is sure to fit: a partial write would desynchronize the resampler.
+    size_t room = (queue->capacity() - queue->used()) / frame_bytes;
+    size_t fit = room > 2 ? (room - 2) * sample_rate / out_rate : 0;
+    if (frames > fit) {
+        frames = fit;
+    }
+    size_t converted = converter_.convert(data, frames, format, sample_rate, channels, out_rate, out_channels);
+    queue->write(reinterpret_cast<const char*>(converter_.data()), converted * frame_bytes, frame_bytes);
+    last_push_us_.store(monotonic_us(), std::memory_order_release);
+    return frames;
+}
+
+void AudioMicPacer::start(ZOOMSDK::IZoomSDKAudioRawDataSender *sender) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (running_.load(std::memory_order_relaxed) || !enabled() || !sender) {
+        return;
+    }
+    if (thread_.joinable()) {
+        // The previous thread gave up on its own.
+        thread_.join();
+    }
+    running_.store(true, std::memory_order_release);
+    thread_ = std::thread(&AudioMicPacer::run, this, sender);
+}
+
+void AudioMicPacer::stop() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    running_.store(false, std::memory_order_release);
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void AudioMicPacer::stats(struct audio_mic_pacer_stats *out) const {
+    SpscByteRing *queue = queue_.load(std::memory_order_acquire);
+    out->sent_chunks = sent_chunks_.load(std::memory_order_relaxed);
+    out->silence_chunks = silence_chunks_.load(std::memory_order_relaxed);
+    out->underruns = underruns_.load(std::memory_order_relaxed);
+    out->late_chunks = late_chunks_.load(std::memory_order_relaxed);
+    out->send_errors = send_errors_.load(std::memory_order_relaxed);
+    out->max_lateness_us = max_lateness_us_.load(std::memory_order_relaxed);
+    out->queued_bytes = queue ? queue->used() : 0;
+    out->running = running_.load(std::memory_order_relaxed);
+    out->sample_rate = sample_rate_.load(std::memory_order_relaxed);
+    out->channels = channels_.load(std::memory_order_relaxed);
+}
+
+void AudioMicPacer::run(ZOOMSDK::IZoomSDKAudioRawDataSender *sender) {
+    SpscByteRing *queue = queue_.load(std::memory_order_acquire);
+    unsigned int rate = sample_rate_.load(std::memory_order_acquire);
+    unsigned int channels = channels_.load(std::memory_order_relaxed);
+    ZOOMSDK::ZoomSDKAudioChannel layout = channels == 2 ? ZOOMSDK::ZoomSDKAudioChannel_Stereo : ZOOMSDK::ZoomSDKAudioChannel_Mono;
+    int64_t period_us = chunk_ms_.load(std::memory_order_relaxed) * 1000;
+    int64_t prefill_us = prefill_ms_.load(std::memory_order_relaxed) * 1000;
+    size_t frame_bytes = sizeof(int16_t) * channels;
+    size_t chunk_bytes = static_cast<size_t>(rate) * period_us / 1000000 * frame_bytes;
+    size_t prefill_bytes = std::max(static_cast<size_t>(rate * prefill_us / 1000000 * frame_bytes), chunk_bytes);
+    std::vector<char> chunk(chunk_bytes);
+
+    int fd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+    if (fd < 0) {
+        running_.store(false, std::memory_order_release);
+        return;
+    }
+    struct itimerspec spec;
+    spec.it_interval.tv_sec = 0;
+    spec.it_interval.tv_nsec = period_us * 1000;
+    spec.it_value = spec.it_interval;
+    int64_t origin = monotonic_us();
+    timerfd_settime(fd, 0, &spec, nullptr);
+
+    bool playing = false;
+    uint64_t ticks = 0;
+    while (running_.load(std::memory_order_acquire)) {
+        uint64_t expirations = 0;
+        if (read(fd, &expirations, sizeof(expirations)) != sizeof(expirations)) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+        ticks += expirations;
+        int64_t lateness = monotonic_us() - (origin + static_cast<int64_t>(ticks) * period_us);
+        if (lateness > max_lateness_us_.load(std::memory_order_relaxed)) {
+            max_lateness_us_.store(lateness, std::memory_order_relaxed);
+        }
+        if (expirations > 1) {
+            late_chunks_.fetch_add(expirations - 1, std::memory_order_relaxed);
+        }
+
+        for (uint64_t i = 0; i < std::min(expirations, MIC_MAX_CATCH_UP); i += 1) {
+            size_t queued = queue->used();
+            if (!playing && queued != 0) {
+                int64_t idle = monotonic_us() - last_push_us_.load(std::memory_order_acquire);
+                playing = queued >= prefill_bytes || idle >= prefill_us;
+            }
+            size_t got = playing ? queue->read(chunk.data(), chunk_bytes) : 0;
+            if (playing && got < chunk_bytes) {
+                // Pad the tail and wait for the prefill again.
+                underruns_.fetch_add(1, std::memory_order_relaxed);
+                playing = false;
+            }
+            memset(chunk.data() + got, 0, chunk_bytes - got);
+            if (got == 0) {
+                silence_chunks_.fetch_add(1, std::memory_order_relaxed);
+            } else {
+                sent_chunks_.fetch_add(1, std::memory_order_relaxed);
+            }
+            if (sender->send(chunk.data(), chunk_bytes, rate, layout) != ZOOMSDK::SDKERR_SUCCESS) {
+                send_errors_.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    }
+    close(fd);
+}
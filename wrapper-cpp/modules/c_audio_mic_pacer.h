@@ -0,0 +1,75 @@
+#ifndef _C_AUDIO_MIC_PACER_H_
+#define _C_AUDIO_MIC_PACER_H_
+
+#include "c_rawdata_audio_helper.h"
+#include "c_audio_mic_converter.h"
+#include "c_audio_ring_buffer.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+/// @brief Real-time sender of the virtual mic, see audio_helper_set_mic_pacer.
+///
+/// Producers push PCM of any size into a lock-free byte queue. While the SDK lets the mic send,
+/// a dedicated thread woken by a timerfd sends exactly one chunk per period. The queue doubles
+/// as a jitter buffer: playback (re)starts once `prefill_ms` are queued, or once the producer
+/// went quiet for that long, and silence is sent whenever there is nothing to play.
+class AudioMicPacer {
+public:
+    AudioMicPacer();
+    ~AudioMicPacer();
+
+    /// @brief Change the settings, the running thread picks them up at its next start.
+    /// `sample_rate` is replaced by mic_send_rate(). The queue is sized by the first call and kept,
+    /// a producer may be pushing into it.
+    /// @return false if `chunk_ms` is neither 10 nor 20 or `channels` neither 1 nor 2.
+    bool configure(unsigned int sample_rate, unsigned int channels, unsigned int chunk_ms, unsigned int prefill_ms, unsigned int queue_ms);
+
+    bool enabled() const {
+        return sample_rate_.load(std::memory_order_acquire) != 0;
+    }
+
+    /// @brief Queue 16-bit PCM in the sent format. Single producer.
+    /// @return The number of bytes queued, less than `len` when the queue is full.
+    size_t push(const char *data, size_t len);
+
+    /// @brief Convert PCM of any format to the sent format and queue it. Single producer, shared with push().
+    /// @return The number of input frames consumed, less than `frames` when the queue is full.
+    size_t push_pcm(const char *data, size_t frames, enum audio_sample_format format, unsigned int sample_rate, unsigned int channels);
+
+    /// @brief Start sending through `sender`, called from onMicStartSend.
+    void start(ZOOMSDK::IZoomSDKAudioRawDataSender *sender);
+
+    /// @brief Stop the thread, within one period. Queued audio is kept for the next start.
+    void stop();
+
+    void stats(struct audio_mic_pacer_stats *out) const;
+
+private:
+    void run(ZOOMSDK::IZoomSDKAudioRawDataSender *sender);
+
+    std::mutex mutex_;
+    std::thread thread_;
+    std::atomic<bool> running_;
+    std::atomic<SpscByteRing*> queue_;
+    std::unique_ptr<SpscByteRing> queue_storage_;
+    std::atomic<unsigned int> sample_rate_;
+    std::atomic<unsigned int> channels_;
+    std::atomic<unsigned int> chunk_ms_;
+    std::atomic<unsigned int> prefill_ms_;
+    /// Monotonic time of the last push, lets a short tail play without reaching the prefill.
+    std::atomic<int64_t> last_push_us_;
+    std::atomic<uint64_t> sent_chunks_;
+    std::atomic<uint64_t> silence_chunks_;
+    std::atomic<uint64_t> underruns_;
+    std::atomic<uint64_t> late_chunks_;
+    std::atomic<uint64_t> send_errors_;
+    std::atomic<int64_t> max_lateness_us_;
+    /// Producer side.
+    MicConverter converter_;
+};
+
+#endif
@@ -0,0 +1,295 @@
+#include "c_audio_mixer.h"
+#include "c_audio_dsp.h"
+#include "c_media_timeline.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+extern "C" void on_custom_audio_mix(void *ptr, struct exported_audio_raw_data *data, uint32_t mix_id);
+
+constexpr int64_t MIXER_PERIOD_US = 10000;
+constexpr unsigned int MIXER_MAX_RATE = 48000;
+/// Size of each input queue.
+constexpr unsigned int MIXER_QUEUE_MS = 400;
+/// Periods an input may hold beyond the prefill before it is cut back.
+constexpr size_t MIXER_MAX_LAG_PERIODS = 4;
+/// Periods mixed back to back when the thread wakes up late, further missed periods are not mixed.
+constexpr uint64_t MIXER_MAX_CATCH_UP = 4;
+
+/// Drop `bytes` from the head of a queue. Consumer side only.
+static void discard(SpscByteRing *queue, size_t bytes, char *scratch, size_t scratch_len) {
+    while (bytes != 0) {
+        size_t got = queue->read(scratch, std::min(bytes, scratch_len));
+        if (got == 0) {
+            return;
+        }
+        bytes -= got;
+    }
+}
+
+AudioMixer::AudioMixer(void *ptr, unsigned int max_inputs) {
+    ptr_to_rust_ = ptr;
+    max_inputs_ = max_inputs;
+    inputs_ = new Input[max_inputs];
+    for (unsigned int i = 0; i < max_inputs; i += 1) {
+        inputs_[i].queue.store(nullptr, std::memory_order_relaxed);
+        inputs_[i].user_id.store(0, std::memory_order_relaxed);
+        inputs_[i].mixed_user = 0;
+        inputs_[i].playing = false;
+    }
+    for (unsigned int i = 0; i < AUDIO_MAX_MIXES; i += 1) {
+        mixes_[i].mode = AUDIO_MIX_OFF;
+    }
+    running_.store(false, std::memory_order_relaxed);
+    sample_rate_.store(0, std::memory_order_relaxed);
+    jitter_ms_.store(0, std::memory_order_relaxed);
+    mix_count_.store(0, std::memory_order_relaxed);
+    ticks_.store(0, std::memory_order_relaxed);
+    late_ticks_.store(0, std::memory_order_relaxed);
+    delivered_frames_.store(0, std::memory_order_relaxed);
+    underruns_.store(0, std::memory_order_relaxed);
+    dropped_bytes_.store(0, std::memory_order_relaxed);
+    max_lateness_us_.store(0, std::memory_order_relaxed);
+    max_mix_us_.store(0, std::memory_order_relaxed);
+    active_inputs_.store(0, std::memory_order_relaxed);
+}
+
+AudioMixer::~AudioMixer() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop();
+    }
+    for (unsigned int i = 0; i < max_inputs_; i += 1) {
+        delete inputs_[i].queue.load(std::memory_order_relaxed);
+    }
+    delete[] inputs_;
+}
+
+bool AudioMixer::configure(unsigned int sample_rate, unsigned int jitter_ms) {
+    if (sample_rate != 0 && (sample_rate < 8000 || sample_rate > MIXER_MAX_RATE || sample_rate % 100 != 0)) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop();
+    jitter_ms_.store(jitter_ms, std::memory_order_relaxed);
+    sample_rate_.store(sample_rate, std::memory_order_release);
+    if (sample_rate != 0) {
+        running_.store(true, std::memory_order_release);
+        thread_ = std::thread(&AudioMixer::run, this, sample_rate, jitter_ms);
+    }
+    return true;
+}
+
+void AudioMixer::stop() {
+    running_.store(false, std::memory_order_release);
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+bool AudioMixer::set_mix(unsigned int mix_id, enum audio_mix_mode mode, const uint32_t *user_ids, unsigned int count) {
+    if (mix_id >= AUDIO_MAX_MIXES) {
+        return false;
+    }
+    std::vector<uint32_t> users;
+    if (mode != AUDIO_MIX_OFF && user_ids) {
+        users.assign(user_ids, user_ids + count);
+        std::sort(users.begin(), users.end());
+    }
+    std::lock_guard<std::mutex> lock(mixes_mutex_);
+    mixes_[mix_id].mode = mode;
+    mixes_[mix_id].users.swap(users);
+    unsigned int produced = 0;
+    for (unsigned int i = 0; i < AUDIO_MAX_MIXES; i += 1) {
+        produced += mixes_[i].mode != AUDIO_MIX_OFF;
+    }
+    mix_count_.store(produced, std::memory_order_relaxed);
+    return true;
+}
+
+bool AudioMixer::member(const Mix &mix, uint32_t user_id) const {
+    bool listed = std::binary_search(mix.users.begin(), mix.users.end(), user_id);
+    return mix.mode == AUDIO_MIX_INCLUDE ? listed : !listed;
+}
+
+void AudioMixer::feed(unsigned int input, uint32_t user_id, const struct exported_audio_raw_data &data) {
+    unsigned int rate = sample_rate_.load(std::memory_order_acquire);
+    if (rate == 0 || input >= max_inputs_ || data.sample_rate == 0 || data.channels == 0) {
+        return;
+    }
+    Input &in = inputs_[input];
+    SpscByteRing *queue = in.queue.load(std::memory_order_relaxed);
+    if (!queue) {
+        queue = new SpscByteRing(static_cast<size_t>(MIXER_MAX_RATE) * sizeof(int16_t) * MIXER_QUEUE_MS / 1000);
+        in.queue.store(queue, std::memory_order_release);
+    }
+    in.user_id.store(user_id, std::memory_order_release);
+    size_t frames = data.len / (sizeof(int16_t) * data.channels);
+    const char *pcm = data.data;
+    size_t len = frames * sizeof(int16_t);
+    if (data.sample_rate != rate || data.channels != 1) {
+        len = in.converter.convert(data.data, frames, AUDIO_SAMPLE_S16, data.sample_rate, data.channels, rate, 1) * sizeof(int16_t);
+        pcm = reinterpret_cast<const char*>(in.converter.data());
+    }
+    size_t written = queue->write(pcm, len, sizeof(int16_t));
+    if (written < len) {
+        dropped_bytes_.fetch_add(len - written, std::memory_order_relaxed);
+    }
+}
+
+void AudioMixer::stats(struct audio_mixer_stats *out) const {
+    out->ticks = ticks_.load(std::memory_order_relaxed);
+    out->late_ticks = late_ticks_.load(std::memory_order_relaxed);
+    out->delivered_frames = delivered_frames_.load(std::memory_order_relaxed);
+    out->underruns = underruns_.load(std::memory_order_relaxed);
+    out->dropped_bytes = dropped_bytes_.load(std::memory_order_relaxed);
+    out->max_lateness_us = max_lateness_us_.load(std::memory_order_relaxed);
+    out->max_mix_us = max_mix_us_.load(std::memory_order_relaxed);
+    out->inputs = active_inputs_.load(std::memory_order_relaxed);
+    out->mixes = mix_count_.load(std::memory_order_relaxed);
+    out->sample_rate = sample_rate_.load(std::memory_order_relaxed);
+    out->running = running_.load(std::memory_order_relaxed);
+}
+
+void AudioMixer::run(unsigned int rate, unsigned int jitter_ms) {
+    size_t period = rate * MIXER_PERIOD_US / 1000000;
+    size_t period_bytes = period * sizeof(int16_t);
+    size_t prefill_bytes = std::max(static_cast<size_t>(rate) * jitter_ms / 1000, period) * sizeof(int16_t);
+    size_t lag_bytes = prefill_bytes + MIXER_MAX_LAG_PERIODS * period_bytes;
+    std::vector<int16_t> chunk(period);
+    std::vector<int16_t> mixed(AUDIO_MAX_MIXES * period);
+    bool produced[AUDIO_MAX_MIXES];
+
+    // Audio queued at another rate, or before a stop, is not played.
+    for (unsigned int i = 0; i < max_inputs_; i += 1) {
+        Input &in = inputs_[i];
+        SpscByteRing *queue = in.queue.load(std::memory_order_acquire);
+        if (queue) {
+            discard(queue, queue->used(), reinterpret_cast<char*>(chunk.data()), period_bytes);
+        }
+        in.mixed_user = in.user_id.load(std::memory_order_acquire);
+        in.playing = false;
+    }
+
+    int fd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+    if (fd < 0) {
+        running_.store(false, std::memory_order_release);
+        return;
+    }
+    struct itimerspec spec;
+    spec.it_interval.tv_sec = 0;
+    spec.it_interval.tv_nsec = MIXER_PERIOD_US * 1000;
+    spec.it_value = spec.it_interval;
+    int64_t origin = monotonic_us();
+    timerfd_settime(fd, 0, &spec, nullptr);
+
+    uint64_t ticks = 0;
+    while (running_.load(std::memory_order_acquire)) {
+        uint64_t expirations = 0;
+        if (read(fd, &expirations, sizeof(expirations)) != sizeof(expirations)) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+        int64_t lateness = monotonic_us() - (origin + static_cast<int64_t>(ticks + expirations) * MIXER_PERIOD_US);
+        if (lateness > max_lateness_us_.load(std::memory_order_relaxed)) {
+            max_lateness_us_.store(lateness, std::memory_order_relaxed);
+        }
+        if (expirations > 1) {
+            late_ticks_.fetch_add(expirations - 1, std::memory_order_relaxed);
+        }
+        uint64_t mixed_ticks = std::min(expirations, MIXER_MAX_CATCH_UP);
+        // Skipped periods keep their place on the timeline, the inputs catch up by the lag cut.
+        ticks += expirations - mixed_ticks;
+
+        for (uint64_t t = 0; t < mixed_ticks; t += 1) {
+            int64_t start = monotonic_us();
+            unsigned int contributing = 0;
+            {
+                std::lock_guard<std::mutex> lock(mixes_mutex_);
+                for (unsigned int m = 0; m < AUDIO_MAX_MIXES; m += 1) {
+                    produced[m] = mixes_[m].mode != AUDIO_MIX_OFF;
+                    if (produced[m]) {
+                        memset(mixed.data() + m * period, 0, period_bytes);
+                    }
+                }
+                for (unsigned int i = 0; i < max_inputs_; i += 1) {
+                    Input &in = inputs_[i];
+                    SpscByteRing *queue = in.queue.load(std::memory_order_acquire);
+                    if (!queue) {
+                        continue;
+                    }
+                    uint32_t user_id = in.user_id.load(std::memory_order_acquire);
+                    if (user_id != in.mixed_user) {
+                        // The slot moved to another user, the queue may still hold the previous one.
+                        if (in.mixed_user != 0) {
+                            discard(queue, queue->used(), reinterpret_cast<char*>(chunk.data()), period_bytes);
+                        }
+                        in.mixed_user = user_id;
+                        in.playing = false;
+                    }
+                    size_t queued = queue->used();
+                    if (!in.playing) {
+                        if (queued < prefill_bytes) {
+                            continue;
+                        }
+                        in.playing = true;
+                    }
+                    if (queued > lag_bytes) {
+                        size_t excess = queued - prefill_bytes;
+                        excess -= excess % sizeof(int16_t);
+                        discard(queue, excess, reinterpret_cast<char*>(chunk.data()), period_bytes);
+                        dropped_bytes_.fetch_add(excess, std::memory_order_relaxed);
+                    }
+                    size_t got = queue->read(reinterpret_cast<char*>(chunk.data()), period_bytes);
+                    if (got < period_bytes) {
+                        // Pad the tail and wait for the prefill again.
+                        underruns_.fetch_add(1, std::memory_order_relaxed);
+                        memset(reinterpret_cast<char*>(chunk.data()) + got, 0, period_bytes - got);
+                        in.playing = false;
+                    }
+                    contributing += 1;
+                    for (unsigned int m = 0; m < AUDIO_MAX_MIXES; m += 1) {
+                        if (produced[m] && member(mixes_[m], user_id)) {
+                            dsp_mix_s16(mixed.data() + m * period, chunk.data(), period);
+                        }
+                    }
+                }
+            }
+            int64_t elapsed = monotonic_us() - start;
+            if (elapsed > max_mix_us_.load(std::memory_order_relaxed)) {
+                max_mix_us_.store(elapsed, std::memory_order_relaxed);
+            }
+            active_inputs_.store(contributing, std::memory_order_relaxed);
+
+            int64_t mono_time = origin + static_cast<int64_t>(ticks) * MIXER_PERIOD_US;
+            for (unsigned int m = 0; m < AUDIO_MAX_MIXES; m += 1) {
+                if (!produced[m]) {
+                    continue;
+                }
+                struct exported_audio_raw_data data = {
+                    data: reinterpret_cast<char*>(mixed.data() + m * period),
+                    time: timeline_wall_us(mono_time),
+                    len: static_cast<unsigned int>(period_bytes),
+                    format: AUDIO_SAMPLE_S16,
+                    sample_rate: rate,
+                    channels: 1,
+                    raw: nullptr,
+                    sdk_time: 0,
+                    mono_time: mono_time,
+                    drift: 0,
+                    sample_index: static_cast<int64_t>(ticks * period),
+                };
+                on_custom_audio_mix(ptr_to_rust_, &data, m);
+                delivered_frames_.fetch_add(1, std::memory_order_relaxed);
+            }
+            ticks += 1;
+            ticks_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    close(fd);
+}
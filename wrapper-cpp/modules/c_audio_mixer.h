@@ -0,0 +1,92 @@
+#ifndef _C_AUDIO_MIXER_H_
+#define _C_AUDIO_MIXER_H_
+
+#include "c_rawdata_audio_helper.h"
+#include "c_audio_mic_converter.h"
+#include "c_audio_ring_buffer.h"
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+constexpr unsigned int AUDIO_MAX_MIXES = 16;
+
+/// @brief Builds custom mixes of the one-way streams, see audio_helper_set_mixer.
+///
+/// Each user slot has an input: a byte queue of mono 16-bit PCM at the mix rate, filled by the
+/// SDK audio thread through its own converter. A thread woken every 10 ms by a timerfd reads one
+/// period from every input that reached the jitter prefill, adds it with saturation into each
+/// mix the user belongs to, then hands the mixes to Rust. Inputs lagging more than a few periods
+/// behind the clock are cut back to the prefill, so the mix latency stays bounded.
+class AudioMixer {
+public:
+    /// @param ptr Rust context passed to on_custom_audio_mix.
+    AudioMixer(void *ptr, unsigned int max_inputs);
+    ~AudioMixer();
+    AudioMixer(const AudioMixer &) = delete;
+    AudioMixer &operator=(const AudioMixer &) = delete;
+
+    /// @brief Stop the thread, apply the settings and start it again unless `sample_rate` is 0.
+    /// @return false if the rate is not a multiple of 100 between 8000 and 48000.
+    bool configure(unsigned int sample_rate, unsigned int jitter_ms);
+
+    /// @brief Replace the members of a mix from the next period, waits for the current one to be mixed.
+    bool set_mix(unsigned int mix_id, enum audio_mix_mode mode, const uint32_t *user_ids, unsigned int count);
+
+    /// @brief Queue a frame of the user owning input `input`. SDK audio thread only.
+    void feed(unsigned int input, uint32_t user_id, const struct exported_audio_raw_data &data);
+
+    bool enabled() const {
+        return sample_rate_.load(std::memory_order_acquire) != 0;
+    }
+
+    void stats(struct audio_mixer_stats *out) const;
+
+private:
+    struct Mix {
+        enum audio_mix_mode mode;
+        /// Sorted.
+        std::vector<uint32_t> users;
+    };
+
+    struct Input {
+        /// Allocated with the first frame of the slot and kept afterwards.
+        std::atomic<SpscByteRing*> queue;
+        std::atomic<uint32_t> user_id;
+        /// Producer side.
+        MicConverter converter;
+        /// Mixer thread side: user whose audio is in the queue, and whether it is being played.
+        uint32_t mixed_user;
+        bool playing;
+    };
+
+    void run(unsigned int rate, unsigned int jitter_ms);
+    void stop();
+    bool member(const Mix &mix, uint32_t user_id) const;
+
+    void *ptr_to_rust_;
+    unsigned int max_inputs_;
+    Input *inputs_;
+    Mix mixes_[AUDIO_MAX_MIXES];
+    /// Guards mixes_, held by the thread while it mixes one period.
+    std::mutex mixes_mutex_;
+    /// Serializes configure().
+    std::mutex mutex_;
+    std::thread thread_;
+    std::atomic<bool> running_;
+    std::atomic<unsigned int> sample_rate_;
+    std::atomic<unsigned int> jitter_ms_;
+    std::atomic<unsigned int> mix_count_;
+    std::atomic<uint64_t> ticks_;
+    std::atomic<uint64_t> late_ticks_;
+    std::atomic<uint64_t> delivered_frames_;
+    std::atomic<uint64_t> underruns_;
+    std::atomic<uint64_t> dropped_bytes_;
+    std::atomic<int64_t> max_lateness_us_;
+    std::atomic<int64_t> max_mix_us_;
+    std::atomic<unsigned int> active_inputs_;
+};
+
+#endif
@@ -0,0 +1,177 @@
+#include "c_audio_overload.h"
+#include "c_audio_dsp.h"
+
+AudioOverloadLane::AudioOverloadLane() {
+    degraded = false;
+    shed = false;
+}
+
+AudioOverloadPolicy::AudioOverloadPolicy() {
+    for (unsigned int i = 0; i < STREAMS; i += 1) {
+        Stream &stream = streams_[i];
+        stream.policy.store(AUDIO_OVERLOAD_NEVER_DROP, std::memory_order_relaxed);
+        stream.high_water_percent.store(50, std::memory_order_relaxed);
+        stream.degrade_rate.store(16000, std::memory_order_relaxed);
+        stream.dropped_silent_frames.store(0, std::memory_order_relaxed);
+        stream.degraded_frames.store(0, std::memory_order_relaxed);
+        stream.degrade_events.store(0, std::memory_order_relaxed);
+        stream.shed_frames.store(0, std::memory_order_relaxed);
+        stream.shed_events.store(0, std::memory_order_relaxed);
+        stream.unshed_frames.store(0, std::memory_order_relaxed);
+        stream.degraded_queues.store(0, std::memory_order_relaxed);
+        stream.shed_users.store(0, std::memory_order_relaxed);
+    }
+}
+
+bool AudioOverloadPolicy::configure(unsigned int stream, enum audio_overload_policy policy,
+                                    unsigned int high_water_percent, unsigned int degrade_rate) {
+    if (stream >= STREAMS || policy > AUDIO_OVERLOAD_SHED_USERS) {
+        return false;
+    }
+    if (policy == AUDIO_OVERLOAD_SHED_USERS && stream != AUDIO_STREAM_ONE_WAY) {
+        return false;
+    }
+    if (high_water_percent == 0 || high_water_percent > 99) {
+        return false;
+    }
+    if (degrade_rate < 8000 || degrade_rate > 48000 || degrade_rate % 100 != 0) {
+        return false;
+    }
+    // Lanes engaged by the previous policy are let go by their next frame.
+    streams_[stream].high_water_percent.store(high_water_percent, std::memory_order_relaxed);
+    streams_[stream].degrade_rate.store(degrade_rate, std::memory_order_relaxed);
+    streams_[stream].policy.store(policy, std::memory_order_release);
+    return true;
+}
+
+bool AudioOverloadPolicy::admit(unsigned int stream, size_t used, size_t capacity, AudioOverloadLane &lane, AudioOverloadLane *sender,
+                                double silence_power, struct exported_audio_raw_data &data, bool *silent) {
+    Stream &state = streams_[stream];
+    int policy = state.policy.load(std::memory_order_acquire);
+    *silent = false;
+    if (policy == AUDIO_OVERLOAD_NEVER_DROP && !lane.degraded && !(sender && sender->shed)) {
+        return true;
+    }
+    size_t high = capacity / 100 * state.high_water_percent.load(std::memory_order_relaxed);
+    // Hysteresis: a queue only recovers once the drain has caught up with half the mark.
+    size_t low = high / 2;
+
+    bool shed = policy >= AUDIO_OVERLOAD_SHED_USERS;
+    size_t shed_mark = high + (capacity - high) / 2;
+    if (sender) {
+        // On a ring shared by several users, each one backing it up is shed on its own.
+        if (sender->shed && (!shed || used < low)) {
+            sender->shed = false;
+            state.shed_users.fetch_sub(1, std::memory_order_relaxed);
+        } else if (!sender->shed && shed && used >= shed_mark) {
+            sender->shed = true;
+            state.shed_users.fetch_add(1, std::memory_order_relaxed);
+            state.shed_events.fetch_add(1, std::memory_order_relaxed);
+        }
+        if (sender->shed) {
+            state.shed_frames.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+    } else if (shed && used >= shed_mark) {
+        state.unshed_frames.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    bool degrade_rate = policy >= AUDIO_OVERLOAD_DEGRADE;
+    if (lane.degraded && (!degrade_rate || used < low)) {
+        lane.degraded = false;
+        state.degraded_queues.fetch_sub(1, std::memory_order_relaxed);
+    } else if (!lane.degraded && degrade_rate && used >= high) {
+        lane.degraded = true;
+        // The history belongs to frames queued before the last recovery.
+        lane.resampler.reset();
+        state.degraded_queues.fetch_add(1, std::memory_order_relaxed);
+        state.degrade_events.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (policy == AUDIO_OVERLOAD_NEVER_DROP) {
+        return true;
+    }
+
+    // Measured on every frame: the drain decides when the ring is over the mark, by then the frame is old.
+    *silent = AudioOverloadPolicy::silent(data, silence_power);
+    unsigned int rate = state.degrade_rate.load(std::memory_order_relaxed);
+    if (lane.degraded && data.sample_index < 0 && data.sample_rate > rate) {
+        degrade(lane, rate, data);
+        state.degraded_frames.fetch_add(1, std::memory_order_relaxed);
+    }
+    return true;
+}
+
+bool AudioOverloadPolicy::drops_silence(unsigned int stream, size_t used, size_t capacity) const {
+    const Stream &state = streams_[stream];
+    if (state.policy.load(std::memory_order_acquire) == AUDIO_OVERLOAD_NEVER_DROP) {
+        return false;
+    }
+    return used >= capacity / 100 * state.high_water_percent.load(std::memory_order_relaxed);
+}
+
+bool AudioOverloadPolicy::stats(unsigned int stream, struct audio_overload_stats *out) const {
+    if (stream >= STREAMS) {
+        return false;
+    }
+    const Stream &state = streams_[stream];
+    out->dropped_silent_frames = state.dropped_silent_frames.load(std::memory_order_relaxed);
+    out->degraded_frames = state.degraded_frames.load(std::memory_order_relaxed);
+    out->degrade_events = state.degrade_events.load(std::memory_order_relaxed);
+    out->shed_frames = state.shed_frames.load(std::memory_order_relaxed);
+    out->shed_events = state.shed_events.load(std::memory_order_relaxed);
+    out->unshed_frames = state.unshed_frames.load(std::memory_order_relaxed);
+    out->degraded_queues = state.degraded_queues.load(std::memory_order_relaxed);
+    out->shed_users = state.shed_users.load(std::memory_order_relaxed);
+    out->policy = static_cast<enum audio_overload_policy>(state.policy.load(std::memory_order_relaxed));
+    out->high_water_percent = state.high_water_percent.load(std::memory_order_relaxed);
+    out->degrade_rate = state.degrade_rate.load(std::memory_order_relaxed);
+    return true;
+}
+
+bool AudioOverloadPolicy::silent(const struct exported_audio_raw_data &data, double silence_power) {
+    if (data.format == AUDIO_SAMPLE_F32) {
+        size_t samples = data.len / sizeof(float);
+        if (samples == 0) {
+            return false;
+        }
+        const float *pcm = reinterpret_cast<const float*>(data.data);
+        return dsp_dot_f32(pcm, pcm, samples) < silence_power * samples;
+    }
+    size_t samples = data.len / sizeof(int16_t);
+    if (samples == 0) {
+        return false;
+    }
+    struct pcm_activity activity;
+    dsp_s16_activity(reinterpret_cast<const int16_t*>(data.data), samples, data.channels, &activity);
+    // Energies rather than levels, as in the voice activity gate.
+    return activity.energy < silence_power * static_cast<double>(samples) * 32768.0 * 32768.0;
+}
+
+void AudioOverloadPolicy::degrade(AudioOverloadLane &lane, unsigned int rate, struct exported_audio_raw_data &data) {
+    bool f32 = data.format == AUDIO_SAMPLE_F32;
+    size_t sample_size = f32 ? sizeof(float) : sizeof(int16_t);
+    size_t samples = data.len / sample_size;
+    size_t frames = samples / data.channels;
+    size_t max_samples = AudioResampler::max_output(frames, data.sample_rate, rate) * data.channels;
+    const float *in = reinterpret_cast<const float*>(data.data);
+    if (!f32) {
+        if (lane.work.size() < samples + max_samples) {
+            lane.work.resize(samples + max_samples);
+        }
+        dsp_s16_to_f32(reinterpret_cast<const int16_t*>(data.data), lane.work.data(), samples, 1.0f / 32768.0f);
+        in = lane.work.data();
+    }
+    if (lane.out.size() < max_samples * sizeof(float)) {
+        lane.out.resize(max_samples * sizeof(float));
+    }
+    // Floats are resampled straight into `out`, 16-bit PCM goes through the end of `work`.
+    float *resampled = f32 ? reinterpret_cast<float*>(lane.out.data()) : lane.work.data() + samples;
+    size_t out_samples = lane.resampler.process(in, frames, data.channels, data.sample_rate, rate, resampled) * data.channels;
+    if (!f32) {
+        dsp_f32_to_s16(resampled, reinterpret_cast<int16_t*>(lane.out.data()), out_samples, 32768.0f);
+    }
+    data.data = lane.out.data();
+    data.len = out_samples * sample_size;
+    data.sample_rate = rate;
+    data.raw = nullptr;
+}
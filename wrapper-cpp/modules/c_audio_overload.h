@@ -0,0 +1,83 @@
+#ifndef _C_AUDIO_OVERLOAD_H_
+#define _C_AUDIO_OVERLOAD_H_
+
+#include "c_rawdata_audio_helper.h"
+#include "c_audio_resampler.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// @brief Overload state of one queue or one sender, written by the SDK thread feeding it only.
+struct AudioOverloadLane {
+    AudioOverloadLane();
+
+    bool degraded;
+    bool shed;
+    /// Degraded frames, rebuilt in `out` until the next frame of the queue.
+    AudioResampler resampler;
+    std::vector<float> work;
+    std::vector<char> out;
+};
+
+/// @brief Per-stream overload policies of the queued delivery mode, see audio_helper_set_overload_policy.
+///
+/// The producer asks admit() before each push: it measures the frame for the drain, resamples it
+/// while its queue is over the high-water mark, or turns it away while its user is shed. The
+/// drain asks drops_silence() once per ring and skips the silent records, oldest first, until the
+/// backlog is gone. Both sides only look at the ring fill, so the SDK thread never waits for Rust.
+class AudioOverloadPolicy {
+public:
+    AudioOverloadPolicy();
+    AudioOverloadPolicy(const AudioOverloadPolicy &) = delete;
+    AudioOverloadPolicy &operator=(const AudioOverloadPolicy &) = delete;
+
+    /// @return false if the stream is unknown, the settings invalid, or users are shed from another stream than one-way.
+    bool configure(unsigned int stream, enum audio_overload_policy policy, unsigned int high_water_percent, unsigned int degrade_rate);
+
+    /// @brief Decide the fate of a frame about to be queued. Producer side only.
+    /// @param used Bytes waiting in the ring, `capacity` its size.
+    /// @param sender Lane of the user who sent the frame, whose `shed` state applies: `lane` itself
+    /// on a per-user ring, NULL if the sender cannot be shed.
+    /// @param silence_power Mean power, relative to full scale, under which the frame is silent.
+    /// @param data Replaced by the lane's degraded copy when the rate is lowered.
+    /// @param silent Set when the frame can be skipped by the drain.
+    /// @return false if the frame is not to be queued.
+    bool admit(unsigned int stream, size_t used, size_t capacity, AudioOverloadLane &lane, AudioOverloadLane *sender,
+               double silence_power, struct exported_audio_raw_data &data, bool *silent);
+
+    /// @brief Whether the drain of a ring holding `used` bytes skips silent records. Consumer side only.
+    bool drops_silence(unsigned int stream, size_t used, size_t capacity) const;
+
+    void count_dropped_silence(unsigned int stream) {
+        streams_[stream].dropped_silent_frames.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    bool stats(unsigned int stream, struct audio_overload_stats *out) const;
+
+private:
+    static constexpr unsigned int STREAMS = AUDIO_STREAM_INTERPRETER + 1;
+
+    /// Settings and counters of one stream.
+    struct Stream {
+        std::atomic<int> policy;
+        std::atomic<unsigned int> high_water_percent;
+        std::atomic<unsigned int> degrade_rate;
+        std::atomic<uint64_t> dropped_silent_frames;
+        std::atomic<uint64_t> degraded_frames;
+        std::atomic<uint64_t> degrade_events;
+        std::atomic<uint64_t> shed_frames;
+        std::atomic<uint64_t> shed_events;
+        std::atomic<uint64_t> unshed_frames;
+        std::atomic<unsigned int> degraded_queues;
+        std::atomic<unsigned int> shed_users;
+    };
+
+    static bool silent(const struct exported_audio_raw_data &data, double silence_power);
+    static void degrade(AudioOverloadLane &lane, unsigned int rate, struct exported_audio_raw_data &data);
+
+    Stream streams_[STREAMS];
+};
+
+#endif
@@ -0,0 +1,178 @@
+#include "c_audio_resampler.h"
+#include "c_audio_dsp.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <numeric>
+
+/// Taps per phase at unity ratio, scaled with the decimation factor and rounded to the SIMD width.
+constexpr unsigned int RESAMPLER_BASE_TAPS = 24;
+/// Kaiser window parameter, about 80 dB of stopband attenuation.
+constexpr double RESAMPLER_KAISER_BETA = 8.0;
+/// Passband edge as a fraction of the output Nyquist frequency.
+constexpr double RESAMPLER_PASSBAND = 0.92;
+
+struct ResamplerFilterBank {
+    unsigned int up;
+    unsigned int down;
+    unsigned int taps;
+    /// `up` phases of `taps` coefficients, reversed to line up with ascending input samples.
+    std::vector<float> coefficients;
+    /// Bank published before this one.
+    const ResamplerFilterBank *next;
+};
+
+/// Banks designed so far, newest first. Pushed with a CAS and never freed, so lookups take no lock.
+static std::atomic<const ResamplerFilterBank*> filter_banks(nullptr);
+
+static double bessel_i0(double x) {
+    double sum = 1.0;
+    double term = 1.0;
+    for (int k = 1; k < 32; k += 1) {
+        term *= (x / (2.0 * k)) * (x / (2.0 * k));
+        sum += term;
+    }
+    return sum;
+}
+
+static ResamplerFilterBank *design_filter_bank(unsigned int up, unsigned int down) {
+    ResamplerFilterBank *bank = new ResamplerFilterBank();
+    unsigned int widest = std::max(up, down);
+    unsigned int taps = (RESAMPLER_BASE_TAPS * widest + up - 1) / up;
+    taps = (taps + 7) & ~7u;
+    bank->up = up;
+    bank->down = down;
+    bank->taps = taps;
+    bank->next = nullptr;
+    bank->coefficients.resize(static_cast<size_t>(up) * taps);
+
+    // Windowed sinc prototype at the upsampled rate, cut at the lower of the two Nyquist frequencies.
+    size_t length = static_cast<size_t>(up) * taps;
+    double cutoff = 0.5 * RESAMPLER_PASSBAND / widest;
+    double center = (length - 1) / 2.0;
+    double norm = bessel_i0(RESAMPLER_KAISER_BETA);
+    std::vector<double> prototype(length);
+    for (size_t i = 0; i < length; i += 1) {
+        double x = i - center;
+        double sinc = x == 0.0 ? 2.0 * cutoff : sin(2.0 * M_PI * cutoff * x) / (M_PI * x);
+        double r = x / (center + 1.0);
+        prototype[i] = sinc * bessel_i0(RESAMPLER_KAISER_BETA * sqrt(1.0 - r * r)) / norm;
+    }
+
+    // Split into phases, each normalized to unity DC gain.
+    for (unsigned int phase = 0; phase < up; phase += 1) {
+        double sum = 0.0;
+        for (unsigned int j = 0; j < taps; j += 1) {
+            sum += prototype[phase + static_cast<size_t>(j) * up];
+        }
+        float *out = &bank->coefficients[static_cast<size_t>(phase) * taps];
+        for (unsigned int j = 0; j < taps; j += 1) {
+            out[taps - 1 - j] = static_cast<float>(prototype[phase + static_cast<size_t>(j) * up] / sum);
+        }
+    }
+    return bank;
+}
+
+static const ResamplerFilterBank *find_filter_bank(const ResamplerFilterBank *bank, unsigned int up, unsigned int down) {
+    for (; bank; bank = bank->next) {
+        if (bank->up == up && bank->down == down) {
+            return bank;
+        }
+    }
+    return nullptr;
+}
+
+static const ResamplerFilterBank *filter_bank(unsigned int up, unsigned int down) {
+    const ResamplerFilterBank *head = filter_banks.load(std::memory_order_acquire);
+    ResamplerFilterBank *designed = nullptr;
+    while (true) {
+        // Rescanned after a failed push: another thread may have published the same ratio meanwhile.
+        const ResamplerFilterBank *found = find_filter_bank(head, up, down);
+        if (found) {
+            delete designed;
+            return found;
+        }
+        if (!designed) {
+            designed = design_filter_bank(up, down);
+        }
+        designed->next = head;
+        if (filter_banks.compare_exchange_weak(head, designed, std::memory_order_release, std::memory_order_acquire)) {
+            return designed;
+        }
+    }
+}
+
+AudioResampler::AudioResampler() {
+    bank_ = nullptr;
+    channels_ = 0;
+    in_rate_ = 0;
+    out_rate_ = 0;
+    position_ = 0;
+}
+
+AudioResampler::~AudioResampler() {
+}
+
+size_t AudioResampler::max_output(size_t frames, unsigned int in_rate, unsigned int out_rate) {
+    return (frames * out_rate + in_rate - 1) / in_rate + 1;
+}
+
+void AudioResampler::prepare(unsigned int in_rate, unsigned int out_rate) {
+    if (in_rate == 0 || out_rate == 0 || in_rate == out_rate) {
+        return;
+    }
+    unsigned int divisor = std::gcd(in_rate, out_rate);
+    filter_bank(out_rate / divisor, in_rate / divisor);
+}
+
+void AudioResampler::configure(unsigned int channels, unsigned int in_rate, unsigned int out_rate) {
+    unsigned int divisor = std::gcd(in_rate, out_rate);
+    bank_ = filter_bank(out_rate / divisor, in_rate / divisor);
+    channels_ = channels;
+    in_rate_ = in_rate;
+    out_rate_ = out_rate;
+    history_.assign(static_cast<size_t>(channels) * (bank_->taps - 1), 0.0f);
+    position_ = 0;
+}
+
+void AudioResampler::reset() {
+    std::fill(history_.begin(), history_.end(), 0.0f);
+    position_ = 0;
+}
+
+size_t AudioResampler::process(const float *in, size_t frames, unsigned int channels,
+                               unsigned int in_rate, unsigned int out_rate, float *out) {
+    if (channels == 0 || in_rate == 0 || out_rate == 0) {
+        return 0;
+    }
+    if (!bank_ || channels != channels_ || in_rate != in_rate_ || out_rate != out_rate_) {
+        configure(channels, in_rate, out_rate);
+    }
+    const unsigned int up = bank_->up;
+    const unsigned int down = bank_->down;
+    const unsigned int taps = bank_->taps;
+    const size_t keep = taps - 1;
+    const uint64_t end = static_cast<uint64_t>(frames) * up;
+    work_.resize(keep + frames);
+
+    size_t produced = 0;
+    for (unsigned int c = 0; c < channels; c += 1) {
+        float *history = &history_[c * keep];
+        std::copy(history, history + keep, work_.begin());
+        for (size_t i = 0; i < frames; i += 1) {
+            work_[keep + i] = in[i * channels + c];
+        }
+        size_t k = 0;
+        for (uint64_t position = position_; position < end; position += down) {
+            size_t n = position / up;
+            unsigned int phase = position % up;
+            out[k * channels + c] = dsp_dot_f32(&work_[n], &bank_->coefficients[static_cast<size_t>(phase) * taps], taps);
+            k += 1;
+        }
+        produced = k;
+        std::copy(work_.begin() + frames, work_.begin() + frames + keep, history);
+    }
+    position_ = position_ + static_cast<uint64_t>(produced) * down - end;
+    return produced;
+}
@@ -0,0 +1,56 @@
+#ifndef _C_AUDIO_RESAMPLER_H_
+#define _C_AUDIO_RESAMPLER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// @brief Coefficients of a rational L/M polyphase filter, shared by every stream using the same ratio.
+struct ResamplerFilterBank;
+
+/// @brief Streaming polyphase resampler for interleaved float PCM.
+///
+/// The ratio is reduced to L/M and each output sample is the dot product of one of the L filter
+/// phases with the input history, so the cost is proportional to the output rate. The filter
+/// history and the fractional position are carried across frames, so consecutive frames of a
+/// stream resample without clicks. One instance per stream, not thread safe.
+class AudioResampler {
+public:
+    AudioResampler();
+    ~AudioResampler();
+    AudioResampler(const AudioResampler &) = delete;
+    AudioResampler &operator=(const AudioResampler &) = delete;
+
+    /// @brief Upper bound of the frames produced by process() for `frames` input frames.
+    static size_t max_output(size_t frames, unsigned int in_rate, unsigned int out_rate);
+
+    /// @brief Design the filter of a ratio ahead, from a configuration thread, so that the stream
+    /// threads only look it up. A ratio process() meets unprepared is designed on its thread.
+    static void prepare(unsigned int in_rate, unsigned int out_rate);
+
+    /// @brief Resample `frames` interleaved frames into `out`, sized with max_output().
+    /// The filter is redesigned, and the history cleared, when the rates or the channel count change.
+    /// @return The number of frames written to `out`.
+    size_t process(const float *in, size_t frames, unsigned int channels,
+                   unsigned int in_rate, unsigned int out_rate, float *out);
+
+    /// @brief Forget the history, used when the stream is handed to another user.
+    void reset();
+
+private:
+    void configure(unsigned int channels, unsigned int in_rate, unsigned int out_rate);
+
+    /// Banks are shared by all streams and never freed.
+    const ResamplerFilterBank *bank_;
+    unsigned int channels_;
+    unsigned int in_rate_;
+    unsigned int out_rate_;
+    /// Position of the next output sample, in 1/L input samples from the start of the next frame.
+    uint64_t position_;
+    /// Last taps - 1 input samples of every channel, planar.
+    std::vector<float> history_;
+    /// History followed by the current frame of one channel.
+    std::vector<float> work_;
+};
+
+#endif
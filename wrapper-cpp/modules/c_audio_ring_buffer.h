@@ -0,0 +1,310 @@
+#ifndef _C_AUDIO_RING_BUFFER_H_
+#define _C_AUDIO_RING_BUFFER_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+/// @brief Counters exposed by a SpscRecordRing. All values are monotonic except high_water.
+struct spsc_ring_counters {
+    uint64_t pushed;
+    uint64_t dropped;
+    uint64_t dropped_bytes;
+    uint64_t drained;
+    uint64_t high_water;
+};
+
+/// @brief Single-producer / single-consumer ring of variable length records.
+///
+/// The producer is the SDK callback thread, the consumer is whatever thread calls the drain API.
+/// Every record is a fixed `Header` followed by its payload, padded to 8 bytes. A record never
+/// wraps around the end of the buffer: when it does not fit, the producer skips the remaining
+/// bytes (writing a zero-sized marker when there is room for one) and restarts at offset 0.
+/// The producer never blocks and never allocates: when the ring is full the frame is dropped
+/// and accounted in the overflow counters.
+template <typename Header>
+class SpscRecordRing {
+public:
+    explicit SpscRecordRing(size_t capacity) {
+        capacity_ = align(capacity < sizeof(Slot) ? sizeof(Slot) : capacity);
+        buffer_ = static_cast<char *>(aligned_alloc(64, align64(capacity_)));
+        head_.store(0, std::memory_order_relaxed);
+        tail_.store(0, std::memory_order_relaxed);
+        pushed_.store(0, std::memory_order_relaxed);
+        dropped_.store(0, std::memory_order_relaxed);
+        dropped_bytes_.store(0, std::memory_order_relaxed);
+        drained_.store(0, std::memory_order_relaxed);
+        high_water_.store(0, std::memory_order_relaxed);
+    }
+    ~SpscRecordRing() {
+        free(buffer_);
+    }
+    SpscRecordRing(const SpscRecordRing &) = delete;
+    SpscRecordRing &operator=(const SpscRecordRing &) = delete;
+
+    /// @brief Allocate a ring without throwing, for the extern "C" entry points.
+    /// @return NULL if the memory is not available.
+    static SpscRecordRing *create(size_t capacity) {
+        SpscRecordRing *ring = new (std::nothrow) SpscRecordRing(capacity);
+        if (ring && !ring->buffer_) {
+            delete ring;
+            return nullptr;
+        }
+        return ring;
+    }
+
+    /// @brief Copy one record into the ring. Producer side only.
+    /// @return false if the record did not fit, in which case it is counted as dropped.
+    bool push(const Header &header, const char *payload, uint32_t len) {
+        size_t need = align(sizeof(Slot) + len);
+        uint64_t head = head_.load(std::memory_order_relaxed);
+        uint64_t tail = tail_.load(std::memory_order_acquire);
+        size_t offset = head % capacity_;
+        size_t room_to_end = capacity_ - offset;
+        size_t pad = room_to_end < need ? room_to_end : 0;
+
+        if (need > capacity_ || head + pad + need - tail > capacity_) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            dropped_bytes_.fetch_add(len, std::memory_order_relaxed);
+            return false;
+        }
+        if (pad != 0) {
+            if (room_to_end >= sizeof(Slot)) {
+                reinterpret_cast<Slot *>(buffer_ + offset)->size = 0;
+            }
+            head += pad;
+            offset = 0;
+        }
+        Slot *slot = reinterpret_cast<Slot *>(buffer_ + offset);
+        slot->size = static_cast<uint32_t>(need);
+        slot->len = len;
+        slot->header = header;
+        if (len != 0) {
+            memcpy(buffer_ + offset + sizeof(Slot), payload, len);
+        }
+        head += need;
+        head_.store(head, std::memory_order_release);
+
+        uint64_t used = head - tail;
+        if (used > high_water_.load(std::memory_order_relaxed)) {
+            high_water_.store(used, std::memory_order_relaxed);
+        }
+        pushed_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    /// @brief Hand at most `max_records` records to `visit(header, payload, len)`. Consumer side only.
+    /// Payloads stay valid until `visit` returns.
+    /// @return The number of visited records.
+    template <typename F>
+    unsigned int drain(F &&visit, unsigned int max_records) {
+        return drain(visit, max_records, []() {});
+    }
+
+    /// @brief Same as drain(visit, max_records), then call `done()` before the records are released:
+    /// every payload handed to `visit` stays valid until `done` returns, so they can be consumed together.
+    template <typename F, typename D>
+    unsigned int drain(F &&visit, unsigned int max_records, D &&done) {
+        uint64_t tail = tail_.load(std::memory_order_relaxed);
+        uint64_t head = head_.load(std::memory_order_acquire);
+        unsigned int count = 0;
+
+        while (count < max_records && tail != head) {
+            size_t offset = tail % capacity_;
+            size_t room_to_end = capacity_ - offset;
+            if (room_to_end < sizeof(Slot)) {
+                tail += room_to_end;
+                continue;
+            }
+            Slot *slot = reinterpret_cast<Slot *>(buffer_ + offset);
+            if (slot->size == 0) {
+                tail += room_to_end;
+                continue;
+            }
+            visit(slot->header, buffer_ + offset + sizeof(Slot), slot->len);
+            tail += slot->size;
+            count += 1;
+        }
+        done();
+        tail_.store(tail, std::memory_order_release);
+        drained_.fetch_add(count, std::memory_order_relaxed);
+        return count;
+    }
+
+    /// @brief Bytes currently waiting to be drained, padding included.
+    size_t used() const {
+        return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+    }
+
+    size_t capacity() const {
+        return capacity_;
+    }
+
+    bool empty() const {
+        return used() == 0;
+    }
+
+    void counters(struct spsc_ring_counters *out) const {
+        out->pushed = pushed_.load(std::memory_order_relaxed);
+        out->dropped = dropped_.load(std::memory_order_relaxed);
+        out->dropped_bytes = dropped_bytes_.load(std::memory_order_relaxed);
+        out->drained = drained_.load(std::memory_order_relaxed);
+        out->high_water = high_water_.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct Slot {
+        uint32_t size; // Record size including this slot, 0 marks a skip to offset 0.
+        uint32_t len;  // Payload length.
+        Header header;
+    };
+
+    static constexpr size_t align(size_t n) {
+        return (n + 7) & ~static_cast<size_t>(7);
+    }
+    static constexpr size_t align64(size_t n) {
+        return (n + 63) & ~static_cast<size_t>(63);
+    }
+
+    char *buffer_;
+    size_t capacity_;
+    alignas(64) std::atomic<uint64_t> head_;
+    alignas(64) std::atomic<uint64_t> tail_;
+    alignas(64) std::atomic<uint64_t> pushed_;
+    std::atomic<uint64_t> dropped_;
+    std::atomic<uint64_t> dropped_bytes_;
+    std::atomic<uint64_t> high_water_;
+    alignas(64) std::atomic<uint64_t> drained_;
+};
+
+/// @brief Single-producer / single-consumer byte stream.
+///
+/// Unlike SpscRecordRing, writes and reads of any size are cut at the ring boundary and
+/// copied in two parts, so a stream can be consumed in chunks unrelated to how it was written.
+class SpscByteRing {
+public:
+    explicit SpscByteRing(size_t capacity) {
+        capacity_ = capacity;
+        buffer_ = static_cast<char *>(malloc(capacity_));
+        head_.store(0, std::memory_order_relaxed);
+        tail_.store(0, std::memory_order_relaxed);
+    }
+    ~SpscByteRing() {
+        free(buffer_);
+    }
+    SpscByteRing(const SpscByteRing &) = delete;
+    SpscByteRing &operator=(const SpscByteRing &) = delete;
+
+    /// @brief Copy at most `len` bytes, rounded down to a multiple of `unit`. Producer side only.
+    /// @return The number of bytes written.
+    size_t write(const char *data, size_t len, size_t unit) {
+        uint64_t head = head_.load(std::memory_order_relaxed);
+        uint64_t tail = tail_.load(std::memory_order_acquire);
+        size_t room = capacity_ - (head - tail);
+        if (len > room) {
+            len = room;
+        }
+        len -= len % unit;
+        size_t offset = head % capacity_;
+        size_t first = capacity_ - offset < len ? capacity_ - offset : len;
+        memcpy(buffer_ + offset, data, first);
+        memcpy(buffer_, data + first, len - first);
+        head_.store(head + len, std::memory_order_release);
+        return len;
+    }
+
+    /// @brief Move at most `len` bytes into `out`. Consumer side only.
+    /// @return The number of bytes read.
+    size_t read(char *out, size_t len) {
+        uint64_t tail = tail_.load(std::memory_order_relaxed);
+        uint64_t head = head_.load(std::memory_order_acquire);
+        if (len > head - tail) {
+            len = head - tail;
+        }
+        size_t offset = tail % capacity_;
+        size_t first = capacity_ - offset < len ? capacity_ - offset : len;
+        memcpy(out, buffer_ + offset, first);
+        memcpy(out + first, buffer_, len - first);
+        tail_.store(tail + len, std::memory_order_release);
+        return len;
+    }
+
+    size_t used() const {
+        return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+    }
+
+    size_t capacity() const {
+        return capacity_;
+    }
+
+private:
+    char *buffer_;
+    size_t capacity_;
+    alignas(64) std::atomic<uint64_t> head_;
+    alignas(64) std::atomic<uint64_t> tail_;
+};
+
+/// @brief Single-producer / single-consumer queue of fixed size, trivially copyable elements.
+///
+/// For records that own something, e.g. a reference: a failed push leaves the element to the
+/// producer, which can give it back, where SpscRecordRing would only count the drop.
+template <typename T>
+class SpscQueue {
+public:
+    explicit SpscQueue(size_t capacity) {
+        capacity_ = capacity != 0 ? capacity : 1;
+        slots_ = new T[capacity_];
+        head_.store(0, std::memory_order_relaxed);
+        tail_.store(0, std::memory_order_relaxed);
+    }
+    ~SpscQueue() {
+        delete[] slots_;
+    }
+    SpscQueue(const SpscQueue &) = delete;
+    SpscQueue &operator=(const SpscQueue &) = delete;
+
+    /// @return false if the queue is full. Producer side only.
+    bool push(const T &value) {
+        uint64_t head = head_.load(std::memory_order_relaxed);
+        if (head - tail_.load(std::memory_order_acquire) == capacity_) {
+            return false;
+        }
+        slots_[head % capacity_] = value;
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// @brief Move at most `cap` elements into `out`. Consumer side only.
+    /// @return The number of elements moved.
+    size_t pop(T *out, size_t cap) {
+        uint64_t tail = tail_.load(std::memory_order_relaxed);
+        uint64_t head = head_.load(std::memory_order_acquire);
+        size_t count = 0;
+        while (count < cap && tail != head) {
+            out[count] = slots_[tail % capacity_];
+            tail += 1;
+            count += 1;
+        }
+        tail_.store(tail, std::memory_order_release);
+        return count;
+    }
+
+    size_t size() const {
+        return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+    }
+
+    size_t capacity() const {
+        return capacity_;
+    }
+
+private:
+    T *slots_;
+    size_t capacity_;
+    alignas(64) std::atomic<uint64_t> head_;
+    alignas(64) std::atomic<uint64_t> tail_;
+};
+
+#endif
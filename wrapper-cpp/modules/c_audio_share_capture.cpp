@@ -0,0 +1,130 @@
+#include "c_audio_share_capture.h"
+
+#include <cstring>
+
+PooledAudioRawData::PooledAudioRawData() {
+    len_ = 0;
+    sample_rate_ = 0;
+    channels_ = 0;
+    timestamp_ = 0;
+    refs_.store(0, std::memory_order_relaxed);
+}
+
+bool PooledAudioRawData::acquire() {
+    if (busy()) {
+        return false;
+    }
+    // Only the producer takes free objects, nobody else can raise the count from 0.
+    refs_.store(1, std::memory_order_relaxed);
+    return true;
+}
+
+void PooledAudioRawData::fill(const struct exported_audio_raw_data &data) {
+    if (buffer_.size() < data.len) {
+        // Grows to the largest frame seen, then stays.
+        buffer_.resize(data.len);
+    }
+    memcpy(buffer_.data(), data.data, data.len);
+    len_ = data.len;
+    sample_rate_ = data.sample_rate;
+    channels_ = data.channels;
+    timestamp_ = data.sdk_time;
+}
+
+ShareAudioCapture::ShareAudioCapture() {
+    queue_.store(nullptr, std::memory_order_relaxed);
+    cursor_ = 0;
+    enabled_.store(false, std::memory_order_relaxed);
+    zero_copy_.store(0, std::memory_order_relaxed);
+    copied_.store(0, std::memory_order_relaxed);
+    dropped_.store(0, std::memory_order_relaxed);
+    popped_.store(0, std::memory_order_relaxed);
+}
+
+ShareAudioCapture::~ShareAudioCapture() {
+    ShareQueue *queue = queue_.load(std::memory_order_acquire);
+    if (!queue) {
+        return;
+    }
+    struct share_audio_packet packet;
+    while (queue->pop(&packet, 1) == 1) {
+        packet.data.raw->Release();
+    }
+    delete queue;
+}
+
+bool ShareAudioCapture::configure(bool enabled, unsigned int capacity, unsigned int pool_size) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (enabled && !queue_.load(std::memory_order_relaxed)) {
+        for (unsigned int i = 0; i < pool_size; i += 1) {
+            pool_.emplace_back(new PooledAudioRawData());
+        }
+        queue_.store(new ShareQueue(capacity), std::memory_order_release);
+    }
+    enabled_.store(enabled, std::memory_order_release);
+    return true;
+}
+
+void ShareAudioCapture::capture(const struct exported_audio_raw_data &data, uint32_t user_id) {
+    ShareQueue *queue = queue_.load(std::memory_order_acquire);
+    struct share_audio_packet packet = {
+        data: data,
+        user_id: user_id,
+    };
+    bool zero_copy = data.raw && data.raw->CanAddRef() && data.raw->AddRef();
+    if (!zero_copy) {
+        PooledAudioRawData *pooled = acquire();
+        if (!pooled) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        pooled->fill(data);
+        packet.data.data = pooled->GetBuffer();
+        packet.data.raw = pooled;
+    }
+    if (!queue->push(packet)) {
+        packet.data.raw->Release();
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    (zero_copy ? zero_copy_ : copied_).fetch_add(1, std::memory_order_relaxed);
+}
+
+PooledAudioRawData *ShareAudioCapture::acquire() {
+    for (size_t i = 0; i < pool_.size(); i += 1) {
+        PooledAudioRawData *pooled = pool_[cursor_].get();
+        cursor_ = (cursor_ + 1) % pool_.size();
+        if (pooled->acquire()) {
+            return pooled;
+        }
+    }
+    return nullptr;
+}
+
+unsigned int ShareAudioCapture::pop(struct share_audio_packet *out, unsigned int cap) {
+    ShareQueue *queue = queue_.load(std::memory_order_acquire);
+    if (!queue) {
+        return 0;
+    }
+    unsigned int count = static_cast<unsigned int>(queue->pop(out, cap));
+    popped_.fetch_add(count, std::memory_order_relaxed);
+    return count;
+}
+
+void ShareAudioCapture::stats(struct share_capture_stats *out) const {
+    ShareQueue *queue = queue_.load(std::memory_order_acquire);
+    out->zero_copy_frames = zero_copy_.load(std::memory_order_relaxed);
+    out->copied_frames = copied_.load(std::memory_order_relaxed);
+    out->dropped_frames = dropped_.load(std::memory_order_relaxed);
+    out->popped_frames = popped_.load(std::memory_order_relaxed);
+    out->queued = queue ? static_cast<uint32_t>(queue->size()) : 0;
+    out->capacity = queue ? static_cast<uint32_t>(queue->capacity()) : 0;
+    out->pooled_in_use = 0;
+    if (queue) {
+        for (const std::unique_ptr<PooledAudioRawData> &pooled : pool_) {
+            out->pooled_in_use += pooled->busy() ? 1 : 0;
+        }
+    }
+    out->pool_size = queue ? static_cast<uint32_t>(pool_.size()) : 0;
+    out->enabled = enabled();
+}
@@ -0,0 +1,111 @@
+#ifndef _C_AUDIO_SHARE_CAPTURE_H_
+#define _C_AUDIO_SHARE_CAPTURE_H_
+
+#include "c_rawdata_audio_helper.h"
+#include "c_audio_ring_buffer.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/// @brief Wrapper-owned copy of a frame, refcounted like the SDK buffers so both kinds are released the same way.
+/// Free when its count drops to 0, then reused by the producer.
+class PooledAudioRawData : public AudioRawData {
+public:
+    PooledAudioRawData();
+
+    /// @brief Take the object if it is free, with a count of 1. Producer side only.
+    bool acquire();
+    void fill(const struct exported_audio_raw_data &data);
+    bool busy() const {
+        return refs_.load(std::memory_order_acquire) != 0;
+    }
+
+    bool CanAddRef() override {
+        return true;
+    }
+    bool AddRef() override {
+        refs_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    int Release() override {
+        // Publishes the reads of the buffer before the producer can reuse it.
+        return refs_.fetch_sub(1, std::memory_order_acq_rel) - 1;
+    }
+    char* GetBuffer() override {
+        return buffer_.data();
+    }
+    unsigned int GetBufferLen() override {
+        return len_;
+    }
+    unsigned int GetSampleRate() override {
+        return sample_rate_;
+    }
+    unsigned int GetChannelNum() override {
+        return channels_;
+    }
+    unsigned long long GetTimeStamp() override {
+        return timestamp_;
+    }
+
+private:
+    std::vector<char> buffer_;
+    unsigned int len_;
+    unsigned int sample_rate_;
+    unsigned int channels_;
+    unsigned long long timestamp_;
+    std::atomic<int> refs_;
+};
+
+/// @brief Share audio captured into a bounded queue of refcounted frames, see audio_helper_set_share_capture.
+///
+/// The SDK share thread takes a reference on the SDK buffer when the SDK allows it, and only
+/// copies the frame into a pooled buffer otherwise (converted frame, or reference refused). The
+/// packet is then pushed into a lock-free SPSC queue; when the queue is full or the pool is
+/// exhausted the frame is dropped and its reference given back at once, so the number of
+/// references held by the capture is bounded by the queue and the pool. Nothing on the share
+/// thread blocks, allocates once the pool buffers have grown, or writes to stdio.
+class ShareAudioCapture {
+public:
+    ShareAudioCapture();
+    ~ShareAudioCapture();
+    ShareAudioCapture(const ShareAudioCapture &) = delete;
+    ShareAudioCapture &operator=(const ShareAudioCapture &) = delete;
+
+    /// @brief Start or stop capturing. The queue and the pool are allocated by the first start and kept,
+    /// packets still queued when capture stops can be popped afterwards.
+    bool configure(bool enabled, unsigned int capacity, unsigned int pool_size);
+
+    bool enabled() const {
+        return enabled_.load(std::memory_order_acquire);
+    }
+
+    /// @brief Queue a frame of the sharing user. SDK share thread only.
+    void capture(const struct exported_audio_raw_data &data, uint32_t user_id);
+
+    /// @brief Move at most `cap` packets to the caller, which owns their references. Single consumer.
+    unsigned int pop(struct share_audio_packet *out, unsigned int cap);
+
+    void stats(struct share_capture_stats *out) const;
+
+private:
+    typedef SpscQueue<struct share_audio_packet> ShareQueue;
+
+    PooledAudioRawData *acquire();
+
+    std::atomic<ShareQueue*> queue_;
+    /// Filled before the queue is published, never resized afterwards.
+    std::vector<std::unique_ptr<PooledAudioRawData>> pool_;
+    /// Producer side, where the search for a free pooled buffer starts.
+    size_t cursor_;
+    std::atomic<bool> enabled_;
+    std::mutex mutex_;
+    std::atomic<uint64_t> zero_copy_;
+    std::atomic<uint64_t> copied_;
+    std::atomic<uint64_t> dropped_;
+    std::atomic<uint64_t> popped_;
+};
+
+#endif
@@ -0,0 +1,406 @@
+#include "c_audio_track_writer.h"
+#include "c_media_timeline.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+
+/// Frames handed to one pwritev call.
+constexpr unsigned int TRACK_MAX_IOV = 256;
+constexpr size_t WAV_HEADER_BYTES = 44;
+
+static void put_u16(char *out, uint16_t value) {
+    memcpy(out, &value, sizeof(value));
+}
+
+static void put_u32(char *out, uint32_t value) {
+    memcpy(out, &value, sizeof(value));
+}
+
+/// Canonical 44-byte header, sizes saturate at 4 GiB.
+static void wav_header(char *out, const struct audio_track_header &format, uint64_t size) {
+    uint16_t sample_bytes = format.format == AUDIO_SAMPLE_F32 ? sizeof(float) : sizeof(int16_t);
+    uint32_t data_size = static_cast<uint32_t>(std::min<uint64_t>(size, UINT32_MAX - 36));
+    memcpy(out, "RIFF", 4);
+    put_u32(out + 4, 36 + data_size);
+    memcpy(out + 8, "WAVEfmt ", 8);
+    put_u32(out + 16, 16);
+    // 3 is IEEE float, 1 is integer PCM.
+    put_u16(out + 20, format.format == AUDIO_SAMPLE_F32 ? 3 : 1);
+    put_u16(out + 22, format.channels);
+    put_u32(out + 24, format.sample_rate);
+    put_u32(out + 28, format.sample_rate * format.channels * sample_bytes);
+    put_u16(out + 32, format.channels * sample_bytes);
+    put_u16(out + 34, sample_bytes * 8);
+    memcpy(out + 36, "data", 4);
+    put_u32(out + 40, data_size);
+}
+
+static bool same_format(const struct audio_track_header &a, const struct audio_track_header &b) {
+    return a.user_id == b.user_id && a.format == b.format && a.sample_rate == b.sample_rate && a.channels == b.channels;
+}
+
+AudioTrackWriter::AudioTrackWriter(unsigned int max_tracks) {
+    max_tracks_ = max_tracks;
+    tracks_ = new Track[max_tracks];
+    for (unsigned int i = 0; i < max_tracks; i += 1) {
+        tracks_[i].ring.store(nullptr, std::memory_order_relaxed);
+        tracks_[i].fd = -1;
+        tracks_[i].encoded_frames = 0;
+        tracks_[i].format.sample_rate = 0;
+    }
+    recording_.store(false, std::memory_order_relaxed);
+    ring_capacity_.store(0, std::memory_order_relaxed);
+    stopping_ = false;
+    open_tracks_.store(0, std::memory_order_relaxed);
+    files_.store(0, std::memory_order_relaxed);
+    written_frames_.store(0, std::memory_order_relaxed);
+    written_bytes_.store(0, std::memory_order_relaxed);
+    lost_frames_.store(0, std::memory_order_relaxed);
+    lost_bytes_.store(0, std::memory_order_relaxed);
+    syncs_.store(0, std::memory_order_relaxed);
+    write_errors_.store(0, std::memory_order_relaxed);
+    max_write_us_.store(0, std::memory_order_relaxed);
+    pcm_bytes_.store(0, std::memory_order_relaxed);
+    encode_us_.store(0, std::memory_order_relaxed);
+}
+
+AudioTrackWriter::~AudioTrackWriter() {
+    stop();
+    for (unsigned int i = 0; i < max_tracks_; i += 1) {
+        delete tracks_[i].ring.load(std::memory_order_relaxed);
+    }
+    delete[] tracks_;
+}
+
+bool AudioTrackWriter::start(const AudioTrackSettings &settings) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!threads_.empty() || settings.threads == 0 || access(settings.directory.c_str(), W_OK) != 0) {
+        return false;
+    }
+    settings_ = settings;
+    if (ring_capacity_.load(std::memory_order_relaxed) == 0) {
+        ring_capacity_.store(settings.ring_capacity, std::memory_order_relaxed);
+    }
+    for (unsigned int i = 0; i < max_tracks_; i += 1) {
+        AudioTrackRing *ring = tracks_[i].ring.load(std::memory_order_acquire);
+        if (ring) {
+            // Left over by an append racing with the last stop.
+            ring->drain([](struct audio_track_header &, char *, uint32_t) {}, UINT32_MAX);
+        } else {
+            // Every slot gets its ring here so the SDK audio thread never allocates. Only the pages
+            // a user writes are backed, and the rings are kept for the next recordings.
+            tracks_[i].ring.store(new AudioTrackRing(ring_capacity_.load(std::memory_order_relaxed)), std::memory_order_release);
+        }
+        tracks_[i].format.sample_rate = 0;
+    }
+    stopping_ = false;
+    for (unsigned int i = 0; i < settings.threads; i += 1) {
+        threads_.emplace_back(&AudioTrackWriter::run, this, i);
+    }
+    recording_.store(true, std::memory_order_release);
+    return true;
+}
+
+void AudioTrackWriter::stop() {
+    recording_.store(false, std::memory_order_release);
+    std::vector<std::thread> threads;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+        threads.swap(threads_);
+    }
+    wake_.notify_all();
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+}
+
+void AudioTrackWriter::append(unsigned int track, uint32_t user_id, const struct exported_audio_raw_data &data) {
+    Track &slot = tracks_[track];
+    AudioTrackRing *ring = slot.ring.load(std::memory_order_acquire);
+    if (!ring) {
+        // Only before the first start, rings are allocated there.
+        drop(data.len);
+        return;
+    }
+    struct audio_track_header header = {
+        user_id: user_id,
+        format: data.format,
+        sample_rate: data.sample_rate,
+        channels: data.channels,
+        time: data.time,
+        sdk_time: data.sdk_time,
+        sample_index: data.sample_index,
+    };
+    ring->push(header, data.data, data.len);
+}
+
+void AudioTrackWriter::drop(uint32_t len) {
+    lost_frames_.fetch_add(1, std::memory_order_relaxed);
+    lost_bytes_.fetch_add(len, std::memory_order_relaxed);
+}
+
+void AudioTrackWriter::run(unsigned int index) {
+    unsigned int stride = settings_.threads;
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        bool closing = stopping_;
+        lock.unlock();
+        int64_t now = monotonic_us();
+        for (unsigned int i = index; i < max_tracks_; i += stride) {
+            service(tracks_[i], now, closing);
+        }
+        lock.lock();
+        if (closing) {
+            return;
+        }
+        wake_.wait_for(lock, std::chrono::microseconds(settings_.flush_us));
+    }
+}
+
+void AudioTrackWriter::service(Track &track, int64_t now, bool closing) {
+    AudioTrackRing *ring = track.ring.load(std::memory_order_acquire);
+    if (ring) {
+        struct iovec iov[TRACK_MAX_IOV];
+        int count = 0;
+        size_t bytes = 0;
+        auto flush = [&]() {
+            if (count != 0) {
+                write(track, iov, count, bytes, count);
+            }
+            count = 0;
+            bytes = 0;
+        };
+        unsigned int drained;
+        do {
+            drained = ring->drain(
+                [&](struct audio_track_header &header, char *payload, uint32_t len) {
+                    if (track.format.sample_rate == 0 || !same_format(header, track.format)) {
+                        flush();
+                        close(track);
+                        open(track, header);
+                    }
+                    if (track.fd < 0) {
+                        drop(len);
+                        return;
+                    }
+                    pcm_bytes_.fetch_add(len, std::memory_order_relaxed);
+                    if (track.flac) {
+                        encode(track, header, payload, len);
+                        return;
+                    }
+                    if (header.sample_index >= 0) {
+                        uint64_t sample_bytes = header.format == AUDIO_SAMPLE_F32 ? sizeof(float) : sizeof(int16_t);
+                        uint64_t offset = static_cast<uint64_t>(header.sample_index) * sample_bytes * header.channels;
+                        if (offset > track.size + bytes) {
+                            // Skip the gap, the hole reads as zeros: silence in both sample formats.
+                            flush();
+                            track.size = offset;
+                        }
+                    }
+                    iov[count].iov_base = payload;
+                    iov[count].iov_len = len;
+                    count += 1;
+                    bytes += len;
+                },
+                TRACK_MAX_IOV, flush);
+        } while (drained == TRACK_MAX_IOV);
+        if (track.flac) {
+            write_encoded(track);
+        }
+    }
+    if (track.fd < 0) {
+        return;
+    }
+    if (closing) {
+        close(track);
+    } else if (now - track.last_sync >= settings_.sync_us) {
+        write_header(track);
+        fdatasync(track.fd);
+        syncs_.fetch_add(1, std::memory_order_relaxed);
+        track.last_sync = now;
+    }
+}
+
+bool AudioTrackWriter::open(Track &track, const struct audio_track_header &header) {
+    track.format = header;
+    track.size = 0;
+    track.allocated = 0;
+    track.encoded_frames = 0;
+    track.last_sync = monotonic_us();
+    bool flac = settings_.codec == AUDIO_TRACK_FLAC;
+    if (flac && !track.flac) {
+        track.flac.reset(new FlacEncoder());
+    }
+    if (track.flac) {
+        if (flac) {
+            track.flac->reset(header.sample_rate, header.channels);
+        } else {
+            // Left over by a FLAC recording, the slot records WAV now.
+            track.flac.reset();
+        }
+    }
+    char path[4096];
+    snprintf(path, sizeof(path), "%s/%u-%lld.%s", settings_.directory.c_str(), header.user_id, static_cast<long long>(header.time), flac ? "flac" : "wav");
+    track.fd = ::open(path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (track.fd < 0) {
+        write_errors_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    write_header(track);
+    files_.fetch_add(1, std::memory_order_relaxed);
+    open_tracks_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void AudioTrackWriter::close(Track &track) {
+    if (track.fd < 0) {
+        return;
+    }
+    if (track.flac) {
+        track.flac->finish();
+        write_encoded(track);
+    }
+    write_header(track);
+    // Give back the extents preallocated past the end of the data.
+    if (track.allocated > track.size && ftruncate(track.fd, header_bytes(track) + track.size) != 0) {
+        write_errors_.fetch_add(1, std::memory_order_relaxed);
+    }
+    fdatasync(track.fd);
+    syncs_.fetch_add(1, std::memory_order_relaxed);
+    ::close(track.fd);
+    track.fd = -1;
+    open_tracks_.fetch_sub(1, std::memory_order_relaxed);
+}
+
+bool AudioTrackWriter::write(Track &track, struct iovec *iov, int count, size_t bytes, unsigned int frames) {
+    if (track.allocated < track.size) {
+        // Never preallocate a gap of aligned tracks.
+        track.allocated = track.size;
+    }
+    if (track.size + bytes > track.allocated && settings_.preallocate_bytes != 0) {
+        uint64_t target = track.size + bytes + settings_.preallocate_bytes;
+        // Reserved past the end of file, the size only grows with the data. Unsupported file systems just skip it.
+        fallocate(track.fd, FALLOC_FL_KEEP_SIZE, header_bytes(track) + track.allocated, target - track.allocated);
+        track.allocated = target;
+    }
+    int64_t start = monotonic_us();
+    off_t offset = header_bytes(track) + track.size;
+    size_t left = bytes;
+    int first = 0;
+    while (left != 0) {
+        ssize_t written = pwritev(track.fd, iov + first, count - first, offset);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            write_errors_.fetch_add(1, std::memory_order_relaxed);
+            lost_frames_.fetch_add(frames, std::memory_order_relaxed);
+            lost_bytes_.fetch_add(left, std::memory_order_relaxed);
+            return false;
+        }
+        offset += written;
+        left -= written;
+        track.size += written;
+        written_bytes_.fetch_add(written, std::memory_order_relaxed);
+        // Skip what was written, a short write can end in the middle of a frame.
+        while (first < count && static_cast<size_t>(written) >= iov[first].iov_len) {
+            written -= iov[first].iov_len;
+            first += 1;
+        }
+        if (written != 0) {
+            iov[first].iov_base = static_cast<char*>(iov[first].iov_base) + written;
+            iov[first].iov_len -= written;
+        }
+    }
+    written_frames_.fetch_add(frames, std::memory_order_relaxed);
+    int64_t elapsed = monotonic_us() - start;
+    if (elapsed > max_write_us_.load(std::memory_order_relaxed)) {
+        max_write_us_.store(elapsed, std::memory_order_relaxed);
+    }
+    return true;
+}
+
+void AudioTrackWriter::write_header(Track &track) {
+    if (track.flac) {
+        uint8_t header[FlacEncoder::HEADER_BYTES];
+        track.flac->header(header);
+        if (pwrite(track.fd, header, sizeof(header), 0) != static_cast<ssize_t>(sizeof(header))) {
+            write_errors_.fetch_add(1, std::memory_order_relaxed);
+        }
+        return;
+    }
+    char header[WAV_HEADER_BYTES];
+    wav_header(header, track.format, track.size);
+    if (pwrite(track.fd, header, sizeof(header), 0) != static_cast<ssize_t>(sizeof(header))) {
+        write_errors_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void AudioTrackWriter::encode(Track &track, const struct audio_track_header &header, const char *payload, uint32_t len) {
+    FlacEncoder &encoder = *track.flac;
+    int64_t start = monotonic_us();
+    if (header.sample_index >= 0 && static_cast<uint64_t>(header.sample_index) > encoder.frames()) {
+        // Gaps of aligned tracks, overlaps were trimmed by the aligner.
+        encoder.push_silence(header.sample_index - encoder.frames());
+    }
+    if (header.format == AUDIO_SAMPLE_F32) {
+        encoder.push_f32(reinterpret_cast<const float*>(payload), len / (sizeof(float) * header.channels));
+    } else {
+        encoder.push_s16(reinterpret_cast<const int16_t*>(payload), len / (sizeof(int16_t) * header.channels));
+    }
+    encode_us_.fetch_add(monotonic_us() - start, std::memory_order_relaxed);
+    track.encoded_frames += 1;
+}
+
+void AudioTrackWriter::write_encoded(Track &track) {
+    const std::vector<uint8_t> &output = track.flac->output();
+    if (output.empty()) {
+        return;
+    }
+    struct iovec iov = {
+        iov_base: const_cast<uint8_t*>(output.data()),
+        iov_len: output.size(),
+    };
+    // Frames are counted once their encoded blocks reach the file.
+    write(track, &iov, 1, output.size(), track.encoded_frames);
+    track.encoded_frames = 0;
+    track.flac->clear_output();
+}
+
+size_t AudioTrackWriter::header_bytes(const Track &track) const {
+    return track.flac ? FlacEncoder::HEADER_BYTES : WAV_HEADER_BYTES;
+}
+
+void AudioTrackWriter::stats(struct audio_recorder_stats *out) const {
+    out->files = files_.load(std::memory_order_relaxed);
+    out->written_frames = written_frames_.load(std::memory_order_relaxed);
+    out->written_bytes = written_bytes_.load(std::memory_order_relaxed);
+    out->dropped_frames = lost_frames_.load(std::memory_order_relaxed);
+    out->dropped_bytes = lost_bytes_.load(std::memory_order_relaxed);
+    out->queued_bytes = 0;
+    for (unsigned int i = 0; i < max_tracks_; i += 1) {
+        AudioTrackRing *ring = tracks_[i].ring.load(std::memory_order_acquire);
+        if (!ring) {
+            continue;
+        }
+        struct spsc_ring_counters counters;
+        ring->counters(&counters);
+        out->dropped_frames += counters.dropped;
+        out->dropped_bytes += counters.dropped_bytes;
+        out->queued_bytes += ring->used();
+    }
+    out->syncs = syncs_.load(std::memory_order_relaxed);
+    out->write_errors = write_errors_.load(std::memory_order_relaxed);
+    out->max_write_us = max_write_us_.load(std::memory_order_relaxed);
+    out->pcm_bytes = pcm_bytes_.load(std::memory_order_relaxed);
+    out->encode_us = encode_us_.load(std::memory_order_relaxed);
+    out->open_tracks = open_tracks_.load(std::memory_order_relaxed);
+    out->running = recording_.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,129 @@
+#ifndef _C_AUDIO_TRACK_WRITER_H_
+#define _C_AUDIO_TRACK_WRITER_H_
+
+#include "c_rawdata_audio_helper.h"
+#include "c_audio_ring_buffer.h"
+#include "c_audio_flac_encoder.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/// @brief Record stored in the track rings, followed by the PCM of one frame.
+struct audio_track_header {
+    uint32_t user_id;
+    enum audio_sample_format format;
+    uint32_t sample_rate;
+    uint32_t channels;
+    /// Same clocks as exported_audio_raw_data.
+    int64_t time;
+    uint64_t sdk_time;
+    /// Aligned position of the frame, -1 if alignment is off.
+    int64_t sample_index;
+};
+
+typedef SpscRecordRing<struct audio_track_header> AudioTrackRing;
+
+/// @brief Settings of an AudioTrackWriter, see audio_helper_start_recording.
+struct AudioTrackSettings {
+    std::string directory;
+    unsigned int threads;
+    size_t ring_capacity;
+    int64_t flush_us;
+    int64_t sync_us;
+    size_t preallocate_bytes;
+    enum audio_track_codec codec;
+};
+
+/// @brief Appends the one-way audio of every user to its own WAV or FLAC file.
+///
+/// The SDK audio thread only copies frames into a per-slot ring, allocated for every slot by the
+/// first start and kept afterwards. A pool of writer threads, each owning every `threads`-th
+/// slot, wakes up every flush period and hands the queued frames of a track to pwritev straight
+/// from the ring. Files grow by preallocated extents and are fdatasync'ed on their own period,
+/// their header is rewritten before each sync so a crash leaves a playable file. A track is
+/// closed and a new file started when the slot moves to another user or the format changes.
+/// Aligned frames are written at their sample index, gaps are left as holes that read as silence.
+/// With AUDIO_TRACK_FLAC the writer threads also encode: each track owns a FlacEncoder, fed from
+/// the ring and flushed with the same period, and gaps are encoded as silence.
+class AudioTrackWriter {
+public:
+    explicit AudioTrackWriter(unsigned int max_tracks);
+    ~AudioTrackWriter();
+    AudioTrackWriter(const AudioTrackWriter &) = delete;
+    AudioTrackWriter &operator=(const AudioTrackWriter &) = delete;
+
+    /// @brief Start the writer threads. Frames queued before a previous stop are discarded.
+    /// @return false if already running or `directory` is not writable.
+    bool start(const AudioTrackSettings &settings);
+
+    /// @brief Stop accepting frames, write what is queued, close the files and join the threads.
+    void stop();
+
+    /// @brief Queue a frame of the user owning slot `track`. SDK audio thread only, never blocks on I/O.
+    void append(unsigned int track, uint32_t user_id, const struct exported_audio_raw_data &data);
+
+    /// @brief Account a frame that cannot be recorded, e.g. its user has no slot.
+    void drop(uint32_t len);
+
+    bool recording() const {
+        return recording_.load(std::memory_order_acquire);
+    }
+
+    void stats(struct audio_recorder_stats *out) const;
+
+private:
+    /// Writer side of a track, only touched by the thread owning it.
+    struct Track {
+        std::atomic<AudioTrackRing*> ring;
+        int fd;
+        struct audio_track_header format;
+        /// Bytes of PCM in the file.
+        uint64_t size;
+        uint64_t allocated;
+        int64_t last_sync;
+        /// Allocated with the first FLAC track of the slot and kept afterwards.
+        std::unique_ptr<FlacEncoder> flac;
+        /// Frames pushed to the encoder since the last write of its output.
+        unsigned int encoded_frames;
+    };
+
+    void run(unsigned int index);
+    void service(Track &track, int64_t now, bool closing);
+    bool open(Track &track, const struct audio_track_header &header);
+    void close(Track &track);
+    bool write(Track &track, struct iovec *iov, int count, size_t bytes, unsigned int frames);
+    void write_header(Track &track);
+    void encode(Track &track, const struct audio_track_header &header, const char *payload, uint32_t len);
+    void write_encoded(Track &track);
+    size_t header_bytes(const Track &track) const;
+
+    unsigned int max_tracks_;
+    Track *tracks_;
+    AudioTrackSettings settings_;
+    std::atomic<bool> recording_;
+    std::atomic<size_t> ring_capacity_;
+    std::vector<std::thread> threads_;
+    bool stopping_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::atomic<unsigned int> open_tracks_;
+    std::atomic<uint64_t> files_;
+    std::atomic<uint64_t> written_frames_;
+    std::atomic<uint64_t> written_bytes_;
+    /// Frames without slot or file, ring overflows are counted by the rings.
+    std::atomic<uint64_t> lost_frames_;
+    std::atomic<uint64_t> lost_bytes_;
+    std::atomic<uint64_t> syncs_;
+    std::atomic<uint64_t> write_errors_;
+    std::atomic<int64_t> max_write_us_;
+    std::atomic<uint64_t> pcm_bytes_;
+    std::atomic<int64_t> encode_us_;
+};
+
+#endif
@@ -0,0 +1,228 @@
+#include "c_audio_user_table.h"
+
+AudioUserTable::AudioUserTable(unsigned int max_users) {
+    max_users_ = max_users;
+    unsigned int table_size = 1;
+    while (table_size < max_users * 2) {
+        table_size <<= 1;
+    }
+    mask_ = table_size - 1;
+    for (unsigned int t = 0; t < 2; t += 1) {
+        tables_[t] = new std::atomic<uint64_t>[table_size];
+        for (unsigned int i = 0; i < table_size; i += 1) {
+            tables_[t][i].store(EMPTY, std::memory_order_relaxed);
+        }
+    }
+    entries_.store(tables_[0], std::memory_order_relaxed);
+    tombstones_ = 0;
+    slots_ = new AudioUserSlot[max_users];
+    for (unsigned int i = 0; i < max_users; i += 1) {
+        slots_[i].user_id.store(0, std::memory_order_relaxed);
+        slots_[i].active.store(false, std::memory_order_relaxed);
+        slots_[i].joined.store(false, std::memory_order_relaxed);
+        slots_[i].frames.store(0, std::memory_order_relaxed);
+        slots_[i].samples.store(0, std::memory_order_relaxed);
+        slots_[i].last_seen.store(0, std::memory_order_relaxed);
+        slots_[i].silent_frames.store(0, std::memory_order_relaxed);
+        slots_[i].generation.store(0, std::memory_order_relaxed);
+        slots_[i].seen_generation = 0;
+        slots_[i].ring.store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+AudioUserTable::~AudioUserTable() {
+    for (unsigned int i = 0; i < max_users_; i += 1) {
+        delete slots_[i].ring.load(std::memory_order_relaxed);
+    }
+    delete[] slots_;
+    delete[] tables_[0];
+    delete[] tables_[1];
+}
+
+AudioUserSlot *AudioUserTable::find(uint32_t user_id) const {
+    std::atomic<uint64_t> *entries = entries_.load(std::memory_order_acquire);
+    unsigned int index = hash(user_id);
+    for (unsigned int probe = 0; probe <= mask_; probe += 1) {
+        uint64_t entry = entries[index].load(std::memory_order_acquire);
+        uint32_t value = static_cast<uint32_t>(entry);
+        if (value == EMPTY) {
+            return nullptr;
+        }
+        if (value != TOMBSTONE && static_cast<uint32_t>(entry >> 32) == user_id) {
+            return &slots_[value - 1];
+        }
+        index = (index + 1) & mask_;
+    }
+    return nullptr;
+}
+
+AudioUserSlot *AudioUserTable::join(uint32_t user_id, size_t ring_capacity) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    AudioUserSlot *slot = claim_locked(user_id, 0);
+    if (!slot) {
+        return nullptr;
+    }
+    slot->joined.store(true, std::memory_order_relaxed);
+    // A slot claimed by the SDK audio thread before the join gets its ring here at the latest.
+    if (ring_capacity != 0 && !slot->ring.load(std::memory_order_relaxed)) {
+        slot->ring.store(AudioRing::create(ring_capacity), std::memory_order_release);
+    }
+    return slot;
+}
+
+AudioUserSlot *AudioUserTable::claim(uint32_t user_id, int64_t now) {
+    std::unique_lock<std::mutex> lock(mutex_, std::try_to_lock);
+    if (!lock.owns_lock()) {
+        return nullptr;
+    }
+    AudioUserSlot *slot = claim_locked(user_id, now);
+    if (slot) {
+        return slot;
+    }
+    // Without participant events nothing retires the users who left, reclaim the silent ones.
+    bool reclaimed = false;
+    for (unsigned int i = 0; i < max_users_; i += 1) {
+        AudioUserSlot &idle = slots_[i];
+        if (idle.active.load(std::memory_order_relaxed) && !idle.joined.load(std::memory_order_relaxed) &&
+            now - idle.last_seen.load(std::memory_order_relaxed) > AUDIO_USER_IDLE_US) {
+            retire_locked(idle.user_id.load(std::memory_order_relaxed));
+            reclaimed = true;
+        }
+    }
+    return reclaimed ? claim_locked(user_id, now) : nullptr;
+}
+
+AudioUserSlot *AudioUserTable::claim_locked(uint32_t user_id, int64_t last_seen) {
+    AudioUserSlot *existing = find(user_id);
+    if (existing) {
+        return existing;
+    }
+    unsigned int slot_index = max_users_;
+    for (unsigned int i = 0; i < max_users_; i += 1) {
+        if (!slots_[i].active.load(std::memory_order_relaxed)) {
+            slot_index = i;
+            break;
+        }
+    }
+    if (slot_index == max_users_) {
+        return nullptr;
+    }
+
+    AudioUserSlot &slot = slots_[slot_index];
+    slot.user_id.store(user_id, std::memory_order_relaxed);
+    slot.joined.store(false, std::memory_order_relaxed);
+    slot.frames.store(0, std::memory_order_relaxed);
+    slot.samples.store(0, std::memory_order_relaxed);
+    slot.last_seen.store(last_seen, std::memory_order_relaxed);
+    slot.silent_frames.store(0, std::memory_order_relaxed);
+    // The SDK audio thread may be using the stream state of the previous user, it resets it itself.
+    slot.generation.fetch_add(1, std::memory_order_release);
+    slot.active.store(true, std::memory_order_release);
+
+    if (!insert_locked(entries_.load(std::memory_order_relaxed), user_id, slot_index)) {
+        slot.active.store(false, std::memory_order_relaxed);
+        return nullptr;
+    }
+    return &slot;
+}
+
+bool AudioUserTable::insert_locked(std::atomic<uint64_t> *entries, uint32_t user_id, unsigned int slot_index) {
+    // Reuse the first tombstone of the probe sequence, or the terminating empty entry.
+    uint64_t entry = (static_cast<uint64_t>(user_id) << 32) | (slot_index + 1);
+    unsigned int index = hash(user_id);
+    for (unsigned int probe = 0; probe <= mask_; probe += 1) {
+        uint32_t value = static_cast<uint32_t>(entries[index].load(std::memory_order_relaxed));
+        if (value == EMPTY || value == TOMBSTONE) {
+            tombstones_ -= value == TOMBSTONE;
+            entries[index].store(entry, std::memory_order_release);
+            return true;
+        }
+        index = (index + 1) & mask_;
+    }
+    return false;
+}
+
+void AudioUserTable::rebuild_locked() {
+    std::atomic<uint64_t> *current = entries_.load(std::memory_order_relaxed);
+    std::atomic<uint64_t> *spare = current == tables_[0] ? tables_[1] : tables_[0];
+    for (unsigned int i = 0; i <= mask_; i += 1) {
+        spare[i].store(EMPTY, std::memory_order_relaxed);
+    }
+    tombstones_ = 0;
+    for (unsigned int i = 0; i <= mask_; i += 1) {
+        uint64_t entry = current[i].load(std::memory_order_relaxed);
+        uint32_t value = static_cast<uint32_t>(entry);
+        if (value != EMPTY && value != TOMBSTONE) {
+            insert_locked(spare, static_cast<uint32_t>(entry >> 32), value - 1);
+        }
+    }
+    entries_.store(spare, std::memory_order_release);
+}
+
+void AudioUserTable::retire(uint32_t user_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    retire_locked(user_id);
+}
+
+void AudioUserTable::retire_locked(uint32_t user_id) {
+    std::atomic<uint64_t> *entries = entries_.load(std::memory_order_relaxed);
+    unsigned int index = hash(user_id);
+    for (unsigned int probe = 0; probe <= mask_; probe += 1) {
+        uint64_t entry = entries[index].load(std::memory_order_relaxed);
+        uint32_t value = static_cast<uint32_t>(entry);
+        if (value == EMPTY) {
+            return;
+        }
+        if (value != TOMBSTONE && static_cast<uint32_t>(entry >> 32) == user_id) {
+            slots_[value - 1].active.store(false, std::memory_order_release);
+            if (static_cast<uint32_t>(entries[(index + 1) & mask_].load(std::memory_order_relaxed)) != EMPTY) {
+                entries[index].store(TOMBSTONE, std::memory_order_release);
+                tombstones_ += 1;
+            } else {
+                // Nothing is stored past an EMPTY entry, so this entry and the tombstones before it end no probe.
+                entries[index].store(EMPTY, std::memory_order_release);
+                for (unsigned int run = 0; run < mask_; run += 1) {
+                    index = (index - 1) & mask_;
+                    if (static_cast<uint32_t>(entries[index].load(std::memory_order_relaxed)) != TOMBSTONE) {
+                        break;
+                    }
+                    entries[index].store(EMPTY, std::memory_order_release);
+                    tombstones_ -= 1;
+                }
+            }
+            // Tombstones left in front of live entries lengthen every miss on the SDK audio thread.
+            if (tombstones_ > (mask_ + 1) / 4) {
+                rebuild_locked();
+            }
+            return;
+        }
+        index = (index + 1) & mask_;
+    }
+}
+
+void AudioUserTable::refresh(AudioUserSlot *slot) {
+    uint32_t generation = slot->generation.load(std::memory_order_acquire);
+    if (generation == slot->seen_generation) {
+        return;
+    }
+    slot->seen_generation = generation;
+    slot->clock.reset();
+    slot->resampler.reset();
+    slot->vad.reset();
+    slot->level.reset();
+    slot->aligner.reset();
+}
+
+bool AudioUserTable::allocate_rings(size_t ring_capacity) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (unsigned int i = 0; i < max_users_; i += 1) {
+        if (slots_[i].active.load(std::memory_order_relaxed) && !slots_[i].ring.load(std::memory_order_relaxed)) {
+            AudioRing *ring = AudioRing::create(ring_capacity);
+            if (!ring) {
+                return false;
+            }
+            slots_[i].ring.store(ring, std::memory_order_release);
+        }
+    }
+    return true;
+}
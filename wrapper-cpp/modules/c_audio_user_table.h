@@ -0,0 +1,141 @@
+#ifndef _C_AUDIO_USER_TABLE_H_
+#define _C_AUDIO_USER_TABLE_H_
+
+#include "c_rawdata_audio_helper.h"
+#include "c_audio_aligner.h"
+#include "c_audio_resampler.h"
+#include "c_audio_level.h"
+#include "c_audio_overload.h"
+#include "c_audio_ring_buffer.h"
+#include "c_audio_vad.h"
+#include "c_media_timeline.h"
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+/// @brief Record stored in the audio rings of the queued delivery mode.
+struct audio_ring_header {
+    struct exported_audio_raw_data data;
+    /// Sender of the frame, or its language id on the interpreter stream.
+    uint32_t user_id;
+    enum audio_record_kind kind;
+    /// Frame the drain may skip when the queue backs up, see AudioOverloadPolicy.
+    bool silent;
+};
+
+typedef SpscRecordRing<struct audio_ring_header> AudioRing;
+
+/// A user who sent no audio for this long and never joined is reclaimed when the table is full.
+constexpr int64_t AUDIO_USER_IDLE_US = 30 * 1000000;
+
+/// @brief Per-user stream state, one cache line per user so the SDK thread never shares lines between users.
+struct alignas(64) AudioUserSlot {
+    std::atomic<uint32_t> user_id;
+    std::atomic<bool> active;
+    /// Created by a participant join, only the matching leave retires the slot.
+    std::atomic<bool> joined;
+    std::atomic<uint64_t> frames;
+    std::atomic<uint64_t> samples;
+    std::atomic<int64_t> last_seen;
+    std::atomic<uint64_t> silent_frames;
+    /// Bumped by every claim, the SDK audio thread resets the stream state below when it moves.
+    std::atomic<uint32_t> generation;
+    /// Written by the SDK audio thread only.
+    uint32_t seen_generation;
+    /// Written by the SDK audio thread only.
+    StreamClock clock;
+    /// Written by the SDK audio thread only.
+    AudioResampler resampler;
+    /// Written by the SDK audio thread only.
+    VoiceActivityGate vad;
+    /// Written by the SDK audio thread, read by audio_helper_get_levels.
+    AudioLevelMeter level;
+    /// Written by the SDK audio thread only.
+    StreamAligner aligner;
+    /// Written by the SDK audio thread only, kept with the ring it watches. Also holds whether the
+    /// user is shed while its frames go to the stream ring.
+    AudioOverloadLane overload;
+    /// Owned by the slot and kept when the slot is retired, so a reused slot does not allocate.
+    std::atomic<AudioRing*> ring;
+};
+
+/// @brief Open-addressing user_id -> AudioUserSlot table.
+///
+/// Lookups are lock-free and run on the SDK audio thread. Joins and retirements come from
+/// participant events, claims from the SDK audio thread for users heard before their join or
+/// without any participants handler; all are serialized by a mutex. Queued records carry their
+/// own user_id, so a slot can be reused while its ring still holds frames of the previous user.
+class AudioUserTable {
+public:
+    explicit AudioUserTable(unsigned int max_users);
+    ~AudioUserTable();
+    AudioUserTable(const AudioUserTable &) = delete;
+    AudioUserTable &operator=(const AudioUserTable &) = delete;
+
+    /// @brief Find the slot of a user, NULL if the user has none. Never blocks.
+    AudioUserSlot *find(uint32_t user_id) const;
+
+    /// @brief Find or create the slot of a user who joined the meeting.
+    /// @param ring_capacity Allocate a ring of this size if the slot has none, 0 to skip. A slot left
+    /// without a ring for lack of memory gets it from a later allocate_rings().
+    /// @return NULL if all slots are taken.
+    AudioUserSlot *join(uint32_t user_id, size_t ring_capacity);
+
+    /// @brief Create the slot of a user heard on the SDK audio thread. Never blocks nor allocates.
+    /// When the table is full, slots idle for AUDIO_USER_IDLE_US that no join created are reclaimed.
+    /// @param now Wall clock of the frame, as stored in `last_seen`.
+    /// @return NULL if all slots are taken or the lock was busy.
+    AudioUserSlot *claim(uint32_t user_id, int64_t now);
+
+    /// @brief Reset the stream state of a slot claimed again since the last frame. SDK audio thread only.
+    static void refresh(AudioUserSlot *slot);
+
+    /// @brief Release the slot of a user that left the meeting.
+    void retire(uint32_t user_id);
+
+    /// @brief Allocate the missing rings of active slots, used when queued mode is enabled late and
+    /// for the slots claimed by the SDK audio thread.
+    /// @return false if a ring could not be allocated, the rings allocated so far are kept.
+    bool allocate_rings(size_t ring_capacity);
+
+    unsigned int max_users() const {
+        return max_users_;
+    }
+
+    AudioUserSlot &slot(unsigned int index) {
+        return slots_[index];
+    }
+
+    unsigned int index(const AudioUserSlot *slot) const {
+        return static_cast<unsigned int>(slot - slots_);
+    }
+
+private:
+    static constexpr uint32_t EMPTY = 0;
+    static constexpr uint32_t TOMBSTONE = 0xFFFFFFFFu;
+
+    unsigned int hash(uint32_t user_id) const {
+        return (user_id * 0x9E3779B1u) & mask_;
+    }
+    AudioUserSlot *claim_locked(uint32_t user_id, int64_t last_seen);
+    void retire_locked(uint32_t user_id);
+    /// Store the entry of an active slot at the first free position of its probe sequence.
+    bool insert_locked(std::atomic<uint64_t> *entries, uint32_t user_id, unsigned int slot_index);
+    /// Rebuild the table without tombstones into the spare array, then publish it.
+    void rebuild_locked();
+
+    unsigned int max_users_;
+    unsigned int mask_;
+    /// Entries pack (user_id << 32) | (slot index + 1). Low half EMPTY ends a probe, TOMBSTONE does not.
+    /// Tombstones right before an EMPTY entry are cleared, no probe can go past them.
+    std::atomic<std::atomic<uint64_t>*> entries_;
+    /// The published array and the spare one of the next rebuild, which a late lookup can at worst miss in.
+    std::atomic<uint64_t> *tables_[2];
+    /// Guarded by `mutex_`.
+    unsigned int tombstones_;
+    AudioUserSlot *slots_;
+    std::mutex mutex_;
+};
+
+#endif
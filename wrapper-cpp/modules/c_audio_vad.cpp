@@ -0,0 +1,95 @@
+#include "c_audio_vad.h"
+
+#include <cmath>
+
+/// Frames this far under the threshold still count as voice when their zero-crossing rate is low.
+constexpr float VAD_SOFT_MARGIN_DB = 10.0f;
+/// Zero crossings per sample under which a quiet frame is taken for voiced speech rather than noise.
+constexpr float VAD_VOICED_CROSSING_RATE = 0.1f;
+
+VadParams VadParams::from_settings(float threshold_dbfs, unsigned int hangover_ms, unsigned int max_silence_ms) {
+    VadParams params;
+    params.loud_power = pow(10.0, threshold_dbfs / 10.0);
+    params.soft_power = pow(10.0, (threshold_dbfs - VAD_SOFT_MARGIN_DB) / 10.0);
+    params.hangover_us = static_cast<int64_t>(hangover_ms) * 1000;
+    params.max_silence_us = static_cast<int64_t>(max_silence_ms) * 1000;
+    return params;
+}
+
+VoiceActivityGate::VoiceActivityGate() {
+    reset();
+}
+
+void VoiceActivityGate::reset() {
+    last_voice_ = INT64_MIN;
+    silence_start_ = 0;
+    silence_sdk_time_ = 0;
+    silence_us_ = 0;
+    silence_frames_ = 0;
+    silence_index_ = -1;
+    silence_samples_ = 0;
+}
+
+void VoiceActivityGate::take_marker(struct audio_silence_marker *marker) {
+    marker->start_time = silence_start_;
+    marker->sdk_time = silence_sdk_time_;
+    marker->duration_ms = static_cast<uint32_t>((silence_us_ + 500) / 1000);
+    marker->frames = silence_frames_;
+    marker->sample_index = silence_index_;
+    marker->samples = silence_samples_;
+    silence_us_ = 0;
+    silence_frames_ = 0;
+    silence_samples_ = 0;
+}
+
+bool VoiceActivityGate::flush(struct audio_silence_marker *marker) {
+    if (silence_frames_ == 0) {
+        return false;
+    }
+    take_marker(marker);
+    return true;
+}
+
+bool VoiceActivityGate::process(const struct exported_audio_raw_data &data, const struct pcm_activity &activity,
+                                const VadParams &params, int64_t sample_index, uint64_t delivered_samples,
+                                struct audio_silence_marker *marker, bool *emit) {
+    *emit = false;
+    size_t samples = data.len / sizeof(int16_t);
+    unsigned int channels = data.channels ? data.channels : 1;
+    if (samples == 0 || data.sample_rate == 0) {
+        return true;
+    }
+
+    // Compare energies rather than levels to keep the log out of the hot path.
+    double reference = static_cast<double>(samples) * 32768.0 * 32768.0;
+    double loud = reference * params.loud_power;
+    double soft = reference * params.soft_power;
+    float crossing_rate = samples > channels ? static_cast<float>(activity.crossings) / (samples - channels) : 0.0f;
+    bool voiced = activity.energy >= loud || (activity.energy >= soft && crossing_rate < VAD_VOICED_CROSSING_RATE);
+    if (voiced) {
+        last_voice_ = data.mono_time;
+    }
+
+    bool hangover = last_voice_ != INT64_MIN && data.mono_time - last_voice_ < params.hangover_us;
+    if (voiced || hangover) {
+        if (silence_frames_ != 0) {
+            take_marker(marker);
+            *emit = true;
+        }
+        return true;
+    }
+
+    if (silence_frames_ == 0) {
+        silence_start_ = data.time;
+        silence_sdk_time_ = data.sdk_time;
+        silence_index_ = sample_index;
+    }
+    silence_samples_ += delivered_samples;
+    silence_us_ += static_cast<int64_t>(samples / channels) * 1000000 / data.sample_rate;
+    silence_frames_ += 1;
+    if (silence_us_ >= params.max_silence_us) {
+        take_marker(marker);
+        *emit = true;
+    }
+    return false;
+}
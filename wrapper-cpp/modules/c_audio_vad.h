@@ -0,0 +1,62 @@
+#ifndef _C_AUDIO_VAD_H_
+#define _C_AUDIO_VAD_H_
+
+#include "c_rawdata_audio_helper.h"
+#include "c_audio_dsp.h"
+
+#include <cstddef>
+#include <cstdint>
+
+/// @brief Settings shared by the gates of every user, see audio_helper_set_vad.
+struct VadParams {
+    /// Mean power, relative to full scale, from which a frame is voiced.
+    double loud_power;
+    /// Mean power under which a frame is never voiced.
+    double soft_power;
+    int64_t hangover_us;
+    int64_t max_silence_us;
+
+    static VadParams from_settings(float threshold_dbfs, unsigned int hangover_ms, unsigned int max_silence_ms);
+};
+
+/// @brief Energy and zero-crossing voice gate of one stream, with hangover.
+///
+/// A frame is voiced when its RMS level reaches the threshold, or comes within 10 dB of it with
+/// the low zero-crossing rate of voiced speech. The gate stays open `hangover_us` after the last
+/// voiced frame. Closed frames are summed into a silence marker, handed out when the gate opens
+/// again or when the marker reaches `max_silence_us`. One instance per stream, not thread safe.
+class VoiceActivityGate {
+public:
+    VoiceActivityGate();
+
+    /// @brief Feed one 16-bit frame.
+    /// @param activity Measured on the frame by dsp_s16_activity.
+    /// @param sample_index Aligned position of the frame, -1 if alignment is off.
+    /// @param delivered_samples Samples per channel of the frame once delivered.
+    /// @param marker Filled when a silence marker is due, it must be delivered before the frame.
+    /// @param emit Set to true when `marker` was filled.
+    /// @return true if the frame must be forwarded, false if it was folded into the pending marker.
+    bool process(const struct exported_audio_raw_data &data, const struct pcm_activity &activity,
+                 const VadParams &params, int64_t sample_index, uint64_t delivered_samples,
+                 struct audio_silence_marker *marker, bool *emit);
+
+    /// @brief Take the pending marker early, so a record placed after it is delivered in order.
+    /// @return false if no frame is folded.
+    bool flush(struct audio_silence_marker *marker);
+
+    /// @brief Close the gate and drop the pending marker, used when the stream is handed to another user.
+    void reset();
+
+private:
+    int64_t last_voice_;
+    int64_t silence_start_;
+    uint64_t silence_sdk_time_;
+    int64_t silence_us_;
+    uint32_t silence_frames_;
+    int64_t silence_index_;
+    uint64_t silence_samples_;
+
+    void take_marker(struct audio_silence_marker *marker);
+};
+
+#endif
@@ -0,0 +1,24 @@
+#ifndef _C_CPU_FEATURES_H_
+#define _C_CPU_FEATURES_H_
+
+/// @brief Runtime CPU feature checks used to select SIMD kernels.
+///
+/// The wrapper is built for x86-64-v2, so SSE4.2 paths need no check. AVX2 kernels are
+/// compiled with a target attribute and only selected when the CPU reports AVX2 and FMA.
+
+#if defined(__x86_64__) || defined(__i386__)
+#define WRAPPER_HAVE_X86_SIMD 1
+#else
+#define WRAPPER_HAVE_X86_SIMD 0
+#endif
+
+inline bool cpu_has_avx2() {
+#if WRAPPER_HAVE_X86_SIMD
+    static const bool supported = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    return supported;
+#else
+    return false;
+#endif
+}
+
+#endif
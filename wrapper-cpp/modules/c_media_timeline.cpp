@@ -0,0 +1,22 @@
+#include "c_media_timeline.h"
+
+#include <chrono>
+
+namespace {
+
+struct TimelineAnchor {
+    TimelineAnchor() {
+        using namespace std::chrono;
+        mono_us = monotonic_us();
+        wall_us = duration_cast<microseconds>(system_clock::now().time_since_epoch()).count();
+    }
+    int64_t mono_us;
+    int64_t wall_us;
+};
+
+}
+
+int64_t timeline_wall_us(int64_t mono_us) {
+    static const TimelineAnchor anchor;
+    return anchor.wall_us + (mono_us - anchor.mono_us);
+}
@@ -0,0 +1,66 @@
+#ifndef _C_MEDIA_TIMELINE_H_
+#define _C_MEDIA_TIMELINE_H_
+
+#include <cstdint>
+#include <time.h>
+
+/// @brief CLOCK_MONOTONIC in microseconds.
+inline int64_t monotonic_us() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000 + ts.tv_nsec / 1000;
+}
+
+/// @brief Wall clock time in microseconds derived from the monotonic clock.
+///
+/// The wall clock is sampled once per process, every later timestamp is that anchor plus
+/// the elapsed monotonic time, so NTP steps never make media timestamps jump.
+int64_t timeline_wall_us(int64_t mono_us);
+
+/// @brief Drift estimator of one media stream.
+///
+/// Compares the SDK media timestamp of each frame with its monotonic arrival time. The drift
+/// is the smoothed change of (arrival - media time) since the first frame of the stream:
+/// positive when the stream is delivered later and later than its media clock.
+/// Only the thread delivering the stream may call update().
+class StreamClock {
+public:
+    StreamClock() {
+        reset();
+    }
+
+    void reset() {
+        started_ = false;
+        base_offset_ = 0;
+        drift_ = 0;
+    }
+
+    /// @param sdk_ms SDK media timestamp in milliseconds, 0 if unavailable.
+    /// @param mono_us Monotonic arrival time in microseconds.
+    /// @return The current drift estimate in microseconds.
+    int64_t update(uint64_t sdk_ms, int64_t mono_us) {
+        if (sdk_ms == 0) {
+            return drift_;
+        }
+        int64_t offset = mono_us - static_cast<int64_t>(sdk_ms) * 1000;
+        if (!started_) {
+            started_ = true;
+            base_offset_ = offset;
+            return drift_;
+        }
+        // EWMA over ~16 frames absorbs callback jitter while following real drift.
+        drift_ += (offset - base_offset_ - drift_) / 16;
+        return drift_;
+    }
+
+    int64_t drift() const {
+        return drift_;
+    }
+
+private:
+    bool started_;
+    int64_t base_offset_;
+    int64_t drift_;
+};
+
+#endif
@@ -1,5 +1,7 @@
 #include "c_meeting_participants_interface.h"
+#include "c_rawdata_audio_helper.h"
 
+#include <atomic>
 #include <stdio.h>
 #include <cstdlib>
 
@@ -82,12 +84,17 @@ extern "C" void on_user_join(void *ptr_to_rust, unsigned int *user_ids, unsigned
 extern "C" void on_user_left(void *ptr_to_rust, unsigned int *user_ids, unsigned int count);
 extern "C" void on_host_change(void *ptr_to_rust, unsigned int new_host_id);
 
+/// The controller holds a single event handler, the Rust one and the audio delegate share it.
 class C_MeetingParticipantsCtrlEvent : public ZOOMSDK::IMeetingParticipantsCtrlEvent {
 public:
-    C_MeetingParticipantsCtrlEvent(void *ptr) {
-        ptr_to_rust = ptr;
+    C_MeetingParticipantsCtrlEvent() {
+        ptr_to_rust.store(nullptr, std::memory_order_relaxed);
+        audio_delegate.store(nullptr, std::memory_order_relaxed);
     }
 
+    std::atomic<void*> ptr_to_rust;
+    std::atomic<ZOOMSDK::IZoomSDKAudioRawDataDelegate*> audio_delegate;
+
 protected:
     void onUserJoin(ZOOMSDK::IList<unsigned int>* lstUserID, const zchar_t* strUserList = nullptr) override {
         (void)strUserList;
@@ -100,7 +107,11 @@ protected:
         for (int i = 0; i < count; i++) {
             user_ids[i] = lstUserID->GetItem(i);
         }
-        on_user_join(ptr_to_rust, user_ids, count);
+        audio_helper_user_join(audio_delegate.load(std::memory_order_acquire), user_ids, count);
+        void *ptr = ptr_to_rust.load(std::memory_order_acquire);
+        if (ptr) {
+            on_user_join(ptr, user_ids, count);
+        }
         free(user_ids);
     }
 
@@ -115,12 +126,19 @@ protected:
         for (int i = 0; i < count; i++) {
             user_ids[i] = lstUserID->GetItem(i);
         }
-        on_user_left(ptr_to_rust, user_ids, count);
+        audio_helper_user_left(audio_delegate.load(std::memory_order_acquire), user_ids, count);
+        void *ptr = ptr_to_rust.load(std::memory_order_acquire);
+        if (ptr) {
+            on_user_left(ptr, user_ids, count);
+        }
         free(user_ids);
     }
 
     void onHostChangeNotification(unsigned int userId) override {
-        on_host_change(ptr_to_rust, userId);
+        void *ptr = ptr_to_rust.load(std::memory_order_acquire);
+        if (ptr) {
+            on_host_change(ptr, userId);
+        }
     }
 
     // Implement other required virtual methods with empty bodies
@@ -144,12 +162,23 @@ protected:
     void onVirtualNameTagStatusChanged(bool bOn, unsigned int userID) override { (void)bOn; (void)userID; }
     void onVirtualNameTagRosterInfoUpdated(unsigned int userID) override { (void)userID; }
     void onGrantCoOwnerPrivilegeChanged(bool canGrantOther) override { (void)canGrantOther; }
-
-private:
-    void *ptr_to_rust;
 };
 
+static C_MeetingParticipantsCtrlEvent participants_event;
+
 extern "C" ZOOMSDK::SDKError participants_set_event(ZOOMSDK::IMeetingParticipantsController *controller, void *arc_ptr) {
-    auto* obj = new C_MeetingParticipantsCtrlEvent(arc_ptr);
-    return controller->SetEvent(obj);
+    participants_event.ptr_to_rust.store(arc_ptr, std::memory_order_release);
+    return controller->SetEvent(&participants_event);
+}
+
+extern "C" ZOOMSDK::SDKError participants_set_audio_delegate(
+    ZOOMSDK::IMeetingParticipantsController *controller,
+    ZOOMSDK::IZoomSDKAudioRawDataDelegate *delegate) {
+    participants_event.audio_delegate.store(delegate, std::memory_order_release);
+    return controller->SetEvent(&participants_event);
+}
+
+extern "C" void participants_clear_audio_delegate(ZOOMSDK::IZoomSDKAudioRawDataDelegate *delegate) {
+    // A newer delegate may have been set in between, it stays.
+    participants_event.audio_delegate.compare_exchange_strong(delegate, nullptr, std::memory_order_acq_rel);
 }
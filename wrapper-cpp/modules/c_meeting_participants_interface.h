@@ -3,6 +3,7 @@
 
 #include "../../zoom-meeting-sdk-linux/h/meeting_service_components/meeting_audio_interface.h"
 #include "../../zoom-meeting-sdk-linux/h/meeting_service_components/meeting_participants_ctrl_interface.h"
+#include "../../zoom-meeting-sdk-linux/h/rawdata/rawdata_audio_helper_interface.h"
 
 /// @brief This structure represents an user with ID and virtual interface.
 extern "C" struct participant {
@@ -76,4 +77,16 @@ extern "C" bool is_participant_request_local_recording_allowed(ZOOMSDK::IMeeting
 /// @return SDKError indicating success or failure
 extern "C" ZOOMSDK::SDKError participants_set_event(ZOOMSDK::IMeetingParticipantsController *controller, void *arc_ptr);
 
+/// @brief Route the participant joins and leaves to an audio delegate, see audio_helper_attach_participants.
+/// Shares the event handler of participants_set_event, either can be set first.
+/// @param controller A Pointer to ZOOMSDK::IMeetingParticipantsController
+/// @param delegate The audio delegate, replaces the previous one
+/// @return SDKError indicating success or failure
+extern "C" ZOOMSDK::SDKError participants_set_audio_delegate(
+    ZOOMSDK::IMeetingParticipantsController *controller,
+    ZOOMSDK::IZoomSDKAudioRawDataDelegate *delegate);
+
+/// @brief Stop routing the participant events to `delegate`, if it is still the routed one.
+extern "C" void participants_clear_audio_delegate(ZOOMSDK::IZoomSDKAudioRawDataDelegate *delegate);
+
 #endif
\ No newline at end of file
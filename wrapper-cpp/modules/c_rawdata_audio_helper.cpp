@@ -1,81 +1,941 @@
 #include "c_rawdata_audio_helper.h"
+#include "c_audio_aligner.h"
+#include "c_audio_batch.h"
+#include "c_audio_chunker.h"
+#include "c_audio_dsp.h"
+#include "c_audio_echo_canceller.h"
+#include "c_audio_language_table.h"
+#include "c_audio_level.h"
+#include "c_audio_mic_pacer.h"
+#include "c_audio_mixer.h"
+#include "c_audio_overload.h"
+#include "c_audio_resampler.h"
+#include "c_audio_ring_buffer.h"
+#include "c_audio_share_capture.h"
+#include "c_audio_track_writer.h"
+#include "c_audio_user_table.h"
+#include "c_audio_vad.h"
+#include "c_media_timeline.h"
+#include "c_meeting_participants_interface.h"
 
-#include <chrono>
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <stdio.h>
+#include <vector>
 
 extern "C" int32_t on_one_way_audio_raw_data(void *ptr, struct exported_audio_raw_data *data, uint32_t user_id);
 
 extern "C" int32_t on_mixed_audio_raw_data(void *ptr, struct exported_audio_raw_data *data);
 
-extern "C" int32_t on_share_audio_raw_data(void *ptr, struct exported_audio_raw_data *data);
+extern "C" int32_t on_share_audio_raw_data(void *ptr, struct exported_audio_raw_data *data, uint32_t user_id);
+
+extern "C" int32_t on_interpreter_audio_raw_data(void *ptr, struct exported_audio_raw_data *data, uint16_t language_id);
+
+extern "C" void on_one_way_audio_silence(void *ptr, const struct audio_silence_marker *marker, uint32_t user_id);
+
+extern "C" void on_audio_raw_data_batch(void *ptr, const struct audio_batch_entry *entries, uint32_t count);
 
 // #include <fstream>
 // #include <iostream>
 
+constexpr unsigned int AUDIO_STREAM_COUNT = AUDIO_STREAM_INTERPRETER + 1;
+constexpr unsigned int DEFAULT_RING_CAPACITY = 1 << 20;
+constexpr unsigned int DEFAULT_USER_RING_CAPACITY = 1 << 17;
+constexpr unsigned int AUDIO_MAX_USERS = 1024;
+constexpr unsigned int DEFAULT_TRACK_RING_CAPACITY = 1 << 18;
+/// 2.5 s of 10 ms frames.
+constexpr unsigned int DEFAULT_SHARE_QUEUE_CAPACITY = 256;
+constexpr unsigned int DEFAULT_SHARE_POOL_SIZE = 64;
+constexpr unsigned int DEFAULT_OVERLOAD_HIGH_WATER_PERCENT = 50;
+constexpr unsigned int DEFAULT_OVERLOAD_DEGRADE_RATE = 16000;
+constexpr unsigned int DEFAULT_ECHO_SAMPLE_RATE = 32000;
+/// Age past the window from which the batch of a quiet stream is delivered by another thread.
+/// Streams that flow send a frame every 10 ms and deliver their own batches well before.
+constexpr int64_t BATCH_STALE_US = 20000;
+/// Rates the SDK sends audio at, their resampling filters are designed by the settings that need them.
+constexpr unsigned int SDK_AUDIO_RATES[] = { 32000, 48000 };
+constexpr unsigned int DEFAULT_ECHO_MAX_DELAY_MS = 1000;
+constexpr unsigned int DEFAULT_ECHO_TAPS = 256;
+/// Chunker slot of the mixed stream, the user of slot `i` uses `i + 1`.
+constexpr unsigned int CHUNK_STREAM_MIXED = 0;
+
 class ZoomSDKAudioRawDataDelegate : public ZOOMSDK::IZoomSDKAudioRawDataDelegate {
 public:
-    ZoomSDKAudioRawDataDelegate(void *ptr, bool separate_channels) {
+    ZoomSDKAudioRawDataDelegate(void *ptr, bool separate_channels) : users(AUDIO_MAX_USERS), recorder(AUDIO_MAX_USERS), mixer(ptr, AUDIO_MAX_USERS), chunker(AUDIO_MAX_USERS + 1) {
         ptr_to_rust = ptr;
         use_separate_channels = separate_channels;
+        delivery_mode.store(AUDIO_DELIVERY_DIRECT, std::memory_order_relaxed);
+        rings_ready.store(false, std::memory_order_relaxed);
+        user_ring_capacity.store(0, std::memory_order_relaxed);
+        rings_wanted.store(false, std::memory_order_relaxed);
+        output_format.store(AUDIO_SAMPLE_S16, std::memory_order_relaxed);
+        output_downmix.store(false, std::memory_order_relaxed);
+        output_gain.store(1.0f, std::memory_order_relaxed);
+        output_rate.store(0, std::memory_order_relaxed);
+        set_vad(false, -50.0f, 300, 1000);
+        level_window_us.store(0, std::memory_order_relaxed);
+        batch_window_us.store(0, std::memory_order_relaxed);
+        alignment_enabled.store(false, std::memory_order_relaxed);
+        alignment_tolerance_us.store(0, std::memory_order_relaxed);
     }
     void onMixedAudioRawDataReceived(AudioRawData* rawdata) override {
-        // std::ofstream file("output_audio.raw", std::ios::binary | std::ios::app);
-        // if (!file.is_open()) {
-        //     std::cerr << "Failed to open file!" << std::endl;
-        //     return;
-        // }
-        // int buffer_len = rawdata->GetBufferLen();
-        // int channel_num = rawdata->GetChannelNum();
-        // int sample_rate = rawdata->GetSampleRate();
+        struct exported_audio_raw_data data = provide(rawdata, &mixed_clock);
+        if (echo.enabled()) {
+            // On the SDK PCM, before anything else reads the frame.
+            echo.process(data);
+        }
+        bool align = aligned() && data.sample_rate != 0;
+        int64_t position = align ? origin.position_us(data.sdk_time, data.mono_time) : 0;
+        convert(data, mixed_resampler, AUDIO_STREAM_MIXED);
+        if (align) {
+            int64_t gap;
+            int64_t skip;
+            data.sample_index = mixed_aligner.place(position, origin.epoch(), data.sample_rate, alignment_tolerance_us.load(std::memory_order_relaxed), &gap, &skip);
+            if (!trim(data, skip)) {
+                return;
+            }
+            mixed_aligner.advance(data.sample_index + frame_samples(data));
+        }
+        if (chunker.begin(CHUNK_STREAM_MIXED, data)) {
+            struct exported_audio_raw_data window;
+            while (chunker.next(CHUNK_STREAM_MIXED, &window)) {
+                deliver_mixed(window);
+            }
+            return;
+        }
+        deliver_mixed(data);
+    }
+    void onOneWayAudioRawDataReceived(AudioRawData* rawdata, uint32_t user_id) override {
+        if (!use_separate_channels) {
+            return;
+        }
+        AudioUserSlot *slot = users.find(user_id);
+        if (!slot) {
+            // Audio can arrive before the join notification, or without any participants handler attached.
+            // The slot gets its ring from the next drain, the stream ring is used until then.
+            slot = users.claim(user_id, timeline_wall_us(monotonic_us()));
+        }
+        if (slot) {
+            AudioUserTable::refresh(slot);
+        }
+        struct exported_audio_raw_data data = provide(rawdata, slot ? &slot->clock : nullptr);
+        if (slot) {
+            // Only the SDK audio thread writes these counters.
+            slot->frames.store(slot->frames.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            slot->samples.store(slot->samples.load(std::memory_order_relaxed) + data.len / (2 * data.channels), std::memory_order_relaxed);
+            slot->last_seen.store(data.time, std::memory_order_relaxed);
+        }
+        bool queued = is_queued();
+        AudioRing *ring = nullptr;
+        if (queued) {
+            ring = slot ? slot->ring.load(std::memory_order_acquire) : nullptr;
+            if (!ring) {
+                if (slot && !rings_wanted.load(std::memory_order_relaxed)) {
+                    rings_wanted.store(true, std::memory_order_release);
+                }
+                ring = rings[AUDIO_STREAM_ONE_WAY].get();
+            }
+        }
+        bool vad = slot && vad_enabled.load(std::memory_order_relaxed);
+        bool align = slot && aligned() && data.sample_rate != 0;
+        int64_t level_window = slot ? level_window_us.load(std::memory_order_relaxed) : 0;
+        struct pcm_activity activity;
+        if (vad || level_window != 0) {
+            // Measured once on the SDK PCM for both the meter and the gate.
+            dsp_s16_activity(reinterpret_cast<const int16_t*>(data.data), data.len / sizeof(int16_t), data.channels, &activity);
+        }
+        if (level_window != 0) {
+            slot->level.update(activity, data.len / sizeof(int16_t), data.mono_time, level_window);
+        }
+        if (slot && mixer.enabled()) {
+            // Mixed from the SDK PCM, before the gate and the output format.
+            mixer.feed(users.index(slot), user_id, data);
+        }
+        // Samples per channel of the frame once converted, the resampler may be one off.
+        unsigned int rate = delivered_rate(data);
+        uint64_t samples = data.sample_rate ? static_cast<uint64_t>(data.len / (sizeof(int16_t) * data.channels)) * rate / data.sample_rate : 0;
+        int64_t sample_index = -1;
+        int64_t skip = 0;
+        if (align) {
+            int64_t gap;
+            int64_t position = origin.position_us(data.sdk_time, data.mono_time);
+            sample_index = slot->aligner.place(position, origin.epoch(), rate, alignment_tolerance_us.load(std::memory_order_relaxed), &gap, &skip);
+            if (gap > 0) {
+                struct audio_silence_marker marker;
+                if (vad && slot->vad.flush(&marker)) {
+                    deliver_silence(data, slot, user_id, ring, marker);
+                }
+                int64_t gap_us = gap * 1000000 / rate;
+                marker = {
+                    start_time: data.time - gap_us,
+                    sdk_time: 0,
+                    duration_ms: static_cast<uint32_t>((gap_us + 500) / 1000),
+                    frames: 0,
+                    sample_index: sample_index - gap,
+                    samples: static_cast<uint64_t>(gap),
+                };
+                deliver_silence(data, slot, user_id, ring, marker);
+            }
+        }
+        if (vad) {
+            // Silent frames skip the conversion entirely.
+            struct audio_silence_marker marker;
+            bool emit = false;
+            bool forward = slot->vad.process(data, activity, vad_params(), sample_index, samples, &marker, &emit);
+            if (emit) {
+                deliver_silence(data, slot, user_id, ring, marker);
+                if (forward) {
+                    // The filter history predates the silence.
+                    slot->resampler.reset();
+                }
+            }
+            if (!forward) {
+                slot->silent_frames.store(slot->silent_frames.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                if (align) {
+                    slot->aligner.advance(sample_index + samples);
+                }
+                return;
+            }
+        }
+        convert(data, slot ? slot->resampler : one_way_resampler, AUDIO_STREAM_ONE_WAY);
+        if (align) {
+            data.sample_index = sample_index;
+            if (!trim(data, skip)) {
+                return;
+            }
+            slot->aligner.advance(sample_index + frame_samples(data));
+        }
+        if (recorder.recording()) {
+            if (slot) {
+                recorder.append(users.index(slot), user_id, data);
+            } else {
+                recorder.drop(data.len);
+            }
+        }
+        if (slot && chunker.begin(users.index(slot) + 1, data)) {
+            struct exported_audio_raw_data window;
+            while (chunker.next(users.index(slot) + 1, &window)) {
+                deliver_one_way(window, slot, user_id, ring);
+            }
+            return;
+        }
+        deliver_one_way(data, slot, user_id, ring);
+    }
+    void onShareAudioRawDataReceived(AudioRawData* rawdata, uint32_t user_id) override {
+        struct exported_audio_raw_data data = provide(rawdata, &share_clock);
+        convert(data, share_resampler, AUDIO_STREAM_SHARE);
+        if (share_capture.enabled()) {
+            share_capture.capture(data, user_id);
+            return;
+        }
+        if (is_queued()) {
+            // The frame is copied, no need to keep the SDK buffer alive.
+            enqueue(*rings[AUDIO_STREAM_SHARE], overload_lanes[AUDIO_STREAM_SHARE], AUDIO_STREAM_SHARE, data, user_id, nullptr);
+            return;
+        }
+        if (batched(AUDIO_STREAM_SHARE, data, user_id, AUDIO_RECORD_FRAME, data.data, data.len)) {
+            return;
+        }
+        on_share_audio_raw_data(ptr_to_rust, &data, user_id);
+    }
+    void onOneWayInterpreterAudioRawDataReceived(AudioRawData* rawdata, const zchar_t* pLanguageName) override {
+        uint16_t language_id = languages.intern(pLanguageName);
+        struct exported_audio_raw_data data = provide(rawdata, &interpreter_clock);
+        convert(data, interpreter_resamplers[language_id], AUDIO_STREAM_INTERPRETER);
+        if (is_queued()) {
+            enqueue(*rings[AUDIO_STREAM_INTERPRETER], overload_lanes[AUDIO_STREAM_INTERPRETER], AUDIO_STREAM_INTERPRETER, data, language_id, nullptr);
+            return;
+        }
+        if (batched(AUDIO_STREAM_INTERPRETER, data, language_id, AUDIO_RECORD_FRAME, data.data, data.len)) {
+            return;
+        }
+        on_interpreter_audio_raw_data(ptr_to_rust, &data, language_id);
+    }
 
-        // file.write(reinterpret_cast<const char*>(rawdata->GetBuffer()), buffer_len);
+    bool set_delivery_mode(enum audio_delivery_mode mode, unsigned int ring_capacity, unsigned int user_capacity) {
+        std::lock_guard<std::mutex> lock(config_mutex);
+        if (mode == AUDIO_DELIVERY_QUEUED && !rings_ready.load(std::memory_order_relaxed)) {
+            // Rings are allocated once and kept until the delegate dies: the SDK thread may still
+            // be inside a push when the mode is switched back to direct.
+            size_t capacity = ring_capacity != 0 ? ring_capacity : DEFAULT_RING_CAPACITY;
+            std::unique_ptr<AudioRing> allocated[AUDIO_STREAM_COUNT];
+            for (unsigned int i = 0; i < AUDIO_STREAM_COUNT; i += 1) {
+                allocated[i].reset(AudioRing::create(capacity));
+                if (!allocated[i]) {
+                    return false;
+                }
+            }
+            size_t per_user = user_capacity != 0 ? user_capacity : DEFAULT_USER_RING_CAPACITY;
+            // User rings allocated so far stay with their slots, only queued mode pushes into them.
+            if (!users.allocate_rings(per_user)) {
+                return false;
+            }
+            for (unsigned int i = 0; i < AUDIO_STREAM_COUNT; i += 1) {
+                rings[i] = std::move(allocated[i]);
+            }
+            user_ring_capacity.store(per_user, std::memory_order_relaxed);
+            rings_ready.store(true, std::memory_order_release);
+        }
+        delivery_mode.store(mode, std::memory_order_release);
+        return true;
+    }
+
+    bool set_output_format(enum audio_sample_format format, bool downmix_mono, float gain, unsigned int sample_rate) {
+        prepare_resamplers(sample_rate, 0);
+        output_rate.store(sample_rate, std::memory_order_relaxed);
+        output_format.store(format, std::memory_order_relaxed);
+        output_downmix.store(downmix_mono, std::memory_order_relaxed);
+        output_gain.store(gain, std::memory_order_relaxed);
+        return true;
+    }
+
+    bool set_vad(bool enabled, float threshold_dbfs, unsigned int hangover_ms, unsigned int max_silence_ms) {
+        VadParams params = VadParams::from_settings(threshold_dbfs, hangover_ms, max_silence_ms);
+        vad_loud_power.store(params.loud_power, std::memory_order_relaxed);
+        vad_soft_power.store(params.soft_power, std::memory_order_relaxed);
+        vad_hangover_us.store(params.hangover_us, std::memory_order_relaxed);
+        vad_max_silence_us.store(params.max_silence_us, std::memory_order_relaxed);
+        vad_enabled.store(enabled, std::memory_order_release);
+        return true;
+    }
 
-        // file.close();
+    bool set_level_window(unsigned int window_ms) {
+        level_window_us.store(static_cast<int64_t>(window_ms) * 1000, std::memory_order_relaxed);
+        return true;
+    }
 
-        struct exported_audio_raw_data data = provide(rawdata);
+    unsigned int levels(struct user_level *levels, unsigned int cap) {
+        int64_t window = level_window_us.load(std::memory_order_relaxed);
+        if (window == 0) {
+            return 0;
+        }
+        int64_t now = monotonic_us();
+        unsigned int count = 0;
+        for (unsigned int i = 0; i < users.max_users() && count < cap; i += 1) {
+            AudioUserSlot &slot = users.slot(i);
+            if (!slot.active.load(std::memory_order_acquire)) {
+                continue;
+            }
+            levels[count].user_id = slot.user_id.load(std::memory_order_relaxed);
+            slot.level.read(&levels[count], now, window);
+            count += 1;
+        }
+        return count;
+    }
+
+    bool set_batch_window(unsigned int window_ms) {
+        batch_window_us.store(static_cast<int64_t>(window_ms) * 1000, std::memory_order_relaxed);
+        return true;
+    }
+
+    void flush_batches() {
+        for (unsigned int i = 0; i < AUDIO_STREAM_COUNT; i += 1) {
+            batches[i].hold();
+            deliver_batch(batches[i]);
+            batches[i].release();
+        }
+    }
+
+    void flush_stale_batches() {
+        int64_t window = batch_window_us.load(std::memory_order_relaxed);
+        if (window != 0) {
+            flush_stale(AUDIO_STREAM_COUNT, monotonic_us(), window);
+        }
+    }
+
+    bool start_recording(const char *directory, unsigned int threads, unsigned int ring_capacity,
+                         unsigned int flush_ms, unsigned int sync_ms, unsigned int preallocate_kb,
+                         enum audio_track_codec codec) {
+        AudioTrackSettings settings;
+        settings.directory = directory;
+        settings.threads = threads;
+        settings.ring_capacity = ring_capacity != 0 ? ring_capacity : DEFAULT_TRACK_RING_CAPACITY;
+        settings.flush_us = static_cast<int64_t>(flush_ms) * 1000;
+        settings.sync_us = static_cast<int64_t>(sync_ms) * 1000;
+        settings.preallocate_bytes = static_cast<size_t>(preallocate_kb) * 1024;
+        settings.codec = codec;
+        return recorder.start(settings);
+    }
+
+    void stop_recording() {
+        recorder.stop();
+    }
+
+    void recorder_stats(struct audio_recorder_stats *stats) {
+        recorder.stats(stats);
+    }
+
+    bool set_mixer(unsigned int sample_rate, unsigned int jitter_ms) {
+        return mixer.configure(sample_rate, jitter_ms);
+    }
+
+    bool set_mix(unsigned int mix_id, enum audio_mix_mode mode, const uint32_t *user_ids, unsigned int count) {
+        return mixer.set_mix(mix_id, mode, user_ids, count);
+    }
+
+    void mixer_stats(struct audio_mixer_stats *stats) {
+        mixer.stats(stats);
+    }
+
+    bool set_chunker(unsigned int window_ms, unsigned int overlap_ms, char *slab, size_t slot_bytes, unsigned int slots) {
+        return chunker.configure(window_ms, overlap_ms, slab, slot_bytes, slots);
+    }
+
+    void chunker_stats(struct audio_chunker_stats *stats) {
+        chunker.stats(stats);
+    }
+
+    bool set_share_capture(bool enabled, unsigned int capacity, unsigned int pool_size) {
+        return share_capture.configure(enabled, capacity != 0 ? capacity : DEFAULT_SHARE_QUEUE_CAPACITY,
+                                       pool_size != 0 ? pool_size : DEFAULT_SHARE_POOL_SIZE);
+    }
+
+    unsigned int pop_share_audio(struct share_audio_packet *packets, unsigned int cap) {
+        return share_capture.pop(packets, cap);
+    }
+
+    void share_capture_stats(struct share_capture_stats *stats) {
+        share_capture.stats(stats);
+    }
+
+    bool set_alignment(bool enabled, unsigned int tolerance_ms) {
+        std::lock_guard<std::mutex> lock(config_mutex);
+        alignment_tolerance_us.store(static_cast<int64_t>(tolerance_ms) * 1000, std::memory_order_relaxed);
+        if (enabled && !alignment_enabled.load(std::memory_order_relaxed)) {
+            origin.reset();
+        }
+        alignment_enabled.store(enabled, std::memory_order_release);
+        return true;
+    }
+
+    bool alignment_origin(int64_t *time) {
+        int64_t mono_us;
+        if (!aligned() || !origin.mono_us(&mono_us)) {
+            return false;
+        }
+        *time = timeline_wall_us(mono_us);
+        return true;
+    }
+
+    unsigned int interpreter_language_count() {
+        return languages.size();
+    }
+
+    unsigned int interpreter_languages(struct interpreter_language *out, unsigned int cap) {
+        return languages.copy(out, cap);
+    }
+
+    unsigned int drain(unsigned int max_frames) {
+        if (!rings_ready.load(std::memory_order_acquire)) {
+            return 0;
+        }
+        provide_rings();
+        unsigned int count = 0;
+        // Decided once per ring: the fill only moves when a drain releases its records.
+        bool skip_silence = dropping_silence(AUDIO_STREAM_MIXED, *rings[AUDIO_STREAM_MIXED]);
+        count += rings[AUDIO_STREAM_MIXED]->drain(
+            [this, skip_silence](struct audio_ring_header &header, char *payload, uint32_t len) {
+                if (skip_silence && header.silent) {
+                    overload.count_dropped_silence(AUDIO_STREAM_MIXED);
+                    return;
+                }
+                header.data.data = payload;
+                header.data.len = len;
+                header.data.raw = nullptr;
+                on_mixed_audio_raw_data(ptr_to_rust, &header.data);
+            },
+            max_frames - count);
+        // Consecutive silent frames skipped from a user ring are handed over as one marker.
+        struct audio_silence_marker skipped;
+        uint32_t skipped_user = 0;
+        unsigned int skipped_rate = 0;
+        bool has_skipped = false;
+        auto flush_skipped = [this, &skipped, &skipped_user, &has_skipped]() {
+            if (has_skipped) {
+                on_one_way_audio_silence(ptr_to_rust, &skipped, skipped_user);
+                has_skipped = false;
+            }
+        };
+        auto one_way = [&](struct audio_ring_header &header, char *payload, uint32_t len) {
+            if (header.kind == AUDIO_RECORD_FRAME && skip_silence && header.silent && header.data.sample_rate != 0) {
+                overload.count_dropped_silence(AUDIO_STREAM_ONE_WAY);
+                header.data.len = len;
+                uint64_t samples = frame_samples(header.data);
+                bool follows = has_skipped && skipped_user == header.user_id && skipped_rate == header.data.sample_rate &&
+                               (skipped.sample_index < 0 ? header.data.sample_index < 0
+                                                         : header.data.sample_index == skipped.sample_index + static_cast<int64_t>(skipped.samples));
+                if (!follows) {
+                    flush_skipped();
+                    skipped = {
+                        start_time: header.data.time,
+                        sdk_time: header.data.sdk_time,
+                        duration_ms: 0,
+                        frames: 0,
+                        sample_index: header.data.sample_index,
+                        samples: 0,
+                    };
+                    skipped_user = header.user_id;
+                    skipped_rate = header.data.sample_rate;
+                    has_skipped = true;
+                }
+                skipped.frames += 1;
+                skipped.samples += samples;
+                skipped.duration_ms = static_cast<uint32_t>(skipped.samples * 1000 / skipped_rate);
+                return;
+            }
+            flush_skipped();
+            if (header.kind == AUDIO_RECORD_SILENCE) {
+                on_one_way_audio_silence(ptr_to_rust, reinterpret_cast<struct audio_silence_marker*>(payload), header.user_id);
+                return;
+            }
+            header.data.data = payload;
+            header.data.len = len;
+            header.data.raw = nullptr;
+            on_one_way_audio_raw_data(ptr_to_rust, &header.data, header.user_id);
+        };
+        for (unsigned int i = 0; i < users.max_users() && count < max_frames; i += 1) {
+            AudioRing *ring = users.slot(i).ring.load(std::memory_order_acquire);
+            if (ring) {
+                skip_silence = dropping_silence(AUDIO_STREAM_ONE_WAY, *ring);
+                count += ring->drain(one_way, max_frames - count, flush_skipped);
+            }
+        }
+        skip_silence = dropping_silence(AUDIO_STREAM_ONE_WAY, *rings[AUDIO_STREAM_ONE_WAY]);
+        count += rings[AUDIO_STREAM_ONE_WAY]->drain(one_way, max_frames - count, flush_skipped);
+        skip_silence = dropping_silence(AUDIO_STREAM_SHARE, *rings[AUDIO_STREAM_SHARE]);
+        count += rings[AUDIO_STREAM_SHARE]->drain(
+            [this, skip_silence](struct audio_ring_header &header, char *payload, uint32_t len) {
+                if (skip_silence && header.silent) {
+                    overload.count_dropped_silence(AUDIO_STREAM_SHARE);
+                    return;
+                }
+                header.data.data = payload;
+                header.data.len = len;
+                header.data.raw = nullptr;
+                on_share_audio_raw_data(ptr_to_rust, &header.data, header.user_id);
+            },
+            max_frames - count);
+        skip_silence = dropping_silence(AUDIO_STREAM_INTERPRETER, *rings[AUDIO_STREAM_INTERPRETER]);
+        count += rings[AUDIO_STREAM_INTERPRETER]->drain(
+            [this, skip_silence](struct audio_ring_header &header, char *payload, uint32_t len) {
+                if (skip_silence && header.silent) {
+                    overload.count_dropped_silence(AUDIO_STREAM_INTERPRETER);
+                    return;
+                }
+                header.data.data = payload;
+                header.data.len = len;
+                header.data.raw = nullptr;
+                on_interpreter_audio_raw_data(ptr_to_rust, &header.data, static_cast<uint16_t>(header.user_id));
+            },
+            max_frames - count);
+        return count;
+    }
+
+    bool set_overload_policy(enum audio_stream_kind stream, enum audio_overload_policy policy,
+                             unsigned int high_water_percent, unsigned int degrade_rate) {
+        unsigned int rate = degrade_rate != 0 ? degrade_rate : DEFAULT_OVERLOAD_DEGRADE_RATE;
+        if (!overload.configure(stream, policy, high_water_percent != 0 ? high_water_percent : DEFAULT_OVERLOAD_HIGH_WATER_PERCENT, rate)) {
+            return false;
+        }
+        // Frames are degraded after the output conversion.
+        if (policy >= AUDIO_OVERLOAD_DEGRADE) {
+            prepare_resamplers(rate, output_rate.load(std::memory_order_relaxed));
+        }
+        return true;
+    }
+
+    bool overload_stats(enum audio_stream_kind stream, struct audio_overload_stats *stats) {
+        return overload.stats(stream, stats);
+    }
+
+    bool set_echo_canceller(bool enabled, unsigned int sample_rate, unsigned int max_delay_ms, unsigned int taps) {
+        return echo.configure(enabled, sample_rate != 0 ? sample_rate : DEFAULT_ECHO_SAMPLE_RATE,
+                              max_delay_ms != 0 ? max_delay_ms : DEFAULT_ECHO_MAX_DELAY_MS,
+                              taps != 0 ? taps : DEFAULT_ECHO_TAPS);
+    }
+
+    void echo_canceller_stats(struct audio_echo_canceller_stats *stats) {
+        echo.stats(stats);
+    }
+
+    bool queue_stats(enum audio_stream_kind stream, struct audio_queue_stats *stats) {
+        if (!rings_ready.load(std::memory_order_acquire) || stream >= AUDIO_STREAM_COUNT) {
+            return false;
+        }
+        provide_rings();
+        struct spsc_ring_counters counters;
+        rings[stream]->counters(&counters);
+        stats->pushed_frames = counters.pushed;
+        stats->dropped_frames = counters.dropped;
+        stats->dropped_bytes = counters.dropped_bytes;
+        stats->drained_frames = counters.drained;
+        stats->high_water_bytes = counters.high_water;
+        stats->capacity_bytes = rings[stream]->capacity();
+        if (stream == AUDIO_STREAM_ONE_WAY) {
+            // Per-user rings are summed, high_water_bytes is the worst user.
+            for (unsigned int i = 0; i < users.max_users(); i += 1) {
+                AudioRing *ring = users.slot(i).ring.load(std::memory_order_acquire);
+                if (!ring) {
+                    continue;
+                }
+                ring->counters(&counters);
+                stats->pushed_frames += counters.pushed;
+                stats->dropped_frames += counters.dropped;
+                stats->dropped_bytes += counters.dropped_bytes;
+                stats->drained_frames += counters.drained;
+                stats->capacity_bytes += ring->capacity();
+                if (counters.high_water > stats->high_water_bytes) {
+                    stats->high_water_bytes = counters.high_water;
+                }
+            }
+        }
+        return true;
+    }
+
+    void user_join(const unsigned int *user_ids, unsigned int count) {
+        size_t capacity = user_ring_capacity.load(std::memory_order_relaxed);
+        for (unsigned int i = 0; i < count; i += 1) {
+            users.join(user_ids[i], capacity);
+        }
+    }
+
+    void user_left(const unsigned int *user_ids, unsigned int count) {
+        for (unsigned int i = 0; i < count; i += 1) {
+            users.retire(user_ids[i]);
+        }
+    }
+
+    unsigned int user_streams(struct audio_user_stream *streams, unsigned int cap) {
+        if (rings_ready.load(std::memory_order_acquire)) {
+            provide_rings();
+        }
+        unsigned int count = 0;
+        for (unsigned int i = 0; i < users.max_users() && count < cap; i += 1) {
+            AudioUserSlot &slot = users.slot(i);
+            AudioRing *ring = slot.ring.load(std::memory_order_acquire);
+            bool active = slot.active.load(std::memory_order_acquire);
+            if (!active && (!ring || ring->empty())) {
+                continue;
+            }
+            struct audio_user_stream &out = streams[count];
+            out.user_id = slot.user_id.load(std::memory_order_relaxed);
+            out.active = active;
+            out.frames = slot.frames.load(std::memory_order_relaxed);
+            out.samples = slot.samples.load(std::memory_order_relaxed);
+            out.last_seen = slot.last_seen.load(std::memory_order_relaxed);
+            out.queued_bytes = 0;
+            out.dropped_frames = 0;
+            out.silent_frames = slot.silent_frames.load(std::memory_order_relaxed);
+            if (ring) {
+                struct spsc_ring_counters counters;
+                ring->counters(&counters);
+                out.queued_bytes = ring->used();
+                out.dropped_frames = counters.dropped;
+            }
+            count += 1;
+        }
+        return count;
+    }
+
+    /// Fed by the mic events linked with audio_helper_set_echo_canceller.
+    EchoCanceller echo;
+private:
+    inline bool is_queued() {
+        return delivery_mode.load(std::memory_order_acquire) == AUDIO_DELIVERY_QUEUED;
+    }
+    /// Design the filters from the SDK rates, and `from` if not 0, to `rate` before the audio threads meet them.
+    static void prepare_resamplers(unsigned int rate, unsigned int from) {
+        for (unsigned int sdk_rate : SDK_AUDIO_RATES) {
+            AudioResampler::prepare(sdk_rate, rate);
+        }
+        AudioResampler::prepare(from, rate);
+    }
+    /// Allocate the rings of the slots the SDK audio thread claimed, off that thread. Queued mode only.
+    void provide_rings() {
+        if (rings_wanted.load(std::memory_order_relaxed) && rings_wanted.exchange(false, std::memory_order_acquire) &&
+            !users.allocate_rings(user_ring_capacity.load(std::memory_order_relaxed))) {
+            // Out of memory, the next call tries again.
+            rings_wanted.store(true, std::memory_order_relaxed);
+        }
+    }
+    inline bool aligned() {
+        return alignment_enabled.load(std::memory_order_acquire);
+    }
+    /// Rate of a frame once converted.
+    inline unsigned int delivered_rate(const struct exported_audio_raw_data &data) {
+        unsigned int rate = output_rate.load(std::memory_order_relaxed);
+        return rate != 0 ? rate : data.sample_rate;
+    }
+    inline static uint64_t frame_samples(const struct exported_audio_raw_data &data) {
+        size_t sample_size = data.format == AUDIO_SAMPLE_F32 ? sizeof(float) : sizeof(int16_t);
+        return data.len / (sample_size * data.channels);
+    }
+    /// Drop the first `skip` samples of a delivered frame, already covered by the previous frames of its stream.
+    /// @return false if nothing is left.
+    inline static bool trim(struct exported_audio_raw_data &data, int64_t skip) {
+        if (skip == 0) {
+            return true;
+        }
+        uint64_t samples = frame_samples(data);
+        if (static_cast<uint64_t>(skip) >= samples) {
+            return false;
+        }
+        size_t bytes = static_cast<size_t>(skip) * (data.len / samples);
+        data.data += bytes;
+        data.len -= bytes;
+        data.sample_index += skip;
+        return true;
+    }
+    inline void deliver_mixed(struct exported_audio_raw_data &data) {
+        if (is_queued()) {
+            enqueue(*rings[AUDIO_STREAM_MIXED], overload_lanes[AUDIO_STREAM_MIXED], AUDIO_STREAM_MIXED, data, 0, nullptr);
+            return;
+        }
+        if (batched(AUDIO_STREAM_MIXED, data, 0, AUDIO_RECORD_FRAME, data.data, data.len)) {
+            return;
+        }
         on_mixed_audio_raw_data(ptr_to_rust, &data);
     }
-    void onOneWayAudioRawDataReceived(AudioRawData* rawdata, uint32_t user_id) override {
-        if (!use_separate_channels) {
+    /// @param ring Queue of the user when delivery is queued, NULL otherwise.
+    inline void deliver_one_way(struct exported_audio_raw_data &data, AudioUserSlot *slot, uint32_t user_id, AudioRing *ring) {
+        if (ring) {
+            // Users without a ring share the stream ring and its lane, those with a slot are still shed one by one.
+            bool shared = ring == rings[AUDIO_STREAM_ONE_WAY].get();
+            AudioOverloadLane *sender = slot ? &slot->overload : nullptr;
+            enqueue(*ring, shared ? overload_lanes[AUDIO_STREAM_ONE_WAY] : slot->overload, AUDIO_STREAM_ONE_WAY, data, user_id, sender);
+            return;
+        }
+        if (batched(AUDIO_STREAM_ONE_WAY, data, user_id, AUDIO_RECORD_FRAME, data.data, data.len)) {
             return;
         }
-        struct exported_audio_raw_data data = provide(rawdata);
         on_one_way_audio_raw_data(ptr_to_rust, &data, user_id);
     }
-    void onShareAudioRawDataReceived(AudioRawData* rawdata, uint32_t user_id) override {
-        (void) user_id;
-        // TODO : May crash with segfault
-        struct exported_audio_raw_data data = provide(rawdata);
-        int32_t res = on_share_audio_raw_data(ptr_to_rust, &data);
-        if (res == 1) {
-            printf("increment\n");
-            rawdata->AddRef();
-        } else if (res < 0) {
-            for (; res < 0; res += 1) {
-                printf("Executing purge\n");
-                rawdata->Release();
+    /// Hand a one-way silence marker over like a frame of the user, after the window it interrupts.
+    inline void deliver_silence(const struct exported_audio_raw_data &data, AudioUserSlot *slot, uint32_t user_id,
+                                AudioRing *ring, const struct audio_silence_marker &marker) {
+        struct exported_audio_raw_data window;
+        if (chunker.flush(users.index(slot) + 1, &window)) {
+            deliver_one_way(window, slot, user_id, ring);
+        }
+        if (ring) {
+            ring->push({ data, user_id, AUDIO_RECORD_SILENCE, false }, reinterpret_cast<const char*>(&marker), sizeof(marker));
+        } else if (!batched(AUDIO_STREAM_ONE_WAY, data, user_id, AUDIO_RECORD_SILENCE, reinterpret_cast<const char*>(&marker), sizeof(marker))) {
+            on_one_way_audio_silence(ptr_to_rust, &marker, user_id);
+        }
+    }
+    /// Queue a frame through the overload policy of its stream.
+    /// @param sender Overload state of the sender that can be shed, see AudioOverloadPolicy::admit.
+    inline void enqueue(AudioRing &ring, AudioOverloadLane &lane, enum audio_stream_kind stream,
+                        struct exported_audio_raw_data &data, uint32_t id, AudioOverloadLane *sender) {
+        bool silent;
+        if (!overload.admit(stream, ring.used(), ring.capacity(), lane, sender, vad_loud_power.load(std::memory_order_relaxed), data, &silent)) {
+            return;
+        }
+        ring.push({ data, id, AUDIO_RECORD_FRAME, silent }, data.data, data.len);
+    }
+    /// Whether the drain of `ring` skips its silent frames, see AudioOverloadPolicy.
+    inline bool dropping_silence(enum audio_stream_kind stream, const AudioRing &ring) {
+        return overload.drops_silence(stream, ring.used(), ring.capacity());
+    }
+    /// Add a directly delivered record to the batch of its stream.
+    /// @param id Sender of the record, or its language id on the interpreter stream.
+    /// @return false if batching is off, the caller delivers the record itself.
+    inline bool batched(enum audio_stream_kind stream, const struct exported_audio_raw_data &data, uint32_t id,
+                        enum audio_record_kind kind, const char *payload, uint32_t len) {
+        AudioBatch &batch = batches[stream];
+        int64_t window = batch_window_us.load(std::memory_order_relaxed);
+        if (window == 0 && batch.idle()) {
+            return false;
+        }
+        batch.hold();
+        // A batch left over by a disabled window goes out with this record, to keep the order.
+        batch.append(data, id, stream, kind, payload, len);
+        if (window == 0 || batch.due(data.mono_time, window)) {
+            deliver_batch(batch);
+        }
+        batch.release();
+        if (window != 0) {
+            flush_stale(stream, data.mono_time, window);
+        }
+        return true;
+    }
+    /// Deliver the batches of the streams that went quiet, their own SDK threads would keep them until their next frame.
+    /// A batch its stream is using is left alone, the stream delivers it itself.
+    inline void flush_stale(unsigned int current, int64_t now, int64_t window) {
+        for (unsigned int i = 0; i < AUDIO_STREAM_COUNT; i += 1) {
+            AudioBatch &batch = batches[i];
+            if (i == current || !batch.due(now, window + BATCH_STALE_US) || !batch.try_hold()) {
+                continue;
+            }
+            // Checked again under the hold, the stream may have delivered it in between.
+            if (batch.due(now, window + BATCH_STALE_US)) {
+                deliver_batch(batch);
             }
+            batch.release();
         }
     }
-    void onOneWayInterpreterAudioRawDataReceived(AudioRawData* data_, const zchar_t* pLanguageName) override {
-        (void) data_;
-        (void) pLanguageName;
+    inline void deliver_batch(AudioBatch &batch) {
+        if (batch.empty()) {
+            return;
+        }
+        uint32_t count = 0;
+        const struct audio_batch_entry *entries = batch.seal(&count);
+        on_audio_raw_data_batch(ptr_to_rust, entries, count);
+        batch.clear();
     }
-private:
-    inline struct exported_audio_raw_data provide(AudioRawData* rawdata) {
-        using namespace std::chrono;
-        int64_t timestamp = duration_cast<microseconds>(system_clock::now().time_since_epoch()).count();
-        
+    inline VadParams vad_params() {
+        VadParams params;
+        params.loud_power = vad_loud_power.load(std::memory_order_relaxed);
+        params.soft_power = vad_soft_power.load(std::memory_order_relaxed);
+        params.hangover_us = vad_hangover_us.load(std::memory_order_relaxed);
+        params.max_silence_us = vad_max_silence_us.load(std::memory_order_relaxed);
+        return params;
+    }
+    inline struct exported_audio_raw_data provide(AudioRawData* rawdata, StreamClock *clock) {
+        int64_t mono_time = monotonic_us();
+        uint64_t sdk_time = rawdata->GetTimeStamp();
+
         struct exported_audio_raw_data data = {
             data: rawdata->GetBuffer(),
-            time: timestamp,
+            time: timeline_wall_us(mono_time),
             len: rawdata->GetBufferLen(),
-            // can_add_ref: rawdata->CanAddRef(),
+            format: AUDIO_SAMPLE_S16,
+            sample_rate: rawdata->GetSampleRate(),
+            channels: rawdata->GetChannelNum() ? rawdata->GetChannelNum() : 1,
+            raw: rawdata,
+            sdk_time: sdk_time,
+            mono_time: mono_time,
+            drift: clock ? clock->update(sdk_time, mono_time) : 0,
+            sample_index: -1,
         };
         return data;
     }
+    /// Apply the output format to a frame, the result lives in `scratch[stream]` until the next frame of the stream.
+    inline void convert(struct exported_audio_raw_data &data, AudioResampler &resampler, unsigned int stream) {
+        enum audio_sample_format format = static_cast<enum audio_sample_format>(output_format.load(std::memory_order_relaxed));
+        bool downmix = data.channels == 2 && output_downmix.load(std::memory_order_relaxed);
+        float gain = output_gain.load(std::memory_order_relaxed);
+        unsigned int rate = output_rate.load(std::memory_order_relaxed);
+        bool resample = rate != 0 && data.sample_rate != 0 && rate != data.sample_rate;
+        if (format == AUDIO_SAMPLE_S16 && !downmix && gain == 1.0f && !resample) {
+            return;
+        }
+        std::vector<char> &out = scratch[stream];
+        const int16_t *in = reinterpret_cast<const int16_t*>(data.data);
+        size_t samples = data.len / sizeof(int16_t);
+        size_t out_samples = downmix ? samples / 2 : samples;
+        unsigned int channels = downmix ? 1 : data.channels;
+        if (resample) {
+            // Float pipeline: convert and downmix at the start of `work`, resample behind it, then pack into `out`.
+            std::vector<float> &pcm = work[stream];
+            size_t frames = out_samples / channels;
+            size_t max_samples = AudioResampler::max_output(frames, data.sample_rate, rate) * channels;
+            if (pcm.size() < samples + max_samples) {
+                pcm.resize(samples + max_samples);
+            }
+            dsp_s16_to_f32(in, pcm.data(), samples, 1.0f / 32768.0f);
+            if (downmix) {
+                dsp_downmix_f32(pcm.data(), pcm.data(), out_samples);
+            }
+            float *resampled = pcm.data() + samples;
+            out_samples = resampler.process(pcm.data(), frames, channels, data.sample_rate, rate, resampled) * channels;
+            size_t sample_size = format == AUDIO_SAMPLE_F32 ? sizeof(float) : sizeof(int16_t);
+            if (out.size() < out_samples * sample_size) {
+                out.resize(out_samples * sample_size);
+            }
+            if (format == AUDIO_SAMPLE_F32) {
+                dsp_gain_clip_f32(resampled, reinterpret_cast<float*>(out.data()), out_samples, gain);
+            } else {
+                dsp_f32_to_s16(resampled, reinterpret_cast<int16_t*>(out.data()), out_samples, gain * 32768.0f);
+            }
+            data.len = out_samples * sample_size;
+            data.sample_rate = rate;
+        } else if (format == AUDIO_SAMPLE_F32) {
+            // Converted in place before the downmix, so the buffer holds every input sample.
+            if (out.size() < samples * sizeof(float)) {
+                out.resize(samples * sizeof(float));
+            }
+            float *pcm = reinterpret_cast<float*>(out.data());
+            dsp_s16_to_f32(in, pcm, samples, gain / 32768.0f);
+            if (downmix) {
+                dsp_downmix_f32(pcm, pcm, out_samples);
+            }
+            if (gain > 1.0f) {
+                dsp_gain_clip_f32(pcm, pcm, out_samples, 1.0f);
+            }
+            data.len = out_samples * sizeof(float);
+        } else {
+            if (out.size() < out_samples * sizeof(int16_t)) {
+                out.resize(out_samples * sizeof(int16_t));
+            }
+            int16_t *pcm = reinterpret_cast<int16_t*>(out.data());
+            if (downmix) {
+                dsp_downmix_s16(in, pcm, out_samples);
+                in = pcm;
+            }
+            if (gain != 1.0f) {
+                dsp_gain_s16(in, pcm, out_samples, gain);
+            }
+            data.len = out_samples * sizeof(int16_t);
+        }
+        data.data = out.data();
+        data.format = format;
+        data.channels = channels;
+        data.raw = nullptr;
+    }
     void *ptr_to_rust;
     bool use_separate_channels;
+    std::atomic<int> delivery_mode;
+    std::atomic<bool> rings_ready;
+    std::unique_ptr<AudioRing> rings[AUDIO_STREAM_COUNT];
+    std::atomic<size_t> user_ring_capacity;
+    /// Set by the SDK audio thread when a claimed slot has no ring yet.
+    std::atomic<bool> rings_wanted;
+    AudioUserTable users;
+    StreamClock mixed_clock;
+    StreamClock share_clock;
+    StreamClock interpreter_clock;
+    std::atomic<int> output_format;
+    std::atomic<bool> output_downmix;
+    std::atomic<float> output_gain;
+    std::atomic<unsigned int> output_rate;
+    /// Conversion buffers, one per stream: each stream is delivered by a single SDK thread.
+    std::vector<char> scratch[AUDIO_STREAM_COUNT];
+    std::vector<float> work[AUDIO_STREAM_COUNT];
+    AudioResampler mixed_resampler;
+    AudioResampler share_resampler;
+    /// Used by one-way audio of users without a slot.
+    AudioResampler one_way_resampler;
+    /// One per interpreter language, indexed by language id, 0 included. Part of the delegate so that
+    /// a new language never allocates on the SDK thread.
+    AudioResampler interpreter_resamplers[AudioLanguageTable::MAX_LANGUAGES + 1];
+    AudioLanguageTable languages;
+    std::atomic<bool> vad_enabled;
+    std::atomic<double> vad_loud_power;
+    std::atomic<double> vad_soft_power;
+    std::atomic<int64_t> vad_hangover_us;
+    std::atomic<int64_t> vad_max_silence_us;
+    std::atomic<int64_t> level_window_us;
+    std::atomic<int64_t> batch_window_us;
+    /// Pending batches, one per stream, owned by the SDK thread of the stream.
+    AudioBatch batches[AUDIO_STREAM_COUNT];
+    /// Per-user tracks, indexed by slot.
+    AudioTrackWriter recorder;
+    /// Custom mixes of the per-user streams, inputs indexed by slot.
+    AudioMixer mixer;
+    /// Fixed windows of the mixed and one-way streams, see CHUNK_STREAM_MIXED.
+    AudioChunker chunker;
+    ShareAudioCapture share_capture;
+    AudioOverloadPolicy overload;
+    /// Overload state of the stream rings, the user rings have theirs in the slots.
+    AudioOverloadLane overload_lanes[AUDIO_STREAM_COUNT];
+    std::atomic<bool> alignment_enabled;
+    std::atomic<int64_t> alignment_tolerance_us;
+    MeetingOrigin origin;
+    /// Written by the mixed audio thread only, one-way aligners live in the user slots.
+    StreamAligner mixed_aligner;
+    std::mutex config_mutex;
 };
 
 extern "C" ZOOMSDK::IZoomSDKAudioRawDataDelegate* audio_helper_create_delegate(
@@ -87,14 +947,359 @@ extern "C" ZOOMSDK::IZoomSDKAudioRawDataDelegate* audio_helper_create_delegate(
 
 extern "C" ZOOMSDK::SDKError audio_helper_subscribe_delegate(
     ZOOMSDK::IZoomSDKAudioRawDataHelper* ctx,
-    ZOOMSDK::IZoomSDKAudioRawDataDelegate* pDelegate) {
-    return ctx->subscribe(pDelegate);
+    ZOOMSDK::IZoomSDKAudioRawDataDelegate* pDelegate,
+    bool bWithInterpreters) {
+    return ctx->subscribe(pDelegate, bWithInterpreters);
 }
 
 extern "C" ZOOMSDK::SDKError audio_helper_unsubscribe_delegate(ZOOMSDK::IZoomSDKAudioRawDataHelper* ctx) {
     return ctx->unSubscribe();
 }
 
+extern "C" AudioRawData* audio_raw_data_retain(const struct exported_audio_raw_data *data) {
+    if (!data || !data->raw || !data->raw->CanAddRef() || !data->raw->AddRef()) {
+        return nullptr;
+    }
+    return data->raw;
+}
+
+extern "C" void audio_raw_data_release(AudioRawData *raw) {
+    if (raw) {
+        raw->Release();
+    }
+}
+
+extern "C" bool audio_helper_set_level_window(
+    ZOOMSDK::IZoomSDKAudioRawDataDelegate* delegate,
+    unsigned int window_ms) {
+    if (!delegate) {
+        return false;
+    }
+    return static_cast<ZoomSDKAudioRawDataDelegate*>(delegate)->set_level_window(window_ms);
+}
+
+extern "C" unsigned int audio_helper_get_levels(
+    ZOOMSDK::IZoomSDKAudioRawDataDelegate* delegate,
+    struct user_level *levels,
+    unsigned int cap) {
+    if (!delegate || !levels) {
+        return 0;
+    }
+    return static_cast<ZoomSDKAudioRawDataDelegate*>(delegate)->levels(levels, cap);
+}
+
+extern "C" bool audio_helper_set_batch_window(
+    ZOOMSDK::IZoomSDKAudioRawDataDelegate* delegate,
+    unsigned int window_ms) {
+    if (!delegate) {
+        return false;
+    }
+    return static_cast<ZoomSDKAudioRawDataDelegate*>(delegate)->set_batch_window(window_ms);
+}
+
+extern "C" void audio_helper_flush_batches(ZOOMSDK::IZoomSDKAudioRawDataDelegate* delegate) {
+    if (!delegate) {
+        return;
+    }
+    static_cast<ZoomSDKAudioRawDataDelegate*>(delegate)->flush_batches();
+}
+
+extern "C" void audio_helper_flush_stale_batches(ZOOMSDK::IZoomSDKAudioRawDataDelegate* delegate) {
+    if (!delegate) {
+        return;
+    }
+    static_cast<ZoomSDKAudioRawDataDelegate*>(delegate)->flush_stale_batches();
+}
+
+extern "C" bool audio_helper_start_recording(
+    ZOOMSDK::IZoomSDKAudioRawDataDelegate* delegate,
+    const char *directory,
+    unsigned int threads,
+    unsigned int ring_capacity,
+    unsigned int flush_ms,
+    unsigned int sync_ms,
+    unsigned int preallocate_kb,
+    enum audio_track_codec codec) {
+    if (!delegate || !directory) {
+        return false;
+    }
+    return static_cast<ZoomSDKAudioRawDataDelegate*>(delegate)->start_recording(directory, threads, ring_capacity, flush_ms, sync_ms, preallocate_kb, codec);
+}
+
+extern "C" void audio_helper_stop_recording(ZOOMSDK::IZoomSDKAudioRawDataDelegate* delegate) {
+    if (!delegate) {
+        return;
+    }
+    static_cast<ZoomSDKAudioRawDataDelegate*>(delegate)->stop_recording();
+}
+
+extern "C" bool audio_helper_get_recorder_stats(
+    ZOOMSDK::IZoomSDKAudioRawDataDelegate* delegate,
+    struct audio_recorder_stats *stats) {
+    if (!delegate || !stats) {
+        return false;
+    }
+    static_cast<ZoomSDKAudioRawDataDelegate*>(delegate)->recorder_stats(stats);
+    return true;
+}
+
+extern "C" unsigned int audio_helper_get_interpreter_language_count(ZOOMSDK::IZoomSDKAudioRawDataDelegate* delegate) {
+    if (!delegate) {
+        return 0;
+    }
+    return static_cast<ZoomSDKAudioRawDataDelegate*>(delegate)->interpreter_language_count();
+}
+
+extern "C" unsigned int audio_helper_get_interpreter_languages(
+    ZOOMSDK::IZoomSDKAudioRawDataDelegate* delegate,
+    struct interpreter_language *languages,
+    unsigned int cap) {
+    if (!delegate || !languages) {
+        return 0;
+    }
+    return static_cast<ZoomSDKAudioRawDataDelegate*>(delegate)->interpreter_languages(languages, cap);
+}
+
+extern "C" bool audio_helper_set_mixer(
+    ZOOMSDK::IZoomSDKAudioRawDataDelegate* delegate,
+    unsigned int sample_rate,
+    unsigned int jitter_ms) {
+    if (!delegate) {
+        return false;
+    }
+    return static_cast<ZoomSDKAudioRawDataDelegate*>(delegate)->set_mixer(sample_rate, jitter_ms);
+}
+
+extern "C" bool audio_helper_set_mix(
+    ZOOMSDK::IZoomSDKAudioRawDataDelegate* delegate,
+    unsigned int mix_id,
+    enum audio_mix_mode mode,
+    const uint32_t *user_ids,
+    unsigned int count) {
+    if (!delegate || (!user_ids && count != 0)) {
+        return false;
+    }
+    return static_cast<ZoomSDKAudioRawDataDelegate*>(delegate)->set_mix(mix_id, mode, user_ids, count);
+}
+
+extern "C" bool audio_helper_get_mixer_stats(
+    ZOOMSDK::IZoomSDKAudioRawDataDelegate* delegate,
+    struct audio_mixer_stats *stats) {
+    if (!delegate || !stats) {
+        return false;
+    }
+    static_cast<ZoomSDKAudioRawDataDelegate*>(delegate)->mixer_stats(stats);
+    return true;
+}
+
+extern "C" bool audio_helper_set_chunker(
+    ZOOMSDK::IZoomSDKAudioRawDataDelegate* delegate,
+    unsigned int window_ms,
+    unsigned int overlap_ms,
+    char *slab,
+    size_t slot_bytes,
+    unsigned int slots) {
+    if (!delegate) {
+        return false;
+    }
+    return static_cast<ZoomSDKAudioRawDataDelegate*>(delegate)->set_chunker(window_ms, overlap_ms, slab, slot_bytes, slots);
+}
+
+extern "C" bool audio_helper_get_chunker_stats(
+    ZOOMSDK::IZoomSDKAudioRawDataDelegate* delegate,
+    struct audio_chunker_stats *stats) {
+    if (!delegate || !stats) {
+        return false;
+    }
+    static_cast<ZoomSDKAudioRawDataDelegate*>(delegate)->chunker_stats(stats);
+    return true;
+}
+
+extern "C" bool audio_helper_set_share_capture(
+    ZOOMSDK::IZoomSDKAudioRawDataDelegate* delegate,
+    bool enabled,
+    unsigned int capacity,
+    unsigned int pool_size) {
+    if (!delegate) {
+        return false;
+    }
+    return static_cast<ZoomSDKAudioRawDataDelegate*>(delegate)->set_share_capture(enabled, capacity, pool_size);
+}
+
+extern "C" unsigned int audio_helper_pop_share_audio(
+    ZOOMSDK::IZoomSDKAudioRawDataDelegate* delegate,
+    struct share_audio_packet *packets,
+    unsigned int cap) {
+    if (!delegate || !packets) {
+        return 0;
+    }
+    return static_cast<ZoomSDKAudioRawDataDelegate*>(delegate)->pop_share_audio(packets, cap);
+}
+
+extern "C" bool audio_helper_get_share_capture_stats(
+    ZOOMSDK::IZoomSDKAudioRawDataDelegate* delegate,
+    struct share_capture_stats *stats) {
+    if (!delegate || !stats) {
+        return false;
+    }
+    static_cast<ZoomSDKAudioRawDataDelegate*>(delegate)->share_capture_stats(stats);
+    return true;
+}
+
+extern "C" bool audio_helper_set_overload_policy(
+    ZOOMSDK::IZoomSDKAudioRawDataDelegate* delegate,
+    enum audio_stream_kind stream,
+    enum audio_overload_policy policy,
+    unsigned int high_water_percent,
+    unsigned int degrade_rate) {
+    if (!delegate) {
+        return false;
+    }
+    return static_cast<ZoomSDKAudioRawDataDelegate*>(delegate)->set_overload_policy(stream, policy, high_water_percent, degrade_rate);
+}
+
+extern "C" bool audio_helper_get_overload_stats(
+    ZOOMSDK::IZoomSDKAudioRawDataDelegate* delegate,
+    enum audio_stream_kind stream,
+    struct audio_overload_stats *stats) {
+    if (!delegate || !stats) {
+        return false;
+    }
+    return static_cast<ZoomSDKAudioRawDataDelegate*>(delegate)->overload_stats(stream, stats);
+}
+
+extern "C" bool audio_helper_set_alignment(
+    ZOOMSDK::IZoomSDKAudioRawDataDelegate* delegate,
+    bool enabled,
+    unsigned int tolerance_ms) {
+    if (!delegate) {
+        return false;
+    }
+    return static_cast<ZoomSDKAudioRawDataDelegate*>(delegate)->set_alignment(enabled, tolerance_ms);
+}
+
+extern "C" bool audio_helper_get_alignment_origin(
+    ZOOMSDK::IZoomSDKAudioRawDataDelegate* delegate,
+    int64_t *time) {
+    if (!delegate || !time) {
+        return false;
+    }
+    return static_cast<ZoomSDKAudioRawDataDelegate*>(delegate)->alignment_origin(time);
+}
+
+extern "C" bool audio_helper_set_delivery_mode(
+    ZOOMSDK::IZoomSDKAudioRawDataDelegate* delegate,
+    enum audio_delivery_mode mode,
+    unsigned int ring_capacity,
+    unsigned int user_ring_capacity) {
+    if (!delegate) {
+        return false;
+    }
+    return static_cast<ZoomSDKAudioRawDataDelegate*>(delegate)->set_delivery_mode(mode, ring_capacity, user_ring_capacity);
+}
+
+extern "C" unsigned int audio_helper_drain(
+    ZOOMSDK::IZoomSDKAudioRawDataDelegate* delegate,
+    unsigned int max_frames) {
+    if (!delegate) {
+        return 0;
+    }
+    return static_cast<ZoomSDKAudioRawDataDelegate*>(delegate)->drain(max_frames);
+}
+
+extern "C" bool audio_helper_set_output_format(
+    ZOOMSDK::IZoomSDKAudioRawDataDelegate* delegate,
+    enum audio_sample_format format,
+    bool downmix_mono,
+    float gain,
+    unsigned int sample_rate) {
+    if (!delegate) {
+        return false;
+    }
+    return static_cast<ZoomSDKAudioRawDataDelegate*>(delegate)->set_output_format(format, downmix_mono, gain, sample_rate);
+}
+
+extern "C" bool audio_helper_set_vad(
+    ZOOMSDK::IZoomSDKAudioRawDataDelegate* delegate,
+    bool enabled,
+    float threshold_dbfs,
+    unsigned int hangover_ms,
+    unsigned int max_silence_ms) {
+    if (!delegate) {
+        return false;
+    }
+    return static_cast<ZoomSDKAudioRawDataDelegate*>(delegate)->set_vad(enabled, threshold_dbfs, hangover_ms, max_silence_ms);
+}
+
+extern "C" bool audio_helper_get_queue_stats(
+    ZOOMSDK::IZoomSDKAudioRawDataDelegate* delegate,
+    enum audio_stream_kind stream,
+    struct audio_queue_stats *stats) {
+    if (!delegate || !stats) {
+        return false;
+    }
+    return static_cast<ZoomSDKAudioRawDataDelegate*>(delegate)->queue_stats(stream, stats);
+}
+
+extern "C" void audio_helper_user_join(
+    ZOOMSDK::IZoomSDKAudioRawDataDelegate* delegate,
+    const unsigned int *user_ids,
+    unsigned int count) {
+    if (!delegate || !user_ids) {
+        return;
+    }
+    static_cast<ZoomSDKAudioRawDataDelegate*>(delegate)->user_join(user_ids, count);
+}
+
+extern "C" ZOOMSDK::SDKError audio_helper_attach_participants(
+    ZOOMSDK::IZoomSDKAudioRawDataDelegate* delegate,
+    ZOOMSDK::IMeetingParticipantsController *controller) {
+    if (!delegate || !controller) {
+        return ZOOMSDK::SDKERR_INVALID_PARAMETER;
+    }
+    // Routed first: a join racing the seeding is then applied twice rather than missed.
+    ZOOMSDK::SDKError err = participants_set_audio_delegate(controller, delegate);
+    if (err != ZOOMSDK::SDKERR_SUCCESS) {
+        return err;
+    }
+    auto id_list = controller->GetParticipantsList();
+    if (id_list) {
+        int count = id_list->GetCount();
+        for (int i = 0; i < count; i += 1) {
+            unsigned int user_id = id_list->GetItem(i);
+            static_cast<ZoomSDKAudioRawDataDelegate*>(delegate)->user_join(&user_id, 1);
+        }
+    }
+    return ZOOMSDK::SDKERR_SUCCESS;
+}
+
+extern "C" void audio_helper_detach_participants(ZOOMSDK::IZoomSDKAudioRawDataDelegate* delegate) {
+    if (!delegate) {
+        return;
+    }
+    participants_clear_audio_delegate(delegate);
+}
+
+extern "C" void audio_helper_user_left(
+    ZOOMSDK::IZoomSDKAudioRawDataDelegate* delegate,
+    const unsigned int *user_ids,
+    unsigned int count) {
+    if (!delegate || !user_ids) {
+        return;
+    }
+    static_cast<ZoomSDKAudioRawDataDelegate*>(delegate)->user_left(user_ids, count);
+}
+
+extern "C" unsigned int audio_helper_get_user_streams(
+    ZOOMSDK::IZoomSDKAudioRawDataDelegate* delegate,
+    struct audio_user_stream *streams,
+    unsigned int cap) {
+    if (!delegate || !streams) {
+        return 0;
+    }
+    return static_cast<ZoomSDKAudioRawDataDelegate*>(delegate)->user_streams(streams, cap);
+}
+
 extern "C" void on_mic_initialize(void *ptr, ZOOMSDK::IZoomSDKAudioRawDataSender* pSender);
 
 extern "C" void on_mic_start_send(void *ptr);
@@ -103,6 +1308,33 @@ extern "C" void on_mic_stop_send(void *ptr);
 
 extern "C" void on_mic_uninitialized(void *ptr);
 
+/// @brief Sender handed to Rust and to the pacer in place of the SDK one, so the audio sent either way
+/// reaches the echo canceller linked to the mic.
+class EchoTapSender : public ZOOMSDK::IZoomSDKAudioRawDataSender {
+public:
+    EchoTapSender() {
+        sender.store(nullptr, std::memory_order_relaxed);
+        canceller.store(nullptr, std::memory_order_relaxed);
+    }
+
+    ZOOMSDK::SDKError send(char* data, unsigned int data_length, int sample_rate, ZOOMSDK::ZoomSDKAudioChannel channel) override {
+        ZOOMSDK::IZoomSDKAudioRawDataSender *target = sender.load(std::memory_order_acquire);
+        if (!target) {
+            return ZOOMSDK::SDKERR_UNINITIALIZE;
+        }
+        ZOOMSDK::SDKError result = target->send(data, data_length, sample_rate, channel);
+        EchoCanceller *echo = canceller.load(std::memory_order_acquire);
+        if (result == ZOOMSDK::SDKERR_SUCCESS && echo && sample_rate > 0) {
+            echo->reference(data, data_length, sample_rate, channel == ZOOMSDK::ZoomSDKAudioChannel_Stereo ? 2 : 1);
+        }
+        return result;
+    }
+
+    /// SDK sender, NULL outside onMicInitialize / onMicUninitialized.
+    std::atomic<ZOOMSDK::IZoomSDKAudioRawDataSender*> sender;
+    std::atomic<EchoCanceller*> canceller;
+};
+
 class ZoomSDKVirtualAudioMicEvent : public ZOOMSDK::IZoomSDKVirtualAudioMicEvent {
 public:
 	ZoomSDKVirtualAudioMicEvent(void *ptr) {
@@ -112,40 +1344,127 @@ public:
 	/// \brief Callback for virtual audio mic to do some initialization.
 	/// \param pSender, You can send audio data based on this object, see \link IZoomSDKAudioRawDataSender \endlink.
 	virtual void onMicInitialize(ZOOMSDK::IZoomSDKAudioRawDataSender* pSender) override {
-        on_mic_initialize(ptr_to_rust, pSender);
+        tap.sender.store(pSender, std::memory_order_release);
+        on_mic_initialize(ptr_to_rust, &tap);
     }
 
 	/// \brief Callback for virtual audio mic can send raw data with 'pSender'.
 	virtual void onMicStartSend() override {
+        pacer.start(&tap);
         on_mic_start_send(ptr_to_rust);
     }
 
 	/// \brief Callback for virtual audio mic should stop send raw data.
 	virtual void onMicStopSend() override {
+        pacer.stop();
         on_mic_stop_send(ptr_to_rust);
     }
 
 	/// \brief Callback for virtual audio mic is uninitialized.
 	virtual void onMicUninitialized() override {
+        pacer.stop();
+        tap.sender.store(nullptr, std::memory_order_release);
         on_mic_uninitialized(ptr_to_rust);
     }
+
+    AudioMicPacer pacer;
+    EchoTapSender tap;
 private:
     void *ptr_to_rust;
 };
 
+extern "C" ZOOMSDK::IZoomSDKVirtualAudioMicEvent* audio_helper_create_mic_event(void *arc_ptr) {
+    return new ZoomSDKVirtualAudioMicEvent(arc_ptr); // TODO : Fix memory leak
+}
+
 extern "C" ZOOMSDK::SDKError audio_helper_set_external_audio_source(
     ZOOMSDK::IZoomSDKAudioRawDataHelper* ctx,
-    void *arc_ptr) {
-        auto* obj = new ZoomSDKVirtualAudioMicEvent(arc_ptr); // TODO : Fix memory leak
-        return ctx->setExternalAudioSource(obj);
+    ZOOMSDK::IZoomSDKVirtualAudioMicEvent* mic) {
+        return ctx->setExternalAudioSource(mic);
+}
+
+extern "C" bool audio_helper_set_mic_pacer(
+    ZOOMSDK::IZoomSDKVirtualAudioMicEvent* mic,
+    unsigned int sample_rate,
+    unsigned int channels,
+    unsigned int chunk_ms,
+    unsigned int prefill_ms,
+    unsigned int queue_ms) {
+    if (!mic) {
+        return false;
+    }
+    return static_cast<ZoomSDKVirtualAudioMicEvent*>(mic)->pacer.configure(sample_rate, channels, chunk_ms, prefill_ms, queue_ms);
+}
+
+extern "C" unsigned int audio_helper_mic_push(
+    ZOOMSDK::IZoomSDKVirtualAudioMicEvent* mic,
+    const char *data,
+    unsigned int len) {
+    if (!mic || !data) {
+        return 0;
+    }
+    return static_cast<ZoomSDKVirtualAudioMicEvent*>(mic)->pacer.push(data, len);
+}
+
+extern "C" unsigned int audio_helper_mic_push_pcm(
+    ZOOMSDK::IZoomSDKVirtualAudioMicEvent* mic,
+    const char *data,
+    unsigned int frames,
+    enum audio_sample_format format,
+    unsigned int sample_rate,
+    unsigned int channels) {
+    if (!mic || !data) {
+        return 0;
+    }
+    return static_cast<ZoomSDKVirtualAudioMicEvent*>(mic)->pacer.push_pcm(data, frames, format, sample_rate, channels);
+}
+
+extern "C" bool audio_helper_get_mic_pacer_stats(
+    ZOOMSDK::IZoomSDKVirtualAudioMicEvent* mic,
+    struct audio_mic_pacer_stats *stats) {
+    if (!mic || !stats) {
+        return false;
+    }
+    static_cast<ZoomSDKVirtualAudioMicEvent*>(mic)->pacer.stats(stats);
+    return true;
+}
+
+extern "C" bool audio_helper_set_echo_canceller(
+    ZOOMSDK::IZoomSDKAudioRawDataDelegate* delegate,
+    ZOOMSDK::IZoomSDKVirtualAudioMicEvent* mic,
+    bool enabled,
+    unsigned int sample_rate,
+    unsigned int max_delay_ms,
+    unsigned int taps) {
+    if (!delegate || !mic) {
+        return false;
+    }
+    ZoomSDKAudioRawDataDelegate *audio = static_cast<ZoomSDKAudioRawDataDelegate*>(delegate);
+    if (!audio->set_echo_canceller(enabled, sample_rate, max_delay_ms, taps)) {
+        return false;
+    }
+    // Delegates are never freed, the tap can keep pointing at the canceller.
+    static_cast<ZoomSDKVirtualAudioMicEvent*>(mic)->tap.canceller.store(&audio->echo, std::memory_order_release);
+    return true;
+}
+
+extern "C" bool audio_helper_get_echo_canceller_stats(
+    ZOOMSDK::IZoomSDKAudioRawDataDelegate* delegate,
+    struct audio_echo_canceller_stats *stats) {
+    if (!delegate || !stats) {
+        return false;
+    }
+    static_cast<ZoomSDKAudioRawDataDelegate*>(delegate)->echo_canceller_stats(stats);
+    return true;
 }
 
 extern "C" ZOOMSDK::SDKError send_audio_raw_data(
     ZOOMSDK::IZoomSDKAudioRawDataSender* p_sender,
     char* data,
     unsigned int data_length,
-    int sample_rate) {
-        return p_sender->send(data, data_length, sample_rate);
+    int sample_rate,
+    ZOOMSDK::ZoomSDKAudioChannel channel) {
+        return p_sender->send(data, data_length, sample_rate, channel);
 }
 
 // TODO : Check it is not bullshit documentation
@@ -3,19 +3,652 @@
 
 #include "../../zoom-meeting-sdk-linux/h/rawdata/zoom_rawdata_api.h"
 #include "../../zoom-meeting-sdk-linux/h/rawdata/rawdata_audio_helper_interface.h"
+#include "../../zoom-meeting-sdk-linux/h/meeting_service_components/meeting_audio_interface.h"
+#include "../../zoom-meeting-sdk-linux/h/meeting_service_components/meeting_participants_ctrl_interface.h"
 #include "../../zoom-meeting-sdk-linux/h/zoom_sdk_raw_data_def.h"
 
+/// @brief Sample format of exported_audio_raw_data::data.
+enum audio_sample_format {
+    /// Signed 16-bit PCM, as produced by the SDK.
+    AUDIO_SAMPLE_S16 = 0,
+    /// 32-bit float PCM in [-1, 1].
+    AUDIO_SAMPLE_F32 = 1,
+};
+
 extern "C" struct exported_audio_raw_data {
     char *data;
+    /// Wall clock arrival time in microseconds, derived from the monotonic clock so NTP steps do not show.
     int64_t time;
     unsigned int len;
-    // bool can_add_ref;
+    /// Sample format of `data`, see audio_helper_set_output_format.
+    enum audio_sample_format format;
+    /// Sample rate of `data` in Hz, the SDK rate unless a resampling rate is set.
+    unsigned int sample_rate;
+    /// Interleaved channels in `data`.
+    unsigned int channels;
+    /// SDK buffer backing `data`, NULL when `data` is a copy owned by the wrapper (queued delivery).
+    /// Pass the frame to audio_raw_data_retain to keep `data` valid after the callback returns.
+    AudioRawData *raw;
+    /// SDK media timestamp in milliseconds (AudioRawData::GetTimeStamp), 0 if unavailable.
+    uint64_t sdk_time;
+    /// CLOCK_MONOTONIC arrival time in microseconds.
+    int64_t mono_time;
+    /// Smoothed change of (arrival - media time) since the first frame of this stream, in microseconds.
+    int64_t drift;
+    /// Position of the first sample on the aligned timeline, at `sample_rate`: sample 0 is the first audio
+    /// frame of the meeting. -1 when alignment is off or for share and interpreter audio, see audio_helper_set_alignment.
+    int64_t sample_index;
+};
+
+/// @brief Silent one-way frames folded by the voice activity gate (see audio_helper_set_vad),
+/// or a gap between aligned frames (see audio_helper_set_alignment).
+extern "C" struct audio_silence_marker {
+    /// Arrival time of the first silent frame, same clock as exported_audio_raw_data::time.
+    int64_t start_time;
+    /// SDK media timestamp of the first silent frame in milliseconds, 0 if unavailable.
+    uint64_t sdk_time;
+    /// Audio duration of the folded frames.
+    uint32_t duration_ms;
+    /// Folded frames, 0 for a gap.
+    uint32_t frames;
+    /// Aligned position of the first silent sample, -1 when alignment is off.
+    int64_t sample_index;
+    /// Silent samples per channel, at the rate of the user's frames.
+    uint64_t samples;
+};
+
+/// @brief How the delegate hands frames over to Rust.
+enum audio_delivery_mode {
+    /// Call into Rust synchronously from the SDK callback thread.
+    AUDIO_DELIVERY_DIRECT = 0,
+    /// Copy frames into preallocated lock-free rings, Rust pulls them with audio_helper_drain().
+    AUDIO_DELIVERY_QUEUED = 1,
+};
+
+/// @brief Audio streams produced by the delegate.
+enum audio_stream_kind {
+    AUDIO_STREAM_MIXED = 0,
+    AUDIO_STREAM_ONE_WAY = 1,
+    AUDIO_STREAM_SHARE = 2,
+    /// Interpretation channels, see audio_helper_subscribe_delegate.
+    AUDIO_STREAM_INTERPRETER = 3,
+};
+
+/// @brief Kind of a queued or batched record.
+enum audio_record_kind {
+    /// A frame, the payload is its PCM.
+    AUDIO_RECORD_FRAME = 0,
+    /// The payload is an audio_silence_marker.
+    AUDIO_RECORD_SILENCE = 1,
+};
+
+/// @brief One record of a batch, see audio_helper_set_batch_window.
+extern "C" struct audio_batch_entry {
+    /// Metadata of the frame. `data` points to a copy owned by the batch (`raw` is NULL),
+    /// or to an audio_silence_marker for AUDIO_RECORD_SILENCE.
+    struct exported_audio_raw_data data;
+    /// Sender of one-way and share audio, 0 for mixed and interpreter audio.
+    uint32_t user_id;
+    enum audio_stream_kind stream;
+    enum audio_record_kind kind;
+    /// Language of interpreter audio, see audio_helper_get_interpreter_languages. 0 for the other streams.
+    uint16_t language_id;
+};
+
+/// @brief Ring buffer counters of one stream in AUDIO_DELIVERY_QUEUED mode.
+extern "C" struct audio_queue_stats {
+    uint64_t pushed_frames;
+    uint64_t dropped_frames;
+    uint64_t dropped_bytes;
+    uint64_t drained_frames;
+    uint64_t high_water_bytes;
+    uint64_t capacity_bytes;
+};
+
+/// @brief State of one per-user stream of the one-way audio demultiplexer.
+extern "C" struct audio_user_stream {
+    uint32_t user_id;
+    /// False once the user left, the stream is still listed while it has queued frames.
+    bool active;
+    uint64_t frames;
+    uint64_t samples;
+    /// Arrival time of the last frame, same clock as exported_audio_raw_data::time.
+    int64_t last_seen;
+    uint64_t queued_bytes;
+    uint64_t dropped_frames;
+    /// Frames folded into silence markers by the voice activity gate.
+    uint64_t silent_frames;
+};
+
+/// @brief Rolling audio level of one user, see audio_helper_get_levels.
+extern "C" struct user_level {
+    uint32_t user_id;
+    /// Largest sample magnitude over the window, relative to full scale.
+    float peak;
+    /// RMS over the window, relative to full scale.
+    float rms;
+    /// `peak` in dBFS, -120 for silence.
+    float peak_dbfs;
+    /// `rms` in dBFS, -120 for silence.
+    float rms_dbfs;
+};
+
+/// @brief Interpreter language interned by the delegate.
+extern "C" struct interpreter_language {
+    /// Carried by interpreter frames instead of the name, ids start at 1.
+    uint16_t language_id;
+    /// Name given by the SDK, NUL terminated and truncated to 61 bytes.
+    char name[62];
+};
+
+/// @brief Counters of the virtual mic pacer, see audio_helper_set_mic_pacer.
+extern "C" struct audio_mic_pacer_stats {
+    /// Chunks carrying queued audio, padded with silence on underrun.
+    uint64_t sent_chunks;
+    /// Chunks of pure silence, sent while the queue was empty or refilling.
+    uint64_t silence_chunks;
+    /// Times the queue ran dry during playback.
+    uint64_t underruns;
+    /// Periods the thread woke up too late for, sent back to back or not sent at all.
+    uint64_t late_chunks;
+    /// Chunks rejected by the SDK.
+    uint64_t send_errors;
+    /// Worst delay between a period and the wake up of the thread.
+    int64_t max_lateness_us;
+    uint32_t queued_bytes;
+    bool running;
+    /// Format sent to the SDK.
+    uint32_t sample_rate;
+    uint32_t channels;
+};
+
+/// @brief File format of the recorded tracks.
+enum audio_track_codec {
+    /// PCM as delivered.
+    AUDIO_TRACK_WAV = 0,
+    /// Lossless 16-bit FLAC, encoded by the writer threads.
+    AUDIO_TRACK_FLAC = 1,
+};
+
+/// @brief Counters of the per-user track recorder, see audio_helper_start_recording.
+extern "C" struct audio_recorder_stats {
+    /// Track files opened since the delegate was created.
+    uint64_t files;
+    uint64_t written_frames;
+    uint64_t written_bytes;
+    /// Frames lost to a full track ring, a user without slot or a failed write.
+    uint64_t dropped_frames;
+    uint64_t dropped_bytes;
+    uint64_t syncs;
+    /// Failed opens, writes and truncations.
+    uint64_t write_errors;
+    /// Slowest pwritev call.
+    int64_t max_write_us;
+    /// PCM taken from the track rings, `written_bytes` over it is the compression ratio.
+    uint64_t pcm_bytes;
+    /// Writer thread time spent encoding, summed over the threads.
+    int64_t encode_us;
+    /// Frames waiting in the track rings.
+    uint64_t queued_bytes;
+    uint32_t open_tracks;
+    bool running;
+};
+
+/// @brief Members of a custom mix, see audio_helper_set_mix.
+enum audio_mix_mode {
+    /// The mix is not produced.
+    AUDIO_MIX_OFF = 0,
+    /// Only the listed users.
+    AUDIO_MIX_INCLUDE = 1,
+    /// Everyone but the listed users.
+    AUDIO_MIX_EXCLUDE = 2,
+};
+
+/// @brief Counters of the custom mixer, see audio_helper_set_mixer.
+extern "C" struct audio_mixer_stats {
+    /// 10 ms periods mixed.
+    uint64_t ticks;
+    /// Periods the thread woke up too late for, mixed back to back or not mixed at all.
+    uint64_t late_ticks;
+    /// Mixed frames handed to Rust, one per produced mix and period.
+    uint64_t delivered_frames;
+    /// Times the queue of a playing user ran dry.
+    uint64_t underruns;
+    /// Audio discarded because a user queue was full or lagged too far behind the clock.
+    uint64_t dropped_bytes;
+    /// Worst delay between a period and the wake up of the thread.
+    int64_t max_lateness_us;
+    /// Slowest mixing of one period, callbacks excluded.
+    int64_t max_mix_us;
+    /// Users who contributed to the last period.
+    uint32_t inputs;
+    /// Mixes currently produced.
+    uint32_t mixes;
+    uint32_t sample_rate;
+    bool running;
+};
+
+/// @brief Counters of the chunker, see audio_helper_set_chunker.
+extern "C" struct audio_chunker_stats {
+    /// Windows delivered, padded ones included.
+    uint64_t windows;
+    /// Windows delivered in place, pointing into the frame.
+    uint64_t zero_copy_windows;
+    /// Audio copied into the slab to assemble windows straddling two frames.
+    uint64_t copied_bytes;
+    /// Windows completed with zeros because their stream was interrupted.
+    uint64_t padded_windows;
+    /// Frames delivered as is: stream beyond the slab, or window larger than a slot.
+    uint64_t unchunked_frames;
+    uint32_t window_ms;
+    uint32_t overlap_ms;
+};
+
+/// @brief Share audio frame popped with audio_helper_pop_share_audio.
+/// The receiver owns a reference on `data.raw`, given back with audio_raw_data_release.
+extern "C" struct share_audio_packet {
+    /// `sdk_time` is the SDK timestamp of the frame.
+    struct exported_audio_raw_data data;
+    /// User sharing the audio.
+    uint32_t user_id;
+};
+
+/// @brief Counters of the share audio capture, see audio_helper_set_share_capture.
+extern "C" struct share_capture_stats {
+    /// Frames queued with a reference on the SDK buffer.
+    uint64_t zero_copy_frames;
+    /// Frames queued as a pooled copy: converted by the output format, or reference refused by the SDK.
+    uint64_t copied_frames;
+    /// Frames lost to a full queue or an exhausted pool.
+    uint64_t dropped_frames;
+    uint64_t popped_frames;
+    uint32_t queued;
+    uint32_t capacity;
+    /// Pooled copies still referenced, queued or held by the receiver.
+    uint32_t pooled_in_use;
+    uint32_t pool_size;
+    bool enabled;
+};
+
+/// @brief What a queued stream gives up when its ring backs up, see audio_helper_set_overload_policy.
+/// Each policy applies the gentler ones before it.
+enum audio_overload_policy {
+    /// Queue everything, frames are only lost when the ring is full.
+    AUDIO_OVERLOAD_NEVER_DROP = 0,
+    /// While the ring is over the high-water mark, the drain skips its oldest silent frames.
+    AUDIO_OVERLOAD_DROP_SILENCE = 1,
+    /// Also resample the frames queued over the high-water mark to a lower rate.
+    AUDIO_OVERLOAD_DEGRADE = 2,
+    /// Also stop queueing the users whose ring stays backed up, one-way stream only.
+    AUDIO_OVERLOAD_SHED_USERS = 3,
+};
+
+/// @brief Actions of the overload policy of one stream, see audio_helper_set_overload_policy.
+extern "C" struct audio_overload_stats {
+    /// Silent frames skipped by the drain.
+    uint64_t dropped_silent_frames;
+    /// Frames queued at the degraded rate.
+    uint64_t degraded_frames;
+    /// Times a queue switched to the degraded rate.
+    uint64_t degrade_events;
+    /// Frames of shed users.
+    uint64_t shed_frames;
+    /// Times a user was shed.
+    uint64_t shed_events;
+    /// Frames that would have been shed but were queued, their user having no slot to keep the state in.
+    uint64_t unshed_frames;
+    /// Queues currently at the degraded rate.
+    uint32_t degraded_queues;
+    /// Users currently shed.
+    uint32_t shed_users;
+    enum audio_overload_policy policy;
+    uint32_t high_water_percent;
+    uint32_t degrade_rate;
+};
+
+/// @brief Counters of the echo canceller, see audio_helper_set_echo_canceller.
+extern "C" struct audio_echo_canceller_stats {
+    /// Mixed frames filtered.
+    uint64_t frames;
+    /// Mixed frames left untouched: no delay estimate yet, or not mono 16-bit PCM at the canceller rate.
+    uint64_t bypassed_frames;
+    /// Sent samples kept as reference, at the canceller rate.
+    uint64_t reference_samples;
+    /// Sent samples not kept, sent more than 2 s ahead of real time.
+    uint64_t dropped_reference_samples;
+    /// Trusted delay estimates.
+    uint64_t delay_estimates;
+    /// Filtered frames where someone talked over the bot, the filter does not adapt on them.
+    uint64_t double_talk_frames;
+    /// Longest time spent on a mixed frame.
+    int64_t max_frame_us;
+    /// Estimated loopback delay, -1 until the first estimate.
+    int32_t delay_ms;
+    /// Echo return loss enhancement over the last second of bot speech.
+    float erle_db;
+    bool enabled;
 };
 
 extern "C" ZOOMSDK::IZoomSDKAudioRawDataDelegate* audio_helper_create_delegate(
     void *arc_ptr,
     bool use_separate_channels);
 
+/// @brief Select how frames are delivered to Rust.
+/// @param delegate A delegate created by audio_helper_create_delegate.
+/// @param mode AUDIO_DELIVERY_DIRECT or AUDIO_DELIVERY_QUEUED.
+/// @param ring_capacity Size in bytes of each per-stream ring. Only used the first time queued mode is enabled.
+/// @param user_ring_capacity Size in bytes of each per-user ring of the one-way stream, same rule.
+/// @return false if the delegate is NULL or the rings cannot be allocated.
+extern "C" bool audio_helper_set_delivery_mode(
+    ZOOMSDK::IZoomSDKAudioRawDataDelegate* delegate,
+    enum audio_delivery_mode mode,
+    unsigned int ring_capacity,
+    unsigned int user_ring_capacity);
+
+/// @brief Pop queued frames and dispatch them to the usual Rust callbacks on the calling thread.
+/// Must always be called from the same thread.
+/// @param max_frames Upper bound of frames dispatched by this call, across all streams.
+/// @return The number of dispatched frames.
+extern "C" unsigned int audio_helper_drain(
+    ZOOMSDK::IZoomSDKAudioRawDataDelegate* delegate,
+    unsigned int max_frames);
+
+/// @brief Convert frames before they are delivered, with SIMD kernels on the SDK thread.
+/// Converted frames are owned by the wrapper, their `raw` field is NULL.
+/// @param format AUDIO_SAMPLE_F32 to receive floats instead of 16-bit PCM.
+/// @param downmix_mono Average the channels of stereo frames.
+/// @param gain Linear gain, 16-bit output saturates and float output is clipped to [-1, 1].
+/// @param sample_rate Resample every stream to this rate with a polyphase filter, 0 keeps the SDK rate.
+/// Filter state is kept per stream, and per user for one-way audio.
+/// @return false if the delegate is NULL.
+extern "C" bool audio_helper_set_output_format(
+    ZOOMSDK::IZoomSDKAudioRawDataDelegate* delegate,
+    enum audio_sample_format format,
+    bool downmix_mono,
+    float gain,
+    unsigned int sample_rate);
+
+/// @brief Gate silent one-way frames before they reach Rust.
+/// Each user has an energy / zero-crossing detector. Frames that are not forwarded are summed
+/// into audio_silence_marker records, delivered in order with the frames of the user.
+/// @param enabled false forwards every frame.
+/// @param threshold_dbfs RMS level from which a frame is voice, e.g. -50.
+/// @param hangover_ms Keep forwarding this long after the last voiced frame.
+/// @param max_silence_ms Emit a marker at least this often while a user stays silent.
+/// @return false if the delegate is NULL.
+extern "C" bool audio_helper_set_vad(
+    ZOOMSDK::IZoomSDKAudioRawDataDelegate* delegate,
+    bool enabled,
+    float threshold_dbfs,
+    unsigned int hangover_ms,
+    unsigned int max_silence_ms);
+
+/// @brief Get the ring buffer counters of a stream.
+/// @return false if the delegate is NULL or queued mode was never enabled.
+extern "C" bool audio_helper_get_queue_stats(
+    ZOOMSDK::IZoomSDKAudioRawDataDelegate* delegate,
+    enum audio_stream_kind stream,
+    struct audio_queue_stats *stats);
+
+/// @brief Create the per-user stream slots of users who joined the meeting.
+/// Called automatically for a delegate attached with audio_helper_attach_participants.
+extern "C" void audio_helper_user_join(
+    ZOOMSDK::IZoomSDKAudioRawDataDelegate* delegate,
+    const unsigned int *user_ids,
+    unsigned int count);
+
+/// @brief Keep the per-user stream slots of the delegate in sync with the participants of the meeting.
+/// Creates the slots of the users already in the meeting, then routes the joins and leaves to the delegate.
+/// Without it a slot is created by the first frame of its user and reclaimed once idle and needed.
+/// @return SDKERR_INVALID_PARAMETER if the delegate or the controller is NULL.
+extern "C" ZOOMSDK::SDKError audio_helper_attach_participants(
+    ZOOMSDK::IZoomSDKAudioRawDataDelegate* delegate,
+    ZOOMSDK::IMeetingParticipantsController *controller);
+
+/// @brief Stop routing the participant events to the delegate, see audio_helper_attach_participants.
+extern "C" void audio_helper_detach_participants(ZOOMSDK::IZoomSDKAudioRawDataDelegate* delegate);
+
+/// @brief Retire the per-user stream slots of users who left the meeting.
+extern "C" void audio_helper_user_left(
+    ZOOMSDK::IZoomSDKAudioRawDataDelegate* delegate,
+    const unsigned int *user_ids,
+    unsigned int count);
+
+/// @brief Copy the state of the per-user streams into `streams`.
+/// @return The number of written entries, at most `cap`.
+extern "C" unsigned int audio_helper_get_user_streams(
+    ZOOMSDK::IZoomSDKAudioRawDataDelegate* delegate,
+    struct audio_user_stream *streams,
+    unsigned int cap);
+
+/// @brief Take a reference on the SDK buffer of a frame, so `data` stays valid after the callback returns.
+/// @return The buffer to give back with audio_raw_data_release, NULL if the frame has no SDK buffer
+/// or the SDK does not allow more references.
+extern "C" AudioRawData* audio_raw_data_retain(const struct exported_audio_raw_data *data);
+
+/// @brief Drop a reference taken by audio_raw_data_retain. The SDK frees the buffer with its last reference.
+extern "C" void audio_raw_data_release(AudioRawData *raw);
+
+/// @brief Meter the one-way audio of every user over a rolling window.
+/// @param window_ms Length of the window, 0 disables metering.
+/// @return false if the delegate is NULL.
+extern "C" bool audio_helper_set_level_window(
+    ZOOMSDK::IZoomSDKAudioRawDataDelegate* delegate,
+    unsigned int window_ms);
+
+/// @brief Copy the levels of the users in the meeting into `levels`, in one call.
+/// Users who sent no audio during the window read as silence.
+/// @return The number of written entries, at most `cap`. 0 if metering is disabled.
+extern "C" unsigned int audio_helper_get_levels(
+    ZOOMSDK::IZoomSDKAudioRawDataDelegate* delegate,
+    struct user_level *levels,
+    unsigned int cap);
+
+/// @brief Accumulate directly delivered frames and hand them to Rust in one call per window.
+/// Each stream is batched on its own SDK thread, the records keep their order within a stream.
+/// A batch is delivered with the first frame arriving once the window elapsed. The batch of a stream
+/// that went quiet is delivered by the next frame of another stream, or by audio_helper_flush_stale_batches,
+/// 20 ms past the window. Queued delivery is not batched.
+/// @param window_ms Age of the oldest record of a batch before it is delivered, 0 delivers every frame on its own.
+/// @return false if the delegate is NULL.
+extern "C" bool audio_helper_set_batch_window(
+    ZOOMSDK::IZoomSDKAudioRawDataDelegate* delegate,
+    unsigned int window_ms);
+
+/// @brief Deliver the pending batches. Call it once the delegate is unsubscribed, the SDK threads own them before.
+extern "C" void audio_helper_flush_batches(ZOOMSDK::IZoomSDKAudioRawDataDelegate* delegate);
+
+/// @brief Deliver the batches held 20 ms past the window by streams that went quiet. Safe from any thread,
+/// e.g. a timer for meetings where every stream can stop.
+extern "C" void audio_helper_flush_stale_batches(ZOOMSDK::IZoomSDKAudioRawDataDelegate* delegate);
+
+/// @brief Record the one-way audio of every user to `<directory>/<user_id>-<time>.wav` (or `.flac`), `time` being the
+/// arrival time of the first frame. Frames are recorded as delivered, after conversion and voice gating.
+/// The SDK thread only copies frames into per-user rings, writer threads do the encoding and the I/O.
+/// @param threads Writer threads, each one owns a share of the users.
+/// @param ring_capacity Size in bytes of each per-user ring, 0 for the default. Only used the first time recording starts.
+/// @param flush_ms Period of the batched writes.
+/// @param sync_ms Period of the fdatasync calls of each file, the file header is updated before each one.
+/// @param preallocate_kb Grow the files by extents of this size with fallocate, 0 to disable.
+/// @param codec AUDIO_TRACK_FLAC stores 16-bit FLAC instead of the delivered PCM, float frames are rounded to 16 bits.
+/// FLAC frames carry the number of their first sample, and gaps of aligned tracks are encoded as silence.
+/// @return false if the delegate is NULL, recording is already started or the directory is not writable.
+extern "C" bool audio_helper_start_recording(
+    ZOOMSDK::IZoomSDKAudioRawDataDelegate* delegate,
+    const char *directory,
+    unsigned int threads,
+    unsigned int ring_capacity,
+    unsigned int flush_ms,
+    unsigned int sync_ms,
+    unsigned int preallocate_kb,
+    enum audio_track_codec codec);
+
+/// @brief Write the queued frames, close the files and stop the writer threads. Blocks until done.
+extern "C" void audio_helper_stop_recording(ZOOMSDK::IZoomSDKAudioRawDataDelegate* delegate);
+
+/// @return false if the delegate is NULL.
+extern "C" bool audio_helper_get_recorder_stats(
+    ZOOMSDK::IZoomSDKAudioRawDataDelegate* delegate,
+    struct audio_recorder_stats *stats);
+
+/// @brief Number of interpreter languages seen so far, also the highest language id.
+/// The table only grows, so it only needs to be read again when this number changes.
+extern "C" unsigned int audio_helper_get_interpreter_language_count(ZOOMSDK::IZoomSDKAudioRawDataDelegate* delegate);
+
+/// @brief Copy the interpreter language table into `languages`, ordered by id.
+/// @return The number of written entries, at most `cap`.
+extern "C" unsigned int audio_helper_get_interpreter_languages(
+    ZOOMSDK::IZoomSDKAudioRawDataDelegate* delegate,
+    struct interpreter_language *languages,
+    unsigned int cap);
+
+/// @brief Place mixed and one-way frames on a timeline shared by all users, see exported_audio_raw_data::sample_index.
+/// Sample 0 is the first frame received after alignment is enabled, positions follow the SDK timestamps.
+/// Every user's track is made continuous from sample 0: the time between frames of a user, including the lead-in
+/// before the first one, is delivered as silence markers, and the recorder leaves it as silence in the files.
+/// @param enabled false stops aligning, enabling again starts a new timeline.
+/// @param tolerance_ms Timestamp jitter absorbed before a frame is moved, larger differences open a gap
+/// or trim the frame head.
+/// @return false if the delegate is NULL.
+extern "C" bool audio_helper_set_alignment(
+    ZOOMSDK::IZoomSDKAudioRawDataDelegate* delegate,
+    bool enabled,
+    unsigned int tolerance_ms);
+
+/// @brief Wall clock time of sample 0, in microseconds.
+/// @return false if the delegate is NULL, alignment is off or no frame arrived yet.
+extern "C" bool audio_helper_get_alignment_origin(
+    ZOOMSDK::IZoomSDKAudioRawDataDelegate* delegate,
+    int64_t *time);
+
+/// @brief Mix the one-way audio of chosen users into custom mono streams on a fixed 10 ms clock.
+/// The SDK thread only converts each user's frames to the mix rate and queues them, a dedicated thread
+/// sums one period of every playing user per mix with saturating SIMD adds and hands the mixes to Rust.
+/// Requires a delegate created with separate channels.
+/// @param sample_rate Rate of the mixes, from 8000 to 48000 and a multiple of 100. 0 stops the mixer.
+/// @param jitter_ms Audio queued per user before it joins the mixes, absorbs the delivery jitter of the SDK.
+/// The thread is restarted and the queues emptied. Do not call it from a mix callback, it joins the thread.
+/// @return false if the delegate is NULL or the settings are invalid.
+extern "C" bool audio_helper_set_mixer(
+    ZOOMSDK::IZoomSDKAudioRawDataDelegate* delegate,
+    unsigned int sample_rate,
+    unsigned int jitter_ms);
+
+/// @brief Define, replace or remove (AUDIO_MIX_OFF) a custom mix, from the next period.
+/// Mixes are kept when the mixer is stopped.
+/// @param mix_id From 0 to 15, passed back with each mixed frame.
+/// @param user_ids Users included or excluded according to `mode`.
+/// @return false if the delegate is NULL or `mix_id` is out of range.
+extern "C" bool audio_helper_set_mix(
+    ZOOMSDK::IZoomSDKAudioRawDataDelegate* delegate,
+    unsigned int mix_id,
+    enum audio_mix_mode mode,
+    const uint32_t *user_ids,
+    unsigned int count);
+
+/// @return false if the delegate is NULL.
+extern "C" bool audio_helper_get_mixer_stats(
+    ZOOMSDK::IZoomSDKAudioRawDataDelegate* delegate,
+    struct audio_mixer_stats *stats);
+
+/// @brief Re-frame the mixed and one-way streams into fixed windows of `window_ms`, each one starting
+/// `window_ms - overlap_ms` after the previous one, delivered through the usual callbacks, batches and queues.
+/// Windows are cut after the output format is applied, so they hold `window_ms * rate / 1000` samples per channel.
+/// A window lying inside one frame points into that frame, without copy. Windows straddling two frames
+/// are assembled in `slab`: the mixed stream uses slot 0, the user of slot `i` slot `i + 1`, streams
+/// beyond `slots` are delivered unchunked. A window interrupted by a silence marker, a gap on the
+/// timeline or a format change is completed with zeros. `time` and `sample_index` are those of the first
+/// sample of a window, the other fields come from the frame holding it. Recording and mixing see the frames.
+/// @param window_ms 0 disables the chunker.
+/// @param slab `slot_bytes * slots` bytes owned by the caller, kept alive until the delegate is unsubscribed
+/// even after another call replaced it: a frame being chunked may still write to it.
+/// @return false if the delegate is NULL or `overlap_ms` is not shorter than `window_ms`.
+extern "C" bool audio_helper_set_chunker(
+    ZOOMSDK::IZoomSDKAudioRawDataDelegate* delegate,
+    unsigned int window_ms,
+    unsigned int overlap_ms,
+    char *slab,
+    size_t slot_bytes,
+    unsigned int slots);
+
+/// @return false if the delegate is NULL.
+extern "C" bool audio_helper_get_chunker_stats(
+    ZOOMSDK::IZoomSDKAudioRawDataDelegate* delegate,
+    struct audio_chunker_stats *stats);
+
+/// @brief Capture share audio into a bounded lock-free queue of refcounted frames, tagged with the sharing user,
+/// instead of delivering it to on_share_audio_raw_data. A frame is queued by reference on its SDK buffer when
+/// the SDK allows it, as a copy in a pooled buffer otherwise; with the queue full or the pool exhausted it is
+/// dropped and counted. The share thread never blocks and never writes to stdio.
+/// @param capacity Packets the queue holds, 0 for the default. Only used the first time capture starts.
+/// @param pool_size Pooled copies, bounding the copies queued or held by the receiver at once. Only used the first time.
+/// Packets still queued when capture stops can be popped afterwards.
+/// @return false if the delegate is NULL.
+extern "C" bool audio_helper_set_share_capture(
+    ZOOMSDK::IZoomSDKAudioRawDataDelegate* delegate,
+    bool enabled,
+    unsigned int capacity,
+    unsigned int pool_size);
+
+/// @brief Pop at most `cap` captured share frames, oldest first. A single thread pops.
+/// @return The number of packets written to `packets`, each one to release with audio_raw_data_release.
+extern "C" unsigned int audio_helper_pop_share_audio(
+    ZOOMSDK::IZoomSDKAudioRawDataDelegate* delegate,
+    struct share_audio_packet *packets,
+    unsigned int cap);
+
+/// @return false if the delegate is NULL.
+extern "C" bool audio_helper_get_share_capture_stats(
+    ZOOMSDK::IZoomSDKAudioRawDataDelegate* delegate,
+    struct share_capture_stats *stats);
+
+/// @brief Select what a stream gives up when the Rust side falls behind in AUDIO_DELIVERY_QUEUED mode,
+/// instead of losing whatever arrives once its ring is full. A queue is over the high-water mark when
+/// that share of its ring is waiting to be drained; it goes back to normal under half the mark. Users
+/// are shed halfway between the mark and a full ring. Silence is judged with the threshold of
+/// audio_helper_set_vad, dropped one-way silence is handed over as silence markers. Aligned frames
+/// are never resampled, their sample_index counts samples of the output rate.
+/// @param stream One of audio_stream_kind. Every stream starts with AUDIO_OVERLOAD_NEVER_DROP.
+/// @param high_water_percent From 1 to 99, 0 for 50.
+/// @param degrade_rate Rate of degraded frames, a multiple of 100 from 8000 to 48000, 0 for 16000.
+/// @return false if the delegate is NULL or the settings are invalid.
+extern "C" bool audio_helper_set_overload_policy(
+    ZOOMSDK::IZoomSDKAudioRawDataDelegate* delegate,
+    enum audio_stream_kind stream,
+    enum audio_overload_policy policy,
+    unsigned int high_water_percent,
+    unsigned int degrade_rate);
+
+/// @return false if the delegate is NULL or the stream unknown.
+extern "C" bool audio_helper_get_overload_stats(
+    ZOOMSDK::IZoomSDKAudioRawDataDelegate* delegate,
+    enum audio_stream_kind stream,
+    struct audio_overload_stats *stats);
+
+/// @brief Remove the audio sent through the virtual mic from the mixed stream, so downstream speech recognition does
+/// not transcribe the bot. Everything the mic sends, directly or through the pacer, is kept as a reference; the
+/// loopback delay is estimated by FFT cross-correlation every half second and an adaptive filter centered on it
+/// subtracts the echo before any other processing of the mixed frames. The estimate is spread over several
+/// frames, each mixed frame costs at most one 16k-point FFT on top of the filter.
+/// @param mic Mic event whose sent audio is the reference, see audio_helper_create_mic_event.
+/// @param sample_rate Rate of the mixed frames processed, others pass through. 0 for 32000, the SDK rate.
+/// @param max_delay_ms Longest loopback delay searched, up to 2000, 0 for 1000.
+/// @param taps Length of the adaptive filter in samples, from 32 to 1024, 0 for 256.
+/// The sizes are only used the first time the canceller is enabled.
+/// @return false if the delegate or the mic is NULL, or the settings are invalid.
+extern "C" bool audio_helper_set_echo_canceller(
+    ZOOMSDK::IZoomSDKAudioRawDataDelegate* delegate,
+    ZOOMSDK::IZoomSDKVirtualAudioMicEvent* mic,
+    bool enabled,
+    unsigned int sample_rate,
+    unsigned int max_delay_ms,
+    unsigned int taps);
+
+/// @return false if the delegate is NULL.
+extern "C" bool audio_helper_get_echo_canceller_stats(
+    ZOOMSDK::IZoomSDKAudioRawDataDelegate* delegate,
+    struct audio_echo_canceller_stats *stats);
+
 /// \brief Subscribe raw audio data.
 /// \param pDelegate, the callback handler of raw audio data.
 /// \param bWithInterpreters, if bWithInterpreters is true, it means that you want to get the raw audio data of interpreters, otherwise not. 
@@ -24,29 +657,76 @@ extern "C" ZOOMSDK::IZoomSDKAudioRawDataDelegate* audio_helper_create_delegate(
 ///Otherwise fails. To get extended error information, see \link SDKError \endlink enum.
 extern "C" ZOOMSDK::SDKError audio_helper_subscribe_delegate(
     ZOOMSDK::IZoomSDKAudioRawDataHelper* ctx,
-    ZOOMSDK::IZoomSDKAudioRawDataDelegate* pDelegate);
+    ZOOMSDK::IZoomSDKAudioRawDataDelegate* pDelegate,
+    bool bWithInterpreters);
 
 extern "C" ZOOMSDK::SDKError audio_helper_unsubscribe_delegate(ZOOMSDK::IZoomSDKAudioRawDataHelper* ctx);
 
+extern "C" ZOOMSDK::IZoomSDKVirtualAudioMicEvent* audio_helper_create_mic_event(void *arc_ptr);
+
 /// \brief Subscribe audio mic raw data with a callback.
-/// \param pSource, Callback sink object.
+/// \param mic, Callback sink object created by audio_helper_create_mic_event.
 /// \return If the function succeeds, the return value is SDKERR_SUCCESS.
 ///Otherwise failed. To get extended error information, see \link SDKError \endlink enum.
 extern "C" ZOOMSDK::SDKError audio_helper_set_external_audio_source(
     ZOOMSDK::IZoomSDKAudioRawDataHelper* ctx,
-    void *arc_ptr);
+    ZOOMSDK::IZoomSDKVirtualAudioMicEvent* mic);
+
+/// @brief Let the wrapper send the virtual mic audio in real time.
+/// While the SDK allows sending, a dedicated thread sends one `chunk_ms` chunk per period from the
+/// queue filled by audio_helper_mic_push, and silence when there is nothing to play.
+/// @param sample_rate Rate sent to the SDK, rounded up to the nearest supported rate (48000 at most). 0 disables the pacer.
+/// @param channels Sent layout, 1 (mono) or 2 (stereo).
+/// @param chunk_ms 10 or 20.
+/// @param prefill_ms Audio queued before playback starts or resumes after an underrun.
+/// @param queue_ms Size of the queue. Only used the first time the pacer is enabled.
+/// @return false if the mic is NULL or the settings are invalid.
+extern "C" bool audio_helper_set_mic_pacer(
+    ZOOMSDK::IZoomSDKVirtualAudioMicEvent* mic,
+    unsigned int sample_rate,
+    unsigned int channels,
+    unsigned int chunk_ms,
+    unsigned int prefill_ms,
+    unsigned int queue_ms);
+
+/// @brief Queue 16-bit PCM in the sent format for the pacer, without blocking.
+/// Must always be called from the same thread, shared with audio_helper_mic_push_pcm.
+/// @return The number of bytes queued, less than `len` when the queue is full.
+extern "C" unsigned int audio_helper_mic_push(
+    ZOOMSDK::IZoomSDKVirtualAudioMicEvent* mic,
+    const char *data,
+    unsigned int len);
+
+/// @brief Queue interleaved PCM of any rate, channel count and format for the pacer, without blocking.
+/// The audio is converted to the sent format with the SIMD kernels and a polyphase resampler kept across calls.
+/// @return The number of input frames consumed, less than `frames` when the queue is full.
+extern "C" unsigned int audio_helper_mic_push_pcm(
+    ZOOMSDK::IZoomSDKVirtualAudioMicEvent* mic,
+    const char *data,
+    unsigned int frames,
+    enum audio_sample_format format,
+    unsigned int sample_rate,
+    unsigned int channels);
+
+/// @return false if the mic is NULL.
+extern "C" bool audio_helper_get_mic_pacer_stats(
+    ZOOMSDK::IZoomSDKVirtualAudioMicEvent* mic,
+    struct audio_mic_pacer_stats *stats);
 
 /// \brief Send audio raw data. Audio sample must be 16-bit audio.
 /// \param data the audio datas address.
 /// \param data_length the audio datas length. Must be an even number.
 /// \param sample_rate the audio datas sampling rate.
 /// When the channel is mono, supported sample rates: 8000/11025/16000/32000/44100/48000/50000/50400/96000/192000/2822400
+/// When the channel is stereo, supported sample rates: 8000/16000/32000/44100/48000/50000/50400/96000/192000
+/// \param channel the layout of interleaved `data`.
 /// \return If the function succeeds, the return value is SDKERR_SUCCESS.
 // /Otherwise the function fails and returns an error code. To get extended error information, see \link SDKError \endlink enum.
 extern "C" ZOOMSDK::SDKError send_audio_raw_data(
     ZOOMSDK::IZoomSDKAudioRawDataSender* p_sender,
     char* data,
     unsigned int data_length,
-    int sample_rate);
+    int sample_rate,
+    ZOOMSDK::ZoomSDKAudioChannel channel);
 
 #endif
\ No newline at end of file
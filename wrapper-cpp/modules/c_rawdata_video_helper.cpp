@@ -1,7 +1,13 @@
 #include "c_rawdata_video_helper.h"
+#include "c_media_timeline.h"
+#include "c_video_frame_pool.h"
+#include "c_video_convert.h"
+#include "c_video_frame_rate.h"
+#include "c_video_thumbnailer.h"
 
-#include <chrono>
 #include <stdio.h>
+#include <string.h>
+#include <vector>
 
 extern "C" void on_raw_data_frame_received(void *ptr, struct exported_video_raw_data *data);
 
@@ -9,51 +15,305 @@ extern "C" void on_raw_data_status_changed(void *ptr, bool status, int64_t time)
 
 extern "C" void on_renderer_be_destroyed(void *ptr, int64_t time);
 
+extern "C" void on_video_thumbnail(void *ptr, struct exported_video_raw_data *data);
+
+/// Frames a renderer can retain at once unless told otherwise.
+constexpr unsigned int DEFAULT_VIDEO_MAX_FRAME_REFS = 8;
+
+/// Point the buffers of `exported` at the ones of `data`.
+static void export_buffers(YUVRawDataI420* data, struct exported_video_raw_data *exported) {
+    exported->data = data->GetBuffer();
+    exported->y = data->GetYBuffer();
+    exported->u = data->GetUBuffer();
+    exported->v = data->GetVBuffer();
+    exported->alpha = data->GetAlphaBuffer();
+    exported->alpha_len = exported->alpha ? data->GetAlphaBufferLen() : 0;
+    exported->raw = data;
+}
+
 class ZoomSDKRendererDelegate : public ZOOMSDK::IZoomSDKRendererDelegate {
 public:
     // ZoomSDKRendererDelegate(void *ptr, uint32_t m_user_id) {
     ZoomSDKRendererDelegate(void *ptr) {
         ptr_to_rust = ptr;
         // user_id = m_user_id;
+        pool.set_max_refs(DEFAULT_VIDEO_MAX_FRAME_REFS);
     }
     void onRawDataFrameReceived(YUVRawDataI420* data) override {
-        using namespace std::chrono;
-        int64_t timestamp = duration_cast<microseconds>(system_clock::now().time_since_epoch()).count();
+        int64_t mono_time = monotonic_us();
+        uint64_t sdk_time = data->GetTimeStamp();
 
         struct exported_video_raw_data exported_data = {
-            data: data->GetBuffer(),
-            time: timestamp,
+            data: nullptr,
+            time: timeline_wall_us(mono_time),
             len: data->GetBufferLen(),
             user_id: data->GetSourceID(),
             width: data->GetStreamWidth(),
             height: data->GetStreamHeight(),
+            sdk_time: sdk_time,
+            mono_time: mono_time,
+            drift: clock.update(sdk_time, mono_time),
+            y: nullptr,
+            u: nullptr,
+            v: nullptr,
+            alpha: nullptr,
+            alpha_len: 0,
+            rotation: data->GetRotation(),
+            limited: data->IsLimitedI420(),
+            raw: nullptr,
+            pool: &pool,
         };
-        on_raw_data_frame_received(ptr_to_rust, &exported_data);
+        export_buffers(data, &exported_data);
+        // The media clock paces the decimation without the delivery jitter.
+        int64_t frame_time = sdk_time ? static_cast<int64_t>(sdk_time) * 1000 : mono_time;
+        if (thumbnails.forward_frame() && frame_rate.forward(frame_time)) {
+            on_raw_data_frame_received(ptr_to_rust, &exported_data);
+        }
+
+        PooledVideoRawData *thumbnail = thumbnails.process(data, mono_time, pool);
+        if (thumbnail) {
+            struct exported_video_raw_data exported_thumbnail = exported_data;
+            exported_thumbnail.len = thumbnail->GetBufferLen();
+            exported_thumbnail.width = thumbnail->GetStreamWidth();
+            exported_thumbnail.height = thumbnail->GetStreamHeight();
+            export_buffers(thumbnail, &exported_thumbnail);
+            on_video_thumbnail(ptr_to_rust, &exported_thumbnail);
+            // Retained thumbnails hold their own reference.
+            thumbnail->Release();
+        }
     }
     void onRawDataStatusChanged(RawDataStatus status) override {
-        using namespace std::chrono;
-        int64_t timestamp = duration_cast<microseconds>(system_clock::now().time_since_epoch()).count();
+        int64_t timestamp = timeline_wall_us(monotonic_us());
 
+        if (status == RawData_On) {
+            // A new subscription may come from another source with its own media clock.
+            clock.reset();
+            frame_rate.reset();
+        }
         on_raw_data_status_changed(ptr_to_rust, status == RawData_On ? true : false, timestamp);
     }
     void onRendererBeDestroyed() override {
-        using namespace std::chrono;
-        int64_t timestamp = duration_cast<microseconds>(system_clock::now().time_since_epoch()).count();
+        int64_t timestamp = timeline_wall_us(monotonic_us());
 
         on_renderer_be_destroyed(ptr_to_rust, timestamp);
     }
+    /// Outlives the renderer with the delegate, retained frames can be released after it is gone.
+    VideoFramePool pool;
+    VideoThumbnailer thumbnails;
+    VideoFrameRate frame_rate;
 private:
     void *ptr_to_rust;
+    StreamClock clock;
     // uint32_t user_id;
 };
 
 // SDK_API SDKError createRenderer(IZoomSDKRenderer** ppRenderer, IZoomSDKRendererDelegate* pDelegate);
 
-extern "C" ZOOMSDK::IZoomSDKRendererDelegate* video_helper_create_delegate(void *arc_ptr) {
+extern "C" ZOOMSDK::IZoomSDKRendererDelegate* video_helper_create_delegate(void *arc_ptr, unsigned int target_fps) {
+    if (target_fps > VIDEO_TARGET_FPS_LIMIT) {
+        return nullptr;
+    }
     auto* obj = new ZoomSDKRendererDelegate(arc_ptr); // TODO : Fix memory leak
+    obj->frame_rate.set_target_fps(target_fps);
     return obj;
 }
 
+extern "C" bool video_raw_data_retain(
+    const struct exported_video_raw_data *data,
+    struct exported_video_raw_data *retained) {
+    if (!data || !data->raw || !data->pool || !retained) {
+        return false;
+    }
+    YUVRawDataI420 *raw = data->pool->retain(data->raw);
+    if (!raw) {
+        return false;
+    }
+    *retained = *data;
+    // A pooled copy has its own buffers.
+    export_buffers(raw, retained);
+    return true;
+}
+
+extern "C" void video_raw_data_release(VideoFramePool *pool, YUVRawDataI420 *raw) {
+    if (pool && raw) {
+        pool->release(raw);
+    }
+}
+
+extern "C" size_t video_raw_data_converted_len(
+    const struct exported_video_raw_data *data,
+    enum video_pixel_format format) {
+    if (!data) {
+        return 0;
+    }
+    size_t luma = static_cast<size_t>(data->width) * data->height;
+    size_t chroma = static_cast<size_t>((data->width + 1) / 2) * ((data->height + 1) / 2);
+    switch (format) {
+    case VIDEO_PIXEL_I420:
+    case VIDEO_PIXEL_NV12:
+        return luma + 2 * chroma;
+    default:
+        return luma * yuv_pixel_size(format);
+    }
+}
+
+/// Packed I420 planes over `buffer`.
+static struct i420_image packed_i420(uint8_t *buffer, unsigned int width, unsigned int height) {
+    size_t luma = static_cast<size_t>(width) * height;
+    size_t chroma = static_cast<size_t>((width + 1) / 2) * ((height + 1) / 2);
+    return {
+        y: buffer,
+        u: buffer + luma,
+        v: buffer + luma + chroma,
+        y_stride: width,
+        uv_stride: (width + 1) / 2,
+        width: width,
+        height: height,
+    };
+}
+
+extern "C" bool video_raw_data_convert(
+    const struct exported_video_raw_data *data,
+    enum video_pixel_format format,
+    unsigned int rotation,
+    bool full_range,
+    uint8_t *out,
+    size_t out_len) {
+    if (!data || !data->y || !data->u || !data->v || !out) {
+        return false;
+    }
+    if (format > VIDEO_PIXEL_RGB24 || rotation % 90 != 0 || rotation >= 360) {
+        return false;
+    }
+    if (out_len < video_raw_data_converted_len(data, format)) {
+        return false;
+    }
+    struct i420_image in = {
+        y: reinterpret_cast<uint8_t*>(data->y),
+        u: reinterpret_cast<uint8_t*>(data->u),
+        v: reinterpret_cast<uint8_t*>(data->v),
+        y_stride: data->width,
+        uv_stride: (data->width + 1) / 2,
+        width: data->width,
+        height: data->height,
+    };
+    const uint8_t *alpha = data->alpha && data->alpha_len >= static_cast<size_t>(data->width) * data->height
+        ? reinterpret_cast<const uint8_t*>(data->alpha) : nullptr;
+    bool swap = rotation == 90 || rotation == 270;
+    unsigned int width = swap ? data->height : data->width;
+    unsigned int height = swap ? data->width : data->height;
+    bool expand = full_range && data->limited;
+
+    if (format == VIDEO_PIXEL_I420) {
+        struct i420_image image = packed_i420(out, width, height);
+        if (rotation) {
+            yuv_i420_rotate(in, rotation, image);
+            in = image;
+        }
+        if (expand) {
+            yuv_expand_range(in.y, in.y_stride, image.y, image.y_stride, width, height, false);
+            yuv_expand_range(in.u, in.uv_stride, image.u, image.uv_stride, (width + 1) / 2, (height + 1) / 2, true);
+            yuv_expand_range(in.v, in.uv_stride, image.v, image.uv_stride, (width + 1) / 2, (height + 1) / 2, true);
+        } else if (!rotation) {
+            yuv_i420_rotate(in, 0, image);
+        }
+        return true;
+    }
+
+    if (rotation) {
+        // Other layouts are converted from an upright copy, kept per thread so steady conversion does not allocate.
+        thread_local std::vector<uint8_t> scratch;
+        size_t frame = video_raw_data_converted_len(data, VIDEO_PIXEL_I420);
+        size_t alpha_len = alpha ? static_cast<size_t>(width) * height : 0;
+        if (scratch.size() < frame + alpha_len) {
+            scratch.resize(frame + alpha_len);
+        }
+        struct i420_image image = packed_i420(scratch.data(), width, height);
+        yuv_i420_rotate(in, rotation, image);
+        if (alpha) {
+            yuv_rotate_plane(alpha, data->width, data->width, data->height, rotation, scratch.data() + frame, width);
+            alpha = scratch.data() + frame;
+        }
+        in = image;
+    }
+    if (format == VIDEO_PIXEL_NV12) {
+        size_t luma = static_cast<size_t>(width) * height;
+        unsigned int chroma_width = (width + 1) / 2;
+        yuv_i420_to_nv12(in, out, width, out + luma, 2 * chroma_width);
+        if (expand) {
+            yuv_expand_range(out, width, out, width, width, height, false);
+            yuv_expand_range(out + luma, 2 * chroma_width, out + luma, 2 * chroma_width, 2 * chroma_width, (height + 1) / 2, true);
+        }
+        return true;
+    }
+    // RGB is full range, the matrix takes care of limited input.
+    yuv_i420_to_rgb(in, alpha, width, data->limited, format, out, static_cast<size_t>(width) * yuv_pixel_size(format));
+    return true;
+}
+
+extern "C" bool video_helper_set_thumbnail(
+    ZOOMSDK::IZoomSDKRendererDelegate* delegate,
+    bool enabled,
+    unsigned int width,
+    unsigned int height,
+    unsigned int interval_ms,
+    enum video_scale_filter filter,
+    bool forward_frames) {
+    if (!delegate) {
+        return false;
+    }
+    return static_cast<ZoomSDKRendererDelegate*>(delegate)->thumbnails.configure(
+        enabled, width, height, interval_ms, filter, forward_frames);
+}
+
+extern "C" bool video_helper_get_thumbnail_stats(
+    ZOOMSDK::IZoomSDKRendererDelegate* delegate,
+    struct video_thumbnail_stats *stats) {
+    if (!delegate || !stats) {
+        return false;
+    }
+    static_cast<ZoomSDKRendererDelegate*>(delegate)->thumbnails.stats(stats);
+    return true;
+}
+
+extern "C" bool video_helper_set_target_fps(
+    ZOOMSDK::IZoomSDKRendererDelegate* delegate,
+    unsigned int target_fps) {
+    if (!delegate) {
+        return false;
+    }
+    return static_cast<ZoomSDKRendererDelegate*>(delegate)->frame_rate.set_target_fps(target_fps);
+}
+
+extern "C" bool video_helper_get_frame_rate_stats(
+    ZOOMSDK::IZoomSDKRendererDelegate* delegate,
+    struct video_frame_rate_stats *stats) {
+    if (!delegate || !stats) {
+        return false;
+    }
+    static_cast<ZoomSDKRendererDelegate*>(delegate)->frame_rate.stats(stats);
+    return true;
+}
+
+extern "C" bool video_helper_set_max_frame_refs(
+    ZOOMSDK::IZoomSDKRendererDelegate* delegate,
+    unsigned int max_refs) {
+    if (!delegate) {
+        return false;
+    }
+    return static_cast<ZoomSDKRendererDelegate*>(delegate)->pool.set_max_refs(max_refs ? max_refs : DEFAULT_VIDEO_MAX_FRAME_REFS);
+}
+
+extern "C" bool video_helper_get_frame_ref_stats(
+    ZOOMSDK::IZoomSDKRendererDelegate* delegate,
+    struct video_frame_ref_stats *stats) {
+    if (!delegate || !stats) {
+        return false;
+    }
+    static_cast<ZoomSDKRendererDelegate*>(delegate)->pool.stats(stats);
+    return true;
+}
+
 extern "C" ZOOMSDK::SDKError video_helper_subscribe_delegate(
     ZOOMSDK::IZoomSDKRenderer* ctx,
     uint32_t user_id,
@@ -5,18 +5,189 @@
 #include "../../zoom-meeting-sdk-linux/h/rawdata/rawdata_renderer_interface.h"
 #include "../../zoom-meeting-sdk-linux/h/zoom_sdk_raw_data_def.h"
 
+#include <stddef.h>
+#include <stdint.h>
+
+class VideoFramePool;
+
+/// @brief Pixel layouts produced by video_raw_data_convert, rows packed without padding.
+enum video_pixel_format {
+    /// Y plane, then the U and V planes of (width + 1) / 2 x (height + 1) / 2 samples.
+    VIDEO_PIXEL_I420 = 0,
+    /// Y plane, then one plane of interleaved U/V pairs.
+    VIDEO_PIXEL_NV12 = 1,
+    /// 4 bytes per pixel, alpha from the alpha plane of the frame or opaque.
+    VIDEO_PIXEL_RGBA = 2,
+    /// 4 bytes per pixel, alpha from the alpha plane of the frame or opaque.
+    VIDEO_PIXEL_BGRA = 3,
+    /// 3 bytes per pixel.
+    VIDEO_PIXEL_RGB24 = 4,
+};
+
+/// @brief Filters of the thumbnail downscaler, see video_helper_set_thumbnail.
+enum video_scale_filter {
+    /// Average of every source pixel under the thumbnail pixel.
+    VIDEO_SCALE_BOX = 0,
+    /// Interpolation between the 4 nearest source pixels, cheaper but aliased past a 2x reduction.
+    VIDEO_SCALE_BILINEAR = 1,
+};
+
 struct exported_video_raw_data {
     char *data;
+    /// Wall clock arrival time in microseconds, derived from the monotonic clock so NTP steps do not show.
     int64_t time;
     uint32_t len;
     uint32_t user_id;
     uint32_t width;
     uint32_t height;
+    /// SDK media timestamp in milliseconds (YUVRawDataI420::GetTimeStamp), 0 if unavailable.
+    uint64_t sdk_time;
+    /// CLOCK_MONOTONIC arrival time in microseconds.
+    int64_t mono_time;
+    /// Smoothed change of (arrival - media time) since the first frame of this renderer, in microseconds.
+    int64_t drift;
+    /// Planes of the I420 frame, each row `width` (luma) or `(width + 1) / 2` (chroma) bytes long.
+    /// They usually follow each other in `data` but need not.
+    char *y;
+    char *u;
+    char *v;
+    /// Alpha plane, one byte per pixel, NULL when the source sends none.
+    char *alpha;
+    uint32_t alpha_len;
+    /// Clockwise rotation to apply for display, in degrees: 0, 90, 180 or 270.
+    uint32_t rotation;
+    /// Whether the samples use the limited (16-235) range rather than the full one.
+    bool limited;
+    /// SDK frame backing the buffers. Pass the frame to video_raw_data_retain to keep them valid after the callback returns.
+    YUVRawDataI420 *raw;
+    /// References kept on the frames of the renderer, see video_raw_data_retain.
+    VideoFramePool *pool;
+};
+
+/// @brief References kept on the frames of a renderer, see video_raw_data_retain.
+struct video_frame_ref_stats {
+    /// References taken on the SDK frame.
+    uint64_t zero_copy_refs;
+    /// Frames copied into a pooled buffer, the SDK refused the reference.
+    uint64_t copied_refs;
+    /// Frames not retained, `max_refs` references were out.
+    uint64_t refused_refs;
+    /// References not released yet.
+    uint32_t outstanding;
+    uint32_t max_refs;
+};
+
+/// @brief Counters of the thumbnails of a renderer, see video_helper_set_thumbnail.
+struct video_thumbnail_stats {
+    /// Thumbnails delivered.
+    uint64_t thumbnails;
+    /// Thumbnails due but not made, every pooled buffer was retained.
+    uint64_t dropped_thumbnails;
+    /// Full frames not delivered, thumbnails only being asked for.
+    uint64_t unforwarded_frames;
+    /// Longest time spent scaling a frame.
+    int64_t max_scale_us;
+};
+
+/// @brief Counters of the frame rate decimation of a renderer, see video_helper_set_target_fps.
+struct video_frame_rate_stats {
+    /// Frames delivered to on_raw_data_frame_received.
+    uint64_t forwarded_frames;
+    /// Frames dropped before reaching Rust, over the target frame rate.
+    uint64_t dropped_frames;
+    uint32_t target_fps;
 };
 
 // SDK_API SDKError createRenderer(IZoomSDKRenderer** ppRenderer, IZoomSDKRendererDelegate* pDelegate);
 
-extern "C" ZOOMSDK::IZoomSDKRendererDelegate* video_helper_create_delegate(void *arc_ptr);
+/// @param target_fps Frame rate delivered to on_raw_data_frame_received, see video_helper_set_target_fps.
+/// @return NULL if `target_fps` is over 60.
+extern "C" ZOOMSDK::IZoomSDKRendererDelegate* video_helper_create_delegate(void *arc_ptr, unsigned int target_fps);
+
+/// @brief Keep a frame after the callback returns, e.g. in an encoder queue. Call it from the frame callback only.
+/// The SDK frame itself is kept when it can be, without a copy; otherwise it is copied into a buffer of the
+/// renderer's pool, planes, alpha and properties included.
+/// @param retained Filled with `data`, buffers and `raw` pointing at the kept frame.
+/// @return false once the renderer has `max_refs` frames out (see video_helper_set_max_frame_refs)
+/// or if `data` has no frame. Otherwise give the frame back with video_raw_data_release.
+extern "C" bool video_raw_data_retain(
+    const struct exported_video_raw_data *data,
+    struct exported_video_raw_data *retained);
+
+/// @brief Drop a reference taken by video_raw_data_retain, from any thread.
+/// @param pool The `pool` of the retained frame.
+extern "C" void video_raw_data_release(VideoFramePool *pool, YUVRawDataI420 *raw);
+
+/// @return Bytes written by video_raw_data_convert for `format`, 0 if the format is unknown.
+extern "C" size_t video_raw_data_converted_len(
+    const struct exported_video_raw_data *data,
+    enum video_pixel_format format);
+
+/// @brief Convert a frame into a caller-owned buffer with SIMD kernels, from any thread while the frame is valid.
+/// Colors use the BT.601 matrix.
+/// @param rotation Clockwise rotation applied on the way: 0, 90, 180 or 270, `data->rotation` to get the frame
+/// upright. Width and height swap at 90 and 270.
+/// @param full_range Expand limited range samples to the full range in I420 and NV12 output. RGB output is
+/// always full range.
+/// @return false if `data` has no planes, the format or rotation is unknown or `out_len` is below
+/// video_raw_data_converted_len.
+extern "C" bool video_raw_data_convert(
+    const struct exported_video_raw_data *data,
+    enum video_pixel_format format,
+    unsigned int rotation,
+    bool full_range,
+    uint8_t *out,
+    size_t out_len);
+
+/// @brief Deliver downscaled copies of the frames through on_video_thumbnail, e.g. for a gallery or a face detector.
+/// A thumbnail fits in `width` x `height` with the aspect ratio of the frame, in even sizes, and is never larger than
+/// the frame. It is a packed I420 frame from the renderer's pool: it can be retained and converted like full frames.
+/// @param enabled false stops thumbnails and delivers full frames again.
+/// @param width From 16 to 1920.
+/// @param height From 16 to 1080.
+/// @param interval_ms Time between two thumbnails, 0 for one per frame.
+/// @param forward_frames false stops on_raw_data_frame_received while thumbnails are on.
+/// @return false if the delegate is NULL or the settings are invalid.
+extern "C" bool video_helper_set_thumbnail(
+    ZOOMSDK::IZoomSDKRendererDelegate* delegate,
+    bool enabled,
+    unsigned int width,
+    unsigned int height,
+    unsigned int interval_ms,
+    enum video_scale_filter filter,
+    bool forward_frames);
+
+/// @return false if the delegate is NULL.
+extern "C" bool video_helper_get_thumbnail_stats(
+    ZOOMSDK::IZoomSDKRendererDelegate* delegate,
+    struct video_thumbnail_stats *stats);
+
+/// @brief Deliver at most `target_fps` frames per second to on_raw_data_frame_received, e.g. for snapshots or a
+/// detector. Frames over the rate are dropped in the delegate, before crossing into Rust. The kept frames are the
+/// closest to a fixed 1 / target_fps grid of the frame timestamps (SDK media time, arrival time without it), so
+/// the cadence stays even when the frames jitter. Thumbnails keep their own interval.
+/// @param target_fps From 1 to 60, 0 for every frame.
+/// @return false if the delegate is NULL or `target_fps` is over 60.
+extern "C" bool video_helper_set_target_fps(
+    ZOOMSDK::IZoomSDKRendererDelegate* delegate,
+    unsigned int target_fps);
+
+/// @return false if the delegate is NULL.
+extern "C" bool video_helper_get_frame_rate_stats(
+    ZOOMSDK::IZoomSDKRendererDelegate* delegate,
+    struct video_frame_rate_stats *stats);
+
+/// @brief Cap the frames of the renderer retained at once, so a slow consumer cannot pin the SDK buffers.
+/// @param max_refs From 1 to 64, 0 for 8.
+/// @return false if the delegate is NULL or `max_refs` is over 64.
+extern "C" bool video_helper_set_max_frame_refs(
+    ZOOMSDK::IZoomSDKRendererDelegate* delegate,
+    unsigned int max_refs);
+
+/// @return false if the delegate is NULL.
+extern "C" bool video_helper_get_frame_ref_stats(
+    ZOOMSDK::IZoomSDKRendererDelegate* delegate,
+    struct video_frame_ref_stats *stats);
 
 extern "C" ZOOMSDK::SDKError video_helper_subscribe_delegate(
     ZOOMSDK::IZoomSDKRenderer* ctx,
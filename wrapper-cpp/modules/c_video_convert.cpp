@@ -0,0 +1,779 @@
+#include "c_video_convert.h"
+#include "c_cpu_features.h"
+
+#include <cstring>
+
+#if WRAPPER_HAVE_X86_SIMD
+#include <immintrin.h>
+#endif
+
+/// BT.601 coefficients in 6-bit fixed point. Luma is scaled as libyuv does: the sample is
+/// replicated into 16 bits (y * 257) and multiplied by `yg`, keeping the high half.
+struct YuvMatrix {
+    int16_t yg;
+    /// Luma offset scaled by the luma gain, with the rounding of the final shift.
+    int16_t yadd;
+    int16_t ub;
+    int16_t ug;
+    int16_t vg;
+    int16_t vr;
+};
+
+static const YuvMatrix LIMITED_MATRIX = {18997, 32 - 1192, 129, 25, 52, 102};
+static const YuvMatrix FULL_MATRIX = {16320, 32, 113, 22, 46, 90};
+
+/// Range expansion gains for mulhrs: luma (y - 16) * 255 / 219 from (y - 16) << 7,
+/// chroma (c - 128) * 255 / 224 from (c - 128) << 6.
+constexpr int16_t RANGE_LUMA_GAIN = 298;
+constexpr int16_t RANGE_CHROMA_GAIN = 583;
+
+unsigned int yuv_pixel_size(enum video_pixel_format format) {
+    switch (format) {
+    case VIDEO_PIXEL_RGBA:
+    case VIDEO_PIXEL_BGRA:
+        return 4;
+    case VIDEO_PIXEL_RGB24:
+        return 3;
+    default:
+        return 0;
+    }
+}
+
+static inline uint8_t clamp_pixel(int value) {
+    value >>= 6;
+    return static_cast<uint8_t>(value < 0 ? 0 : value > 255 ? 255 : value);
+}
+
+static void interleave_uv_scalar(const uint8_t *u, const uint8_t *v, uint8_t *uv, size_t samples) {
+    for (size_t i = 0; i < samples; i += 1) {
+        uv[2 * i] = u[i];
+        uv[2 * i + 1] = v[i];
+    }
+}
+
+static void rgb_row_scalar(
+    const uint8_t *y,
+    const uint8_t *u,
+    const uint8_t *v,
+    const uint8_t *alpha,
+    uint8_t *out,
+    unsigned int width,
+    const YuvMatrix &m,
+    enum video_pixel_format format) {
+    unsigned int size = yuv_pixel_size(format);
+    for (unsigned int x = 0; x < width; x += 1) {
+        int luma = static_cast<int>((y[x] * 257u * static_cast<uint32_t>(m.yg)) >> 16) + m.yadd;
+        int du = u[x / 2] - 128;
+        int dv = v[x / 2] - 128;
+        uint8_t r = clamp_pixel(luma + m.vr * dv);
+        uint8_t g = clamp_pixel(luma - m.ug * du - m.vg * dv);
+        uint8_t b = clamp_pixel(luma + m.ub * du);
+        uint8_t *pixel = out + x * size;
+        pixel[0] = format == VIDEO_PIXEL_BGRA ? b : r;
+        pixel[1] = g;
+        pixel[2] = format == VIDEO_PIXEL_BGRA ? r : b;
+        if (size == 4) {
+            pixel[3] = alpha ? alpha[x] : 255;
+        }
+    }
+}
+
+static void range_row_scalar(const uint8_t *in, uint8_t *out, size_t samples, bool chroma) {
+    for (size_t i = 0; i < samples; i += 1) {
+        int value;
+        if (chroma) {
+            value = ((((in[i] - 128) * 64) * RANGE_CHROMA_GAIN + 16384) >> 15) + 128;
+        } else {
+            int offset = in[i] > 16 ? in[i] - 16 : 0;
+            value = ((offset * 128) * RANGE_LUMA_GAIN + 16384) >> 15;
+        }
+        out[i] = static_cast<uint8_t>(value < 0 ? 0 : value > 255 ? 255 : value);
+    }
+}
+
+static void reverse_row_scalar(const uint8_t *in, uint8_t *out, size_t samples) {
+    for (size_t i = 0; i < samples; i += 1) {
+        out[i] = in[samples - 1 - i];
+    }
+}
+
+static void add_row_scalar(const uint8_t *in, uint16_t *sums, size_t samples) {
+    for (size_t i = 0; i < samples; i += 1) {
+        sums[i] = static_cast<uint16_t>(sums[i] + in[i]);
+    }
+}
+
+static void lerp_row_scalar(const uint8_t *a, const uint8_t *b, uint8_t *out, size_t samples, unsigned int fraction) {
+    for (size_t i = 0; i < samples; i += 1) {
+        out[i] = static_cast<uint8_t>((a[i] * (256 - fraction) + b[i] * fraction + 128) >> 8);
+    }
+}
+
+#if WRAPPER_HAVE_X86_SIMD
+
+static void interleave_uv_sse4(const uint8_t *u, const uint8_t *v, uint8_t *uv, size_t samples) {
+    size_t i = 0;
+    for (; i + 16 <= samples; i += 16) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(u + i));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(v + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(uv + 2 * i), _mm_unpacklo_epi8(a, b));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(uv + 2 * i + 16), _mm_unpackhi_epi8(a, b));
+    }
+    interleave_uv_scalar(u + i, v + i, uv + 2 * i, samples - i);
+}
+
+/// Store 16 pixels given as one register per channel.
+static inline void store_pixels_sse4(
+    uint8_t *out,
+    __m128i r,
+    __m128i g,
+    __m128i b,
+    __m128i a,
+    enum video_pixel_format format) {
+    __m128i first = format == VIDEO_PIXEL_BGRA ? b : r;
+    __m128i third = format == VIDEO_PIXEL_BGRA ? r : b;
+    __m128i low = _mm_unpacklo_epi8(first, g);
+    __m128i high = _mm_unpackhi_epi8(first, g);
+    __m128i low_alpha = _mm_unpacklo_epi8(third, a);
+    __m128i high_alpha = _mm_unpackhi_epi8(third, a);
+    __m128i p0 = _mm_unpacklo_epi16(low, low_alpha);
+    __m128i p1 = _mm_unpackhi_epi16(low, low_alpha);
+    __m128i p2 = _mm_unpacklo_epi16(high, high_alpha);
+    __m128i p3 = _mm_unpackhi_epi16(high, high_alpha);
+    if (format != VIDEO_PIXEL_RGB24) {
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out), p0);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 16), p1);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 32), p2);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 48), p3);
+        return;
+    }
+    // Drop the fourth byte of each pixel, then glue the 12-byte groups into 3 registers.
+    const __m128i pack = _mm_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+    p0 = _mm_shuffle_epi8(p0, pack);
+    p1 = _mm_shuffle_epi8(p1, pack);
+    p2 = _mm_shuffle_epi8(p2, pack);
+    p3 = _mm_shuffle_epi8(p3, pack);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out), _mm_or_si128(p0, _mm_slli_si128(p1, 12)));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 16), _mm_or_si128(_mm_srli_si128(p1, 4), _mm_slli_si128(p2, 8)));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 32), _mm_or_si128(_mm_srli_si128(p2, 8), _mm_slli_si128(p3, 4)));
+}
+
+/// One channel of 8 pixels: (luma + chroma terms) >> 6, saturated like the scalar clamp.
+static inline __m128i rgb_channel_sse4(__m128i luma, __m128i plus, __m128i minus) {
+    return _mm_srai_epi16(_mm_subs_epi16(_mm_adds_epi16(luma, plus), minus), 6);
+}
+
+static void rgb_row_sse4(
+    const uint8_t *y,
+    const uint8_t *u,
+    const uint8_t *v,
+    const uint8_t *alpha,
+    uint8_t *out,
+    unsigned int width,
+    const YuvMatrix &m,
+    enum video_pixel_format format) {
+    const __m128i yg = _mm_set1_epi16(m.yg);
+    const __m128i yadd = _mm_set1_epi16(m.yadd);
+    const __m128i ub = _mm_set1_epi16(m.ub);
+    const __m128i ug = _mm_set1_epi16(m.ug);
+    const __m128i vg = _mm_set1_epi16(m.vg);
+    const __m128i vr = _mm_set1_epi16(m.vr);
+    const __m128i center = _mm_set1_epi16(128);
+    const __m128i opaque = _mm_set1_epi8(-1);
+    const __m128i zero = _mm_setzero_si128();
+    unsigned int size = yuv_pixel_size(format);
+    unsigned int x = 0;
+    for (; x + 16 <= width; x += 16) {
+        __m128i luma = _mm_loadu_si128(reinterpret_cast<const __m128i *>(y + x));
+        __m128i du = _mm_sub_epi16(_mm_cvtepu8_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(u + x / 2))), center);
+        __m128i dv = _mm_sub_epi16(_mm_cvtepu8_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(v + x / 2))), center);
+        __m128i du_low = _mm_unpacklo_epi16(du, du);
+        __m128i du_high = _mm_unpackhi_epi16(du, du);
+        __m128i dv_low = _mm_unpacklo_epi16(dv, dv);
+        __m128i dv_high = _mm_unpackhi_epi16(dv, dv);
+        __m128i luma_low = _mm_add_epi16(_mm_mulhi_epu16(_mm_unpacklo_epi8(luma, luma), yg), yadd);
+        __m128i luma_high = _mm_add_epi16(_mm_mulhi_epu16(_mm_unpackhi_epi8(luma, luma), yg), yadd);
+        __m128i r = _mm_packus_epi16(
+            rgb_channel_sse4(luma_low, _mm_mullo_epi16(dv_low, vr), zero),
+            rgb_channel_sse4(luma_high, _mm_mullo_epi16(dv_high, vr), zero));
+        __m128i g = _mm_packus_epi16(
+            rgb_channel_sse4(_mm_subs_epi16(luma_low, _mm_mullo_epi16(du_low, ug)), zero, _mm_mullo_epi16(dv_low, vg)),
+            rgb_channel_sse4(_mm_subs_epi16(luma_high, _mm_mullo_epi16(du_high, ug)), zero, _mm_mullo_epi16(dv_high, vg)));
+        __m128i b = _mm_packus_epi16(
+            rgb_channel_sse4(luma_low, _mm_mullo_epi16(du_low, ub), zero),
+            rgb_channel_sse4(luma_high, _mm_mullo_epi16(du_high, ub), zero));
+        __m128i a = alpha ? _mm_loadu_si128(reinterpret_cast<const __m128i *>(alpha + x)) : opaque;
+        store_pixels_sse4(out + x * size, r, g, b, a, format);
+    }
+    rgb_row_scalar(y + x, u + x / 2, v + x / 2, alpha ? alpha + x : nullptr, out + x * size, width - x, m, format);
+}
+
+/// Expand 8 samples widened to 16 bits.
+static inline __m128i range_expand_sse4(__m128i samples, bool chroma) {
+    if (chroma) {
+        __m128i centered = _mm_slli_epi16(_mm_sub_epi16(samples, _mm_set1_epi16(128)), 6);
+        return _mm_add_epi16(_mm_mulhrs_epi16(centered, _mm_set1_epi16(RANGE_CHROMA_GAIN)), _mm_set1_epi16(128));
+    }
+    return _mm_mulhrs_epi16(_mm_slli_epi16(samples, 7), _mm_set1_epi16(RANGE_LUMA_GAIN));
+}
+
+static void range_row_sse4(const uint8_t *in, uint8_t *out, size_t samples, bool chroma) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i black = _mm_set1_epi8(16);
+    size_t i = 0;
+    for (; i + 16 <= samples; i += 16) {
+        __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i));
+        if (!chroma) {
+            value = _mm_subs_epu8(value, black);
+        }
+        __m128i low = range_expand_sse4(_mm_unpacklo_epi8(value, zero), chroma);
+        __m128i high = range_expand_sse4(_mm_unpackhi_epi8(value, zero), chroma);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), _mm_packus_epi16(low, high));
+    }
+    range_row_scalar(in + i, out + i, samples - i, chroma);
+}
+
+static void reverse_row_sse4(const uint8_t *in, uint8_t *out, size_t samples) {
+    const __m128i reverse = _mm_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+    size_t i = 0;
+    for (; i + 16 <= samples; i += 16) {
+        __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + samples - 16 - i));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), _mm_shuffle_epi8(value, reverse));
+    }
+    // The rest is the head of `in`.
+    reverse_row_scalar(in, out + i, samples - i);
+}
+
+static void transpose_block_sse4(const uint8_t *in, ptrdiff_t in_stride, uint8_t *out, ptrdiff_t out_stride) {
+    __m128i rows[8];
+    for (int i = 0; i < 8; i += 1) {
+        rows[i] = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(in + i * in_stride));
+    }
+    // Pairs of rows, then quads, then all 8: each column ends up in 8 consecutive bytes.
+    __m128i a0 = _mm_unpacklo_epi8(rows[0], rows[1]);
+    __m128i a1 = _mm_unpacklo_epi8(rows[2], rows[3]);
+    __m128i a2 = _mm_unpacklo_epi8(rows[4], rows[5]);
+    __m128i a3 = _mm_unpacklo_epi8(rows[6], rows[7]);
+    __m128i b0 = _mm_unpacklo_epi16(a0, a1);
+    __m128i b1 = _mm_unpackhi_epi16(a0, a1);
+    __m128i b2 = _mm_unpacklo_epi16(a2, a3);
+    __m128i b3 = _mm_unpackhi_epi16(a2, a3);
+    __m128i columns[4] = {
+        _mm_unpacklo_epi32(b0, b2),
+        _mm_unpackhi_epi32(b0, b2),
+        _mm_unpacklo_epi32(b1, b3),
+        _mm_unpackhi_epi32(b1, b3),
+    };
+    for (int j = 0; j < 4; j += 1) {
+        _mm_storel_epi64(reinterpret_cast<__m128i *>(out + 2 * j * out_stride), columns[j]);
+        _mm_storel_epi64(reinterpret_cast<__m128i *>(out + (2 * j + 1) * out_stride), _mm_unpackhi_epi64(columns[j], columns[j]));
+    }
+}
+
+static void add_row_sse4(const uint8_t *in, uint16_t *sums, size_t samples) {
+    const __m128i zero = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 16 <= samples; i += 16) {
+        __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i));
+        __m128i *low = reinterpret_cast<__m128i *>(sums + i);
+        __m128i *high = reinterpret_cast<__m128i *>(sums + i + 8);
+        _mm_storeu_si128(low, _mm_add_epi16(_mm_loadu_si128(low), _mm_unpacklo_epi8(value, zero)));
+        _mm_storeu_si128(high, _mm_add_epi16(_mm_loadu_si128(high), _mm_unpackhi_epi8(value, zero)));
+    }
+    add_row_scalar(in + i, sums + i, samples - i);
+}
+
+/// Weighted sum of 8 samples widened to 16 bits. It can reach 65408, which wraps in signed lanes
+/// but is exact once shifted as unsigned.
+static inline __m128i lerp_sse4(__m128i a, __m128i b, __m128i weight_a, __m128i weight_b) {
+    __m128i sum = _mm_add_epi16(_mm_mullo_epi16(a, weight_a), _mm_mullo_epi16(b, weight_b));
+    return _mm_srli_epi16(_mm_add_epi16(sum, _mm_set1_epi16(128)), 8);
+}
+
+static void lerp_row_sse4(const uint8_t *a, const uint8_t *b, uint8_t *out, size_t samples, unsigned int fraction) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i weight_a = _mm_set1_epi16(static_cast<int16_t>(256 - fraction));
+    const __m128i weight_b = _mm_set1_epi16(static_cast<int16_t>(fraction));
+    size_t i = 0;
+    for (; i + 16 <= samples; i += 16) {
+        __m128i first = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i));
+        __m128i second = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + i));
+        __m128i low = lerp_sse4(_mm_unpacklo_epi8(first, zero), _mm_unpacklo_epi8(second, zero), weight_a, weight_b);
+        __m128i high = lerp_sse4(_mm_unpackhi_epi8(first, zero), _mm_unpackhi_epi8(second, zero), weight_a, weight_b);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), _mm_packus_epi16(low, high));
+    }
+    lerp_row_scalar(a + i, b + i, out + i, samples - i, fraction);
+}
+
+#define YUV_AVX2 __attribute__((target("avx2,fma")))
+
+YUV_AVX2 static void interleave_uv_avx2(const uint8_t *u, const uint8_t *v, uint8_t *uv, size_t samples) {
+    size_t i = 0;
+    for (; i + 32 <= samples; i += 32) {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(u + i));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(v + i));
+        // unpack works per 128-bit lane, regroup the halves in sample order.
+        __m256i low = _mm256_unpacklo_epi8(a, b);
+        __m256i high = _mm256_unpackhi_epi8(a, b);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(uv + 2 * i), _mm256_permute2x128_si256(low, high, 0x20));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(uv + 2 * i + 32), _mm256_permute2x128_si256(low, high, 0x31));
+    }
+    interleave_uv_sse4(u + i, v + i, uv + 2 * i, samples - i);
+}
+
+YUV_AVX2 static inline __m256i rgb_channel_avx2(__m256i luma, __m256i plus, __m256i minus) {
+    return _mm256_srai_epi16(_mm256_subs_epi16(_mm256_adds_epi16(luma, plus), minus), 6);
+}
+
+/// Pack two registers of 16 pixels into 32 bytes in pixel order.
+YUV_AVX2 static inline __m256i pack_pixels_avx2(__m256i low, __m256i high) {
+    return _mm256_permute4x64_epi64(_mm256_packus_epi16(low, high), 0xD8);
+}
+
+YUV_AVX2 static void rgb_row_avx2(
+    const uint8_t *y,
+    const uint8_t *u,
+    const uint8_t *v,
+    const uint8_t *alpha,
+    uint8_t *out,
+    unsigned int width,
+    const YuvMatrix &m,
+    enum video_pixel_format format) {
+    const __m256i yg = _mm256_set1_epi16(m.yg);
+    const __m256i yadd = _mm256_set1_epi16(m.yadd);
+    const __m256i ub = _mm256_set1_epi16(m.ub);
+    const __m256i ug = _mm256_set1_epi16(m.ug);
+    const __m256i vg = _mm256_set1_epi16(m.vg);
+    const __m256i vr = _mm256_set1_epi16(m.vr);
+    const __m256i center = _mm256_set1_epi16(128);
+    const __m256i opaque = _mm256_set1_epi8(-1);
+    const __m256i zero = _mm256_setzero_si256();
+    unsigned int size = yuv_pixel_size(format);
+    unsigned int x = 0;
+    for (; x + 32 <= width; x += 32) {
+        __m256i du = _mm256_sub_epi16(_mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(u + x / 2))), center);
+        __m256i dv = _mm256_sub_epi16(_mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(v + x / 2))), center);
+        // Duplicate each chroma sample for its two pixels, unpack works per lane so regroup the quarters first.
+        du = _mm256_permute4x64_epi64(du, 0xD8);
+        dv = _mm256_permute4x64_epi64(dv, 0xD8);
+        __m256i du_low = _mm256_unpacklo_epi16(du, du);
+        __m256i du_high = _mm256_unpackhi_epi16(du, du);
+        __m256i dv_low = _mm256_unpacklo_epi16(dv, dv);
+        __m256i dv_high = _mm256_unpackhi_epi16(dv, dv);
+        __m256i luma_low = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(y + x)));
+        __m256i luma_high = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(y + x + 16)));
+        luma_low = _mm256_add_epi16(_mm256_mulhi_epu16(_mm256_or_si256(luma_low, _mm256_slli_epi16(luma_low, 8)), yg), yadd);
+        luma_high = _mm256_add_epi16(_mm256_mulhi_epu16(_mm256_or_si256(luma_high, _mm256_slli_epi16(luma_high, 8)), yg), yadd);
+        __m256i r = pack_pixels_avx2(
+            rgb_channel_avx2(luma_low, _mm256_mullo_epi16(dv_low, vr), zero),
+            rgb_channel_avx2(luma_high, _mm256_mullo_epi16(dv_high, vr), zero));
+        __m256i g = pack_pixels_avx2(
+            rgb_channel_avx2(_mm256_subs_epi16(luma_low, _mm256_mullo_epi16(du_low, ug)), zero, _mm256_mullo_epi16(dv_low, vg)),
+            rgb_channel_avx2(_mm256_subs_epi16(luma_high, _mm256_mullo_epi16(du_high, ug)), zero, _mm256_mullo_epi16(dv_high, vg)));
+        __m256i b = pack_pixels_avx2(
+            rgb_channel_avx2(luma_low, _mm256_mullo_epi16(du_low, ub), zero),
+            rgb_channel_avx2(luma_high, _mm256_mullo_epi16(du_high, ub), zero));
+        __m256i a = alpha ? _mm256_loadu_si256(reinterpret_cast<const __m256i *>(alpha + x)) : opaque;
+        store_pixels_sse4(out + x * size, _mm256_castsi256_si128(r), _mm256_castsi256_si128(g),
+            _mm256_castsi256_si128(b), _mm256_castsi256_si128(a), format);
+        store_pixels_sse4(out + (x + 16) * size, _mm256_extracti128_si256(r, 1), _mm256_extracti128_si256(g, 1),
+            _mm256_extracti128_si256(b, 1), _mm256_extracti128_si256(a, 1), format);
+    }
+    rgb_row_sse4(y + x, u + x / 2, v + x / 2, alpha ? alpha + x : nullptr, out + x * size, width - x, m, format);
+}
+
+YUV_AVX2 static inline __m256i range_expand_avx2(__m256i samples, bool chroma) {
+    if (chroma) {
+        __m256i centered = _mm256_slli_epi16(_mm256_sub_epi16(samples, _mm256_set1_epi16(128)), 6);
+        return _mm256_add_epi16(_mm256_mulhrs_epi16(centered, _mm256_set1_epi16(RANGE_CHROMA_GAIN)), _mm256_set1_epi16(128));
+    }
+    return _mm256_mulhrs_epi16(_mm256_slli_epi16(samples, 7), _mm256_set1_epi16(RANGE_LUMA_GAIN));
+}
+
+YUV_AVX2 static void range_row_avx2(const uint8_t *in, uint8_t *out, size_t samples, bool chroma) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i black = _mm256_set1_epi8(16);
+    size_t i = 0;
+    for (; i + 32 <= samples; i += 32) {
+        __m256i value = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + i));
+        if (!chroma) {
+            value = _mm256_subs_epu8(value, black);
+        }
+        // unpack and pack both work per lane, the byte order is kept.
+        __m256i low = range_expand_avx2(_mm256_unpacklo_epi8(value, zero), chroma);
+        __m256i high = range_expand_avx2(_mm256_unpackhi_epi8(value, zero), chroma);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), _mm256_packus_epi16(low, high));
+    }
+    range_row_sse4(in + i, out + i, samples - i, chroma);
+}
+
+YUV_AVX2 static void reverse_row_avx2(const uint8_t *in, uint8_t *out, size_t samples) {
+    const __m256i reverse = _mm256_setr_epi8(
+        15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0,
+        15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+    size_t i = 0;
+    for (; i + 32 <= samples; i += 32) {
+        __m256i value = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + samples - 32 - i));
+        value = _mm256_permute4x64_epi64(_mm256_shuffle_epi8(value, reverse), 0x4E);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), value);
+    }
+    // The rest is the head of `in`.
+    reverse_row_sse4(in, out + i, samples - i);
+}
+
+YUV_AVX2 static void add_row_avx2(const uint8_t *in, uint16_t *sums, size_t samples) {
+    size_t i = 0;
+    for (; i + 32 <= samples; i += 32) {
+        __m256i *low = reinterpret_cast<__m256i *>(sums + i);
+        __m256i *high = reinterpret_cast<__m256i *>(sums + i + 16);
+        __m256i first = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i)));
+        __m256i second = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i + 16)));
+        _mm256_storeu_si256(low, _mm256_add_epi16(_mm256_loadu_si256(low), first));
+        _mm256_storeu_si256(high, _mm256_add_epi16(_mm256_loadu_si256(high), second));
+    }
+    add_row_sse4(in + i, sums + i, samples - i);
+}
+
+YUV_AVX2 static inline __m256i lerp_avx2(__m256i a, __m256i b, __m256i weight_a, __m256i weight_b) {
+    __m256i sum = _mm256_add_epi16(_mm256_mullo_epi16(a, weight_a), _mm256_mullo_epi16(b, weight_b));
+    return _mm256_srli_epi16(_mm256_add_epi16(sum, _mm256_set1_epi16(128)), 8);
+}
+
+YUV_AVX2 static void lerp_row_avx2(const uint8_t *a, const uint8_t *b, uint8_t *out, size_t samples, unsigned int fraction) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i weight_a = _mm256_set1_epi16(static_cast<int16_t>(256 - fraction));
+    const __m256i weight_b = _mm256_set1_epi16(static_cast<int16_t>(fraction));
+    size_t i = 0;
+    for (; i + 32 <= samples; i += 32) {
+        __m256i first = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i));
+        __m256i second = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + i));
+        // unpack and pack both work per lane, the sample order is kept.
+        __m256i low = lerp_avx2(_mm256_unpacklo_epi8(first, zero), _mm256_unpacklo_epi8(second, zero), weight_a, weight_b);
+        __m256i high = lerp_avx2(_mm256_unpackhi_epi8(first, zero), _mm256_unpackhi_epi8(second, zero), weight_a, weight_b);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), _mm256_packus_epi16(low, high));
+    }
+    lerp_row_sse4(a + i, b + i, out + i, samples - i, fraction);
+}
+
+#else
+
+/// out row j = in column j of an 8x8 block, strides may be negative.
+static void transpose_block_scalar(const uint8_t *in, ptrdiff_t in_stride, uint8_t *out, ptrdiff_t out_stride) {
+    for (int j = 0; j < 8; j += 1) {
+        for (int i = 0; i < 8; i += 1) {
+            out[j * out_stride + i] = in[i * in_stride + j];
+        }
+    }
+}
+
+#endif
+
+struct YuvKernels {
+    void (*interleave_uv)(const uint8_t *, const uint8_t *, uint8_t *, size_t);
+    void (*rgb_row)(const uint8_t *, const uint8_t *, const uint8_t *, const uint8_t *, uint8_t *, unsigned int,
+        const YuvMatrix &, enum video_pixel_format);
+    void (*range_row)(const uint8_t *, uint8_t *, size_t, bool);
+    void (*reverse_row)(const uint8_t *, uint8_t *, size_t);
+    void (*transpose_block)(const uint8_t *, ptrdiff_t, uint8_t *, ptrdiff_t);
+    void (*add_row)(const uint8_t *, uint16_t *, size_t);
+    void (*lerp_row)(const uint8_t *, const uint8_t *, uint8_t *, size_t, unsigned int);
+    const char *name;
+};
+
+static YuvKernels select_kernels() {
+#if WRAPPER_HAVE_X86_SIMD
+    // An 8x8 byte transpose is already a handful of unpacks, AVX2 keeps the SSE one.
+    if (cpu_has_avx2()) {
+        return {
+            interleave_uv_avx2, rgb_row_avx2, range_row_avx2, reverse_row_avx2, transpose_block_sse4,
+            add_row_avx2, lerp_row_avx2, "avx2",
+        };
+    }
+    return {
+        interleave_uv_sse4, rgb_row_sse4, range_row_sse4, reverse_row_sse4, transpose_block_sse4,
+        add_row_sse4, lerp_row_sse4, "sse4.2",
+    };
+#else
+    return {
+        interleave_uv_scalar, rgb_row_scalar, range_row_scalar, reverse_row_scalar, transpose_block_scalar,
+        add_row_scalar, lerp_row_scalar, "scalar",
+    };
+#endif
+}
+
+static const YuvKernels &kernels() {
+    static const YuvKernels selected = select_kernels();
+    return selected;
+}
+
+void yuv_i420_to_nv12(const struct i420_image &in, uint8_t *y, size_t y_stride, uint8_t *uv, size_t uv_stride) {
+    for (unsigned int row = 0; row < in.height; row += 1) {
+        memcpy(y + row * y_stride, in.y + row * in.y_stride, in.width);
+    }
+    unsigned int chroma_width = (in.width + 1) / 2;
+    unsigned int chroma_height = (in.height + 1) / 2;
+    for (unsigned int row = 0; row < chroma_height; row += 1) {
+        kernels().interleave_uv(in.u + row * in.uv_stride, in.v + row * in.uv_stride, uv + row * uv_stride, chroma_width);
+    }
+}
+
+void yuv_i420_to_rgb(
+    const struct i420_image &in,
+    const uint8_t *alpha,
+    size_t alpha_stride,
+    bool limited,
+    enum video_pixel_format format,
+    uint8_t *out,
+    size_t stride) {
+    if (!yuv_pixel_size(format)) {
+        return;
+    }
+    const YuvMatrix &matrix = limited ? LIMITED_MATRIX : FULL_MATRIX;
+    const YuvKernels &k = kernels();
+    for (unsigned int row = 0; row < in.height; row += 1) {
+        k.rgb_row(
+            in.y + row * in.y_stride,
+            in.u + (row / 2) * in.uv_stride,
+            in.v + (row / 2) * in.uv_stride,
+            alpha ? alpha + row * alpha_stride : nullptr,
+            out + row * stride,
+            in.width,
+            matrix,
+            format);
+    }
+}
+
+void yuv_expand_range(
+    const uint8_t *in,
+    size_t in_stride,
+    uint8_t *out,
+    size_t out_stride,
+    unsigned int width,
+    unsigned int height,
+    bool chroma) {
+    for (unsigned int row = 0; row < height; row += 1) {
+        kernels().range_row(in + row * in_stride, out + row * out_stride, width, chroma);
+    }
+}
+
+/// Rotate by 90 (clockwise) or 270 degrees, by 8x8 blocks transposed with the rows or the columns reversed.
+static void rotate_quarter(
+    const uint8_t *in,
+    ptrdiff_t in_stride,
+    unsigned int width,
+    unsigned int height,
+    bool clockwise,
+    uint8_t *out,
+    ptrdiff_t out_stride) {
+    const YuvKernels &k = kernels();
+    for (unsigned int y0 = 0; y0 < height; y0 += 8) {
+        for (unsigned int x0 = 0; x0 < width; x0 += 8) {
+            if (y0 + 8 <= height && x0 + 8 <= width) {
+                if (clockwise) {
+                    k.transpose_block(in + (y0 + 7) * in_stride + x0, -in_stride, out + x0 * out_stride + (height - 8 - y0), out_stride);
+                } else {
+                    k.transpose_block(in + y0 * in_stride + x0, in_stride, out + (width - 1 - x0) * out_stride + y0, -out_stride);
+                }
+                continue;
+            }
+            for (unsigned int y = y0; y < y0 + 8 && y < height; y += 1) {
+                for (unsigned int x = x0; x < x0 + 8 && x < width; x += 1) {
+                    uint8_t value = in[y * in_stride + x];
+                    if (clockwise) {
+                        out[x * out_stride + (height - 1 - y)] = value;
+                    } else {
+                        out[(width - 1 - x) * out_stride + y] = value;
+                    }
+                }
+            }
+        }
+    }
+}
+
+void yuv_rotate_plane(
+    const uint8_t *in,
+    size_t in_stride,
+    unsigned int width,
+    unsigned int height,
+    unsigned int rotation,
+    uint8_t *out,
+    size_t out_stride) {
+    switch (rotation) {
+    case 90:
+    case 270:
+        rotate_quarter(in, static_cast<ptrdiff_t>(in_stride), width, height, rotation == 90, out, static_cast<ptrdiff_t>(out_stride));
+        break;
+    case 180:
+        for (unsigned int row = 0; row < height; row += 1) {
+            kernels().reverse_row(in + row * in_stride, out + (height - 1 - row) * out_stride, width);
+        }
+        break;
+    default:
+        for (unsigned int row = 0; row < height; row += 1) {
+            memcpy(out + row * out_stride, in + row * in_stride, width);
+        }
+        break;
+    }
+}
+
+void yuv_i420_rotate(const struct i420_image &in, unsigned int rotation, const struct i420_image &out) {
+    unsigned int chroma_width = (in.width + 1) / 2;
+    unsigned int chroma_height = (in.height + 1) / 2;
+    yuv_rotate_plane(in.y, in.y_stride, in.width, in.height, rotation, out.y, out.y_stride);
+    yuv_rotate_plane(in.u, in.uv_stride, chroma_width, chroma_height, rotation, out.u, out.uv_stride);
+    yuv_rotate_plane(in.v, in.uv_stride, chroma_width, chroma_height, rotation, out.v, out.uv_stride);
+}
+
+/// Average of the in_width / out_width x in_height / out_height box of each output sample, the rows of a
+/// box summed with the kernel and the columns by hand, a row of sums being much shorter than the box.
+static void scale_box(
+    const uint8_t *in,
+    size_t in_stride,
+    unsigned int in_width,
+    unsigned int in_height,
+    uint8_t *out,
+    size_t out_stride,
+    unsigned int out_width,
+    unsigned int out_height,
+    uint16_t *sums) {
+    const YuvKernels &k = kernels();
+    // Boxes are `step` or `step + 1` columns wide, 1 when upscaling.
+    unsigned int step = in_width / out_width;
+    unsigned int carry = in_width % out_width;
+    unsigned int base = step ? step : 1;
+    for (unsigned int y = 0; y < out_height; y += 1) {
+        unsigned int y0 = static_cast<unsigned int>(static_cast<uint64_t>(y) * in_height / out_height);
+        unsigned int y1 = static_cast<unsigned int>(static_cast<uint64_t>(y + 1) * in_height / out_height);
+        y1 = y1 > y0 ? y1 : y0 + 1;
+        // 16-bit sums hold 257 rows of 255.
+        y1 = y1 - y0 > YUV_BOX_MAX_ROWS ? y0 + YUV_BOX_MAX_ROWS : y1;
+        memset(sums, 0, in_width * sizeof(uint16_t));
+        for (unsigned int row = y0; row < y1; row += 1) {
+            k.add_row(in + row * in_stride, sums, in_width);
+        }
+        // Rounded division by the area as a multiplication by ceil(2^46 / area), exact for areas
+        // below 2^19 as the sums stay below 256 areas.
+        uint64_t area = static_cast<uint64_t>(base) * (y1 - y0);
+        uint64_t reciprocal[2] = {
+            ((uint64_t(1) << 46) + area - 1) / area,
+            ((uint64_t(1) << 46) + area + (y1 - y0) - 1) / (area + (y1 - y0)),
+        };
+        uint8_t *line = out + y * out_stride;
+        unsigned int x0 = 0;
+        unsigned int remainder = 0;
+        for (unsigned int x = 0; x < out_width; x += 1) {
+            // x1 = (x + 1) * in_width / out_width, stepped.
+            unsigned int x1 = x0 + step;
+            remainder += carry;
+            if (remainder >= out_width) {
+                remainder -= out_width;
+                x1 += 1;
+            }
+            unsigned int end = x1 > x0 ? x1 : x0 + 1;
+            uint32_t sum = 0;
+            for (unsigned int i = x0; i < end; i += 1) {
+                sum += sums[i];
+            }
+            uint64_t wide = end - x0 > base;
+            line[x] = static_cast<uint8_t>(((sum + ((area + wide * (y1 - y0)) >> 1)) * reciprocal[wide]) >> 46);
+            x0 = x1;
+        }
+    }
+}
+
+/// Position of the center of output sample `index` in the input, 8-bit fixed point, clamped to the edges.
+static inline void bilinear_position(unsigned int index, unsigned int in_size, unsigned int out_size, unsigned int *first, unsigned int *fraction) {
+    int64_t position = (static_cast<int64_t>(2 * index + 1) * in_size * 256) / (2 * out_size) - 128;
+    position = position < 0 ? 0 : position;
+    *first = static_cast<unsigned int>(position >> 8);
+    *fraction = static_cast<unsigned int>(position & 255);
+    if (*first >= in_size - 1) {
+        *first = in_size - 1;
+        *fraction = 0;
+    }
+}
+
+/// Interpolate the two input rows around each output row with the kernel, then the columns by hand.
+static void scale_bilinear(
+    const uint8_t *in,
+    size_t in_stride,
+    unsigned int in_width,
+    unsigned int in_height,
+    uint8_t *out,
+    size_t out_stride,
+    unsigned int out_width,
+    unsigned int out_height,
+    uint8_t *row) {
+    const YuvKernels &k = kernels();
+    // Column positions (2 * x + 1) * in_width * 256 / (2 * out_width), stepped by `step` and `carry`.
+    uint64_t denominator = 2 * static_cast<uint64_t>(out_width);
+    uint64_t start = static_cast<uint64_t>(in_width) * 256;
+    uint64_t step = 2 * start / denominator;
+    uint64_t carry = 2 * start % denominator;
+    for (unsigned int y = 0; y < out_height; y += 1) {
+        unsigned int first;
+        unsigned int fraction;
+        bilinear_position(y, in_height, out_height, &first, &fraction);
+        const uint8_t *above = in + first * in_stride;
+        const uint8_t *below = fraction ? above + in_stride : above;
+        k.lerp_row(above, below, row, in_width, fraction);
+        uint8_t *line = out + y * out_stride;
+        uint64_t position = start / denominator;
+        uint64_t remainder = start % denominator;
+        for (unsigned int x = 0; x < out_width; x += 1) {
+            unsigned int left = 0;
+            unsigned int weight = 0;
+            if (position >= 128) {
+                left = static_cast<unsigned int>((position - 128) >> 8);
+                weight = static_cast<unsigned int>((position - 128) & 255);
+            }
+            if (left >= in_width - 1) {
+                left = in_width - 1;
+                weight = 0;
+            }
+            unsigned int right = weight ? left + 1 : left;
+            line[x] = static_cast<uint8_t>((row[left] * (256 - weight) + row[right] * weight + 128) >> 8);
+            position += step;
+            remainder += carry;
+            if (remainder >= denominator) {
+                remainder -= denominator;
+                position += 1;
+            }
+        }
+    }
+}
+
+void yuv_scale_plane(
+    const uint8_t *in,
+    size_t in_stride,
+    unsigned int in_width,
+    unsigned int in_height,
+    uint8_t *out,
+    size_t out_stride,
+    unsigned int out_width,
+    unsigned int out_height,
+    enum video_scale_filter filter,
+    uint16_t *scratch) {
+    if (!in_width || !in_height || !out_width || !out_height) {
+        return;
+    }
+    if (filter == VIDEO_SCALE_BILINEAR) {
+        scale_bilinear(in, in_stride, in_width, in_height, out, out_stride, out_width, out_height, reinterpret_cast<uint8_t *>(scratch));
+    } else {
+        scale_box(in, in_stride, in_width, in_height, out, out_stride, out_width, out_height, scratch);
+    }
+}
+
+void yuv_i420_scale(const struct i420_image &in, const struct i420_image &out, enum video_scale_filter filter, uint16_t *scratch) {
+    yuv_scale_plane(in.y, in.y_stride, in.width, in.height, out.y, out.y_stride, out.width, out.height, filter, scratch);
+    unsigned int in_chroma_width = (in.width + 1) / 2;
+    unsigned int in_chroma_height = (in.height + 1) / 2;
+    unsigned int out_chroma_width = (out.width + 1) / 2;
+    unsigned int out_chroma_height = (out.height + 1) / 2;
+    yuv_scale_plane(in.u, in.uv_stride, in_chroma_width, in_chroma_height, out.u, out.uv_stride, out_chroma_width, out_chroma_height, filter, scratch);
+    yuv_scale_plane(in.v, in.uv_stride, in_chroma_width, in_chroma_height, out.v, out.uv_stride, out_chroma_width, out_chroma_height, filter, scratch);
+}
+
+const char *yuv_kernel_name() {
+    return kernels().name;
+}
@@ -0,0 +1,93 @@
+#ifndef _C_VIDEO_CONVERT_H_
+#define _C_VIDEO_CONVERT_H_
+
+#include "c_rawdata_video_helper.h"
+
+#include <cstddef>
+#include <cstdint>
+
+/// @brief Vectorized I420 kernels, dispatched once to AVX2 or SSE4.2 at startup.
+///
+/// Planes are 8-bit with a stride in bytes between rows. Chroma planes are subsampled 2x2: a
+/// `width` x `height` frame has (width + 1) / 2 x (height + 1) / 2 chroma samples. Colors use the
+/// BT.601 matrix, chroma is upsampled by repeating samples. Outputs are written into caller-owned
+/// buffers and never alias the input, unless stated otherwise.
+
+/// @brief Planes of an I420 image.
+struct i420_image {
+    uint8_t *y;
+    uint8_t *u;
+    uint8_t *v;
+    size_t y_stride;
+    size_t uv_stride;
+    unsigned int width;
+    unsigned int height;
+};
+
+/// @brief Bytes per pixel of the packed RGB formats, 0 for the others.
+unsigned int yuv_pixel_size(enum video_pixel_format format);
+
+/// @brief Copy the luma plane and interleave the chroma planes into one U/V plane.
+void yuv_i420_to_nv12(const struct i420_image &in, uint8_t *y, size_t y_stride, uint8_t *uv, size_t uv_stride);
+
+/// @brief Convert to packed RGBA, BGRA or RGB24 of full range.
+/// @param alpha Alpha plane copied to the 4-byte formats, NULL for opaque pixels.
+/// @param limited Whether `in` uses the limited (16-235) range.
+void yuv_i420_to_rgb(
+    const struct i420_image &in,
+    const uint8_t *alpha,
+    size_t alpha_stride,
+    bool limited,
+    enum video_pixel_format format,
+    uint8_t *out,
+    size_t stride);
+
+/// @brief Expand a limited range plane to the full range, `out` may be `in`.
+/// @param chroma Whether the samples are chroma (16-240 centered on 128) rather than luma (16-235).
+void yuv_expand_range(
+    const uint8_t *in,
+    size_t in_stride,
+    uint8_t *out,
+    size_t out_stride,
+    unsigned int width,
+    unsigned int height,
+    bool chroma);
+
+/// @brief Rotate a plane clockwise by 0, 90, 180 or 270 degrees, `out` is `height` x `width` at 90 and 270.
+void yuv_rotate_plane(
+    const uint8_t *in,
+    size_t in_stride,
+    unsigned int width,
+    unsigned int height,
+    unsigned int rotation,
+    uint8_t *out,
+    size_t out_stride);
+
+/// @brief Rotate the three planes of `in` into `out`, whose size must be the rotated one.
+void yuv_i420_rotate(const struct i420_image &in, unsigned int rotation, const struct i420_image &out);
+
+/// Rows averaged at most by a box, taller boxes only use their first rows.
+constexpr unsigned int YUV_BOX_MAX_ROWS = 257;
+
+/// @brief Scale a plane to `out_width` x `out_height`.
+/// @param scratch `in_width` entries.
+void yuv_scale_plane(
+    const uint8_t *in,
+    size_t in_stride,
+    unsigned int in_width,
+    unsigned int in_height,
+    uint8_t *out,
+    size_t out_stride,
+    unsigned int out_width,
+    unsigned int out_height,
+    enum video_scale_filter filter,
+    uint16_t *scratch);
+
+/// @brief Scale the three planes of `in` to the size of `out`.
+/// @param scratch `in.width` entries.
+void yuv_i420_scale(const struct i420_image &in, const struct i420_image &out, enum video_scale_filter filter, uint16_t *scratch);
+
+/// @brief Name of the selected kernel set, "avx2", "sse4.2" or "scalar".
+const char *yuv_kernel_name();
+
+#endif
@@ -0,0 +1,167 @@
+#include "c_video_frame_pool.h"
+
+#include <cstring>
+
+PooledVideoRawData::PooledVideoRawData() {
+    len_ = 0;
+    alpha_len_ = 0;
+    y_offset_ = 0;
+    u_offset_ = 0;
+    v_offset_ = 0;
+    limited_ = false;
+    width_ = 0;
+    height_ = 0;
+    rotation_ = 0;
+    source_id_ = 0;
+    timestamp_ = 0;
+    refs_.store(0, std::memory_order_relaxed);
+}
+
+bool PooledVideoRawData::acquire() {
+    if (refs_.load(std::memory_order_acquire) != 0) {
+        return false;
+    }
+    // Only the renderer thread takes free objects, nobody else can raise the count from 0.
+    refs_.store(1, std::memory_order_relaxed);
+    return true;
+}
+
+/// Offset of `plane` in `buffer`, `fallback` when the plane lives elsewhere.
+static size_t plane_offset(const char *buffer, size_t len, const char *plane, size_t fallback) {
+    if (!plane || plane < buffer || plane >= buffer + len) {
+        return fallback;
+    }
+    return static_cast<size_t>(plane - buffer);
+}
+
+void PooledVideoRawData::fill(YUVRawDataI420 *source) {
+    char *data = source->GetBuffer();
+    len_ = source->GetBufferLen();
+    width_ = source->GetStreamWidth();
+    height_ = source->GetStreamHeight();
+    if (buffer_.size() < len_) {
+        // Grows to the largest frame seen, then stays.
+        buffer_.resize(len_);
+    }
+    memcpy(buffer_.data(), data, len_);
+    // The SDK buffer is packed I420, the planes are looked up anyway in case it ever pads them.
+    size_t luma = static_cast<size_t>(width_) * height_;
+    y_offset_ = plane_offset(data, len_, source->GetYBuffer(), 0);
+    u_offset_ = plane_offset(data, len_, source->GetUBuffer(), luma);
+    v_offset_ = plane_offset(data, len_, source->GetVBuffer(), luma + luma / 4);
+
+    char *alpha = source->GetAlphaBuffer();
+    alpha_len_ = alpha ? source->GetAlphaBufferLen() : 0;
+    if (alpha_.size() < alpha_len_) {
+        alpha_.resize(alpha_len_);
+    }
+    if (alpha_len_) {
+        memcpy(alpha_.data(), alpha, alpha_len_);
+    }
+    limited_ = source->IsLimitedI420();
+    rotation_ = source->GetRotation();
+    source_id_ = source->GetSourceID();
+    timestamp_ = source->GetTimeStamp();
+}
+
+struct i420_image PooledVideoRawData::shape(YUVRawDataI420 *source, unsigned int width, unsigned int height) {
+    size_t luma = static_cast<size_t>(width) * height;
+    size_t chroma = static_cast<size_t>((width + 1) / 2) * ((height + 1) / 2);
+    len_ = static_cast<unsigned int>(luma + 2 * chroma);
+    if (buffer_.size() < len_) {
+        buffer_.resize(len_);
+    }
+    width_ = width;
+    height_ = height;
+    y_offset_ = 0;
+    u_offset_ = luma;
+    v_offset_ = luma + chroma;
+    alpha_len_ = 0;
+    limited_ = source->IsLimitedI420();
+    rotation_ = source->GetRotation();
+    source_id_ = source->GetSourceID();
+    timestamp_ = source->GetTimeStamp();
+    uint8_t *data = reinterpret_cast<uint8_t*>(buffer_.data());
+    return {
+        y: data,
+        u: data + u_offset_,
+        v: data + v_offset_,
+        y_stride: width,
+        uv_stride: (width + 1) / 2,
+        width: width,
+        height: height,
+    };
+}
+
+VideoFramePool::VideoFramePool() {
+    for (unsigned int i = 0; i < VIDEO_FRAME_REFS_LIMIT; i += 1) {
+        pool_.emplace_back(new PooledVideoRawData());
+    }
+    cursor_ = 0;
+    max_refs_.store(0, std::memory_order_relaxed);
+    outstanding_.store(0, std::memory_order_relaxed);
+    zero_copy_.store(0, std::memory_order_relaxed);
+    copied_.store(0, std::memory_order_relaxed);
+    refused_.store(0, std::memory_order_relaxed);
+}
+
+bool VideoFramePool::set_max_refs(unsigned int max_refs) {
+    if (max_refs == 0 || max_refs > VIDEO_FRAME_REFS_LIMIT) {
+        return false;
+    }
+    // Lowering the cap keeps the references already out, retain() refuses until they come back under it.
+    max_refs_.store(max_refs, std::memory_order_relaxed);
+    return true;
+}
+
+YUVRawDataI420 *VideoFramePool::retain(YUVRawDataI420 *raw) {
+    if (!raw) {
+        return nullptr;
+    }
+    if (outstanding_.fetch_add(1, std::memory_order_relaxed) >= max_refs_.load(std::memory_order_relaxed)) {
+        outstanding_.fetch_sub(1, std::memory_order_relaxed);
+        refused_.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    if (raw->CanAddRef() && raw->AddRef()) {
+        zero_copy_.fetch_add(1, std::memory_order_relaxed);
+        return raw;
+    }
+    // Only a cap of VIDEO_FRAME_REFS_LIMIT with a thumbnail being delivered can leave no free object.
+    PooledVideoRawData *pooled = acquire();
+    if (!pooled) {
+        outstanding_.fetch_sub(1, std::memory_order_relaxed);
+        refused_.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    pooled->fill(raw);
+    copied_.fetch_add(1, std::memory_order_relaxed);
+    return pooled;
+}
+
+void VideoFramePool::release(YUVRawDataI420 *raw) {
+    if (!raw) {
+        return;
+    }
+    raw->Release();
+    outstanding_.fetch_sub(1, std::memory_order_relaxed);
+}
+
+PooledVideoRawData *VideoFramePool::acquire() {
+    for (size_t i = 0; i < pool_.size(); i += 1) {
+        PooledVideoRawData *pooled = pool_[cursor_].get();
+        cursor_ = (cursor_ + 1) % pool_.size();
+        if (pooled->acquire()) {
+            return pooled;
+        }
+    }
+    return nullptr;
+}
+
+void VideoFramePool::stats(struct video_frame_ref_stats *out) const {
+    out->zero_copy_refs = zero_copy_.load(std::memory_order_relaxed);
+    out->copied_refs = copied_.load(std::memory_order_relaxed);
+    out->refused_refs = refused_.load(std::memory_order_relaxed);
+    out->outstanding = outstanding_.load(std::memory_order_relaxed);
+    out->max_refs = max_refs_.load(std::memory_order_relaxed);
+}
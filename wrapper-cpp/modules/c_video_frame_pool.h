@@ -0,0 +1,136 @@
+#ifndef _C_VIDEO_FRAME_POOL_H_
+#define _C_VIDEO_FRAME_POOL_H_
+
+#include "c_rawdata_video_helper.h"
+#include "c_video_convert.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/// Most references a renderer can hand out at once, whatever the configured cap.
+constexpr unsigned int VIDEO_FRAME_REFS_LIMIT = 64;
+
+/// @brief Wrapper-owned copy of a frame, refcounted like the SDK frames so both kinds are released the same way.
+/// Free when its count drops to 0, then reused by the renderer thread.
+class PooledVideoRawData : public YUVRawDataI420 {
+public:
+    PooledVideoRawData();
+
+    /// @brief Take the object if it is free, with a count of 1. Renderer thread only.
+    bool acquire();
+    /// @brief Copy the buffer, alpha plane and properties of `source`, keeping its plane offsets.
+    void fill(YUVRawDataI420 *source);
+    /// @brief Size the buffer for a packed `width` x `height` frame with the properties of `source`, without alpha.
+    /// @return The planes to write the frame into.
+    struct i420_image shape(YUVRawDataI420 *source, unsigned int width, unsigned int height);
+
+    bool CanAddRef() override {
+        return true;
+    }
+    bool AddRef() override {
+        refs_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    int Release() override {
+        // Publishes the reads of the buffer before the renderer thread can reuse it.
+        return refs_.fetch_sub(1, std::memory_order_acq_rel) - 1;
+    }
+    char* GetYBuffer() override {
+        return buffer_.data() + y_offset_;
+    }
+    char* GetUBuffer() override {
+        return buffer_.data() + u_offset_;
+    }
+    char* GetVBuffer() override {
+        return buffer_.data() + v_offset_;
+    }
+    char* GetAlphaBuffer() override {
+        return alpha_len_ ? alpha_.data() : nullptr;
+    }
+    char* GetBuffer() override {
+        return buffer_.data();
+    }
+    unsigned int GetBufferLen() override {
+        return len_;
+    }
+    unsigned int GetAlphaBufferLen() override {
+        return alpha_len_;
+    }
+    bool IsLimitedI420() override {
+        return limited_;
+    }
+    unsigned int GetStreamWidth() override {
+        return width_;
+    }
+    unsigned int GetStreamHeight() override {
+        return height_;
+    }
+    unsigned int GetRotation() override {
+        return rotation_;
+    }
+    unsigned int GetSourceID() override {
+        return source_id_;
+    }
+    unsigned long long GetTimeStamp() override {
+        return timestamp_;
+    }
+
+private:
+    std::vector<char> buffer_;
+    std::vector<char> alpha_;
+    unsigned int len_;
+    unsigned int alpha_len_;
+    size_t y_offset_;
+    size_t u_offset_;
+    size_t v_offset_;
+    bool limited_;
+    unsigned int width_;
+    unsigned int height_;
+    unsigned int rotation_;
+    unsigned int source_id_;
+    unsigned long long timestamp_;
+    std::atomic<int> refs_;
+};
+
+/// @brief References on the frames of one renderer kept past the callback, see video_raw_data_retain.
+///
+/// A frame is kept by a reference on the SDK buffer when the SDK allows it, and copied into a
+/// pooled buffer otherwise. Either way the renderer never holds more than `max_refs` frames, so
+/// a consumer falling behind cannot pin the decoder's buffers: past the cap retain() refuses.
+/// retain() runs on the renderer thread, inside the frame callback; release() on any thread.
+class VideoFramePool {
+public:
+    VideoFramePool();
+    VideoFramePool(const VideoFramePool &) = delete;
+    VideoFramePool &operator=(const VideoFramePool &) = delete;
+
+    /// @return false if `max_refs` is 0 or over VIDEO_FRAME_REFS_LIMIT.
+    bool set_max_refs(unsigned int max_refs);
+
+    /// @brief Take a reference on the frame being delivered.
+    /// @return The frame to give back with release(), NULL if the cap is reached.
+    YUVRawDataI420 *retain(YUVRawDataI420 *raw);
+
+    void release(YUVRawDataI420 *raw);
+
+    void stats(struct video_frame_ref_stats *out) const;
+
+    /// @brief Take a free pooled frame with a count of 1, for frames made by the wrapper. Renderer thread only.
+    /// @return NULL if every pooled frame is retained.
+    PooledVideoRawData *acquire();
+
+private:
+    /// All VIDEO_FRAME_REFS_LIMIT objects, created up front so the renderer thread never allocates one.
+    std::vector<std::unique_ptr<PooledVideoRawData>> pool_;
+    /// Renderer thread side, where the search for a free pooled frame starts.
+    size_t cursor_;
+    std::atomic<unsigned int> max_refs_;
+    std::atomic<unsigned int> outstanding_;
+    std::atomic<uint64_t> zero_copy_;
+    std::atomic<uint64_t> copied_;
+    std::atomic<uint64_t> refused_;
+};
+
+#endif
@@ -0,0 +1,62 @@
+#include "c_video_frame_rate.h"
+
+VideoFrameRate::VideoFrameRate() {
+    target_fps_.store(0, std::memory_order_relaxed);
+    current_fps_ = 0;
+    reset();
+    forwarded_.store(0, std::memory_order_relaxed);
+    dropped_.store(0, std::memory_order_relaxed);
+}
+
+bool VideoFrameRate::set_target_fps(unsigned int fps) {
+    if (fps > VIDEO_TARGET_FPS_LIMIT) {
+        return false;
+    }
+    target_fps_.store(fps, std::memory_order_relaxed);
+    return true;
+}
+
+void VideoFrameRate::reset() {
+    started_ = false;
+    next_due_ = 0;
+    last_time_ = 0;
+    frame_interval_ = 0;
+}
+
+bool VideoFrameRate::forward(int64_t time_us) {
+    unsigned int fps = target_fps_.load(std::memory_order_relaxed);
+    if (fps != current_fps_) {
+        current_fps_ = fps;
+        started_ = false;
+    }
+    if (fps == 0) {
+        forwarded_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    int64_t period = 1000000 / fps;
+    if (started_) {
+        int64_t gap = time_us - last_time_;
+        // EWMA over ~8 frames, gaps of a second or more are pauses rather than the frame rate.
+        if (gap > 0 && gap < 1000000) {
+            frame_interval_ = frame_interval_ ? frame_interval_ + (gap - frame_interval_) / 8 : gap;
+        }
+    }
+    if (!started_ || time_us < last_time_ || time_us >= next_due_ + period) {
+        started_ = true;
+        next_due_ = time_us;
+    }
+    last_time_ = time_us;
+    if (time_us < next_due_ - frame_interval_ / 2) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    next_due_ += period;
+    forwarded_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void VideoFrameRate::stats(struct video_frame_rate_stats *out) const {
+    out->forwarded_frames = forwarded_.load(std::memory_order_relaxed);
+    out->dropped_frames = dropped_.load(std::memory_order_relaxed);
+    out->target_fps = target_fps_.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,52 @@
+#ifndef _C_VIDEO_FRAME_RATE_H_
+#define _C_VIDEO_FRAME_RATE_H_
+
+#include "c_rawdata_video_helper.h"
+
+#include <atomic>
+#include <cstdint>
+
+/// Highest target frame rate, the SDK sends at most 30 fps.
+constexpr unsigned int VIDEO_TARGET_FPS_LIMIT = 60;
+
+/// @brief Frame rate decimator of a renderer, see video_helper_set_target_fps.
+///
+/// Frames are due every 1 / target_fps on a grid of the frame timestamps started by the first
+/// one. Of the frames around a due time the one closest to it goes through, the others are
+/// dropped: half a source frame interval of tolerance keeps the output cadence even when the
+/// timestamps jitter, and the grid never drifts. A timestamp going back or a gap of a whole
+/// period restarts the grid.
+/// set_target_fps() can be called from any thread, forward() and reset() from the renderer thread only.
+class VideoFrameRate {
+public:
+    VideoFrameRate();
+    VideoFrameRate(const VideoFrameRate &) = delete;
+    VideoFrameRate &operator=(const VideoFrameRate &) = delete;
+
+    /// @return false if `fps` is above VIDEO_TARGET_FPS_LIMIT.
+    bool set_target_fps(unsigned int fps);
+
+    /// @brief Start a new grid on the next frame, e.g. for a new source with its own clock.
+    void reset();
+
+    /// @brief Whether the frame of timestamp `time_us` goes to Rust, counting it.
+    bool forward(int64_t time_us);
+
+    void stats(struct video_frame_rate_stats *out) const;
+
+private:
+    std::atomic<unsigned int> target_fps_;
+
+    /// Renderer thread state.
+    unsigned int current_fps_;
+    bool started_;
+    int64_t next_due_;
+    int64_t last_time_;
+    /// Smoothed interval between source frames.
+    int64_t frame_interval_;
+
+    std::atomic<uint64_t> forwarded_;
+    std::atomic<uint64_t> dropped_;
+};
+
+#endif
@@ -0,0 +1,132 @@
+#include "c_video_thumbnailer.h"
+#include "c_media_timeline.h"
+#include "c_video_convert.h"
+
+VideoThumbnailer::VideoThumbnailer() {
+    enabled_.store(false, std::memory_order_relaxed);
+    forward_.store(true, std::memory_order_relaxed);
+    generation_.store(0, std::memory_order_relaxed);
+    settings_ = {
+        width: 0,
+        height: 0,
+        interval_us: 0,
+        filter: VIDEO_SCALE_BOX,
+    };
+    seen_generation_ = 0;
+    current_ = settings_;
+    next_due_ = 0;
+    thumbnails_.store(0, std::memory_order_relaxed);
+    dropped_.store(0, std::memory_order_relaxed);
+    unforwarded_.store(0, std::memory_order_relaxed);
+    max_scale_us_.store(0, std::memory_order_relaxed);
+}
+
+bool VideoThumbnailer::configure(
+    bool enabled,
+    unsigned int width,
+    unsigned int height,
+    unsigned int interval_ms,
+    enum video_scale_filter filter,
+    bool forward_frames) {
+    if (enabled && (width < 16 || width > 1920 || height < 16 || height > 1080)) {
+        return false;
+    }
+    if (filter != VIDEO_SCALE_BOX && filter != VIDEO_SCALE_BILINEAR) {
+        return false;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        settings_ = {
+            width: width,
+            height: height,
+            interval_us: static_cast<int64_t>(interval_ms) * 1000,
+            filter: filter,
+        };
+        // The renderer thread picks the settings and starts a new grid on its next frame.
+        generation_.fetch_add(1, std::memory_order_release);
+    }
+    forward_.store(forward_frames, std::memory_order_relaxed);
+    enabled_.store(enabled, std::memory_order_release);
+    return true;
+}
+
+bool VideoThumbnailer::forward_frame() {
+    if (!enabled_.load(std::memory_order_acquire) || forward_.load(std::memory_order_relaxed)) {
+        return true;
+    }
+    unforwarded_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+PooledVideoRawData *VideoThumbnailer::process(YUVRawDataI420 *frame, int64_t mono_time, VideoFramePool &pool) {
+    if (!enabled_.load(std::memory_order_acquire)) {
+        return nullptr;
+    }
+    unsigned int generation = generation_.load(std::memory_order_acquire);
+    if (generation != seen_generation_) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        current_ = settings_;
+        seen_generation_ = generation;
+        next_due_ = mono_time;
+    }
+    if (mono_time < next_due_) {
+        return nullptr;
+    }
+    next_due_ += current_.interval_us;
+    if (next_due_ <= mono_time) {
+        // A gap longer than the interval, or no interval: the grid restarts from this frame.
+        next_due_ = mono_time + current_.interval_us;
+    }
+
+    unsigned int width = frame->GetStreamWidth();
+    unsigned int height = frame->GetStreamHeight();
+    if (!width || !height || !frame->GetYBuffer() || !frame->GetUBuffer() || !frame->GetVBuffer()) {
+        return nullptr;
+    }
+    // Fit in the box keeping the aspect ratio, never upscaling, in even sizes.
+    unsigned int out_width;
+    unsigned int out_height;
+    if (static_cast<uint64_t>(width) * current_.height <= static_cast<uint64_t>(height) * current_.width) {
+        out_height = height < current_.height ? height : current_.height;
+        out_width = static_cast<unsigned int>(static_cast<uint64_t>(width) * out_height / height);
+    } else {
+        out_width = width < current_.width ? width : current_.width;
+        out_height = static_cast<unsigned int>(static_cast<uint64_t>(height) * out_width / width);
+    }
+    out_width = out_width < 2 ? 2 : out_width & ~1u;
+    out_height = out_height < 2 ? 2 : out_height & ~1u;
+
+    PooledVideoRawData *thumbnail = pool.acquire();
+    if (!thumbnail) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    struct i420_image out = thumbnail->shape(frame, out_width, out_height);
+    struct i420_image in = {
+        y: reinterpret_cast<uint8_t*>(frame->GetYBuffer()),
+        u: reinterpret_cast<uint8_t*>(frame->GetUBuffer()),
+        v: reinterpret_cast<uint8_t*>(frame->GetVBuffer()),
+        y_stride: width,
+        uv_stride: (width + 1) / 2,
+        width: width,
+        height: height,
+    };
+    if (scratch_.size() < width) {
+        scratch_.resize(width);
+    }
+    int64_t start = monotonic_us();
+    yuv_i420_scale(in, out, current_.filter, scratch_.data());
+    int64_t elapsed = monotonic_us() - start;
+    if (elapsed > max_scale_us_.load(std::memory_order_relaxed)) {
+        max_scale_us_.store(elapsed, std::memory_order_relaxed);
+    }
+    thumbnails_.fetch_add(1, std::memory_order_relaxed);
+    return thumbnail;
+}
+
+void VideoThumbnailer::stats(struct video_thumbnail_stats *out) const {
+    out->thumbnails = thumbnails_.load(std::memory_order_relaxed);
+    out->dropped_thumbnails = dropped_.load(std::memory_order_relaxed);
+    out->unforwarded_frames = unforwarded_.load(std::memory_order_relaxed);
+    out->max_scale_us = max_scale_us_.load(std::memory_order_relaxed);
+}
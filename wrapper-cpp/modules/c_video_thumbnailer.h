@@ -0,0 +1,71 @@
+#ifndef _C_VIDEO_THUMBNAILER_H_
+#define _C_VIDEO_THUMBNAILER_H_
+
+#include "c_rawdata_video_helper.h"
+#include "c_video_frame_pool.h"
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+/// @brief Downscaled copies of the frames of a renderer, see video_helper_set_thumbnail.
+///
+/// Thumbnails are due every `interval_ms` on a grid started by the first one, so they keep their
+/// rate whatever the frame rate; after a gap the grid restarts. A due frame is scaled with the
+/// video kernels into a frame of the renderer's pool, which is released once delivered unless the
+/// consumer retained it.
+/// configure() can be called from any thread, process() and forward_frame() from the renderer thread only.
+class VideoThumbnailer {
+public:
+    VideoThumbnailer();
+    VideoThumbnailer(const VideoThumbnailer &) = delete;
+    VideoThumbnailer &operator=(const VideoThumbnailer &) = delete;
+
+    /// @return false if the settings are invalid.
+    bool configure(
+        bool enabled,
+        unsigned int width,
+        unsigned int height,
+        unsigned int interval_ms,
+        enum video_scale_filter filter,
+        bool forward_frames);
+
+    /// @brief Whether the full frame goes to Rust, counting the ones that do not.
+    bool forward_frame();
+
+    /// @brief Scale `frame` if a thumbnail is due.
+    /// @return A pooled frame to deliver then Release, NULL if no thumbnail is due or the pool is empty.
+    PooledVideoRawData *process(YUVRawDataI420 *frame, int64_t mono_time, VideoFramePool &pool);
+
+    void stats(struct video_thumbnail_stats *out) const;
+
+private:
+    struct Settings {
+        unsigned int width;
+        unsigned int height;
+        int64_t interval_us;
+        enum video_scale_filter filter;
+    };
+
+    std::atomic<bool> enabled_;
+    std::atomic<bool> forward_;
+    std::atomic<unsigned int> generation_;
+    /// Guarded by `mutex_`, copied by the renderer thread when `generation_` moves.
+    Settings settings_;
+    std::mutex mutex_;
+
+    /// Renderer thread state.
+    unsigned int seen_generation_;
+    Settings current_;
+    int64_t next_due_;
+    /// Row of box sums, or interpolated row, as wide as the largest frame seen.
+    std::vector<uint16_t> scratch_;
+
+    std::atomic<uint64_t> thumbnails_;
+    std::atomic<uint64_t> dropped_;
+    std::atomic<uint64_t> unforwarded_;
+    std::atomic<int64_t> max_scale_us_;
+};
+
+#endif